@@ -158,6 +158,7 @@ struct Settings {
   bool trace_startup = false;
   bool trace_systrace = false;
   std::string trace_to_file;
+  std::string trace_engine_to_file;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
@@ -258,6 +259,14 @@ struct Settings {
   // Enable GPU tracing in Vulkan backends.
   bool enable_vulkan_gpu_tracing = false;
 
+  // Render Gaussian blurs with large sigmas using a dual Kawase filter chain
+  // instead of separable Gaussian passes in Impeller.
+  bool impeller_enable_dual_kawase_blur = false;
+
+  // Tessellate complex paths with compute shaders in Impeller. Every such
+  // path is submitted as its own compute command buffer.
+  bool impeller_enable_compute_tessellation = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -354,6 +363,26 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  /// The number of frames that may be built ahead of the rasterizer. Ignored
+  /// when the platform and raster task runners are the same, where the depth
+  /// is 1 unless Metal is used.
+  uint32_t frame_pipeline_depth = 2;
+
+  /// Whether the rasterizer skips the stale frames that are waiting in the
+  /// pipeline when it falls behind, and rasterizes the latest one instead.
+  bool skip_stale_frames = false;
+
+  /// Whether frames start at an offset from the vsync that is predicted from
+  /// the durations of recent frames, instead of at the vsync. Cheap frames
+  /// start later so that they sample more recent input, and expensive frames
+  /// start earlier where the vsync waiter allows it.
+  bool enable_predictive_frame_start = false;
+
+  /// Whether move and hover events are coalesced to one per pointer per frame
+  /// and resampled to the frame time, instead of being dispatched as they
+  /// arrive. See |ResamplingPointerDataDispatcher|.
+  bool enable_pointer_resampling = false;
+
   /// Enable embedder api on the embedder.
   ///
   /// This is currently only used by iOS.
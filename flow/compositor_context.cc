@@ -49,12 +49,14 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
 CompositorContext::CompositorContext()
     : texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(fixed_refresh_rate_updater_),
-      ui_time_(fixed_refresh_rate_updater_) {}
+      ui_time_(fixed_refresh_rate_updater_),
+      frame_timing_histograms_(std::make_shared<FrameTimingHistograms>()) {}
 
 CompositorContext::CompositorContext(Stopwatch::RefreshRateUpdater& updater)
     : texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(updater),
-      ui_time_(updater) {}
+      ui_time_(updater),
+      frame_timing_histograms_(std::make_shared<FrameTimingHistograms>()) {}
 
 CompositorContext::~CompositorContext() = default;
 
@@ -12,6 +12,7 @@
 #include "flutter/common/macros.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/frame_timing_histograms.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/stopwatch.h"
 #include "flutter/fml/macros.h"
@@ -194,11 +195,16 @@ class CompositorContext {
 
   Stopwatch& ui_time() { return ui_time_; }
 
+  const std::shared_ptr<FrameTimingHistograms>& frame_timing_histograms() {
+    return frame_timing_histograms_;
+  }
+
  private:
   NOT_SLIMPELLER(RasterCache raster_cache_);
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
+  std::shared_ptr<FrameTimingHistograms> frame_timing_histograms_;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -0,0 +1,186 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histograms.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t value_micros) {
+  value_micros = std::min(value_micros, kMaxValueMicros);
+  if (value_micros < kSubBucketCount) {
+    return value_micros;
+  }
+  size_t highest_bit = kSubBucketBits;
+  while ((value_micros >> (highest_bit + 1)) != 0) {
+    highest_bit++;
+  }
+  size_t shift = highest_bit - (kSubBucketBits - 1);
+  size_t sub_bucket = value_micros >> shift;
+  return kSubBucketCount + (shift - 1) * (kSubBucketCount / 2) +
+         (sub_bucket - kSubBucketCount / 2);
+}
+
+uint64_t LatencyHistogram::GetBucketMaxValue(size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  size_t offset = index - kSubBucketCount;
+  size_t shift = offset / (kSubBucketCount / 2) + 1;
+  uint64_t sub_bucket = offset % (kSubBucketCount / 2) + kSubBucketCount / 2;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(fml::TimeDelta duration) {
+  uint64_t micros = std::min<uint64_t>(
+      std::max<int64_t>(duration.ToMicroseconds(), 0), kMaxValueMicros);
+  counts_[GetBucketIndex(micros)]++;
+  count_++;
+  sum_micros_ += micros;
+  min_micros_ = std::min(min_micros_, micros);
+  max_micros_ = std::max(max_micros_, micros);
+}
+
+void LatencyHistogram::Add(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kBucketCount; i++) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+  sum_micros_ += other.sum_micros_;
+  min_micros_ = std::min(min_micros_, other.min_micros_);
+  max_micros_ = std::max(max_micros_, other.max_micros_);
+}
+
+void LatencyHistogram::Reset() {
+  *this = LatencyHistogram();
+}
+
+fml::TimeDelta LatencyHistogram::GetMin() const {
+  return fml::TimeDelta::FromMicroseconds(count_ > 0 ? min_micros_ : 0);
+}
+
+fml::TimeDelta LatencyHistogram::GetMax() const {
+  return fml::TimeDelta::FromMicroseconds(max_micros_);
+}
+
+fml::TimeDelta LatencyHistogram::GetMean() const {
+  return fml::TimeDelta::FromMicroseconds(count_ > 0 ? sum_micros_ / count_
+                                                     : 0);
+}
+
+fml::TimeDelta LatencyHistogram::GetValueAtPercentile(double percentile) const {
+  if (count_ == 0) {
+    return fml::TimeDelta::Zero();
+  }
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  uint64_t rank = std::max<uint64_t>(
+      static_cast<uint64_t>(std::ceil(percentile / 100.0 * count_)), 1u);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      // The end of the bucket may lie past the largest recorded value.
+      return fml::TimeDelta::FromMicroseconds(
+          std::min(GetBucketMaxValue(i), max_micros_));
+    }
+  }
+  return GetMax();
+}
+
+FrameTimingHistograms::FrameTimingHistograms() = default;
+
+FrameTimingHistograms::~FrameTimingHistograms() = default;
+
+const char* FrameTimingHistograms::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kVsyncToBuildStart:
+      return "vsyncToBuildStart";
+    case Phase::kBuild:
+      return "build";
+    case Phase::kRaster:
+      return "raster";
+    case Phase::kGpuSubmit:
+      return "gpuSubmit";
+    case Phase::kPresentLatency:
+      return "presentLatency";
+    case Phase::kRasterCache:
+      return "rasterCache";
+    case Phase::kPipelineQueue:
+      return "pipelineQueue";
+  }
+  FML_UNREACHABLE();
+}
+
+int64_t FrameTimingHistograms::GetWindowNumber(fml::TimePoint time) {
+  return time.ToEpochDelta() / kWindowDuration;
+}
+
+void FrameTimingHistograms::Record(Phase phase,
+                                   fml::TimeDelta duration,
+                                   fml::TimePoint now) {
+  int64_t number = GetWindowNumber(now);
+  std::scoped_lock lock(mutex_);
+  Window& window = windows_[number % kWindowCount];
+  if (window.number != number) {
+    // The sub-window was last used a whole window ago.
+    for (LatencyHistogram& histogram : window.histograms) {
+      histogram.Reset();
+    }
+    window.number = number;
+  }
+  window.histograms[static_cast<size_t>(phase)].Record(duration);
+}
+
+void FrameTimingHistograms::RecordFrame(const FrameTiming& timing,
+                                        fml::TimePoint now) {
+  const fml::TimePoint vsync_start = timing.Get(FrameTiming::kVsyncStart);
+  const fml::TimePoint build_start = timing.Get(FrameTiming::kBuildStart);
+  const fml::TimePoint build_finish = timing.Get(FrameTiming::kBuildFinish);
+  const fml::TimePoint raster_start = timing.Get(FrameTiming::kRasterStart);
+  const fml::TimePoint raster_finish = timing.Get(FrameTiming::kRasterFinish);
+  Record(Phase::kVsyncToBuildStart, build_start - vsync_start, now);
+  Record(Phase::kBuild, build_finish - build_start, now);
+  Record(Phase::kPipelineQueue, raster_start - build_finish, now);
+  Record(Phase::kRaster, raster_finish - raster_start, now);
+  Record(Phase::kPresentLatency, raster_finish - vsync_start, now);
+}
+
+FrameTimingHistograms::Statistics FrameTimingHistograms::GetStatistics(
+    Phase phase,
+    fml::TimeDelta window,
+    fml::TimePoint now) const {
+  int64_t window_count = std::clamp<int64_t>(
+      (window + kWindowDuration - fml::TimeDelta::FromNanoseconds(1)) /
+          kWindowDuration,
+      1, kWindowCount);
+  int64_t number = GetWindowNumber(now);
+
+  LatencyHistogram histogram;
+  {
+    std::scoped_lock lock(mutex_);
+    for (const Window& sub_window : windows_) {
+      if (sub_window.number > number - window_count &&
+          sub_window.number <= number) {
+        histogram.Add(sub_window.histograms[static_cast<size_t>(phase)]);
+      }
+    }
+  }
+
+  return {
+      .count = histogram.GetCount(),
+      .min = histogram.GetMin(),
+      .max = histogram.GetMax(),
+      .mean = histogram.GetMean(),
+      .p50 = histogram.GetValueAtPercentile(50),
+      .p90 = histogram.GetValueAtPercentile(90),
+      .p99 = histogram.GetValueAtPercentile(99),
+      .p999 = histogram.GetValueAtPercentile(99.9),
+  };
+}
+
+}  // namespace flutter
@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
+#define FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A histogram of durations with a bounded relative error, in the
+///             style of HdrHistogram.
+///
+///             Durations are counted in microseconds. Below
+///             |kSubBucketCount| microseconds, every value has a bucket of
+///             its own. Above it, each power of two is split into
+///             |kSubBucketCount| / 2 buckets. Percentiles are rounded up to
+///             the end of their bucket, so they overstate the recorded values
+///             by at most 2 / |kSubBucketCount|, or 6.25%. Durations longer
+///             than |kMaxValueMicros| are counted as that.
+///
+class LatencyHistogram {
+ public:
+  static constexpr size_t kSubBucketBits = 5u;
+  static constexpr size_t kSubBucketCount = 1u << kSubBucketBits;
+  static constexpr size_t kMaxValueBits = 26u;
+  static constexpr uint64_t kMaxValueMicros = (1u << kMaxValueBits) - 1u;
+  static constexpr size_t kBucketCount =
+      kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketCount / 2;
+
+  void Record(fml::TimeDelta duration);
+
+  /// Adds the counts of another histogram to this one.
+  void Add(const LatencyHistogram& other);
+
+  void Reset();
+
+  uint64_t GetCount() const { return count_; }
+
+  fml::TimeDelta GetMin() const;
+
+  fml::TimeDelta GetMax() const;
+
+  fml::TimeDelta GetMean() const;
+
+  /// The smallest duration that |percentile| percent of the recorded
+  /// durations are less than or equal to, rounded up to the end of its bucket.
+  fml::TimeDelta GetValueAtPercentile(double percentile) const;
+
+  static size_t GetBucketIndex(uint64_t value_micros);
+
+  /// The largest value that is counted in the bucket at |index|.
+  static uint64_t GetBucketMaxValue(size_t index);
+
+ private:
+  std::array<uint32_t, kBucketCount> counts_ = {};
+  uint64_t count_ = 0;
+  uint64_t sum_micros_ = 0;
+  uint64_t min_micros_ = kMaxValueMicros;
+  uint64_t max_micros_ = 0;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Latency histograms of the phases of rendering a frame, over a
+///             sliding window of recent frames.
+///
+///             The window is made of |kWindowCount| sub-windows that are
+///             |kWindowDuration| long each. Recording a duration counts it in
+///             the sub-window of the current time, and queries merge the
+///             sub-windows that they span.
+///
+///             This class is thread safe. Recording takes a lock, which is
+///             only ever contended by queries.
+///
+class FrameTimingHistograms {
+ public:
+  enum class Phase {
+    /// From the vsync signal to the start of the build.
+    kVsyncToBuildStart,
+    /// Building the layer tree on the UI thread.
+    kBuild,
+    /// Rasterizing the layer tree on the raster thread.
+    kRaster,
+    /// Submitting a rasterized frame to the surface, per view.
+    kGpuSubmit,
+    /// From the vsync signal to the end of the rasterization of the frame.
+    kPresentLatency,
+    /// Populating the raster cache during a frame.
+    kRasterCache,
+    /// From the end of the build to the start of the rasterization, while the
+    /// frame waits in the pipeline.
+    kPipelineQueue,
+  };
+
+  static constexpr size_t kPhaseCount =
+      static_cast<size_t>(Phase::kPipelineQueue) + 1;
+
+  static constexpr Phase kPhases[kPhaseCount] = {
+      Phase::kVsyncToBuildStart, Phase::kBuild,          Phase::kRaster,
+      Phase::kGpuSubmit,         Phase::kPresentLatency, Phase::kRasterCache,
+      Phase::kPipelineQueue,
+  };
+
+  static constexpr size_t kWindowCount = 6u;
+  static constexpr fml::TimeDelta kWindowDuration =
+      fml::TimeDelta::FromSeconds(10);
+  static constexpr fml::TimeDelta kMaxWindow = kWindowDuration * kWindowCount;
+
+  struct Statistics {
+    uint64_t count = 0;
+    fml::TimeDelta min;
+    fml::TimeDelta max;
+    fml::TimeDelta mean;
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+    fml::TimeDelta p999;
+  };
+
+  FrameTimingHistograms();
+
+  ~FrameTimingHistograms();
+
+  /// The name of the phase in service protocol responses.
+  static const char* GetPhaseName(Phase phase);
+
+  void Record(Phase phase,
+              fml::TimeDelta duration,
+              fml::TimePoint now = fml::TimePoint::Now());
+
+  /// Records the vsync to build start, build, pipeline queue, raster and
+  /// present latency phases of a rasterized frame.
+  void RecordFrame(const FrameTiming& timing,
+                   fml::TimePoint now = fml::TimePoint::Now());
+
+  /// The statistics of the durations recorded in the last |window|, rounded
+  /// up to a whole number of sub-windows and clamped to |kMaxWindow|.
+  Statistics GetStatistics(Phase phase,
+                           fml::TimeDelta window = kMaxWindow,
+                           fml::TimePoint now = fml::TimePoint::Now()) const;
+
+ private:
+  struct Window {
+    int64_t number = -1;
+    std::array<LatencyHistogram, kPhaseCount> histograms;
+  };
+
+  mutable std::mutex mutex_;
+  std::array<Window, kWindowCount> windows_;
+
+  static int64_t GetWindowNumber(fml::TimePoint time);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimingHistograms);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_TIMING_HISTOGRAMS_H_
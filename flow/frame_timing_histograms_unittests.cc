@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_timing_histograms.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using Phase = FrameTimingHistograms::Phase;
+
+fml::TimeDelta Micros(int64_t micros) {
+  return fml::TimeDelta::FromMicroseconds(micros);
+}
+
+fml::TimePoint Seconds(int64_t seconds) {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(seconds));
+}
+
+}  // namespace
+
+TEST(LatencyHistogramTest, BucketsCoverValuesWithoutGaps) {
+  EXPECT_EQ(LatencyHistogram::GetBucketIndex(0), 0u);
+  EXPECT_EQ(LatencyHistogram::GetBucketIndex(31), 31u);
+  EXPECT_EQ(LatencyHistogram::GetBucketIndex(LatencyHistogram::kMaxValueMicros),
+            LatencyHistogram::kBucketCount - 1);
+  for (size_t i = 1; i < LatencyHistogram::kBucketCount; i++) {
+    uint64_t first_value = LatencyHistogram::GetBucketMaxValue(i - 1) + 1;
+    EXPECT_EQ(LatencyHistogram::GetBucketIndex(first_value), i);
+    EXPECT_EQ(LatencyHistogram::GetBucketIndex(
+                  LatencyHistogram::GetBucketMaxValue(i)),
+              i);
+  }
+}
+
+TEST(LatencyHistogramTest, PercentilesAreWithinBucketPrecision) {
+  LatencyHistogram histogram;
+  for (int64_t micros = 1; micros <= 10000; micros++) {
+    histogram.Record(Micros(micros));
+  }
+
+  EXPECT_EQ(histogram.GetCount(), 10000u);
+  EXPECT_EQ(histogram.GetMin(), Micros(1));
+  EXPECT_EQ(histogram.GetMax(), Micros(10000));
+  EXPECT_EQ(histogram.GetMean(), Micros(5000));
+  for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+    double expected = percentile * 100;
+    double actual = histogram.GetValueAtPercentile(percentile).ToMicroseconds();
+    EXPECT_GE(actual, expected);
+    EXPECT_LE(actual, expected * 1.07);
+  }
+  EXPECT_EQ(histogram.GetValueAtPercentile(100), Micros(10000));
+}
+
+TEST(LatencyHistogramTest, ClampsOutOfRangeDurations) {
+  LatencyHistogram histogram;
+  histogram.Record(Micros(-5));
+  histogram.Record(fml::TimeDelta::FromSeconds(1000));
+
+  EXPECT_EQ(histogram.GetMin(), Micros(0));
+  EXPECT_EQ(histogram.GetMax(), Micros(LatencyHistogram::kMaxValueMicros));
+}
+
+TEST(FrameTimingHistogramsTest, RecordsFramePhases) {
+  FrameTiming timing;
+  fml::TimePoint vsync = Seconds(100);
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  timing.Set(FrameTiming::kBuildStart, vsync + Micros(1000));
+  timing.Set(FrameTiming::kBuildFinish, vsync + Micros(5000));
+  timing.Set(FrameTiming::kRasterStart, vsync + Micros(6000));
+  timing.Set(FrameTiming::kRasterFinish, vsync + Micros(14000));
+
+  FrameTimingHistograms histograms;
+  histograms.RecordFrame(timing, vsync);
+
+  auto statistics = [&](Phase phase) {
+    return histograms.GetStatistics(phase, FrameTimingHistograms::kMaxWindow,
+                                    vsync);
+  };
+  EXPECT_EQ(statistics(Phase::kVsyncToBuildStart).max, Micros(1000));
+  EXPECT_EQ(statistics(Phase::kBuild).max, Micros(4000));
+  EXPECT_EQ(statistics(Phase::kPipelineQueue).max, Micros(1000));
+  EXPECT_EQ(statistics(Phase::kRaster).max, Micros(8000));
+  EXPECT_EQ(statistics(Phase::kPresentLatency).max, Micros(14000));
+  EXPECT_EQ(statistics(Phase::kGpuSubmit).count, 0u);
+  EXPECT_EQ(statistics(Phase::kRasterCache).count, 0u);
+}
+
+TEST(FrameTimingHistogramsTest, ForgetsDurationsOutsideTheWindow) {
+  FrameTimingHistograms histograms;
+  histograms.Record(Phase::kRaster, Micros(30000), Seconds(100));
+  histograms.Record(Phase::kRaster, Micros(1000), Seconds(135));
+  histograms.Record(Phase::kRaster, Micros(2000), Seconds(155));
+
+  auto statistics = histograms.GetStatistics(
+      Phase::kRaster, FrameTimingHistograms::kMaxWindow, Seconds(155));
+  EXPECT_EQ(statistics.count, 3u);
+  EXPECT_EQ(statistics.max, Micros(30000));
+
+  statistics = histograms.GetStatistics(
+      Phase::kRaster, fml::TimeDelta::FromSeconds(30), Seconds(155));
+  EXPECT_EQ(statistics.count, 2u);
+  EXPECT_EQ(statistics.max, Micros(2000));
+
+  // A minute later, the sub-window of the first duration has been reused.
+  histograms.Record(Phase::kRaster, Micros(3000), Seconds(160));
+  statistics = histograms.GetStatistics(
+      Phase::kRaster, FrameTimingHistograms::kMaxWindow, Seconds(160));
+  EXPECT_EQ(statistics.count, 3u);
+  EXPECT_EQ(statistics.max, Micros(3000));
+
+  statistics = histograms.GetStatistics(
+      Phase::kRaster, FrameTimingHistograms::kMaxWindow, Seconds(1000));
+  EXPECT_EQ(statistics.count, 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -135,7 +135,13 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
 #if !SLIMPELLER
   if (cache) {
     cache->EvictUnusedCacheEntries();
-    TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
+    if (!raster_cache_items_.empty()) {
+      const fml::TimePoint start = fml::TimePoint::Now();
+      TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
+      frame.context().frame_timing_histograms()->Record(
+          FrameTimingHistograms::Phase::kRasterCache,
+          fml::TimePoint::Now() - start);
+    }
   }
 #endif  //  !SLIMPELLER
 
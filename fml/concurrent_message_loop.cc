@@ -11,19 +11,35 @@
 
 namespace fml {
 
+namespace {
+
+/// The loop and index of the worker running on the current thread, if any.
+struct WorkerIdentity {
+  const ConcurrentMessageLoop* loop = nullptr;
+  size_t index = 0;
+};
+
+thread_local WorkerIdentity tls_worker;
+
+/// The number of times an idle worker looks for work again, yielding in
+/// between, before it parks.
+constexpr size_t kIdleSpinCount = 64;
+
+}  // namespace
+
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_states_.emplace_back(std::make_unique<Worker>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
@@ -32,6 +48,13 @@ ConcurrentMessageLoop::~ConcurrentMessageLoop() {
     FML_DCHECK(worker.joinable());
     worker.join();
   }
+
+  // Tasks that were still pending at shutdown are dropped, as before.
+  for (auto& worker : worker_states_) {
+    while (fml::closure* task = worker->tasks.Pop()) {
+      delete task;
+    }
+  }
 }
 
 size_t ConcurrentMessageLoop::GetWorkerCount() const {
@@ -42,73 +65,144 @@ std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
   return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(const fml::closure& task,
+                                     TaskPriority priority) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     ExecuteTask(task);
     return;
   }
 
-  tasks_.push(task);
+  if (priority == TaskPriority::kNormal && tls_worker.loop == this) {
+    // Tasks posted by tasks are most likely to touch the same data, so they
+    // stay on this worker unless another one runs out of work and steals
+    // them.
+    worker_states_[tls_worker.index]->tasks.Push(new fml::closure(task));
+  } else {
+    std::scoped_lock lock(injected_tasks_mutex_);
+    injected_tasks_[static_cast<size_t>(priority)].push_back(task);
+    ++injected_task_count_;
+  }
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  NotifyWorkPosted(/*wake_all=*/false);
+}
 
-  tasks_condition_.notify_one();
+void ConcurrentMessageLoop::NotifyWorkPosted(bool wake_all) {
+  // Paired with the check of |work_epoch_| by workers about to park. Either
+  // the worker sees the new epoch, or this sees the worker as idle.
+  ++work_epoch_;
+  if (idle_worker_count_ == 0) {
+    return;
+  }
+
+  // Workers increment |idle_worker_count_| and wait with the mutex held, so
+  // acquiring it ensures they are waiting by the time they are notified.
+  { std::scoped_lock lock(idle_mutex_); }
+  if (wake_all) {
+    idle_condition_.notify_all();
+  } else {
+    idle_condition_.notify_one();
+  }
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+fml::closure ConcurrentMessageLoop::TakeInjectedTask(TaskPriority priority) {
+  if (injected_task_count_ == 0) {
+    return nullptr;
+  }
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
-    std::vector<fml::closure> thread_tasks;
+  std::scoped_lock lock(injected_tasks_mutex_);
+  auto& tasks = injected_tasks_[static_cast<size_t>(priority)];
+  if (tasks.empty()) {
+    return nullptr;
+  }
+  fml::closure task = std::move(tasks.front());
+  tasks.pop_front();
+  --injected_task_count_;
+  return task;
+}
 
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+fml::closure ConcurrentMessageLoop::FindTask(size_t worker_index) {
+  if (fml::closure task = TakeInjectedTask(TaskPriority::kHigh)) {
+    return task;
+  }
+
+  std::unique_ptr<fml::closure> local_task(
+      worker_states_[worker_index]->tasks.Pop());
+  if (local_task) {
+    return std::move(*local_task);
+  }
+
+  if (fml::closure task = TakeInjectedTask(TaskPriority::kNormal)) {
+    return task;
+  }
+
+  for (size_t i = 1; i < worker_count_; ++i) {
+    size_t victim = (worker_index + i) % worker_count_;
+    std::unique_ptr<fml::closure> stolen_task(
+        worker_states_[victim]->tasks.Steal());
+    if (stolen_task) {
+      return std::move(*stolen_task);
     }
+  }
+
+  return TakeInjectedTask(TaskPriority::kLow);
+}
+
+void ConcurrentMessageLoop::RunThreadTasks(Worker& worker) {
+  std::vector<fml::closure> thread_tasks;
+  {
+    std::scoped_lock lock(worker.thread_tasks_mutex);
+    std::swap(thread_tasks, worker.thread_tasks);
+    worker.has_thread_tasks = false;
+  }
+  for (const auto& thread_task : thread_tasks) {
+    ExecuteTask(thread_task);
+  }
+}
+
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tls_worker = {this, worker_index};
+  Worker& worker = *worker_states_[worker_index];
 
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+  size_t spin_count = 0;
+  while (true) {
+    const size_t epoch = work_epoch_;
+
+    if (worker.has_thread_tasks) {
+      RunThreadTasks(worker);
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+    if (shutdown_) {
+      break;
+    }
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
+    if (fml::closure task = FindTask(worker_index)) {
+      TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
       ExecuteTask(task);
+      spin_count = 0;
+      continue;
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      ExecuteTask(thread_task);
+    if (spin_count < kIdleSpinCount) {
+      ++spin_count;
+      std::this_thread::yield();
+      continue;
     }
+    spin_count = 0;
 
-    if (shutdown_now) {
-      break;
-    }
+    std::unique_lock lock(idle_mutex_);
+    ++idle_worker_count_;
+    idle_condition_.wait(lock, [&]() {
+      return shutdown_ || work_epoch_ != epoch || worker.has_thread_tasks;
+    });
+    --idle_worker_count_;
   }
 }
 
@@ -117,9 +211,11 @@ void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
-  shutdown_ = true;
-  tasks_condition_.notify_all();
+  {
+    std::scoped_lock lock(idle_mutex_);
+    shutdown_ = true;
+  }
+  idle_condition_.notify_all();
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -127,24 +223,12 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (auto& worker : worker_states_) {
+    std::scoped_lock lock(worker->thread_tasks_mutex);
+    worker->thread_tasks.emplace_back(task);
+    worker->has_thread_tasks = true;
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
+  NotifyWorkPosted(/*wake_all=*/true);
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -154,12 +238,18 @@ ConcurrentTaskRunner::ConcurrentTaskRunner(
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
 void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
+  PostTaskWithPriority(task, ConcurrentMessageLoop::TaskPriority::kNormal);
+}
+
+void ConcurrentTaskRunner::PostTaskWithPriority(
+    const fml::closure& task,
+    ConcurrentMessageLoop::TaskPriority priority) {
   if (!task) {
     return;
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(task, priority);
     return;
   }
 
@@ -170,13 +260,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return tls_worker.loop == this;
 }
 
 }  // namespace fml
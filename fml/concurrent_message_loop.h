@@ -5,22 +5,46 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/work_stealing_deque.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+//------------------------------------------------------------------------------
+/// @brief      A pool of worker threads that run tasks in no particular order.
+///
+///             Each worker has a lock-free deque for the tasks posted from
+///             its own tasks, and steals from the deques of other workers
+///             when it runs out of work. Tasks posted from other threads go
+///             into a global injection queue. Idle workers spin briefly
+///             before parking, so that bursts of fine-grained tasks do not
+///             pay for a wake-up per task.
+///
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  //----------------------------------------------------------------------------
+  /// High priority tasks run before any other pending task. Low priority
+  /// tasks only run when a worker finds no other work.
+  ///
+  enum class TaskPriority {
+    kHigh,
+    kNormal,
+    kLow,
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
       size_t worker_count = std::thread::hardware_concurrency());
 
@@ -43,22 +67,43 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  struct Worker {
+    WorkStealingDeque<fml::closure> tasks;
+    std::mutex thread_tasks_mutex;
+    std::vector<fml::closure> thread_tasks;
+    std::atomic_bool has_thread_tasks = false;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::vector<std::unique_ptr<Worker>> worker_states_;
+
+  // Tasks posted from threads that are not workers of this loop, and tasks
+  // with a priority other than |TaskPriority::kNormal|. Indexed by priority.
+  std::mutex injected_tasks_mutex_;
+  std::deque<fml::closure> injected_tasks_[3];
+  std::atomic_size_t injected_task_count_ = 0;
+
+  // Parking of idle workers. |work_epoch_| changes whenever work is posted so
+  // that a worker about to park can tell whether it missed any.
+  std::mutex idle_mutex_;
+  std::condition_variable idle_condition_;
+  std::atomic_size_t idle_worker_count_ = 0;
+  std::atomic_size_t work_epoch_ = 0;
+  std::atomic_bool shutdown_ = false;
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
-  void PostTask(const fml::closure& task);
+  void PostTask(const fml::closure& task,
+                TaskPriority priority = TaskPriority::kNormal);
 
-  bool HasThreadTasksLocked() const;
+  fml::closure FindTask(size_t worker_index);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  fml::closure TakeInjectedTask(TaskPriority priority);
+
+  void RunThreadTasks(Worker& worker);
+
+  void NotifyWorkPosted(bool wake_all);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
@@ -71,6 +116,9 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
 
   void PostTask(const fml::closure& task) override;
 
+  void PostTaskWithPriority(const fml::closure& task,
+                            ConcurrentMessageLoop::TaskPriority priority);
+
  private:
   friend ConcurrentMessageLoop;
 
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+#include <functional>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+namespace {
+
+constexpr size_t kTaskCount = 10000;
+
+// A small amount of work per task, so that the benchmarks measure the cost of
+// scheduling rather than the work itself.
+void Spin() {
+  static std::atomic_size_t sink;
+  size_t value = 0;
+  for (size_t i = 0; i < 100; i++) {
+    value += i * i;
+  }
+  sink.fetch_add(value, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+// All tasks are posted from a thread that is not a worker, as the engine does
+// for image decoding.
+static void BM_ConcurrentMessageLoopExternalPosts(
+    benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+
+  for (auto _ : state) {
+    CountDownLatch latch(kTaskCount);
+    for (size_t i = 0; i < kTaskCount; i++) {
+      task_runner->PostTask([&latch]() {
+        Spin();
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+// Tasks are posted by other tasks, fanning out from a single root task, as
+// recursive parallel work does.
+static void BM_ConcurrentMessageLoopRecursivePosts(
+    benchmark::State& state) {  // NOLINT
+  auto loop = ConcurrentMessageLoop::Create(state.range(0));
+  auto task_runner = loop->GetTaskRunner();
+
+  for (auto _ : state) {
+    CountDownLatch latch(kTaskCount);
+    std::function<void(size_t, size_t)> post_range = [&](size_t begin,
+                                                         size_t end) {
+      task_runner->PostTask([&, begin, end]() {
+        // Split the range in halves until a single task remains.
+        size_t current_end = end;
+        while (current_end - begin > 1) {
+          size_t middle = begin + (current_end - begin) / 2;
+          post_range(middle, current_end);
+          current_end = middle;
+        }
+        Spin();
+        latch.CountDown();
+      });
+    };
+    post_range(0, kTaskCount);
+    latch.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * kTaskCount);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopExternalPosts)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_ConcurrentMessageLoopRecursivePosts)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
+}  // namespace benchmarking
+}  // namespace fml
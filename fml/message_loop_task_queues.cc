@@ -47,10 +47,10 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
-  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
-  ++task_queue_id_counter_;
-  queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
+  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_++);
+  Shard& shard = shards_[loop_id % kShardCount];
+  std::lock_guard guard(shard.mutex);
+  shard.entries[loop_id] = std::make_shared<TaskQueueEntry>(loop_id);
   return loop_id;
 }
 
@@ -61,26 +61,58 @@ MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
+std::shared_ptr<TaskQueueEntry> MessageLoopTaskQueues::GetEntry(
+    TaskQueueId queue_id) const {
+  const Shard& shard = shards_[queue_id % kShardCount];
+  std::lock_guard guard(shard.mutex);
+  auto found = shard.entries.find(queue_id);
+  FML_CHECK(found != shard.entries.end())
+      << "Task queue " << queue_id << " does not exist.";
+  return found->second;
+}
+
+MessageLoopTaskQueues::LockedEntry MessageLoopTaskQueues::LockEntry(
+    TaskQueueId queue_id) const {
+  std::shared_ptr<TaskQueueEntry> entry = GetEntry(queue_id);
+  for (;;) {
+    // The owner can only change while both its mutex and the mutex of the
+    // entry are held, so it is stable once its mutex is held and it still
+    // owns the entry.
+    TaskQueueId owner = entry->subsumed_by.load();
+    std::shared_ptr<TaskQueueEntry> owner_entry =
+        owner == kUnmerged ? entry : GetEntry(owner);
+    std::unique_lock lock(owner_entry->mutex);
+    if (entry->subsumed_by.load() == owner) {
+      return {std::move(entry), std::move(lock)};
+    }
+  }
+}
+
+void MessageLoopTaskQueues::EraseEntry(TaskQueueId queue_id) {
+  Shard& shard = shards_[queue_id % kShardCount];
+  std::lock_guard guard(shard.mutex);
+  shard.entries.erase(queue_id);
+}
+
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
+  LockedEntry locked = LockEntry(queue_id);
+  const auto& queue_entry = locked.entry;
+  FML_DCHECK(queue_entry->subsumed_by.load() == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.erase(subsumed);
+    EraseEntry(subsumed);
   }
-  // Erase owner queue_id at last to avoid &subsumed_set from being invalid
-  queue_entries_.erase(queue_id);
+  EraseEntry(queue_id);
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
+  LockedEntry locked = LockEntry(queue_id);
+  const auto& queue_entry = locked.entry;
+  FML_DCHECK(queue_entry->subsumed_by.load() == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
   queue_entry->task_source->ShutDown();
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.at(subsumed)->task_source->ShutDown();
+    GetEntry(subsumed)->task_source->ShutDown();
   }
 }
 
@@ -93,39 +125,40 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+  LockedEntry locked = LockEntry(queue_id);
   size_t order = order_++;
-  const auto& queue_entry = queue_entries_.at(queue_id);
+  const auto& queue_entry = locked.entry;
   queue_entry->task_source->RegisterTask(
       {order, task, target_time, task_source_grade});
-  TaskQueueId loop_to_wake = queue_id;
-  if (queue_entry->subsumed_by != kUnmerged) {
-    loop_to_wake = queue_entry->subsumed_by;
-  }
+  TaskQueueId loop_to_wake = queue_entry->subsumed_by.load();
+  std::shared_ptr<TaskQueueEntry> loop_to_wake_entry =
+      loop_to_wake == kUnmerged ? queue_entry : GetEntry(loop_to_wake);
 
   // This can happen when the secondary tasks are paused.
-  if (HasPendingTasksUnlocked(loop_to_wake)) {
-    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  if (HasPendingTasksUnlocked(*loop_to_wake_entry)) {
+    WakeUpUnlocked(*loop_to_wake_entry,
+                   GetNextWakeTimeUnlocked(*loop_to_wake_entry));
   }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  return HasPendingTasksUnlocked(queue_id);
+  LockedEntry locked = LockEntry(queue_id);
+  return HasPendingTasksUnlocked(*locked.entry);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
-  if (!HasPendingTasksUnlocked(queue_id)) {
+  LockedEntry locked = LockEntry(queue_id);
+  const TaskQueueEntry& entry = *locked.entry;
+  if (!HasPendingTasksUnlocked(entry)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
+  TaskSource::TopTask top = PeekNextTaskUnlocked(entry);
 
-  if (!HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, fml::TimePoint::Max());
+  if (!HasPendingTasksUnlocked(entry)) {
+    WakeUpUnlocked(entry, fml::TimePoint::Max());
   } else {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+    WakeUpUnlocked(entry, GetNextWakeTimeUnlocked(entry));
   }
 
   if (top.task.GetTargetTime() > from_time) {
@@ -133,22 +166,26 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   }
   fml::closure invocation = top.task.GetTask();
   const auto task_source_grade = top.task.GetTaskSourceGrade();
-  queue_entries_.at(top.task_queue_id)->task_source->PopTask(task_source_grade);
+  if (top.task_queue_id == queue_id) {
+    entry.task_source->PopTask(task_source_grade);
+  } else {
+    GetEntry(top.task_queue_id)->task_source->PopTask(task_source_grade);
+  }
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
 
-void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
+void MessageLoopTaskQueues::WakeUpUnlocked(const TaskQueueEntry& entry,
                                            fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+  if (entry.wakeable) {
+    entry.wakeable->WakeUp(time);
   }
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
-  if (queue_entry->subsumed_by != kUnmerged) {
+  LockedEntry locked = LockEntry(queue_id);
+  const auto& queue_entry = locked.entry;
+  if (queue_entry->subsumed_by.load() != kUnmerged) {
     return 0;
   }
 
@@ -157,7 +194,7 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 
   auto& subsumed_set = queue_entry->owner_of;
   for (auto& subsumed : subsumed_set) {
-    const auto& subsumed_entry = queue_entries_.at(subsumed);
+    const auto& subsumed_entry = GetEntry(subsumed);
     total_tasks += subsumed_entry->task_source->GetNumPendingTasks();
   }
   return total_tasks;
@@ -166,33 +203,34 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  LockedEntry locked = LockEntry(queue_id);
+  locked.entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  LockedEntry locked = LockEntry(queue_id);
+  locked.entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  LockedEntry locked = LockEntry(queue_id);
+  const auto& queue_entry = locked.entry;
   std::vector<fml::closure> observers;
 
-  if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
+  if (queue_entry->subsumed_by.load() != kUnmerged) {
     return observers;
   }
 
-  for (const auto& observer : queue_entries_.at(queue_id)->task_observers) {
+  for (const auto& observer : queue_entry->task_observers) {
     observers.push_back(observer.second);
   }
 
-  auto& subsumed_set = queue_entries_.at(queue_id)->owner_of;
+  auto& subsumed_set = queue_entry->owner_of;
   for (auto& subsumed : subsumed_set) {
-    for (const auto& observer : queue_entries_.at(subsumed)->task_observers) {
+    for (const auto& observer : GetEntry(subsumed)->task_observers) {
       observers.push_back(observer.second);
     }
   }
@@ -202,19 +240,21 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  LockedEntry locked = LockEntry(queue_id);
+  FML_CHECK(!locked.entry->wakeable) << "Wakeable can only be set once.";
+  locked.entry->wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
-  auto& owner_entry = queue_entries_.at(owner);
-  auto& subsumed_entry = queue_entries_.at(subsumed);
+  std::shared_ptr<TaskQueueEntry> owner_entry = GetEntry(owner);
+  std::shared_ptr<TaskQueueEntry> subsumed_entry = GetEntry(subsumed);
+  // Neither queue can change its owner without holding its own mutex, so the
+  // checks below see a consistent state. When both queues are unmerged, as
+  // required for merging, these are the mutexes guarding both entries.
+  std::scoped_lock guard(owner_entry->mutex, subsumed_entry->mutex);
   auto& subsumed_set = owner_entry->owner_of;
   if (subsumed_set.find(subsumed) != subsumed_set.end()) {
     return true;
@@ -224,11 +264,12 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   // merged with other different queues.
 
   // Ensure owner_entry->subsumed_by being kUnmerged
-  if (owner_entry->subsumed_by != kUnmerged) {
+  if (owner_entry->subsumed_by.load() != kUnmerged) {
     FML_LOG(WARNING) << "Thread merging failed: owner_entry was already "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed
-                     << ", owner->subsumed_by=" << owner_entry->subsumed_by;
+                     << ", owner->subsumed_by="
+                     << owner_entry->subsumed_by.load();
     return false;
   }
   // Ensure subsumed_entry->owner_of being empty
@@ -240,42 +281,43 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
     return false;
   }
   // Ensure subsumed_entry->subsumed_by being kUnmerged
-  if (subsumed_entry->subsumed_by != kUnmerged) {
+  if (subsumed_entry->subsumed_by.load() != kUnmerged) {
     FML_LOG(WARNING) << "Thread merging failed: subsumed_entry was already "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed
                      << ", subsumed->subsumed_by="
-                     << subsumed_entry->subsumed_by;
+                     << subsumed_entry->subsumed_by.load();
     return false;
   }
   // All checking is OK, set merged state.
   owner_entry->owner_of.insert(subsumed);
-  subsumed_entry->subsumed_by = owner;
+  subsumed_entry->subsumed_by.store(owner);
 
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+  if (HasPendingTasksUnlocked(*owner_entry)) {
+    WakeUpUnlocked(*owner_entry, GetNextWakeTimeUnlocked(*owner_entry));
   }
 
   return true;
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& owner_entry = queue_entries_.at(owner);
+  std::shared_ptr<TaskQueueEntry> owner_entry = GetEntry(owner);
+  std::shared_ptr<TaskQueueEntry> subsumed_entry = GetEntry(subsumed);
+  std::scoped_lock guard(owner_entry->mutex, subsumed_entry->mutex);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry doesn't own anyone, owner="
         << owner << ", subsumed=" << subsumed;
     return false;
   }
-  if (owner_entry->subsumed_by != kUnmerged) {
+  if (owner_entry->subsumed_by.load() != kUnmerged) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry was subsumed by others, owner="
         << owner << ", subsumed=" << subsumed
-        << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by;
+        << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by.load();
     return false;
   }
-  if (queue_entries_.at(subsumed)->subsumed_by == kUnmerged) {
+  if (subsumed_entry->subsumed_by.load() == kUnmerged) {
     FML_LOG(WARNING) << "Thread unmerging failed: subsumed_entry wasn't "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed;
@@ -288,15 +330,15 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
     return false;
   }
 
-  queue_entries_.at(subsumed)->subsumed_by = kUnmerged;
+  subsumed_entry->subsumed_by.store(kUnmerged);
   owner_entry->owner_of.erase(subsumed);
 
-  if (HasPendingTasksUnlocked(owner)) {
-    WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
+  if (HasPendingTasksUnlocked(*owner_entry)) {
+    WakeUpUnlocked(*owner_entry, GetNextWakeTimeUnlocked(*owner_entry));
   }
 
-  if (HasPendingTasksUnlocked(subsumed)) {
-    WakeUpUnlocked(subsumed, GetNextWakeTimeUnlocked(subsumed));
+  if (HasPendingTasksUnlocked(*subsumed_entry)) {
+    WakeUpUnlocked(*subsumed_entry, GetNextWakeTimeUnlocked(*subsumed_entry));
   }
 
   return true;
@@ -304,67 +346,66 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
   if (owner == kUnmerged || subsumed == kUnmerged) {
     return false;
   }
-  auto& subsumed_set = queue_entries_.at(owner)->owner_of;
+  LockedEntry locked = LockEntry(owner);
+  auto& subsumed_set = locked.entry->owner_of;
   return subsumed_set.find(subsumed) != subsumed_set.end();
 }
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
-  return queue_entries_.at(owner)->owner_of;
+  LockedEntry locked = LockEntry(owner);
+  return locked.entry->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  LockedEntry locked = LockEntry(queue_id);
+  locked.entry->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->ResumeSecondary();
+  LockedEntry locked = LockEntry(queue_id);
+  const TaskQueueEntry& entry = *locked.entry;
+  entry.task_source->ResumeSecondary();
   // Schedule a wake as needed.
-  if (HasPendingTasksUnlocked(queue_id)) {
-    WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
+  if (HasPendingTasksUnlocked(entry)) {
+    WakeUpUnlocked(entry, GetNextWakeTimeUnlocked(entry));
   }
 }
 
 // Subsumed queues will never have pending tasks.
 // Owning queues will consider both their and their subsumed tasks.
 bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
-    TaskQueueId queue_id) const {
-  const auto& entry = queue_entries_.at(queue_id);
-  bool is_subsumed = entry->subsumed_by != kUnmerged;
+    const TaskQueueEntry& entry) const {
+  bool is_subsumed = entry.subsumed_by.load() != kUnmerged;
   if (is_subsumed) {
     return false;
   }
 
-  if (!entry->task_source->IsEmpty()) {
+  if (!entry.task_source->IsEmpty()) {
     return true;
   }
 
-  auto& subsumed_set = entry->owner_of;
+  auto& subsumed_set = entry.owner_of;
   return std::any_of(
       subsumed_set.begin(), subsumed_set.end(), [&](const auto& subsumed) {
-        return !queue_entries_.at(subsumed)->task_source->IsEmpty();
+        return !GetEntry(subsumed)->task_source->IsEmpty();
       });
 }
 
 fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
-    TaskQueueId queue_id) const {
-  return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
+    const TaskQueueEntry& entry) const {
+  return PeekNextTaskUnlocked(entry).task.GetTargetTime();
 }
 
 TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
+    const TaskQueueEntry& owner) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
-  const auto& entry = queue_entries_.at(owner);
-  if (entry->owner_of.empty()) {
-    FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+  if (owner.owner_of.empty()) {
+    FML_CHECK(!owner.task_source->IsEmpty());
+    return owner.task_source->Top();
   }
 
   // Use optional for the memory of TopTask object.
@@ -380,11 +421,11 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
         }
       };
 
-  TaskSource* owner_tasks = entry->task_source.get();
+  TaskSource* owner_tasks = owner.task_source.get();
   top_task_updater(owner_tasks);
 
-  for (TaskQueueId subsumed : entry->owner_of) {
-    TaskSource* subsumed_tasks = queue_entries_.at(subsumed)->task_source.get();
+  for (TaskQueueId subsumed : owner.owner_of) {
+    TaskSource* subsumed_tasks = GetEntry(subsumed)->task_source.get();
     top_task_updater(subsumed_tasks);
   }
   // At least one task at the top because PeekNextTaskUnlocked() is called after
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/closure.h"
@@ -28,6 +31,9 @@ static const TaskQueueId kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
 /// this isn't the case when TaskQueues are merged via
 /// \p fml::MessageLoopTaskQueues::Merge.
+///
+/// All fields are guarded by the \p mutex of the owner of the merge group the
+/// entry belongs to: its own if it is not subsumed, its owner's otherwise.
 class TaskQueueEntry {
  public:
   using TaskObservers = std::map<intptr_t, fml::closure>;
@@ -41,10 +47,16 @@ class TaskQueueEntry {
 
   /// Identifies the TaskQueue that subsumes this TaskQueue. If it is kUnmerged
   /// it indicates that this TaskQueue is not owned by any other TaskQueue.
-  TaskQueueId subsumed_by;
+  ///
+  /// Only written with the mutexes of both this entry and the owner held, so
+  /// it may be read without a lock to find the mutex to acquire.
+  std::atomic<TaskQueueId> subsumed_by;
 
   TaskQueueId created_for;
 
+  /// Guards this entry and the entries it owns while it is not subsumed.
+  std::mutex mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -60,6 +72,11 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// There is no lock shared by all task queues. Entries are looked up in one
+/// of |kShardCount| independently locked shards, and each group of merged
+/// task queues is guarded by the mutex of its owner. Posting to a task queue
+/// only contends with other threads using the same merge group.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -116,6 +133,10 @@ class MessageLoopTaskQueues {
   //     b. Be subsumed by a TaskQueue (an owner can never be subsumed).
   //     c. Be independent, i.e, neither owner nor be subsumed.
   //
+  //  4. Merging and unmerging lock both task queues, so that every task queue
+  //     is always guarded by exactly one mutex: the one of its merge group's
+  //     owner.
+  //
   //  Methods currently aware of the merged state of the queues:
   //  HasPendingTasks, GetNextTaskToRun, GetNumPendingTasks
   bool Merge(TaskQueueId owner, TaskQueueId subsumed);
@@ -139,22 +160,43 @@ class MessageLoopTaskQueues {
  private:
   class MergedQueuesRunner;
 
+  static constexpr size_t kShardCount = 16;
+
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<size_t, std::shared_ptr<TaskQueueEntry>> entries;
+  };
+
+  /// An entry together with the lock on the mutex that guards it.
+  struct LockedEntry {
+    std::shared_ptr<TaskQueueEntry> entry;
+    std::unique_lock<std::mutex> lock;
+  };
+
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
-  void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
+  std::shared_ptr<TaskQueueEntry> GetEntry(TaskQueueId queue_id) const;
+
+  /// Locks the mutex of the owner of the merge group |queue_id| belongs to.
+  LockedEntry LockEntry(TaskQueueId queue_id) const;
+
+  void EraseEntry(TaskQueueId queue_id);
+
+  // The methods below must be called with the mutex guarding |entry| held.
+
+  void WakeUpUnlocked(const TaskQueueEntry& entry, fml::TimePoint time) const;
 
-  bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
+  bool HasPendingTasksUnlocked(const TaskQueueEntry& entry) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  TaskSource::TopTask PeekNextTaskUnlocked(const TaskQueueEntry& owner) const;
 
-  fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
+  fml::TimePoint GetNextWakeTimeUnlocked(const TaskQueueEntry& entry) const;
 
-  mutable std::mutex queue_mutex_;
-  std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
+  std::array<Shard, kShardCount> shards_;
 
-  size_t task_queue_id_counter_ = 0;
+  std::atomic<size_t> task_queue_id_counter_ = 0;
 
   std::atomic_int order_;
 
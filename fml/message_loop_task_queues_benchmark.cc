@@ -66,5 +66,90 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Each of |state.range(0)| threads posts to a task queue of its own, as the
+// task runners of different engines in the same process do.
+static void BM_MultiProducerRegisterTasksToOwnQueues(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const size_t num_producers = state.range(0);
+  const size_t num_tasks_per_producer = 1000;
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  std::vector<TaskQueueId> queue_ids;
+  for (size_t i = 0; i < num_producers; i++) {
+    queue_ids.push_back(task_queues->CreateTaskQueue());
+  }
+
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_producers);
+    for (size_t i = 0; i < num_producers; i++) {
+      threads.emplace_back([&task_queues, queue_id = queue_ids[i], past]() {
+        for (size_t j = 0; j < num_tasks_per_producer; j++) {
+          task_queues->RegisterTask(queue_id, [] {}, past);
+        }
+        const auto now = fml::TimePoint::Now();
+        while (task_queues->GetNextTaskToRun(queue_id, now)) {
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (TaskQueueId queue_id : queue_ids) {
+    task_queues->Dispose(queue_id);
+  }
+  state.SetItemsProcessed(state.iterations() * num_producers *
+                          num_tasks_per_producer);
+}
+
+// |state.range(0)| threads post to a single task queue while it is drained
+// by one consumer thread.
+static void BM_MultiProducerRegisterTasksToOneQueue(
+    benchmark::State& state) {  // NOLINT
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const size_t num_producers = state.range(0);
+  const size_t num_tasks_per_producer = 1000;
+  const size_t num_tasks = num_producers * num_tasks_per_producer;
+  const fml::TimePoint past = fml::TimePoint::Now();
+
+  TaskQueueId queue_id = task_queues->CreateTaskQueue();
+
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_producers);
+    for (size_t i = 0; i < num_producers; i++) {
+      threads.emplace_back([&task_queues, queue_id, past]() {
+        for (size_t j = 0; j < num_tasks_per_producer; j++) {
+          task_queues->RegisterTask(queue_id, [] {}, past);
+        }
+      });
+    }
+    size_t num_invocations = 0;
+    while (num_invocations < num_tasks) {
+      if (task_queues->GetNextTaskToRun(queue_id, fml::TimePoint::Now())) {
+        num_invocations++;
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  task_queues->Dispose(queue_id);
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+}
+
+BENCHMARK(BM_MultiProducerRegisterTasksToOwnQueues)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK(BM_MultiProducerRegisterTasksToOneQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
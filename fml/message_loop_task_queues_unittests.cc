@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -440,5 +441,51 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, RegisterTasksWhileMergingAndUnmerging) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queues->CreateTaskQueue();
+  auto raster_queue = task_queues->CreateTaskQueue();
+
+  // kThreadCount threads post kThreadTaskCount tasks each to the raster queue
+  // while it is repeatedly merged into and unmerged from the platform queue.
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kThreadTaskCount = 500;
+
+  std::atomic_bool posting_done = false;
+  fml::CountDownLatch tasks_posted_latch(kThreadCount);
+
+  auto thread_main = [&]() {
+    for (size_t i = 0; i < kThreadTaskCount; i++) {
+      task_queues->RegisterTask(raster_queue, []() {},
+                                ChronoTicksSinceEpoch());
+    }
+    tasks_posted_latch.CountDown();
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back(std::thread{thread_main});
+  }
+  std::thread merger([&]() {
+    while (!posting_done) {
+      ASSERT_TRUE(task_queues->Merge(platform_queue, raster_queue));
+      task_queues->GetNumPendingTasks(platform_queue);
+      ASSERT_TRUE(task_queues->Unmerge(platform_queue, raster_queue));
+    }
+  });
+
+  tasks_posted_latch.Wait();
+  posting_done = true;
+  merger.join();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(task_queues->Owns(platform_queue, raster_queue));
+  ASSERT_EQ(task_queues->GetNumPendingTasks(platform_queue), 0u);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(raster_queue),
+            kThreadCount * kThreadTaskCount);
+}
+
 }  // namespace testing
 }  // namespace fml
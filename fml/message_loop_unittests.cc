@@ -6,8 +6,10 @@
 
 #include "flutter/fml/message_loop.h"
 
+#include <functional>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
@@ -212,3 +214,80 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedFromWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner();
+  const size_t kFanOut = 8;
+  const size_t kDepth = 3;
+  // Each task at depth d posts kFanOut tasks at depth d + 1.
+  size_t task_count = 0;
+  for (size_t d = 0, level = 1; d <= kDepth; ++d, level *= kFanOut) {
+    task_count += level;
+  }
+  fml::CountDownLatch latch(task_count);
+  std::function<void(size_t)> post = [&](size_t depth) {
+    task_runner->PostTask([&, depth]() {
+      ASSERT_TRUE(loop->RunsTasksOnCurrentThread());
+      if (depth < kDepth) {
+        for (size_t i = 0; i < kFanOut; ++i) {
+          post(depth + 1);
+        }
+      }
+      latch.CountDown();
+    });
+  };
+  post(0);
+  latch.Wait();
+  ASSERT_FALSE(loop->RunsTasksOnCurrentThread());
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsHighPriorityTasksFirst) {
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  fml::AutoResetWaitableEvent blocked;
+  fml::AutoResetWaitableEvent unblock;
+  task_runner->PostTask([&]() {
+    blocked.Signal();
+    unblock.Wait();
+  });
+  blocked.Wait();
+
+  using TaskPriority = fml::ConcurrentMessageLoop::TaskPriority;
+  std::mutex order_mutex;
+  std::vector<TaskPriority> order;
+  fml::CountDownLatch latch(3);
+  for (TaskPriority priority :
+       {TaskPriority::kLow, TaskPriority::kNormal, TaskPriority::kHigh}) {
+    task_runner->PostTaskWithPriority(
+        [&, priority]() {
+          {
+            std::scoped_lock lock(order_mutex);
+            order.push_back(priority);
+          }
+          latch.CountDown();
+        },
+        priority);
+  }
+  unblock.Signal();
+  latch.Wait();
+  ASSERT_EQ(order, (std::vector<TaskPriority>{TaskPriority::kHigh,
+                                              TaskPriority::kNormal,
+                                              TaskPriority::kLow}));
+}
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksForAllWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  fml::CountDownLatch latch(loop->GetWorkerCount());
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), loop->GetWorkerCount());
+}
@@ -0,0 +1,163 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_group.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace fml {
+
+namespace {
+
+/// The number of workers |TaskGroup::ParallelFor| asks for help. More are of
+/// no use, as the workers and the calling thread compete for the same cores.
+size_t GetParallelForHelperCount() {
+  static const size_t helper_count =
+      std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  return helper_count;
+}
+
+}  // namespace
+
+struct TaskGroup::State {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<fml::closure> pending_tasks;
+  size_t running_task_count = 0;
+  size_t waiter_count = 0;
+  std::atomic_bool canceled = false;
+
+  /// Runs the oldest task that has not started yet, if any.
+  bool RunNextTask() {
+    fml::closure task;
+    {
+      std::scoped_lock lock(mutex);
+      if (pending_tasks.empty()) {
+        return false;
+      }
+      task = std::move(pending_tasks.front());
+      pending_tasks.pop_front();
+      ++running_task_count;
+    }
+
+    task();
+
+    std::scoped_lock lock(mutex);
+    --running_task_count;
+    if (running_task_count == 0 && waiter_count > 0) {
+      condition.notify_all();
+    }
+    return true;
+  }
+};
+
+TaskGroup::TaskGroup(std::shared_ptr<ConcurrentTaskRunner> task_runner)
+    : task_runner_(std::move(task_runner)),
+      state_(std::make_shared<State>()) {}
+
+TaskGroup::~TaskGroup() {
+  Wait();
+}
+
+void TaskGroup::Run(const fml::closure& task) {
+  if (!task || IsCanceled()) {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(state_->mutex);
+    state_->pending_tasks.push_back(task);
+    // Waiters run the task themselves rather than wait for a worker.
+    if (state_->waiter_count > 0) {
+      state_->condition.notify_all();
+    }
+  }
+
+  // Each posted task runs whichever task of the group is next. It may find
+  // none left if the waiting thread got to them first.
+  if (task_runner_) {
+    task_runner_->PostTask([state = state_]() { state->RunNextTask(); });
+  }
+}
+
+void TaskGroup::ParallelFor(
+    size_t count,
+    size_t grain,
+    const std::function<void(size_t begin, size_t end)>& task) {
+  if (count == 0 || IsCanceled()) {
+    return;
+  }
+  grain = std::max<size_t>(grain, 1u);
+  const size_t chunk_count = (count + grain - 1) / grain;
+  if (chunk_count == 1 || !task_runner_) {
+    task(0, count);
+    return;
+  }
+
+  // Chunks are claimed by whichever thread gets to them first. The helpers
+  // refer to locals, which is fine as |Wait| returns after the last of them.
+  std::atomic_size_t next_chunk = 0;
+  auto run_chunks = [&]() {
+    for (size_t chunk = next_chunk++; chunk < chunk_count && !IsCanceled();
+         chunk = next_chunk++) {
+      size_t begin = chunk * grain;
+      task(begin, std::min(count, begin + grain));
+    }
+  };
+
+  const size_t helper_count =
+      std::min(chunk_count - 1, GetParallelForHelperCount());
+  for (size_t i = 0; i < helper_count; ++i) {
+    Run(run_chunks);
+  }
+  run_chunks();
+  Wait();
+}
+
+void TaskGroup::Wait() {
+  State& state = *state_;
+  while (true) {
+    if (state.RunNextTask()) {
+      continue;
+    }
+
+    std::unique_lock lock(state.mutex);
+    if (state.pending_tasks.empty() && state.running_task_count == 0) {
+      return;
+    }
+    ++state.waiter_count;
+    state.condition.wait(lock, [&state]() {
+      return !state.pending_tasks.empty() || state.running_task_count == 0;
+    });
+    --state.waiter_count;
+  }
+}
+
+void TaskGroup::Cancel() {
+  state_->canceled = true;
+  std::scoped_lock lock(state_->mutex);
+  state_->pending_tasks.clear();
+  if (state_->running_task_count == 0 && state_->waiter_count > 0) {
+    state_->condition.notify_all();
+  }
+}
+
+bool TaskGroup::IsCanceled() const {
+  return state_->canceled;
+}
+
+void ParallelFor(const std::shared_ptr<ConcurrentTaskRunner>& task_runner,
+                 size_t count,
+                 size_t grain,
+                 const std::function<void(size_t begin, size_t end)>& task) {
+  TaskGroup group(task_runner);
+  group.ParallelFor(count, grain, task);
+}
+
+}  // namespace fml
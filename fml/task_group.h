@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_GROUP_H_
+#define FLUTTER_FML_TASK_GROUP_H_
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A set of tasks that run on a concurrent task runner and can be
+///             waited on together.
+///
+///             The thread that waits on the group runs the tasks that no
+///             worker has started yet, instead of blocking on them. So a
+///             group never waits on a task that is stuck behind other work,
+///             and tasks may themselves create and wait on groups of their
+///             own, even when every worker is busy. Without a task runner,
+///             all tasks run on the waiting thread.
+///
+///             Canceling a group drops the tasks that have not started yet.
+///             Running tasks may check |IsCanceled| to stop early.
+///
+class TaskGroup {
+ public:
+  explicit TaskGroup(std::shared_ptr<ConcurrentTaskRunner> task_runner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Waits for the tasks of the group, as |Wait| does.
+  ///
+  ~TaskGroup();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a task to the group. Does nothing if the group has been
+  ///             canceled.
+  ///
+  void Run(const fml::closure& task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Splits `[0, count)` into chunks of `grain` items, and calls
+  ///             `task` with the bounds of each chunk in the group. The
+  ///             calling thread runs chunks too.
+  ///
+  ///             Returns once all the tasks of the group have finished, as
+  ///             |Wait| does. Chunks that have not started when the group is
+  ///             canceled are skipped.
+  ///
+  void ParallelFor(size_t count,
+                   size_t grain,
+                   const std::function<void(size_t begin, size_t end)>& task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs the tasks of the group that have not started yet on the
+  ///             calling thread, then waits for the others to finish. Must
+  ///             not be called from a task of the same group.
+  ///
+  void Wait();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the tasks of the group that have not started yet, and
+  ///             any that are added later.
+  ///
+  void Cancel();
+
+  bool IsCanceled() const;
+
+ private:
+  struct State;
+
+  std::shared_ptr<ConcurrentTaskRunner> task_runner_;
+  std::shared_ptr<State> state_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TaskGroup);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Calls `task` for the chunks of `grain` items of `[0, count)`
+///             in parallel on `task_runner` and the calling thread, and
+///             returns once every chunk has run. See |TaskGroup::ParallelFor|.
+///
+void ParallelFor(const std::shared_ptr<ConcurrentTaskRunner>& task_runner,
+                 size_t count,
+                 size_t grain,
+                 const std::function<void(size_t begin, size_t end)>& task);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_GROUP_H_
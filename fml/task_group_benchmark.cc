@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_group.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Premultiplies the rows of a 2048x2048 RGBA image, as image decoding does,
+// on |state.range(0)| workers and the calling thread. No workers means the
+// calling thread does all the work.
+static void BM_ParallelForPremultiplyRows(
+    benchmark::State& state) {  // NOLINT
+  constexpr size_t kWidth = 2048;
+  constexpr size_t kHeight = 2048;
+  constexpr size_t kRowsPerChunk = 32;
+
+  std::shared_ptr<ConcurrentMessageLoop> loop;
+  std::shared_ptr<ConcurrentTaskRunner> task_runner;
+  if (state.range(0) > 0) {
+    loop = ConcurrentMessageLoop::Create(state.range(0));
+    task_runner = loop->GetTaskRunner();
+  }
+
+  std::vector<uint32_t> src(kWidth * kHeight, 0x80ff8040);
+  std::vector<uint32_t> dst(kWidth * kHeight);
+  for (auto _ : state) {
+    ParallelFor(task_runner, kHeight, kRowsPerChunk,
+                [&](size_t begin, size_t end) {
+                  for (size_t i = begin * kWidth; i < end * kWidth; i++) {
+                    uint32_t pixel = src[i];
+                    uint32_t alpha = pixel >> 24;
+                    uint32_t result = pixel & 0xff000000;
+                    for (uint32_t shift = 0; shift < 24; shift += 8) {
+                      uint32_t channel = (pixel >> shift) & 0xff;
+                      result |= ((channel * alpha + 127) / 255) << shift;
+                    }
+                    dst[i] = result;
+                  }
+                });
+    benchmark::DoNotOptimize(dst.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * kWidth * kHeight * 4);
+}
+
+BENCHMARK(BM_ParallelForPremultiplyRows)
+    ->Arg(0)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_group.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+/// Occupies the only worker of a loop until |Unblock| is called.
+class BlockedWorker {
+ public:
+  explicit BlockedWorker(const std::shared_ptr<ConcurrentTaskRunner>& runner) {
+    runner->PostTask([this]() {
+      blocked_.Signal();
+      unblock_.Wait();
+    });
+    blocked_.Wait();
+  }
+
+  void Unblock() { unblock_.Signal(); }
+
+ private:
+  AutoResetWaitableEvent blocked_;
+  AutoResetWaitableEvent unblock_;
+};
+
+}  // namespace
+
+TEST(TaskGroupTest, RunsAllTasks) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  std::atomic_size_t count = 0;
+  {
+    TaskGroup group(loop->GetTaskRunner());
+    for (size_t i = 0; i < 100; ++i) {
+      group.Run([&count]() { ++count; });
+    }
+    group.Wait();
+    EXPECT_EQ(count, 100u);
+    group.Run([&count]() { ++count; });
+  }
+  EXPECT_EQ(count, 101u);
+}
+
+TEST(TaskGroupTest, RunsTasksOnWaitingThreadWithoutTaskRunner) {
+  TaskGroup group(nullptr);
+  std::thread::id thread_id;
+  group.Run([&thread_id]() { thread_id = std::this_thread::get_id(); });
+  group.Wait();
+  EXPECT_EQ(thread_id, std::this_thread::get_id());
+}
+
+TEST(TaskGroupTest, WaitingThreadRunsTasksWhileWorkersAreBusy) {
+  auto loop = ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  BlockedWorker worker(task_runner);
+
+  std::vector<std::thread::id> thread_ids(10);
+  TaskGroup group(task_runner);
+  for (auto& thread_id : thread_ids) {
+    group.Run([&thread_id]() { thread_id = std::this_thread::get_id(); });
+  }
+  group.Wait();
+  for (const auto& thread_id : thread_ids) {
+    EXPECT_EQ(thread_id, std::this_thread::get_id());
+  }
+  worker.Unblock();
+}
+
+TEST(TaskGroupTest, ParallelForCoversRangeOnce) {
+  auto loop = ConcurrentMessageLoop::Create(4);
+  std::vector<std::atomic_int> items(1003);
+  ParallelFor(loop->GetTaskRunner(), items.size(), 10,
+              [&items](size_t begin, size_t end) {
+                EXPECT_LE(end - begin, 10u);
+                for (size_t i = begin; i < end; ++i) {
+                  ++items[i];
+                }
+              });
+  for (const auto& item : items) {
+    ASSERT_EQ(item, 1);
+  }
+}
+
+TEST(TaskGroupTest, NestedParallelForDoesNotDeadlock) {
+  auto loop = ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  std::atomic_size_t count = 0;
+  ParallelFor(task_runner, 16, 1, [&](size_t, size_t) {
+    ParallelFor(task_runner, 64, 4, [&](size_t begin, size_t end) {
+      count += end - begin;
+    });
+  });
+  EXPECT_EQ(count, 16u * 64u);
+}
+
+TEST(TaskGroupTest, CancelDropsTasksThatHaveNotStarted) {
+  auto loop = ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  BlockedWorker worker(task_runner);
+
+  std::atomic_size_t count = 0;
+  TaskGroup group(task_runner);
+  for (size_t i = 0; i < 10; ++i) {
+    group.Run([&count]() { ++count; });
+  }
+  group.Cancel();
+  EXPECT_TRUE(group.IsCanceled());
+  group.Run([&count]() { ++count; });
+  worker.Unblock();
+  group.Wait();
+  EXPECT_EQ(count, 0u);
+}
+
+TEST(TaskGroupTest, CanceledParallelForSkipsRemainingChunks) {
+  auto loop = ConcurrentMessageLoop::Create(1);
+  auto task_runner = loop->GetTaskRunner();
+  BlockedWorker worker(task_runner);
+
+  size_t count = 0;
+  TaskGroup group(task_runner);
+  group.ParallelFor(100, 1, [&](size_t, size_t) {
+    ++count;
+    if (count == 10) {
+      group.Cancel();
+    }
+  });
+  EXPECT_EQ(count, 10u);
+  worker.Unblock();
+}
+
+}  // namespace testing
+}  // namespace fml
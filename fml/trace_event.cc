@@ -15,7 +15,7 @@
 namespace fml {
 namespace tracing {
 
-#if FLUTTER_TIMELINE_ENABLED
+#if FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
 
 namespace {
 
@@ -50,7 +50,9 @@ void TraceSetAllowlist(const std::vector<std::string>& allowlist) {
 }
 
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {
+#if FLUTTER_TIMELINE_ENABLED
   gTimelineEventHandler = handler;
+#endif  // FLUTTER_TIMELINE_ENABLED
 }
 
 bool TraceHasTimelineEventHandler() {
@@ -80,6 +82,10 @@ void TraceTimelineEvent(TraceArg category_group,
                         Dart_Timeline_Event_Type type,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {
+  if (!TraceHasTimelineEventHandler()) {
+    return;
+  }
+
   const auto argument_count = std::min(c_names.size(), values.size());
 
   std::vector<const char*> c_values;
@@ -126,6 +132,8 @@ void TraceEvent0(TraceArg category_group,
                  TraceArg name,
                  size_t flow_id_count,
                  const uint64_t* flow_ids) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kBegin, category_group, name, 0,
+                        flow_id_count, flow_ids);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -146,6 +154,8 @@ void TraceEvent1(TraceArg category_group,
                  TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
+  TraceRecorderAddEvent(TraceRecord::Phase::kBegin, category_group, name, 0,
+                        flow_id_count, flow_ids, arg1_name, arg1_val);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -168,6 +178,9 @@ void TraceEvent2(TraceArg category_group,
                  TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
+  TraceRecorderAddEvent(TraceRecord::Phase::kBegin, category_group, name, 0,
+                        flow_id_count, flow_ids, arg1_name, arg1_val, arg2_name,
+                        arg2_val);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -181,6 +194,7 @@ void TraceEvent2(TraceArg category_group,
 }
 
 void TraceEventEnd(TraceArg name) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kEnd, nullptr, name, 0, 0, nullptr);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,                        // timestamp1_or_async_id
@@ -198,6 +212,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
                            TraceIDArg id,
                            size_t flow_id_count,
                            const uint64_t* flow_ids) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kAsyncBegin, category_group, name,
+                        id, flow_id_count, flow_ids);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,             // timestamp1_or_async_id
@@ -213,6 +229,8 @@ void TraceEventAsyncBegin0(TraceArg category_group,
 void TraceEventAsyncEnd0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kAsyncEnd, category_group, name, id,
+                        0, nullptr);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
@@ -234,6 +252,8 @@ void TraceEventAsyncBegin1(TraceArg category_group,
                            TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
+  TraceRecorderAddEvent(TraceRecord::Phase::kAsyncBegin, category_group, name,
+                        id, flow_id_count, flow_ids, arg1_name, arg1_val);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,             // timestamp1_or_async_id
@@ -253,6 +273,8 @@ void TraceEventAsyncEnd1(TraceArg category_group,
                          TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
+  TraceRecorderAddEvent(TraceRecord::Phase::kAsyncEnd, category_group, name, id,
+                        0, nullptr, arg1_name, arg1_val);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
@@ -269,6 +291,8 @@ void TraceEventInstant0(TraceArg category_group,
                         TraceArg name,
                         size_t flow_id_count,
                         const uint64_t* flow_ids) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kInstant, category_group, name, 0,
+                        flow_id_count, flow_ids);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -289,6 +313,8 @@ void TraceEventInstant1(TraceArg category_group,
                         TraceArg arg1_val) {
   const char* arg_names[] = {arg1_name};
   const char* arg_values[] = {arg1_val};
+  TraceRecorderAddEvent(TraceRecord::Phase::kInstant, category_group, name, 0,
+                        flow_id_count, flow_ids, arg1_name, arg1_val);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -311,6 +337,9 @@ void TraceEventInstant2(TraceArg category_group,
                         TraceArg arg2_val) {
   const char* arg_names[] = {arg1_name, arg2_name};
   const char* arg_values[] = {arg1_val, arg2_val};
+  TraceRecorderAddEvent(TraceRecord::Phase::kInstant, category_group, name, 0,
+                        flow_id_count, flow_ids, arg1_name, arg1_val, arg2_name,
+                        arg2_val);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        0,              // timestamp1_or_async_id
@@ -326,6 +355,8 @@ void TraceEventInstant2(TraceArg category_group,
 void TraceEventFlowBegin0(TraceArg category_group,
                           TraceArg name,
                           TraceIDArg id) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kFlowBegin, category_group, name,
+                        id, 0, nullptr);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,       // timestamp1_or_async_id
@@ -341,6 +372,8 @@ void TraceEventFlowBegin0(TraceArg category_group,
 void TraceEventFlowStep0(TraceArg category_group,
                          TraceArg name,
                          TraceIDArg id) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kFlowStep, category_group, name, id,
+                        0, nullptr);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                             // timestamp1_or_async_id
@@ -354,6 +387,8 @@ void TraceEventFlowStep0(TraceArg category_group,
 }
 
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
+  TraceRecorderAddEvent(TraceRecord::Phase::kFlowEnd, category_group, name, id,
+                        0, nullptr);
   FlutterTimelineEvent(name,                            // label
                        gTimelineMicrosSource.load()(),  // timestamp0
                        id,                            // timestamp1_or_async_id
@@ -366,7 +401,7 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
   );
 }
 
-#else  // FLUTTER_TIMELINE_ENABLED
+#else  // FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
 
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
 
@@ -489,7 +524,7 @@ void TraceEventFlowStep0(TraceArg category_group,
 void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
 }
 
-#endif  // FLUTTER_TIMELINE_ENABLED
+#endif  // FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
 
 }  // namespace tracing
 }  // namespace fml
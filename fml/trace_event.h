@@ -61,6 +61,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_recorder.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 
 #if (FLUTTER_RELEASE && !defined(OS_FUCHSIA) && !defined(FML_OS_ANDROID))
@@ -69,6 +70,12 @@
 #define FLUTTER_TIMELINE_ENABLED 1
 #endif
 
+// The trace recorder, see trace_recorder.h, is available wherever the timeline
+// is. Release builds may opt in with `flutter_trace_recorder_in_release`.
+#ifndef FLUTTER_TRACE_RECORDER_ENABLED
+#define FLUTTER_TRACE_RECORDER_ENABLED FLUTTER_TIMELINE_ENABLED
+#endif
+
 #if !defined(OS_FUCHSIA)
 #ifndef TRACE_EVENT_HIDE_MACROS
 
@@ -305,12 +312,17 @@ void TraceCounter(TraceArg category,
                   TraceArg name,
                   TraceIDArg identifier,
                   Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
-  auto split = SplitArguments(args...);
-  TraceTimelineEvent(category, name, identifier, /*flow_id_count=*/0,
-                     /*flow_ids=*/nullptr, Dart_Timeline_Event_Counter,
-                     split.first, split.second);
-#endif  // FLUTTER_TIMELINE_ENABLED
+#if FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
+  TraceRecorderAddEvent(TraceRecord::Phase::kCounter, category, name,
+                        identifier, /*flow_id_count=*/0, /*flow_ids=*/nullptr,
+                        args...);
+  if (TraceHasTimelineEventHandler()) {
+    auto split = SplitArguments(args...);
+    TraceTimelineEvent(category, name, identifier, /*flow_id_count=*/0,
+                       /*flow_ids=*/nullptr, Dart_Timeline_Event_Counter,
+                       split.first, split.second);
+  }
+#endif  // FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
 }
 
 // HACK: Used to NOP FML_TRACE_COUNTER macro without triggering unused var
@@ -327,11 +339,15 @@ void TraceEvent(TraceArg category,
                 size_t flow_id_count,
                 const uint64_t* flow_ids,
                 Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
-  auto split = SplitArguments(args...);
-  TraceTimelineEvent(category, name, 0, flow_id_count, flow_ids,
-                     Dart_Timeline_Event_Begin, split.first, split.second);
-#endif  // FLUTTER_TIMELINE_ENABLED
+#if FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
+  TraceRecorderAddEvent(TraceRecord::Phase::kBegin, category, name, 0,
+                        flow_id_count, flow_ids, args...);
+  if (TraceHasTimelineEventHandler()) {
+    auto split = SplitArguments(args...);
+    TraceTimelineEvent(category, name, 0, flow_id_count, flow_ids,
+                       Dart_Timeline_Event_Begin, split.first, split.second);
+  }
+#endif  // FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
 }
 
 void TraceEvent0(TraceArg category_group,
@@ -363,14 +379,29 @@ void TraceEventAsyncComplete(TraceArg category_group,
                              TimePoint begin,
                              TimePoint end,
                              Args... args) {
-#if FLUTTER_TIMELINE_ENABLED
+#if FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
   auto identifier = TraceNonce();
-  const auto split = SplitArguments(args...);
 
   if (begin > end) {
     std::swap(begin, end);
   }
 
+  if (TraceRecorderIsRecording()) {
+    TraceRecord record(TraceRecord::Phase::kAsyncBegin, category_group, name,
+                       identifier, begin);
+    record.AddArguments(args...);
+    TraceRecorderAdd(record);
+    record.phase = TraceRecord::Phase::kAsyncEnd;
+    record.timestamp = end;
+    TraceRecorderAdd(record);
+  }
+
+  if (!TraceHasTimelineEventHandler()) {
+    return;
+  }
+
+  const auto split = SplitArguments(args...);
+
   const int64_t begin_micros = begin.ToEpochDelta().ToMicroseconds();
   const int64_t end_micros = end.ToEpochDelta().ToMicroseconds();
 
@@ -395,7 +426,7 @@ void TraceEventAsyncComplete(TraceArg category_group,
                      split.first,                    // names
                      split.second                    // values
   );
-#endif  // FLUTTER_TIMELINE_ENABLED
+#endif  // FLUTTER_TIMELINE_ENABLED || FLUTTER_TRACE_RECORDER_ENABLED
 }
 
 void TraceEventAsyncBegin0(TraceArg category_group,
@@ -0,0 +1,852 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/process.h"
+
+namespace fml {
+namespace tracing {
+
+namespace internal {
+std::atomic_bool gTraceRecorderEnabled = false;
+}  // namespace internal
+
+void TraceRecord::AddArgument(const char* key, const char* value) {
+  if (Argument* argument = NextArgument(key, Argument::Type::kString)) {
+    size_t length = value ? strnlen(value, kMaxStringLength) : 0u;
+    memcpy(argument->string_value, value, length);
+    argument->string_value[length] = '\0';
+  }
+}
+
+namespace {
+
+/// The number of records each thread buffers between flushes. About 600KB.
+constexpr size_t kRecordsPerThread = 4096u;
+
+//------------------------------------------------------------------------------
+/// A single-producer single-consumer ring of records. The owning thread adds
+/// records, and the flushing thread, holding |Recorder::writer_mutex|,
+/// drains them.
+///
+class ThreadBuffer {
+ public:
+  explicit ThreadBuffer(uint32_t index)
+      : index_(index),
+        records_(kRecordsPerThread,
+                 TraceRecord(TraceRecord::Phase::kInstant, nullptr, nullptr,
+                             0, TimePoint())) {}
+
+  uint32_t GetIndex() const { return index_; }
+
+  void Push(const TraceRecord& record) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == records_.size()) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    records_[head % records_.size()] = record;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  template <typename Consumer>
+  void Drain(const Consumer& consumer) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+      consumer(records_[tail % records_.size()]);
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  void Discard() {
+    tail_.store(head_.load(std::memory_order_acquire),
+                std::memory_order_release);
+    dropped_count_ = 0;
+  }
+
+  bool IsEmpty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetDroppedCount() const { return dropped_count_; }
+
+  // Guarded by |Recorder::registry_mutex|.
+  std::string name;
+  bool thread_exited = false;
+
+ private:
+  const uint32_t index_;
+  std::vector<TraceRecord> records_;
+  std::atomic_size_t head_ = 0;
+  std::atomic_size_t tail_ = 0;
+  std::atomic_size_t dropped_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+//------------------------------------------------------------------------------
+/// Converts records into a trace file format. Only used by the thread that
+/// holds |Recorder::writer_mutex|.
+///
+class TraceWriter {
+ public:
+  explicit TraceWriter(FILE* file) : file_(file) {}
+
+  virtual ~TraceWriter() { fclose(file_); }
+
+  virtual void WriteThread(uint32_t thread_index, const std::string& name) = 0;
+
+  virtual void WriteRecord(uint32_t thread_index,
+                           const TraceRecord& record) = 0;
+
+  virtual void Finish() {}
+
+  void Flush() {
+    if (!pending_.empty()) {
+      fwrite(pending_.data(), 1, pending_.size(), file_);
+      pending_.clear();
+    }
+    fflush(file_);
+  }
+
+ protected:
+  std::string pending_;
+
+ private:
+  FILE* file_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceWriter);
+};
+
+//------------------------------------------------------------------------------
+/// A protobuf message, encoded as it is built.
+///
+class ProtoMessage {
+ public:
+  void AddVarInt(uint32_t field, uint64_t value) {
+    AddTag(field, kVarIntWireType);
+    AddRawVarInt(value);
+  }
+
+  void AddFixed64(uint32_t field, uint64_t value) {
+    AddTag(field, kFixed64WireType);
+    for (size_t i = 0; i < 8; ++i) {
+      data_.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+  }
+
+  void AddDouble(uint32_t field, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    AddFixed64(field, bits);
+  }
+
+  void AddBytes(uint32_t field, std::string_view value) {
+    AddTag(field, kLengthDelimitedWireType);
+    AddRawVarInt(value.size());
+    data_.append(value);
+  }
+
+  void AddMessage(uint32_t field, const ProtoMessage& message) {
+    AddBytes(field, message.data_);
+  }
+
+  const std::string& GetData() const { return data_; }
+
+ private:
+  static constexpr uint32_t kVarIntWireType = 0;
+  static constexpr uint32_t kFixed64WireType = 1;
+  static constexpr uint32_t kLengthDelimitedWireType = 2;
+
+  std::string data_;
+
+  void AddTag(uint32_t field, uint32_t wire_type) {
+    AddRawVarInt((field << 3) | wire_type);
+  }
+
+  void AddRawVarInt(uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+};
+
+//------------------------------------------------------------------------------
+/// Writes a Perfetto `Trace` message, one `TracePacket` per record. Each
+/// thread is a packet sequence with its own interned strings. Flow records
+/// are dropped, as flows are already attached to the slices they connect.
+///
+/// Field numbers are those of perfetto/protos/perfetto/trace/.
+///
+class PerfettoTraceWriter final : public TraceWriter {
+ public:
+  explicit PerfettoTraceWriter(FILE* file)
+      : TraceWriter(file), pid_(GetCurrentProcId()) {}
+
+  // |TraceWriter|
+  void WriteThread(uint32_t thread_index, const std::string& name) override {
+    Sequence& sequence = sequences_[thread_index];
+
+    ProtoMessage thread;
+    thread.AddVarInt(kThreadDescriptorPid, pid_);
+    thread.AddVarInt(kThreadDescriptorTid, thread_index + 1);
+    if (!name.empty()) {
+      thread.AddBytes(kThreadDescriptorThreadName, name);
+    }
+    ProtoMessage track;
+    track.AddVarInt(kTrackDescriptorUuid, GetThreadTrackUuid(thread_index));
+    track.AddMessage(kTrackDescriptorThread, thread);
+
+    ProtoMessage packet;
+    packet.AddVarInt(kTracePacketSequenceId, thread_index + 1);
+    if (!sequence.started) {
+      // Events on this sequence default to the thread track and the
+      // monotonic clock of |TimePoint|.
+      ProtoMessage track_event_defaults;
+      track_event_defaults.AddVarInt(kTrackEventDefaultsTrackUuid,
+                                     GetThreadTrackUuid(thread_index));
+      ProtoMessage defaults;
+      defaults.AddVarInt(kTracePacketDefaultsTimestampClockId,
+                         kBuiltinClockMonotonic);
+      defaults.AddMessage(kTracePacketDefaultsTrackEventDefaults,
+                          track_event_defaults);
+      packet.AddVarInt(kTracePacketSequenceFlags, kSequenceStateCleared);
+      packet.AddMessage(kTracePacketDefaults, defaults);
+      sequence.started = true;
+    }
+    packet.AddMessage(kTracePacketTrackDescriptor, track);
+    AddPacket(packet);
+  }
+
+  // |TraceWriter|
+  void WriteRecord(uint32_t thread_index, const TraceRecord& record) override {
+    Sequence& sequence = sequences_[thread_index];
+    ProtoMessage event;
+
+    switch (record.phase) {
+      case TraceRecord::Phase::kBegin:
+        event.AddVarInt(kTrackEventType, kTrackEventTypeSliceBegin);
+        break;
+      case TraceRecord::Phase::kEnd:
+        event.AddVarInt(kTrackEventType, kTrackEventTypeSliceEnd);
+        break;
+      case TraceRecord::Phase::kInstant:
+        event.AddVarInt(kTrackEventType, kTrackEventTypeInstant);
+        break;
+      case TraceRecord::Phase::kAsyncBegin:
+      case TraceRecord::Phase::kAsyncEnd: {
+        ProtoMessage legacy_event;
+        legacy_event.AddVarInt(
+            kLegacyEventPhase,
+            record.phase == TraceRecord::Phase::kAsyncBegin ? 'b' : 'e');
+        legacy_event.AddVarInt(kLegacyEventUnscopedId, record.id);
+        event.AddMessage(kTrackEventLegacyEvent, legacy_event);
+        break;
+      }
+      case TraceRecord::Phase::kCounter:
+        WriteCounters(thread_index, record);
+        return;
+      case TraceRecord::Phase::kFlowBegin:
+      case TraceRecord::Phase::kFlowStep:
+      case TraceRecord::Phase::kFlowEnd:
+        return;
+    }
+
+    // Strings seen for the first time on this sequence are interned by the
+    // packet that first uses them.
+    ProtoMessage interned_data;
+    if (record.category) {
+      event.AddVarInt(kTrackEventCategoryIids,
+                      Intern(sequence.categories, record.category,
+                             kInternedDataEventCategories, interned_data));
+    }
+    if (record.name) {
+      event.AddVarInt(kTrackEventNameIid,
+                      Intern(sequence.names, record.name,
+                             kInternedDataEventNames, interned_data));
+    }
+    if (record.flow_id != 0) {
+      event.AddFixed64(kTrackEventFlowIds, record.flow_id);
+    }
+
+    for (size_t i = 0; i < record.argument_count; ++i) {
+      const TraceRecord::Argument& argument = record.arguments[i];
+      ProtoMessage annotation;
+      annotation.AddVarInt(
+          kDebugAnnotationNameIid,
+          Intern(sequence.annotation_names, argument.name,
+                 kInternedDataDebugAnnotationNames, interned_data));
+      switch (argument.type) {
+        case TraceRecord::Argument::Type::kInt:
+          annotation.AddVarInt(kDebugAnnotationIntValue, argument.int_value);
+          break;
+        case TraceRecord::Argument::Type::kDouble:
+          annotation.AddDouble(kDebugAnnotationDoubleValue,
+                               argument.double_value);
+          break;
+        case TraceRecord::Argument::Type::kString:
+          annotation.AddBytes(kDebugAnnotationStringValue,
+                              argument.string_value);
+          break;
+      }
+      event.AddMessage(kTrackEventDebugAnnotations, annotation);
+    }
+
+    ProtoMessage packet;
+    AddEventPacketHeader(packet, thread_index, record);
+    if (!interned_data.GetData().empty()) {
+      packet.AddMessage(kTracePacketInternedData, interned_data);
+    }
+    packet.AddMessage(kTracePacketTrackEvent, event);
+    AddPacket(packet);
+  }
+
+ private:
+  // Trace.
+  static constexpr uint32_t kTracePacket = 1;
+  // TracePacket.
+  static constexpr uint32_t kTracePacketTimestamp = 8;
+  static constexpr uint32_t kTracePacketSequenceId = 10;
+  static constexpr uint32_t kTracePacketTrackEvent = 11;
+  static constexpr uint32_t kTracePacketInternedData = 12;
+  static constexpr uint32_t kTracePacketSequenceFlags = 13;
+  static constexpr uint32_t kTracePacketDefaults = 59;
+  static constexpr uint32_t kTracePacketTrackDescriptor = 60;
+  static constexpr uint64_t kSequenceStateCleared = 1;
+  static constexpr uint64_t kSequenceNeedsState = 2;
+  static constexpr uint64_t kBuiltinClockMonotonic = 3;
+  // TracePacketDefaults and TrackEventDefaults.
+  static constexpr uint32_t kTracePacketDefaultsTimestampClockId = 58;
+  static constexpr uint32_t kTracePacketDefaultsTrackEventDefaults = 11;
+  static constexpr uint32_t kTrackEventDefaultsTrackUuid = 11;
+  // TrackEvent.
+  static constexpr uint32_t kTrackEventCategoryIids = 3;
+  static constexpr uint32_t kTrackEventDebugAnnotations = 4;
+  static constexpr uint32_t kTrackEventLegacyEvent = 6;
+  static constexpr uint32_t kTrackEventType = 9;
+  static constexpr uint32_t kTrackEventNameIid = 10;
+  static constexpr uint32_t kTrackEventTrackUuid = 11;
+  static constexpr uint32_t kTrackEventCounterValue = 30;
+  static constexpr uint32_t kTrackEventDoubleCounterValue = 44;
+  static constexpr uint32_t kTrackEventFlowIds = 47;
+  static constexpr uint64_t kTrackEventTypeSliceBegin = 1;
+  static constexpr uint64_t kTrackEventTypeSliceEnd = 2;
+  static constexpr uint64_t kTrackEventTypeInstant = 3;
+  static constexpr uint64_t kTrackEventTypeCounter = 4;
+  // TrackEvent.LegacyEvent.
+  static constexpr uint32_t kLegacyEventPhase = 2;
+  static constexpr uint32_t kLegacyEventUnscopedId = 6;
+  // DebugAnnotation.
+  static constexpr uint32_t kDebugAnnotationNameIid = 1;
+  static constexpr uint32_t kDebugAnnotationIntValue = 4;
+  static constexpr uint32_t kDebugAnnotationDoubleValue = 5;
+  static constexpr uint32_t kDebugAnnotationStringValue = 6;
+  // InternedData, and the iid and name fields of the interned messages.
+  static constexpr uint32_t kInternedDataEventCategories = 1;
+  static constexpr uint32_t kInternedDataEventNames = 2;
+  static constexpr uint32_t kInternedDataDebugAnnotationNames = 3;
+  static constexpr uint32_t kInternedStringIid = 1;
+  static constexpr uint32_t kInternedStringName = 2;
+  // TrackDescriptor.
+  static constexpr uint32_t kTrackDescriptorUuid = 1;
+  static constexpr uint32_t kTrackDescriptorName = 2;
+  static constexpr uint32_t kTrackDescriptorThread = 4;
+  static constexpr uint32_t kTrackDescriptorCounter = 8;
+  // ThreadDescriptor.
+  static constexpr uint32_t kThreadDescriptorPid = 1;
+  static constexpr uint32_t kThreadDescriptorTid = 2;
+  static constexpr uint32_t kThreadDescriptorThreadName = 5;
+
+  static constexpr uint64_t kThreadTrackUuidBase = 0x464c540000000000;
+  static constexpr uint64_t kCounterTrackUuidBase = 0x464c550000000000;
+
+  using InternedStrings = std::unordered_map<const char*, uint64_t>;
+
+  struct Sequence {
+    bool started = false;
+    InternedStrings categories;
+    InternedStrings names;
+    InternedStrings annotation_names;
+  };
+
+  const int pid_;
+  std::unordered_map<uint32_t, Sequence> sequences_;
+  // Keyed by the event name, then the argument name.
+  std::unordered_map<const char*, std::unordered_map<const char*, uint64_t>>
+      counter_tracks_;
+  size_t counter_track_count_ = 0;
+
+  static uint64_t GetThreadTrackUuid(uint32_t thread_index) {
+    return kThreadTrackUuidBase + thread_index;
+  }
+
+  static uint64_t Intern(InternedStrings& strings,
+                         const char* string,
+                         uint32_t interned_data_field,
+                         ProtoMessage& interned_data) {
+    auto found = strings.find(string);
+    if (found != strings.end()) {
+      return found->second;
+    }
+    uint64_t iid = strings.size() + 1;
+    strings[string] = iid;
+    ProtoMessage interned_string;
+    interned_string.AddVarInt(kInternedStringIid, iid);
+    interned_string.AddBytes(kInternedStringName, string);
+    interned_data.AddMessage(interned_data_field, interned_string);
+    return iid;
+  }
+
+  void AddEventPacketHeader(ProtoMessage& packet,
+                            uint32_t thread_index,
+                            const TraceRecord& record) {
+    packet.AddVarInt(kTracePacketTimestamp,
+                     record.timestamp.ToEpochDelta().ToNanoseconds());
+    packet.AddVarInt(kTracePacketSequenceId, thread_index + 1);
+    packet.AddVarInt(kTracePacketSequenceFlags, kSequenceNeedsState);
+  }
+
+  // Each argument of a counter event is a counter track of its own.
+  void WriteCounters(uint32_t thread_index, const TraceRecord& record) {
+    for (size_t i = 0; i < record.argument_count; ++i) {
+      const TraceRecord::Argument& argument = record.arguments[i];
+      auto& tracks = counter_tracks_[record.name];
+      auto found = tracks.find(argument.name);
+      uint64_t track_uuid;
+      if (found == tracks.end()) {
+        track_uuid = kCounterTrackUuidBase + counter_track_count_++;
+        tracks[argument.name] = track_uuid;
+
+        ProtoMessage track;
+        track.AddVarInt(kTrackDescriptorUuid, track_uuid);
+        std::string track_name = record.name ? record.name : "";
+        track_name.append(" ").append(argument.name);
+        track.AddBytes(kTrackDescriptorName, track_name);
+        track.AddMessage(kTrackDescriptorCounter, ProtoMessage());
+        ProtoMessage packet;
+        packet.AddVarInt(kTracePacketSequenceId, thread_index + 1);
+        packet.AddMessage(kTracePacketTrackDescriptor, track);
+        AddPacket(packet);
+      } else {
+        track_uuid = found->second;
+      }
+
+      ProtoMessage event;
+      event.AddVarInt(kTrackEventType, kTrackEventTypeCounter);
+      event.AddVarInt(kTrackEventTrackUuid, track_uuid);
+      switch (argument.type) {
+        case TraceRecord::Argument::Type::kInt:
+          event.AddVarInt(kTrackEventCounterValue, argument.int_value);
+          break;
+        case TraceRecord::Argument::Type::kDouble:
+          event.AddDouble(kTrackEventDoubleCounterValue, argument.double_value);
+          break;
+        case TraceRecord::Argument::Type::kString:
+          event.AddDouble(kTrackEventDoubleCounterValue,
+                          strtod(argument.string_value, nullptr));
+          break;
+      }
+
+      ProtoMessage packet;
+      AddEventPacketHeader(packet, thread_index, record);
+      packet.AddMessage(kTracePacketTrackEvent, event);
+      AddPacket(packet);
+    }
+  }
+
+  void AddPacket(const ProtoMessage& packet) {
+    ProtoMessage trace;
+    trace.AddMessage(kTracePacket, packet);
+    pending_.append(trace.GetData());
+  }
+};
+
+//------------------------------------------------------------------------------
+/// Writes the JSON array format of chrome://tracing. The closing bracket is
+/// written when recording stops, but is optional for trace viewers.
+///
+class ChromeJsonTraceWriter final : public TraceWriter {
+ public:
+  explicit ChromeJsonTraceWriter(FILE* file)
+      : TraceWriter(file), pid_(GetCurrentProcId()) {
+    pending_.append("[");
+  }
+
+  // |TraceWriter|
+  void WriteThread(uint32_t thread_index, const std::string& name) override {
+    if (name.empty()) {
+      return;
+    }
+    BeginEvent("thread_name", nullptr, 'M', thread_index);
+    pending_.append(",\"args\":{\"name\":");
+    AppendString(name.c_str());
+    pending_.append("}}");
+  }
+
+  // |TraceWriter|
+  void WriteRecord(uint32_t thread_index, const TraceRecord& record) override {
+    BeginEvent(record.name, record.category, GetPhase(record.phase),
+               thread_index);
+    AppendFormat(",\"ts\":%.3f",
+                 record.timestamp.ToEpochDelta().ToNanoseconds() / 1000.0);
+    if (record.phase != TraceRecord::Phase::kBegin &&
+        record.phase != TraceRecord::Phase::kEnd &&
+        record.phase != TraceRecord::Phase::kInstant) {
+      AppendFormat(",\"id\":\"0x%llx\"",
+                   static_cast<unsigned long long>(record.id));
+    }
+    if (record.phase == TraceRecord::Phase::kFlowEnd) {
+      pending_.append(",\"bp\":\"e\"");
+    }
+    if (record.flow_id != 0) {
+      AppendFormat(",\"bind_id\":\"0x%llx\"",
+                   static_cast<unsigned long long>(record.flow_id));
+    }
+    pending_.append(",\"args\":{");
+    for (size_t i = 0; i < record.argument_count; ++i) {
+      const TraceRecord::Argument& argument = record.arguments[i];
+      if (i > 0) {
+        pending_.append(",");
+      }
+      AppendString(argument.name);
+      pending_.append(":");
+      switch (argument.type) {
+        case TraceRecord::Argument::Type::kInt:
+          AppendFormat("%lld", static_cast<long long>(argument.int_value));
+          break;
+        case TraceRecord::Argument::Type::kDouble:
+          AppendFormat("%.17g", argument.double_value);
+          break;
+        case TraceRecord::Argument::Type::kString:
+          AppendString(argument.string_value);
+          break;
+      }
+    }
+    pending_.append("}}");
+  }
+
+  // |TraceWriter|
+  void Finish() override { pending_.append("\n]\n"); }
+
+ private:
+  const int pid_;
+  bool has_events_ = false;
+
+  static char GetPhase(TraceRecord::Phase phase) {
+    switch (phase) {
+      case TraceRecord::Phase::kBegin:
+        return 'B';
+      case TraceRecord::Phase::kEnd:
+        return 'E';
+      case TraceRecord::Phase::kInstant:
+        return 'i';
+      case TraceRecord::Phase::kAsyncBegin:
+        return 'b';
+      case TraceRecord::Phase::kAsyncEnd:
+        return 'e';
+      case TraceRecord::Phase::kFlowBegin:
+        return 's';
+      case TraceRecord::Phase::kFlowStep:
+        return 't';
+      case TraceRecord::Phase::kFlowEnd:
+        return 'f';
+      case TraceRecord::Phase::kCounter:
+        return 'C';
+    }
+    FML_UNREACHABLE();
+  }
+
+  void BeginEvent(const char* name,
+                  const char* category,
+                  char phase,
+                  uint32_t thread_index) {
+    pending_.append(has_events_ ? ",\n{" : "\n{");
+    has_events_ = true;
+    pending_.append("\"name\":");
+    AppendString(name);
+    if (category) {
+      pending_.append(",\"cat\":");
+      AppendString(category);
+    }
+    AppendFormat(",\"ph\":\"%c\",\"pid\":%d,\"tid\":%u", phase, pid_,
+                 thread_index + 1);
+  }
+
+  template <typename... Args>
+  void AppendFormat(const char* format, Args... args) {
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), format, args...);
+    if (length > 0) {
+      pending_.append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+    }
+  }
+
+  void AppendString(const char* string) {
+    pending_.push_back('"');
+    for (const char* c = string ? string : ""; *c; ++c) {
+      switch (*c) {
+        case '"':
+          pending_.append("\\\"");
+          break;
+        case '\\':
+          pending_.append("\\\\");
+          break;
+        default:
+          if (static_cast<unsigned char>(*c) < 0x20) {
+            AppendFormat("\\u%04x", *c);
+          } else {
+            pending_.push_back(*c);
+          }
+      }
+    }
+    pending_.push_back('"');
+  }
+};
+
+//------------------------------------------------------------------------------
+/// The state of the recorder. Lives for the rest of the process, as threads
+/// may add events up to their very end.
+///
+struct Recorder {
+  /// Guards the list of buffers, and their names.
+  std::mutex registry_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  uint32_t next_thread_index = 0;
+  /// The events dropped by the threads whose buffers were removed.
+  size_t removed_dropped_count = 0;
+
+  /// Guards the writer, and draining the buffers.
+  std::mutex writer_mutex;
+  std::unique_ptr<TraceWriter> writer;
+  std::unordered_map<uint32_t, std::string> written_thread_names;
+
+  /// Guards starting and stopping the flushing thread.
+  std::mutex flusher_mutex;
+  std::condition_variable flusher_condition;
+  bool flusher_stopped = false;
+  std::thread flusher;
+
+  static Recorder& Get() {
+    static Recorder* recorder = new Recorder();
+    return *recorder;
+  }
+
+  /// Must be called with |writer_mutex| held.
+  void DrainLocked() {
+    std::vector<std::shared_ptr<ThreadBuffer>> drained_buffers;
+    std::vector<std::string> names;
+    {
+      std::scoped_lock lock(registry_mutex);
+      drained_buffers = buffers;
+      for (const auto& buffer : drained_buffers) {
+        names.push_back(buffer->name);
+      }
+    }
+
+    for (size_t i = 0; i < drained_buffers.size(); ++i) {
+      ThreadBuffer& buffer = *drained_buffers[i];
+      if (buffer.IsEmpty()) {
+        continue;
+      }
+      if (writer) {
+        auto written_name = written_thread_names.find(buffer.GetIndex());
+        if (written_name == written_thread_names.end() ||
+            written_name->second != names[i]) {
+          writer->WriteThread(buffer.GetIndex(), names[i]);
+          written_thread_names[buffer.GetIndex()] = names[i];
+        }
+        buffer.Drain([this, &buffer](const TraceRecord& record) {
+          writer->WriteRecord(buffer.GetIndex(), record);
+        });
+      } else {
+        buffer.Discard();
+      }
+    }
+    if (writer) {
+      writer->Flush();
+    }
+
+    // Forget the buffers of threads that are gone, once they are empty.
+    std::scoped_lock lock(registry_mutex);
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [this](const auto& buffer) {
+                                   if (!buffer->thread_exited ||
+                                       !buffer->IsEmpty()) {
+                                     return false;
+                                   }
+                                   removed_dropped_count +=
+                                       buffer->GetDroppedCount();
+                                   return true;
+                                 }),
+                  buffers.end());
+  }
+};
+
+/// The buffer of the current thread, created the first time the thread adds
+/// an event while recording.
+struct ThreadBufferHandle {
+  std::shared_ptr<ThreadBuffer> buffer;
+  std::string name;
+
+  ~ThreadBufferHandle() {
+    if (buffer) {
+      std::scoped_lock lock(Recorder::Get().registry_mutex);
+      buffer->thread_exited = true;
+    }
+  }
+};
+
+thread_local ThreadBufferHandle tls_thread_buffer;
+
+ThreadBuffer& GetThreadBuffer() {
+  if (!tls_thread_buffer.buffer) {
+    Recorder& recorder = Recorder::Get();
+    std::scoped_lock lock(recorder.registry_mutex);
+    auto buffer =
+        std::make_shared<ThreadBuffer>(recorder.next_thread_index++);
+    buffer->name = tls_thread_buffer.name;
+    recorder.buffers.push_back(buffer);
+    tls_thread_buffer.buffer = std::move(buffer);
+  }
+  return *tls_thread_buffer.buffer;
+}
+
+}  // namespace
+
+bool TraceRecorderStart(const std::string& path,
+                        TraceRecorderFormat format,
+                        TimeDelta flush_interval) {
+  Recorder& recorder = Recorder::Get();
+  std::scoped_lock flusher_lock(recorder.flusher_mutex);
+  {
+    std::scoped_lock writer_lock(recorder.writer_mutex);
+    if (recorder.writer) {
+      FML_LOG(ERROR) << "The trace recorder is already recording.";
+      return false;
+    }
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+      FML_LOG(ERROR) << "Could not open " << path << " to record a trace.";
+      return false;
+    }
+
+    // Events left over from an earlier recording are not part of this one.
+    recorder.DrainLocked();
+    {
+      std::scoped_lock registry_lock(recorder.registry_mutex);
+      for (const auto& buffer : recorder.buffers) {
+        buffer->Discard();
+      }
+      recorder.removed_dropped_count = 0;
+    }
+    recorder.written_thread_names.clear();
+    switch (format) {
+      case TraceRecorderFormat::kPerfetto:
+        recorder.writer = std::make_unique<PerfettoTraceWriter>(file);
+        break;
+      case TraceRecorderFormat::kChromeJson:
+        recorder.writer = std::make_unique<ChromeJsonTraceWriter>(file);
+        break;
+    }
+  }
+
+  recorder.flusher_stopped = false;
+  recorder.flusher = std::thread([&recorder, flush_interval]() {
+    std::unique_lock lock(recorder.flusher_mutex);
+    while (!recorder.flusher_stopped) {
+      recorder.flusher_condition.wait_for(
+          lock, std::chrono::nanoseconds(flush_interval.ToNanoseconds()));
+      lock.unlock();
+      {
+        std::scoped_lock writer_lock(recorder.writer_mutex);
+        recorder.DrainLocked();
+      }
+      lock.lock();
+    }
+  });
+
+  internal::gTraceRecorderEnabled = true;
+  return true;
+}
+
+void TraceRecorderStop() {
+  Recorder& recorder = Recorder::Get();
+  internal::gTraceRecorderEnabled = false;
+
+  std::thread flusher;
+  {
+    std::scoped_lock lock(recorder.flusher_mutex);
+    recorder.flusher_stopped = true;
+    flusher = std::move(recorder.flusher);
+  }
+  recorder.flusher_condition.notify_all();
+  if (flusher.joinable()) {
+    flusher.join();
+  }
+
+  std::scoped_lock writer_lock(recorder.writer_mutex);
+  if (recorder.writer) {
+    recorder.DrainLocked();
+    recorder.writer->Finish();
+    recorder.writer->Flush();
+    recorder.writer.reset();
+  }
+}
+
+void TraceRecorderFlush() {
+  Recorder& recorder = Recorder::Get();
+  std::scoped_lock writer_lock(recorder.writer_mutex);
+  if (recorder.writer) {
+    recorder.DrainLocked();
+  }
+}
+
+size_t TraceRecorderGetDroppedEventCount() {
+  Recorder& recorder = Recorder::Get();
+  std::scoped_lock lock(recorder.registry_mutex);
+  size_t dropped_count = recorder.removed_dropped_count;
+  for (const auto& buffer : recorder.buffers) {
+    dropped_count += buffer->GetDroppedCount();
+  }
+  return dropped_count;
+}
+
+void TraceRecorderSetThreadName(const std::string& name) {
+  tls_thread_buffer.name = name;
+  if (tls_thread_buffer.buffer) {
+    std::scoped_lock lock(Recorder::Get().registry_mutex);
+    tls_thread_buffer.buffer->name = name;
+  }
+}
+
+void TraceRecorderAdd(const TraceRecord& record) {
+  if (!TraceRecorderIsRecording()) {
+    return;
+  }
+  GetThreadBuffer().Push(record);
+}
+
+}  // namespace tracing
+}  // namespace fml
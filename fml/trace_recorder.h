@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RECORDER_H_
+#define FLUTTER_FML_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// @brief      A fixed-size binary trace event, as buffered by the trace
+///             recorder.
+///
+///             The category, name and argument names are stored as pointers
+///             and must outlive the recording, which string literals do.
+///             String argument values are copied, and truncated to
+///             |kMaxStringLength| bytes.
+///
+struct TraceRecord {
+  enum class Phase : uint8_t {
+    kBegin,
+    kEnd,
+    kInstant,
+    kAsyncBegin,
+    kAsyncEnd,
+    kFlowBegin,
+    kFlowStep,
+    kFlowEnd,
+    kCounter,
+  };
+
+  struct Argument {
+    enum class Type : uint8_t {
+      kInt,
+      kDouble,
+      kString,
+    };
+
+    const char* name;
+    Type type;
+    union {
+      int64_t int_value;
+      double double_value;
+      char string_value[32];
+    };
+  };
+
+  static constexpr size_t kMaxArguments = 2u;
+  static constexpr size_t kMaxStringLength =
+      sizeof(Argument::string_value) - 1;
+
+  TraceRecord(Phase event_phase,
+              const char* event_category,
+              const char* event_name,
+              int64_t event_id = 0,
+              TimePoint event_timestamp = TimePoint::Now())
+      : timestamp(event_timestamp),
+        id(event_id),
+        category(event_category),
+        name(event_name),
+        phase(event_phase) {}
+
+  void AddArgument(const char* key, const char* value);
+
+  void AddArgument(const char* key, const std::string& value) {
+    AddArgument(key, value.c_str());
+  }
+
+  void AddArgument(const char* key, TimePoint value) {
+    if (Argument* argument = NextArgument(key, Argument::Type::kInt)) {
+      argument->int_value = value.ToEpochDelta().ToNanoseconds();
+    }
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+  void AddArgument(const char* key, T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (Argument* argument = NextArgument(key, Argument::Type::kDouble)) {
+        argument->double_value = static_cast<double>(value);
+      }
+    } else {
+      if (Argument* argument = NextArgument(key, Argument::Type::kInt)) {
+        argument->int_value = static_cast<int64_t>(value);
+      }
+    }
+  }
+
+  void AddArguments() {}
+
+  template <typename Key, typename Value, typename... Args>
+  void AddArguments(Key key, Value value, Args... args) {
+    AddArgument(key, value);
+    AddArguments(args...);
+  }
+
+  TimePoint timestamp;
+  /// The async, flow or counter ID of the event.
+  int64_t id = 0;
+  /// The first of the flows that a begin event takes part in, or zero.
+  uint64_t flow_id = 0;
+  const char* category = nullptr;
+  const char* name = nullptr;
+  Phase phase;
+  uint8_t argument_count = 0;
+  Argument arguments[kMaxArguments];
+
+ private:
+  Argument* NextArgument(const char* key, Argument::Type type) {
+    if (argument_count == kMaxArguments) {
+      return nullptr;
+    }
+    Argument* argument = &arguments[argument_count++];
+    argument->name = key;
+    argument->type = type;
+    return argument;
+  }
+};
+
+enum class TraceRecorderFormat {
+  /// A Perfetto `Trace` protobuf, as read by ui.perfetto.dev.
+  kPerfetto,
+  /// The JSON array format of chrome://tracing.
+  kChromeJson,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Starts recording trace events into per-thread lock-free ring
+///             buffers, which a background thread drains into the file at
+///             `path` every `flush_interval`.
+///
+///             Recording a trace event copies a |TraceRecord| into the ring
+///             buffer of the calling thread, and does not lock, allocate or
+///             format strings. Events are dropped when a buffer is full.
+///
+/// @return     Whether the file could be opened. Fails if already recording.
+///
+bool TraceRecorderStart(const std::string& path,
+                        TraceRecorderFormat format,
+                        TimeDelta flush_interval = TimeDelta::FromMilliseconds(
+                            100));
+
+//------------------------------------------------------------------------------
+/// @brief      Stops recording, writes the events still buffered and closes
+///             the file.
+///
+void TraceRecorderStop();
+
+//------------------------------------------------------------------------------
+/// @brief      Writes the buffered events to the file right away.
+///
+void TraceRecorderFlush();
+
+//------------------------------------------------------------------------------
+/// @brief      The number of events dropped because a ring buffer was full,
+///             since recording started.
+///
+size_t TraceRecorderGetDroppedEventCount();
+
+//------------------------------------------------------------------------------
+/// @brief      Names the calling thread in recorded traces.
+///
+void TraceRecorderSetThreadName(const std::string& name);
+
+namespace internal {
+extern std::atomic_bool gTraceRecorderEnabled;
+}  // namespace internal
+
+inline bool TraceRecorderIsRecording() {
+  return internal::gTraceRecorderEnabled.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Adds an event to the ring buffer of the calling thread. Does
+///             nothing unless recording.
+///
+void TraceRecorderAdd(const TraceRecord& record);
+
+//------------------------------------------------------------------------------
+/// @brief      Adds an event timestamped now to the ring buffer of the calling
+///             thread. Only checks a flag unless recording.
+///
+template <typename... Args>
+void TraceRecorderAddEvent(TraceRecord::Phase phase,
+                           const char* category,
+                           const char* name,
+                           int64_t id,
+                           size_t flow_id_count,
+                           const uint64_t* flow_ids,
+                           Args... args) {
+  if (TraceRecorderIsRecording()) {
+    TraceRecord record(phase, category, name, id);
+    if (flow_id_count > 0) {
+      record.flow_id = flow_ids[0];
+    }
+    record.AddArguments(args...);
+    TraceRecorderAdd(record);
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RECORDER_H_
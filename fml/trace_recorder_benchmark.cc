@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Records a scoped trace event with two numeric arguments, with the recorder
+// stopped when |state.range(0)| is 0 and recording otherwise.
+static void BM_TraceEventWithArguments(benchmark::State& state) {  // NOLINT
+  ScopedTemporaryDirectory directory;
+  if (state.range(0) != 0) {
+    tracing::TraceRecorderStart(
+        paths::JoinPaths({directory.path(), "trace.pftrace"}),
+        tracing::TraceRecorderFormat::kPerfetto,
+        TimeDelta::FromMilliseconds(10));
+  }
+
+  int64_t frame = 0;
+  for (auto _ : state) {
+    FML_TRACE_EVENT("flutter", "BM_TraceEventWithArguments", "frame", frame,
+                    "elapsed", 16.6);
+    frame++;
+  }
+
+  tracing::TraceRecorderStop();
+  state.counters["dropped"] = tracing::TraceRecorderGetDroppedEventCount();
+}
+
+BENCHMARK(BM_TraceEventWithArguments)->Arg(0)->Arg(1);
+
+}  // namespace benchmarking
+}  // namespace fml
@@ -0,0 +1,229 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_recorder.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+std::string ReadFile(const std::string& path) {
+  auto mapping = FileMapping::CreateReadOnly(path);
+  if (!mapping || mapping->GetSize() == 0) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                     mapping->GetSize());
+}
+
+size_t CountOccurrences(const std::string& string, const std::string& part) {
+  size_t count = 0;
+  for (size_t position = string.find(part); position != std::string::npos;
+       position = string.find(part, position + part.size())) {
+    count++;
+  }
+  return count;
+}
+
+uint64_t ReadVarInt(const std::string& data, size_t& offset) {
+  uint64_t value = 0;
+  for (size_t shift = 0; offset < data.size(); shift += 7) {
+    uint8_t byte = data[offset++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+}  // namespace
+
+TEST(TraceRecorderTest, DoesNothingUnlessRecording) {
+  ASSERT_FALSE(TraceRecorderIsRecording());
+  TraceRecorderAdd(TraceRecord(TraceRecord::Phase::kInstant, "flutter",
+                               "NotRecorded"));
+  TraceRecorderFlush();
+  TraceRecorderStop();
+  EXPECT_FALSE(TraceRecorderIsRecording());
+}
+
+TEST(TraceRecorderTest, CannotStartTwice) {
+  ScopedTemporaryDirectory directory;
+  ASSERT_TRUE(TraceRecorderStart(paths::JoinPaths({directory.path(), "a"}),
+                                 TraceRecorderFormat::kChromeJson));
+  EXPECT_TRUE(TraceRecorderIsRecording());
+  EXPECT_FALSE(TraceRecorderStart(paths::JoinPaths({directory.path(), "b"}),
+                                  TraceRecorderFormat::kChromeJson));
+  TraceRecorderStop();
+  EXPECT_FALSE(TraceRecorderIsRecording());
+}
+
+TEST(TraceRecorderTest, WritesChromeJson) {
+#if !FLUTTER_TRACE_RECORDER_ENABLED
+  GTEST_SKIP() << "Trace events are compiled out of this build.";
+#endif  // !FLUTTER_TRACE_RECORDER_ENABLED
+  ScopedTemporaryDirectory directory;
+  auto path = paths::JoinPaths({directory.path(), "trace.json"});
+  ASSERT_TRUE(TraceRecorderStart(path, TraceRecorderFormat::kChromeJson));
+
+  uint64_t flow_id = 42;
+  TraceEvent("flutter", "Frame", /*flow_id_count=*/1, &flow_id, "count", 3,
+             "ratio", 0.5);
+  TraceEventInstant1("flutter", "Mark", /*flow_id_count=*/0,
+                     /*flow_ids=*/nullptr, "label", "a \"quoted\" label");
+  TraceEventEnd("Frame");
+  TraceCounter("flutter", "Memory", 7, "bytes", 1024);
+  TraceRecorderStop();
+
+  std::string json = ReadFile(path);
+  EXPECT_EQ(json.front(), '[');
+  EXPECT_EQ(json.substr(json.size() - 2), "]\n");
+  EXPECT_NE(json.find("\"name\":\"Frame\",\"cat\":\"flutter\",\"ph\":\"B\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"bind_id\":\"0x2a\""), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"count\":3,\"ratio\":0.5}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"label\":\"a \\\"quoted\\\" label\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Frame\",\"ph\":\"E\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"Memory\",\"cat\":\"flutter\",\"ph\":\"C\""),
+            std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"bytes\":1024}"), std::string::npos);
+}
+
+TEST(TraceRecorderTest, NamesThreads) {
+#if !FLUTTER_TRACE_RECORDER_ENABLED
+  GTEST_SKIP() << "Trace events are compiled out of this build.";
+#endif  // !FLUTTER_TRACE_RECORDER_ENABLED
+  ScopedTemporaryDirectory directory;
+  auto path = paths::JoinPaths({directory.path(), "trace.json"});
+  ASSERT_TRUE(TraceRecorderStart(path, TraceRecorderFormat::kChromeJson));
+
+  {
+    Thread thread("recorded_thread");
+    AutoResetWaitableEvent latch;
+    thread.GetTaskRunner()->PostTask([&latch]() {
+      TraceEventInstant0("flutter", "OnThread", /*flow_id_count=*/0,
+                         /*flow_ids=*/nullptr);
+      latch.Signal();
+    });
+    latch.Wait();
+  }
+  TraceRecorderStop();
+
+  std::string json = ReadFile(path);
+  EXPECT_NE(json.find("\"args\":{\"name\":\"recorded_thread\"}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"OnThread\""), std::string::npos);
+}
+
+TEST(TraceRecorderTest, WritesPerfettoPackets) {
+#if !FLUTTER_TRACE_RECORDER_ENABLED
+  GTEST_SKIP() << "Trace events are compiled out of this build.";
+#endif  // !FLUTTER_TRACE_RECORDER_ENABLED
+  ScopedTemporaryDirectory directory;
+  auto path = paths::JoinPaths({directory.path(), "trace.pftrace"});
+  ASSERT_TRUE(TraceRecorderStart(path, TraceRecorderFormat::kPerfetto));
+
+  for (int i = 0; i < 10; i++) {
+    TraceEvent("flutter", "PerfettoFrame", /*flow_id_count=*/0,
+               /*flow_ids=*/nullptr, "index", i);
+    TraceEventEnd("PerfettoFrame");
+  }
+  TraceCounter("flutter", "PerfettoCounter", 0, "value", 1.5);
+  TraceRecorderStop();
+
+  std::string trace = ReadFile(path);
+  ASSERT_FALSE(trace.empty());
+
+  // The file is a sequence of `Trace.packet` fields.
+  size_t offset = 0;
+  size_t packet_count = 0;
+  while (offset < trace.size()) {
+    ASSERT_EQ(ReadVarInt(trace, offset), (1u << 3) | 2u);
+    offset += ReadVarInt(trace, offset);
+    packet_count++;
+  }
+  EXPECT_EQ(offset, trace.size());
+  // A thread descriptor, 20 slice events, a counter descriptor and a value.
+  EXPECT_EQ(packet_count, 23u);
+
+  // Names are interned once per thread.
+  EXPECT_EQ(CountOccurrences(trace, "PerfettoFrame"), 1u);
+  EXPECT_EQ(CountOccurrences(trace, "PerfettoCounter value"), 1u);
+}
+
+TEST(TraceRecorderTest, CountsDroppedEvents) {
+  ScopedTemporaryDirectory directory;
+  auto path = paths::JoinPaths({directory.path(), "trace.json"});
+  ASSERT_TRUE(TraceRecorderStart(path, TraceRecorderFormat::kChromeJson,
+                                 TimeDelta::FromSeconds(3600)));
+
+  constexpr size_t kEventCount = 10000;
+  std::thread thread([]() {
+    for (size_t i = 0; i < kEventCount; i++) {
+      TraceRecorderAdd(
+          TraceRecord(TraceRecord::Phase::kInstant, "flutter", "Dropped"));
+    }
+  });
+  thread.join();
+  size_t dropped_count = TraceRecorderGetDroppedEventCount();
+  TraceRecorderStop();
+
+  EXPECT_GT(dropped_count, 0u);
+  EXPECT_EQ(CountOccurrences(ReadFile(path), "\"name\":\"Dropped\"") +
+                dropped_count,
+            kEventCount);
+}
+
+TEST(TraceRecorderTest, RecordsFromManyThreads) {
+#if !FLUTTER_TRACE_RECORDER_ENABLED
+  GTEST_SKIP() << "Trace events are compiled out of this build.";
+#endif  // !FLUTTER_TRACE_RECORDER_ENABLED
+  ScopedTemporaryDirectory directory;
+  auto path = paths::JoinPaths({directory.path(), "trace.json"});
+  ASSERT_TRUE(TraceRecorderStart(path, TraceRecorderFormat::kChromeJson,
+                                 TimeDelta::FromMilliseconds(1)));
+
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kEventCount = 2000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([]() {
+      for (size_t j = 0; j < kEventCount; j++) {
+        TraceEvent("flutter", "Threaded", /*flow_id_count=*/0,
+                   /*flow_ids=*/nullptr, "index", j);
+        TraceEventEnd("Threaded");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  size_t dropped_count = TraceRecorderGetDroppedEventCount();
+  TraceRecorderStop();
+
+  EXPECT_EQ(CountOccurrences(ReadFile(path), "\"name\":\"Threaded\"") +
+                dropped_count,
+            kThreadCount * kEventCount * 2);
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,167 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_WORK_STEALING_DEQUE_H_
+#define FLUTTER_FML_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A lock-free Chase-Lev deque of pointers.
+///
+///             The owning thread pushes and pops items at the bottom of the
+///             deque in LIFO order. Any other thread may steal items from the
+///             top in FIFO order. The deque does not own the items it holds.
+///
+///             The memory orderings follow "Correct and Efficient
+///             Work-Stealing for Weak Memory Models" (Lê et al., PPoPP 2013).
+///             Buffers that are outgrown are kept alive until the deque is
+///             destroyed, as a thief may still be reading from them.
+///
+/// @tparam     T     The type of the pointed-to items.
+///
+template <typename T>
+class WorkStealingDeque {
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 64) {
+    size_t capacity = 1;
+    while (capacity < initial_capacity) {
+      capacity <<= 1;
+    }
+    buffers_.emplace_back(std::make_unique<Buffer>(capacity));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  ~WorkStealingDeque() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an item at the bottom of the deque. May only be called on
+  ///             the owning thread.
+  ///
+  void Push(T* item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->capacity) - 1) {
+      buffer = Grow(buffer, top, bottom);
+    }
+    buffer->Put(bottom, item);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the most recently pushed item. May only be called on
+  ///             the owning thread.
+  ///
+  /// @return     The item, or nullptr if the deque is empty.
+  ///
+  T* Pop() {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // Empty.
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T* item = buffer->Get(bottom);
+    if (top == bottom) {
+      // Last item, race the thieves for it.
+      if (!top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the least recently pushed item. May be called on any
+  ///             thread.
+  ///
+  /// @return     The item, or nullptr if the deque is empty or another thread
+  ///             took the item first.
+  ///
+  T* Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+
+    Buffer* buffer = buffer_.load(std::memory_order_acquire);
+    T* item = buffer->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      An estimate of the number of items in the deque. Exact only
+  ///             when no other thread is using the deque.
+  ///
+  size_t GetSize() const {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0u;
+  }
+
+ private:
+  struct Buffer {
+    explicit Buffer(size_t capacity_arg)
+        : capacity(capacity_arg),
+          mask(capacity_arg - 1),
+          items(new std::atomic<T*>[capacity_arg]) {}
+
+    T* Get(int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, T* item) {
+      items[index & mask].store(item, std::memory_order_relaxed);
+    }
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<std::atomic<T*>[]> items;
+  };
+
+  Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    buffers_.emplace_back(std::make_unique<Buffer>(buffer->capacity * 2));
+    Buffer* grown = buffers_.back().get();
+    for (int64_t i = top; i < bottom; i++) {
+      grown->Put(i, buffer->Get(i));
+    }
+    buffer_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  std::atomic<int64_t> top_ = 0;
+  std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Buffer*> buffer_;
+  // Only accessed by the owning thread.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_WORK_STEALING_DEQUE_H_
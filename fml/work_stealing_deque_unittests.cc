@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(WorkStealingDequeTest, PopIsLastInFirstOut) {
+  WorkStealingDeque<int> deque;
+  int items[3] = {0, 1, 2};
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.GetSize(), 3u);
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Pop(), &items[1]);
+  EXPECT_EQ(deque.Pop(), &items[0]);
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.GetSize(), 0u);
+}
+
+TEST(WorkStealingDequeTest, StealIsFirstInFirstOut) {
+  WorkStealingDeque<int> deque;
+  int items[3] = {0, 1, 2};
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  EXPECT_EQ(deque.Steal(), &items[1]);
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Steal(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity) {
+  WorkStealingDeque<int> deque(2);
+  std::vector<int> items(100);
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.GetSize(), items.size());
+  EXPECT_EQ(deque.Steal(), &items.front());
+  for (size_t i = items.size() - 1; i > 0; i--) {
+    EXPECT_EQ(deque.Pop(), &items[i]);
+  }
+  EXPECT_EQ(deque.Pop(), nullptr);
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce) {
+  constexpr size_t kItemCount = 100000;
+  constexpr size_t kThiefCount = 3;
+  WorkStealingDeque<std::atomic_int> deque(16);
+  std::vector<std::atomic_int> taken(kItemCount);
+  std::atomic_bool done = false;
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefCount; i++) {
+    thieves.emplace_back([&]() {
+      while (!done) {
+        if (std::atomic_int* item = deque.Steal()) {
+          ++*item;
+        }
+      }
+    });
+  }
+
+  // Interleave pushes and pops so that the owner races the thieves for the
+  // last item and the buffer grows while they are reading from it.
+  for (size_t i = 0; i < kItemCount; i++) {
+    deque.Push(&taken[i]);
+    if (i % 3 == 0) {
+      if (std::atomic_int* item = deque.Pop()) {
+        ++*item;
+      }
+    }
+  }
+  while (std::atomic_int* item = deque.Pop()) {
+    ++*item;
+  }
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  for (const auto& count : taken) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -1045,9 +1045,10 @@ void Canvas::SaveLayer(const Paint& paint,
 
     std::shared_ptr<Texture> input_texture;
 
-    // If the backdrop ID is not nullopt and there is more than one usage
-    // of it in the current scene, cache the backdrop texture and remove it from
-    // the current entity pass flip.
+    // If the backdrop ID is not nullopt, or the first pass grouped this
+    // backdrop filter with others that read the same backdrop, and there is
+    // more than one usage of it in the current scene, cache the backdrop
+    // texture and remove it from the current entity pass flip.
     bool will_cache_backdrop_texture = false;
     BackdropData* backdrop_data = nullptr;
     // If we've reached this point, there is at least one backdrop filter. But
@@ -1059,10 +1060,18 @@ void Canvas::SaveLayer(const Paint& paint,
           backdrop_data_.find(backdrop_id.value());
       if (backdrop_data_it != backdrop_data_.end()) {
         backdrop_data = &backdrop_data_it->second;
-        will_cache_backdrop_texture =
-            backdrop_data_it->second.backdrop_count > 1;
-        backdrop_count = backdrop_data_it->second.backdrop_count;
       }
+    } else {
+      auto group_index_it =
+          implicit_backdrop_data_.group_indices.find(backdrop_filter);
+      if (group_index_it != implicit_backdrop_data_.group_indices.end()) {
+        backdrop_data =
+            &implicit_backdrop_data_.groups[group_index_it->second];
+      }
+    }
+    if (backdrop_data) {
+      will_cache_backdrop_texture = backdrop_data->backdrop_count > 1;
+      backdrop_count = backdrop_data->backdrop_count;
     }
 
     if (!will_cache_backdrop_texture || !backdrop_data->texture_slot) {
@@ -1107,9 +1116,23 @@ void Canvas::SaveLayer(const Paint& paint,
       // layer once.
       if (backdrop_data->all_filters_equal &&
           !backdrop_data->shared_filter_snapshot.has_value()) {
-        // TODO(157110): compute minimum input hint.
+        // Only filter the region covered by the backdrop filters that share
+        // the snapshot, when the first pass was able to compute it.
+        std::optional<Rect> coverage_limit;
+        if (backdrop_data->coverage.has_value()) {
+          coverage_limit =
+              backdrop_data->coverage->Shift(-GetGlobalPassPosition());
+        }
         backdrop_data->shared_filter_snapshot =
-            backdrop_filter_contents->RenderToSnapshot(renderer_, {});
+            backdrop_filter_contents->RenderToSnapshot(renderer_, {},
+                                                       coverage_limit);
+        // Keep the snapshot in the global coordinate space so that it can be
+        // sampled from any pass.
+        if (backdrop_data->shared_filter_snapshot.has_value()) {
+          backdrop_data->shared_filter_snapshot->transform =
+              Matrix::MakeTranslation(Vector3(GetGlobalPassPosition())) *
+              backdrop_data->shared_filter_snapshot->transform;
+        }
       }
 
       std::optional<Snapshot> maybe_snapshot =
@@ -1413,16 +1436,12 @@ void Canvas::AddRenderEntityWithFiltersToCurrentPass(Entity& entity,
   if (needs_color_filter &&
       (!paint.color_source ||
        paint.color_source->type() != flutter::DlColorSourceType::kImage)) {
-    if (paint.color_filter) {
-      contents_copy = WrapWithGPUColorFilter(
-          paint.color_filter, FilterInput::Make(std::move(contents_copy)),
+    if (paint.color_filter || paint.invert_colors) {
+      contents_copy = WrapWithGPUColorFilters(
+          paint.color_filter, paint.invert_colors,
+          FilterInput::Make(std::move(contents_copy)),
           ColorFilterContents::AbsorbOpacity::kYes);
     }
-    if (paint.invert_colors) {
-      contents_copy =
-          WrapWithInvertColors(FilterInput::Make(std::move(contents_copy)),
-                               ColorFilterContents::AbsorbOpacity::kYes);
-    }
   }
 
   if (paint.image_filter) {
@@ -1539,9 +1558,11 @@ RenderPass& Canvas::GetCurrentRenderPass() const {
 
 void Canvas::SetBackdropData(
     std::unordered_map<int64_t, BackdropData> backdrop_data,
-    size_t backdrop_count) {
+    size_t backdrop_count,
+    ImplicitBackdropData implicit_backdrop_data) {
   backdrop_data_ = std::move(backdrop_data);
   backdrop_count_ = backdrop_count;
+  implicit_backdrop_data_ = std::move(implicit_backdrop_data);
 }
 
 std::shared_ptr<Texture> Canvas::FlipBackdrop(Point global_pass_position,
@@ -9,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -40,6 +41,20 @@ struct BackdropData {
   // multiple backdrops that share an identical filter.
   std::optional<Snapshot> shared_filter_snapshot;
   std::shared_ptr<flutter::DlImageFilter> last_backdrop;
+  // The union of the coverage of the backdrop filters in the global
+  // coordinate space, if it is known. The shared filter snapshot only needs
+  // to cover this region.
+  std::optional<Rect> coverage;
+};
+
+// Backdrop filters without a backdrop id that read the same backdrop with
+// identical filters. Each group shares a backdrop texture and filter snapshot
+// as if its backdrop filters had the same backdrop id.
+struct ImplicitBackdropData {
+  std::vector<BackdropData> groups;
+  // The index of the group of each backdrop filter, keyed by the backdrop
+  // filter of its save layer.
+  std::unordered_map<const flutter::DlImageFilter*, size_t> group_indices;
 };
 
 struct CanvasStackEntry {
@@ -140,7 +155,8 @@ class Canvas {
   /// @brief Update the backdrop data used to group together backdrop filters
   ///        within the same layer
   void SetBackdropData(std::unordered_map<int64_t, BackdropData> backdrop_data,
-                       size_t backdrop_count);
+                       size_t backdrop_count,
+                       ImplicitBackdropData implicit_backdrop_data = {});
 
   /// @brief Return the culling bounds of the current render target, or nullopt
   ///        if there is no coverage.
@@ -266,6 +282,10 @@ class Canvas {
   /// backdrop_count_ is also mutated during rendering.
   std::unordered_map<int64_t, BackdropData> backdrop_data_;
 
+  /// Backdrop layers without a backdrop id that were grouped together by the
+  /// first pass over the display list.
+  ImplicitBackdropData implicit_backdrop_data_;
+
   /// The remaining number of backdrop filters.
   ///
   /// This value is decremented while rendering. When it reaches 0, then
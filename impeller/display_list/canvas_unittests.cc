@@ -241,6 +241,45 @@ TEST_P(AiksTest, BackdropCountDownBackdropIdMixed) {
   EXPECT_FALSE(canvas->RequiresReadback());
 }
 
+TEST_P(AiksTest, BackdropCountDownImplicitBackdropGroup) {
+  ContentContext context(GetContext(), nullptr);
+  if (!context.GetDeviceCapabilities().SupportsFramebufferFetch()) {
+    GTEST_SKIP() << "Test requires device with framebuffer fetch";
+  }
+  auto canvas = CreateTestCanvas(context, Rect::MakeLTRB(0, 0, 100, 100),
+                                 /*requires_readback=*/true);
+
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(4, 4, flutter::DlTileMode::kClamp);
+  auto grouped_blur =
+      flutter::DlImageFilter::MakeBlur(4, 4, flutter::DlTileMode::kClamp);
+
+  // 3 backdrop filters, 2 grouped by the first pass.
+  ImplicitBackdropData implicit_data;
+  implicit_data.groups.push_back(BackdropData{
+      .backdrop_count = 2, .coverage = Rect::MakeLTRB(0, 0, 100, 100)});
+  implicit_data.group_indices[grouped_blur.get()] = 0;
+  canvas->SetBackdropData({}, 3, implicit_data);
+
+  EXPECT_TRUE(canvas->RequiresReadback());
+  canvas->DrawRect(flutter::DlRect::MakeLTRB(0, 0, 50, 50),
+                   {.color = Color::Azure()});
+  canvas->SaveLayer({}, std::nullopt, blur.get(),
+                    ContentBoundsPromise::kContainsContents, 1, false);
+  canvas->Restore();
+  EXPECT_TRUE(canvas->RequiresReadback());
+
+  canvas->SaveLayer({}, std::nullopt, grouped_blur.get(),
+                    ContentBoundsPromise::kContainsContents, 1, false);
+  canvas->Restore();
+  EXPECT_FALSE(canvas->RequiresReadback());
+
+  canvas->SaveLayer({}, std::nullopt, grouped_blur.get(),
+                    ContentBoundsPromise::kContainsContents, 1, false);
+  canvas->Restore();
+  EXPECT_FALSE(canvas->RequiresReadback());
+}
+
 // We only know the total number of backdrop filters, not the number of backdrop
 // filters in the root pass. If we reach a count of 0 while in a nested
 // saveLayer, we should not restore to the onscreen.
@@ -4,6 +4,8 @@
 
 #include "impeller/display_list/color_filter.h"
 
+#include <vector>
+
 #include "display_list/effects/dl_color_filter.h"
 #include "fml/logging.h"
 #include "impeller/display_list/skia_conversions.h"
@@ -13,18 +15,7 @@
 
 namespace impeller {
 
-std::shared_ptr<ColorFilterContents> WrapWithInvertColors(
-    const std::shared_ptr<FilterInput>& input,
-    ColorFilterContents::AbsorbOpacity absorb_opacity) {
-  auto filter = ColorFilterContents::MakeColorMatrix({input}, kColorInversion);
-  filter->SetAbsorbOpacity(absorb_opacity);
-  return filter;
-}
-
-std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilter(
-    const flutter::DlColorFilter* filter,
-    const std::shared_ptr<FilterInput>& input,
-    ColorFilterContents::AbsorbOpacity absorb_opacity) {
+ColorFilterStage ToColorFilterStage(const flutter::DlColorFilter* filter) {
   FML_DCHECK(filter);
 
   switch (filter->type()) {
@@ -32,37 +23,57 @@ std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilter(
       const flutter::DlBlendColorFilter* blend_filter = filter->asBlend();
       FML_DCHECK(blend_filter);
 
-      auto filter = ColorFilterContents::MakeBlend(
-          static_cast<BlendMode>(blend_filter->mode()), {input},
-          skia_conversions::ToColor(blend_filter->color()));
-      filter->SetAbsorbOpacity(absorb_opacity);
-      return filter;
+      return ColorFilterStage{
+          .type = ColorFilterStage::Type::kBlend,
+          .blend_mode = static_cast<BlendMode>(blend_filter->mode()),
+          .color = skia_conversions::ToColor(blend_filter->color()),
+      };
     }
     case flutter::DlColorFilterType::kMatrix: {
       const flutter::DlMatrixColorFilter* matrix_filter = filter->asMatrix();
       FML_DCHECK(matrix_filter);
 
-      impeller::ColorMatrix color_matrix;
-      matrix_filter->get_matrix(color_matrix.array);
-      auto filter = ColorFilterContents::MakeColorMatrix({input}, color_matrix);
-      filter->SetAbsorbOpacity(absorb_opacity);
-      return filter;
-    }
-    case flutter::DlColorFilterType::kSrgbToLinearGamma: {
-      auto filter = ColorFilterContents::MakeSrgbToLinearFilter({input});
-      filter->SetAbsorbOpacity(absorb_opacity);
-      return filter;
-    }
-    case flutter::DlColorFilterType::kLinearToSrgbGamma: {
-      auto filter = ColorFilterContents::MakeLinearToSrgbFilter({input});
-      filter->SetAbsorbOpacity(absorb_opacity);
-      return filter;
+      ColorFilterStage stage{.type = ColorFilterStage::Type::kColorMatrix};
+      matrix_filter->get_matrix(stage.color_matrix.array);
+      return stage;
     }
+    case flutter::DlColorFilterType::kSrgbToLinearGamma:
+      return ColorFilterStage{.type = ColorFilterStage::Type::kSrgbToLinear};
+    case flutter::DlColorFilterType::kLinearToSrgbGamma:
+      return ColorFilterStage{.type = ColorFilterStage::Type::kLinearToSrgb};
   }
 
   FML_UNREACHABLE();
 }
 
+std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilter(
+    const flutter::DlColorFilter* filter,
+    const std::shared_ptr<FilterInput>& input,
+    ColorFilterContents::AbsorbOpacity absorb_opacity) {
+  return ColorFilterContents::MakeFused(input, {ToColorFilterStage(filter)},
+                                        absorb_opacity);
+}
+
+std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilters(
+    const flutter::DlColorFilter* filter,
+    bool invert_colors,
+    const std::shared_ptr<FilterInput>& input,
+    ColorFilterContents::AbsorbOpacity absorb_opacity) {
+  FML_DCHECK(filter || invert_colors);
+
+  std::vector<ColorFilterStage> stages;
+  if (filter) {
+    stages.push_back(ToColorFilterStage(filter));
+  }
+  if (invert_colors) {
+    stages.push_back(ColorFilterStage{
+        .type = ColorFilterStage::Type::kColorMatrix,
+        .color_matrix = kColorInversion,
+    });
+  }
+  return ColorFilterContents::MakeFused(input, stages, absorb_opacity);
+}
+
 ColorFilterProc GetCPUColorFilterProc(const flutter::DlColorFilter* filter) {
   FML_DCHECK(filter);
 
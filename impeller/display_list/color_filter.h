@@ -22,12 +22,20 @@ static const constexpr ColorMatrix kColorInversion = {
   }
 };
 
-std::shared_ptr<ColorFilterContents> WrapWithInvertColors(
+/// Returns the stage that evaluates `filter` as part of a fused color filter
+/// chain.
+ColorFilterStage ToColorFilterStage(const flutter::DlColorFilter* filter);
+
+std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilter(
+    const flutter::DlColorFilter* filter,
     const std::shared_ptr<FilterInput>& input,
     ColorFilterContents::AbsorbOpacity absorb_opacity);
 
-std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilter(
+/// Applies `filter` followed by color inversion, either of which may be
+/// omitted, using as few passes as possible.
+std::shared_ptr<ColorFilterContents> WrapWithGPUColorFilters(
     const flutter::DlColorFilter* filter,
+    bool invert_colors,
     const std::shared_ptr<FilterInput>& input,
     ColorFilterContents::AbsorbOpacity absorb_opacity);
 
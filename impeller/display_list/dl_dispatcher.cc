@@ -976,8 +976,10 @@ void CanvasDlDispatcher::drawVertices(
 
 void CanvasDlDispatcher::SetBackdropData(
     std::unordered_map<int64_t, BackdropData> backdrop,
-    size_t backdrop_count) {
-  GetCanvas().SetBackdropData(std::move(backdrop), backdrop_count);
+    size_t backdrop_count,
+    ImplicitBackdropData implicit_backdrop) {
+  GetCanvas().SetBackdropData(std::move(backdrop), backdrop_count,
+                              std::move(implicit_backdrop));
 }
 
 //// Text Frame Dispatcher
@@ -987,22 +989,38 @@ FirstPassDispatcher::FirstPassDispatcher(const ContentContext& renderer,
                                          const Rect cull_rect)
     : renderer_(renderer), matrix_(initial_matrix) {
   cull_rect_state_.push_back(cull_rect);
+  clip_bounds_state_.push_back(cull_rect);
 }
 
 FirstPassDispatcher::~FirstPassDispatcher() {
   FML_DCHECK(cull_rect_state_.size() == 1);
+  FML_DCHECK(clip_bounds_state_.size() == 1);
 }
 
 void FirstPassDispatcher::save() {
   stack_.emplace_back(matrix_);
+  layer_stack_.push_back(false);
   cull_rect_state_.push_back(cull_rect_state_.back());
+  clip_bounds_state_.push_back(clip_bounds_state_.back());
 }
 
 void FirstPassDispatcher::saveLayer(const DlRect& bounds,
                                     const flutter::SaveLayerOptions options,
                                     const flutter::DlImageFilter* backdrop,
                                     std::optional<int64_t> backdrop_id) {
+  std::optional<Rect> backdrop_coverage;
+  if (backdrop != nullptr) {
+    backdrop_coverage = GetBackdropCoverage();
+  }
+  if (backdrop != nullptr && !backdrop_id.has_value()) {
+    AddImplicitBackdrop(backdrop, options);
+  } else {
+    OnDraw();
+  }
+
   save();
+  layer_stack_.back() = true;
+  layer_depth_++;
 
   backdrop_count_ += (backdrop == nullptr ? 0 : 1);
   if (backdrop != nullptr && backdrop_id.has_value()) {
@@ -1012,7 +1030,9 @@ void FirstPassDispatcher::saveLayer(const DlRect& bounds,
         backdrop_data_.find(backdrop_id.value());
     if (existing == backdrop_data_.end()) {
       backdrop_data_[backdrop_id.value()] =
-          BackdropData{.backdrop_count = 1, .last_backdrop = shared_backdrop};
+          BackdropData{.backdrop_count = 1,
+                       .last_backdrop = shared_backdrop,
+                       .coverage = backdrop_coverage};
     } else {
       BackdropData& data = existing->second;
       data.backdrop_count++;
@@ -1020,9 +1040,21 @@ void FirstPassDispatcher::saveLayer(const DlRect& bounds,
         data.all_filters_equal = (*data.last_backdrop == *shared_backdrop);
         data.last_backdrop = shared_backdrop;
       }
+      if (data.coverage.has_value()) {
+        data.coverage = backdrop_coverage.has_value()
+                            ? std::optional<Rect>(data.coverage->Union(
+                                  backdrop_coverage.value()))
+                            : std::nullopt;
+      }
     }
   }
 
+  // The content of a layer with an image filter may be moved outside of the
+  // clip, so a backdrop filter within it can't be bounded by the clip.
+  if (has_image_filter_) {
+    clip_bounds_state_.back() = Rect::MakeMaximum();
+  }
+
   // This dispatcher does not track enough state to accurately compute
   // cull rects with image filters.
   auto global_cull_rect = cull_rect_state_.back();
@@ -1043,6 +1075,18 @@ void FirstPassDispatcher::restore() {
   matrix_ = stack_.back();
   stack_.pop_back();
   cull_rect_state_.pop_back();
+  clip_bounds_state_.pop_back();
+  bool was_layer = layer_stack_.back();
+  layer_stack_.pop_back();
+  if (was_layer) {
+    layer_depth_--;
+    // The pass that the backdrop filters of the open group read from ends
+    // here.
+    if (open_backdrop_group_.has_value() &&
+        layer_depth_ < open_backdrop_group_->layer_depth) {
+      CloseBackdropGroup();
+    }
+  }
 }
 
 void FirstPassDispatcher::translate(DlScalar tx, DlScalar ty) {
@@ -1092,10 +1136,184 @@ void FirstPassDispatcher::transformReset() {
   matrix_ = Matrix();
 }
 
+void FirstPassDispatcher::ClipBounds(const DlRect& bounds, ClipOp clip_op) {
+  // Difference clips and clips under a perspective transform are ignored, as
+  // they only make the bounds of the clip larger than necessary.
+  if (clip_op != ClipOp::kIntersect || matrix_.HasPerspective()) {
+    return;
+  }
+  Rect& clip_bounds = clip_bounds_state_.back();
+  clip_bounds =
+      clip_bounds.Intersection(bounds.TransformBounds(matrix_)).value_or(Rect());
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::clipRect(const DlRect& rect,
+                                   ClipOp clip_op,
+                                   bool is_aa) {
+  ClipBounds(rect, clip_op);
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::clipOval(const DlRect& bounds,
+                                   ClipOp clip_op,
+                                   bool is_aa) {
+  ClipBounds(bounds, clip_op);
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::clipRoundRect(const DlRoundRect& rrect,
+                                        ClipOp clip_op,
+                                        bool is_aa) {
+  ClipBounds(rrect.GetBounds(), clip_op);
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::clipPath(const DlPath& path,
+                                   ClipOp clip_op,
+                                   bool is_aa) {
+  ClipBounds(path.GetBounds(), clip_op);
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawColor(flutter::DlColor color,
+                                    flutter::DlBlendMode dl_mode) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawPaint() {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawLine(const DlPoint& p0, const DlPoint& p1) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawDashedLine(const DlPoint& p0,
+                                         const DlPoint& p1,
+                                         DlScalar on_length,
+                                         DlScalar off_length) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawRect(const DlRect& rect) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawOval(const DlRect& bounds) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawCircle(const DlPoint& center, DlScalar radius) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawRoundRect(const DlRoundRect& rrect) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawDiffRoundRect(const DlRoundRect& outer,
+                                            const DlRoundRect& inner) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawPath(const DlPath& path) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawArc(const DlRect& oval_bounds,
+                                  DlScalar start_degrees,
+                                  DlScalar sweep_degrees,
+                                  bool use_center) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawPoints(PointMode mode,
+                                     uint32_t count,
+                                     const DlPoint points[]) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawVertices(
+    const std::shared_ptr<flutter::DlVertices>& vertices,
+    flutter::DlBlendMode dl_mode) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawImage(const sk_sp<flutter::DlImage> image,
+                                    const DlPoint& point,
+                                    flutter::DlImageSampling sampling,
+                                    bool render_with_attributes) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawImageRect(const sk_sp<flutter::DlImage> image,
+                                        const DlRect& src,
+                                        const DlRect& dst,
+                                        flutter::DlImageSampling sampling,
+                                        bool render_with_attributes,
+                                        SrcRectConstraint constraint) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawImageNine(const sk_sp<flutter::DlImage> image,
+                                        const DlIRect& center,
+                                        const DlRect& dst,
+                                        flutter::DlFilterMode filter,
+                                        bool render_with_attributes) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawAtlas(const sk_sp<flutter::DlImage> atlas,
+                                    const SkRSXform xform[],
+                                    const DlRect tex[],
+                                    const flutter::DlColor colors[],
+                                    int count,
+                                    flutter::DlBlendMode mode,
+                                    flutter::DlImageSampling sampling,
+                                    const DlRect* cull_rect,
+                                    bool render_with_attributes) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
+                                       DlScalar x,
+                                       DlScalar y) {
+  OnDraw();
+}
+
+// |flutter::DlOpReceiver|
+void FirstPassDispatcher::drawShadow(const DlPath& path,
+                                     const flutter::DlColor color,
+                                     const DlScalar elevation,
+                                     bool transparent_occluder,
+                                     DlScalar dpr) {
+  OnDraw();
+}
+
 void FirstPassDispatcher::drawTextFrame(
     const std::shared_ptr<impeller::TextFrame>& text_frame,
     DlScalar x,
     DlScalar y) {
+  OnDraw();
+
   GlyphProperties properties;
   if (paint_.style == Paint::Style::kStroke) {
     properties.stroke = true;
@@ -1229,6 +1447,118 @@ FirstPassDispatcher::TakeBackdropData() {
   return std::make_pair(temp, backdrop_count_);
 }
 
+ImplicitBackdropData FirstPassDispatcher::TakeImplicitBackdropData() {
+  CloseBackdropGroup();
+  ImplicitBackdropData temp;
+  std::swap(temp, implicit_backdrop_data_);
+  return temp;
+}
+
+std::optional<Rect> FirstPassDispatcher::GetBackdropCoverage() const {
+  // A backdrop filter floods the clip of its saveLayer regardless of the
+  // bounds of the saveLayer.
+  const Rect& clip_bounds = clip_bounds_state_.back();
+  if (clip_bounds.IsMaximum()) {
+    return std::nullopt;
+  }
+  return Rect::Make(IRect::RoundOut(clip_bounds));
+}
+
+void FirstPassDispatcher::AddImplicitBackdrop(
+    const flutter::DlImageFilter* backdrop,
+    const flutter::SaveLayerOptions& options) {
+  if (!implicit_backdrops_.insert(backdrop).second) {
+    // The same saveLayer is dispatched more than once, as when a display list
+    // is drawn twice. The canvas can't tell the save layers apart, so none of
+    // them are grouped.
+    auto group_index = implicit_backdrop_data_.group_indices.find(backdrop);
+    if (group_index != implicit_backdrop_data_.group_indices.end()) {
+      size_t index = group_index->second;
+      for (auto it = implicit_backdrop_data_.group_indices.begin();
+           it != implicit_backdrop_data_.group_indices.end();) {
+        it = it->second == index
+                 ? implicit_backdrop_data_.group_indices.erase(it)
+                 : std::next(it);
+      }
+    }
+    if (open_backdrop_group_.has_value() &&
+        std::find(open_backdrop_group_->members.begin(),
+                  open_backdrop_group_->members.end(),
+                  backdrop) != open_backdrop_group_->members.end()) {
+      open_backdrop_group_.reset();
+    }
+    OnDraw();
+    return;
+  }
+
+  // A backdrop filter nested in a backdrop filter of the open group reads
+  // from a different pass and leaves the group open.
+  if (open_backdrop_group_.has_value() &&
+      open_backdrop_group_->layer_depth != layer_depth_) {
+    return;
+  }
+
+  // The snapshot of a group is composited without the attributes of the
+  // saveLayer, and the texture can only be shared when the regions written
+  // by the backdrop filters are known.
+  std::optional<Rect> coverage = GetBackdropCoverage();
+  if (!coverage.has_value() || options.renders_with_attributes() ||
+      matrix_.HasPerspective()) {
+    CloseBackdropGroup();
+    return;
+  }
+
+  if (open_backdrop_group_.has_value()) {
+    OpenBackdropGroup& group = open_backdrop_group_.value();
+    DlIRect input_bounds;
+    // The backdrop filter must not read anything that the earlier backdrop
+    // filters of the group drew.
+    if (*group.filter == *backdrop && group.basis == matrix_.Basis() &&
+        group.has_translation == matrix_.HasTranslation() &&
+        backdrop->get_input_device_bounds(IRect::RoundOut(coverage.value()),
+                                          matrix_, input_bounds) &&
+        !group.coverage.IntersectsWithRect(Rect::Make(input_bounds))) {
+      group.members.push_back(backdrop);
+      group.coverage = group.coverage.Union(coverage.value());
+      return;
+    }
+    CloseBackdropGroup();
+  }
+
+  open_backdrop_group_ = OpenBackdropGroup{
+      .filter = backdrop->shared(),
+      .basis = matrix_.Basis(),
+      .has_translation = matrix_.HasTranslation(),
+      .layer_depth = layer_depth_,
+      .members = {backdrop},
+      .coverage = coverage.value(),
+  };
+}
+
+void FirstPassDispatcher::OnDraw() {
+  if (open_backdrop_group_.has_value() &&
+      layer_depth_ <= open_backdrop_group_->layer_depth) {
+    CloseBackdropGroup();
+  }
+}
+
+void FirstPassDispatcher::CloseBackdropGroup() {
+  if (!open_backdrop_group_.has_value()) {
+    return;
+  }
+  const OpenBackdropGroup& group = open_backdrop_group_.value();
+  if (group.members.size() > 1) {
+    size_t index = implicit_backdrop_data_.groups.size();
+    implicit_backdrop_data_.groups.push_back(
+        BackdropData{.backdrop_count = group.members.size(),
+                     .coverage = group.coverage});
+    for (const flutter::DlImageFilter* member : group.members) {
+      implicit_backdrop_data_.group_indices[member] = index;
+    }
+  }
+  open_backdrop_group_.reset();
+}
+
 std::shared_ptr<Texture> DisplayListToTexture(
     const sk_sp<flutter::DisplayList>& display_list,
     ISize size,
@@ -1277,7 +1607,8 @@ std::shared_ptr<Texture> DisplayListToTexture(
       impeller::IRect::MakeSize(size)            //
   );
   const auto& [data, count] = collector.TakeBackdropData();
-  impeller_dispatcher.SetBackdropData(data, count);
+  impeller_dispatcher.SetBackdropData(data, count,
+                                      collector.TakeImplicitBackdropData());
   display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
   impeller_dispatcher.FinishRecording();
 
@@ -1308,7 +1639,8 @@ bool RenderToOnscreen(ContentContext& context,
       IRect::RoundOut(ip_cull_rect)              //
   );
   const auto& [data, count] = collector.TakeBackdropData();
-  impeller_dispatcher.SetBackdropData(data, count);
+  impeller_dispatcher.SetBackdropData(data, count,
+                                      collector.TakeImplicitBackdropData());
   display_list->Dispatch(impeller_dispatcher, cull_rect);
   impeller_dispatcher.FinishRecording();
   if (reset_host_buffer) {
@@ -6,6 +6,9 @@
 #define FLUTTER_IMPELLER_DISPLAY_LIST_DL_DISPATCHER_H_
 
 #include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/geometry/dl_geometry_types.h"
@@ -261,7 +264,8 @@ class CanvasDlDispatcher : public DlDispatcherBase {
   ~CanvasDlDispatcher() = default;
 
   void SetBackdropData(std::unordered_map<int64_t, BackdropData> backdrop,
-                       size_t backdrop_count);
+                       size_t backdrop_count,
+                       ImplicitBackdropData implicit_backdrop = {});
 
   // |flutter::DlOpReceiver|
   void save() override {
@@ -297,8 +301,12 @@ class CanvasDlDispatcher : public DlDispatcherBase {
 
 /// Performs a first pass over the display list to collect infomation.
 /// Collects things like text frames and backdrop filters.
+///
+/// Sibling backdrop filters without a backdrop id are grouped together when
+/// their filters are identical, nothing else is drawn between them, and none
+/// of them reads a region written by an earlier one. Each group is filtered
+/// once, as if its backdrop filters had the same backdrop id.
 class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
-                            public flutter::IgnoreClipDispatchHelper,
                             public flutter::IgnoreDrawDispatchHelper {
  public:
   FirstPassDispatcher(const ContentContext& renderer,
@@ -338,6 +346,106 @@ class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
 
   void transformReset() override;
 
+  // |flutter::DlOpReceiver|
+  void clipRect(const DlRect& rect, ClipOp clip_op, bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void clipOval(const DlRect& bounds, ClipOp clip_op, bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void clipRoundRect(const DlRoundRect& rrect,
+                     ClipOp clip_op,
+                     bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void clipPath(const DlPath& path, ClipOp clip_op, bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void drawColor(flutter::DlColor color, flutter::DlBlendMode mode) override;
+
+  // |flutter::DlOpReceiver|
+  void drawPaint() override;
+
+  // |flutter::DlOpReceiver|
+  void drawLine(const DlPoint& p0, const DlPoint& p1) override;
+
+  // |flutter::DlOpReceiver|
+  void drawDashedLine(const DlPoint& p0,
+                      const DlPoint& p1,
+                      DlScalar on_length,
+                      DlScalar off_length) override;
+
+  // |flutter::DlOpReceiver|
+  void drawRect(const DlRect& rect) override;
+
+  // |flutter::DlOpReceiver|
+  void drawOval(const DlRect& bounds) override;
+
+  // |flutter::DlOpReceiver|
+  void drawCircle(const DlPoint& center, DlScalar radius) override;
+
+  // |flutter::DlOpReceiver|
+  void drawRoundRect(const DlRoundRect& rrect) override;
+
+  // |flutter::DlOpReceiver|
+  void drawDiffRoundRect(const DlRoundRect& outer,
+                         const DlRoundRect& inner) override;
+
+  // |flutter::DlOpReceiver|
+  void drawPath(const DlPath& path) override;
+
+  // |flutter::DlOpReceiver|
+  void drawArc(const DlRect& oval_bounds,
+               DlScalar start_degrees,
+               DlScalar sweep_degrees,
+               bool use_center) override;
+
+  // |flutter::DlOpReceiver|
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const DlPoint points[]) override;
+
+  // |flutter::DlOpReceiver|
+  void drawVertices(const std::shared_ptr<flutter::DlVertices>& vertices,
+                    flutter::DlBlendMode dl_mode) override;
+
+  // |flutter::DlOpReceiver|
+  void drawImage(const sk_sp<flutter::DlImage> image,
+                 const DlPoint& point,
+                 flutter::DlImageSampling sampling,
+                 bool render_with_attributes) override;
+
+  // |flutter::DlOpReceiver|
+  void drawImageRect(const sk_sp<flutter::DlImage> image,
+                     const DlRect& src,
+                     const DlRect& dst,
+                     flutter::DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override;
+
+  // |flutter::DlOpReceiver|
+  void drawImageNine(const sk_sp<flutter::DlImage> image,
+                     const DlIRect& center,
+                     const DlRect& dst,
+                     flutter::DlFilterMode filter,
+                     bool render_with_attributes) override;
+
+  // |flutter::DlOpReceiver|
+  void drawAtlas(const sk_sp<flutter::DlImage> atlas,
+                 const SkRSXform xform[],
+                 const DlRect tex[],
+                 const flutter::DlColor colors[],
+                 int count,
+                 flutter::DlBlendMode mode,
+                 flutter::DlImageSampling sampling,
+                 const DlRect* cull_rect,
+                 bool render_with_attributes) override;
+
+  // |flutter::DlOpReceiver|
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    DlScalar x,
+                    DlScalar y) override;
+
   void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
                      DlScalar x,
                      DlScalar y) override;
@@ -345,6 +453,13 @@ class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
   void drawDisplayList(const sk_sp<flutter::DisplayList> display_list,
                        DlScalar opacity) override;
 
+  // |flutter::DlOpReceiver|
+  void drawShadow(const DlPath& path,
+                  const flutter::DlColor color,
+                  const DlScalar elevation,
+                  bool transparent_occluder,
+                  DlScalar dpr) override;
+
   // |flutter::DlOpReceiver|
   void setDrawStyle(flutter::DlDrawStyle style) override;
 
@@ -368,17 +483,61 @@ class FirstPassDispatcher : public flutter::IgnoreAttributeDispatchHelper,
 
   std::pair<std::unordered_map<int64_t, BackdropData>, size_t> TakeBackdropData();
 
+  /// Return the groups of backdrop filters without a backdrop id that can
+  /// share a backdrop texture and filter snapshot.
+  ImplicitBackdropData TakeImplicitBackdropData();
+
  private:
+  /// Sibling backdrop filters without a backdrop id that are being collected
+  /// into a group.
+  struct OpenBackdropGroup {
+    std::shared_ptr<flutter::DlImageFilter> filter;
+    Matrix basis;
+    bool has_translation = false;
+    // The number of save layers enclosing the backdrop filters.
+    size_t layer_depth = 0u;
+    std::vector<const flutter::DlImageFilter*> members;
+    // The union of the regions written by the backdrop filters, in the
+    // global coordinate space.
+    Rect coverage;
+  };
+
   const Rect GetCurrentLocalCullingBounds() const;
 
+  /// Return the region of the current pass that a backdrop filter saveLayer
+  /// would cover, or nullopt if it can't be bounded.
+  std::optional<Rect> GetBackdropCoverage() const;
+
+  void ClipBounds(const DlRect& bounds, ClipOp clip_op);
+
+  void AddImplicitBackdrop(const flutter::DlImageFilter* backdrop,
+                           const flutter::SaveLayerOptions& options);
+
+  /// Ends the open backdrop group if something is drawn into the pass that
+  /// its backdrop filters read from.
+  void OnDraw();
+
+  void CloseBackdropGroup();
+
   const ContentContext& renderer_;
   Matrix matrix_;
   std::vector<Matrix> stack_;
+  // Whether each entry of the stack was pushed by a saveLayer.
+  std::vector<bool> layer_stack_;
+  size_t layer_depth_ = 0u;
   std::unordered_map<int64_t, BackdropData> backdrop_data_;
   // note: cull rects are always in the global coordinate space.
   std::vector<Rect> cull_rect_state_;
+  // The bounds of the current clip intersected with the cull rect, in the
+  // global coordinate space. Unlike the cull rect, this is not used to cull
+  // display lists, so that text frames are collected for every draw that the
+  // canvas may perform.
+  std::vector<Rect> clip_bounds_state_;
   bool has_image_filter_ = false;
   size_t backdrop_count_ = 0;
+  std::optional<OpenBackdropGroup> open_backdrop_group_;
+  std::unordered_set<const flutter::DlImageFilter*> implicit_backdrops_;
+  ImplicitBackdropData implicit_backdrop_data_;
   Paint paint_;
 };
 
@@ -45,6 +45,13 @@ bool DlPlayground::OpenPlaygroundHere(DisplayListPlaygroundCallback callback) {
           wireframe = !wireframe;
           context.GetContentContext().SetWireframe(wireframe);
         }
+        static bool dual_kawase = false;
+        if (ImGui::IsKeyPressed(ImGuiKey_B)) {
+          dual_kawase = !dual_kawase;
+          context.GetContentContext().SetBlurAlgorithm(
+              dual_kawase ? BlurAlgorithm::kDualKawase
+                          : BlurAlgorithm::kGaussian);
+        }
         return RenderToOnscreen(
             context.GetContentContext(),  //
             render_target,                //
@@ -1551,5 +1551,103 @@ TEST_P(DisplayListTest, DrawMaskBlursThatMightUseSaveLayers) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+namespace {
+void DrawBackdropBar(flutter::DisplayListBuilder& builder,
+                     const DlRect& bar,
+                     const flutter::DlImageFilter* filter) {
+  builder.Save();
+  builder.ClipRect(bar);
+  builder.SaveLayer(std::nullopt, nullptr, filter);
+  builder.DrawRect(bar.Expand(-10),
+                   flutter::DlPaint(flutter::DlColor::kBlue()));
+  builder.Restore();
+  builder.Restore();
+}
+
+ImplicitBackdropData CollectImplicitBackdropData(
+    const std::shared_ptr<Context>& context,
+    const sk_sp<flutter::DisplayList>& display_list) {
+  ContentContext content_context(context, nullptr);
+  FirstPassDispatcher collector(content_context, Matrix(),
+                                Rect::MakeLTRB(0, 0, 400, 400));
+  display_list->Dispatch(collector);
+  return collector.TakeImplicitBackdropData();
+}
+}  // namespace
+
+TEST_P(DisplayListTest, SiblingBackdropFiltersShareASnapshot) {
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(10, 10, flutter::DlTileMode::kClamp);
+  flutter::DisplayListBuilder builder;
+  builder.DrawPaint(flutter::DlPaint(flutter::DlColor::kRed()));
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 0, 400, 50), blur.get());
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 350, 400, 400), blur.get());
+
+  ImplicitBackdropData data =
+      CollectImplicitBackdropData(GetContext(), builder.Build());
+  ASSERT_EQ(data.groups.size(), 1u);
+  EXPECT_EQ(data.groups[0].backdrop_count, 2u);
+  EXPECT_EQ(data.groups[0].coverage, Rect::MakeLTRB(0, 0, 400, 400));
+  EXPECT_EQ(data.group_indices.size(), 2u);
+}
+
+TEST_P(DisplayListTest, BackdropFiltersReadingEachOtherDoNotShareASnapshot) {
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(10, 10, flutter::DlTileMode::kClamp);
+  flutter::DisplayListBuilder builder;
+  builder.DrawPaint(flutter::DlPaint(flutter::DlColor::kRed()));
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 0, 400, 50), blur.get());
+  // The blur of the second bar reaches into the first bar.
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 60, 400, 110), blur.get());
+
+  ImplicitBackdropData data =
+      CollectImplicitBackdropData(GetContext(), builder.Build());
+  EXPECT_TRUE(data.groups.empty());
+  EXPECT_TRUE(data.group_indices.empty());
+}
+
+TEST_P(DisplayListTest, BackdropFiltersWithDrawsBetweenDoNotShareASnapshot) {
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(10, 10, flutter::DlTileMode::kClamp);
+  flutter::DisplayListBuilder builder;
+  builder.DrawPaint(flutter::DlPaint(flutter::DlColor::kRed()));
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 0, 400, 50), blur.get());
+  builder.DrawRect(DlRect::MakeLTRB(100, 300, 200, 400),
+                   flutter::DlPaint(flutter::DlColor::kGreen()));
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 350, 400, 400), blur.get());
+
+  ImplicitBackdropData data =
+      CollectImplicitBackdropData(GetContext(), builder.Build());
+  EXPECT_TRUE(data.groups.empty());
+}
+
+TEST_P(DisplayListTest, DifferentBackdropFiltersDoNotShareASnapshot) {
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(10, 10, flutter::DlTileMode::kClamp);
+  auto other_blur =
+      flutter::DlImageFilter::MakeBlur(20, 20, flutter::DlTileMode::kClamp);
+  flutter::DisplayListBuilder builder;
+  builder.DrawPaint(flutter::DlPaint(flutter::DlColor::kRed()));
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 0, 400, 50), blur.get());
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 350, 400, 400),
+                  other_blur.get());
+
+  ImplicitBackdropData data =
+      CollectImplicitBackdropData(GetContext(), builder.Build());
+  EXPECT_TRUE(data.groups.empty());
+}
+
+TEST_P(DisplayListTest, CanDrawSiblingBackdropFiltersWithASharedSnapshot) {
+  auto texture = CreateTextureForFixture("embarcadero.jpg");
+  auto blur =
+      flutter::DlImageFilter::MakeBlur(20, 20, flutter::DlTileMode::kClamp);
+  flutter::DisplayListBuilder builder;
+  builder.DrawImage(DlImageImpeller::Make(texture), SkPoint::Make(0, 0),
+                    flutter::DlImageSampling::kLinear, nullptr);
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 0, 800, 100), blur.get());
+  DrawBackdropBar(builder, DlRect::MakeLTRB(0, 500, 800, 600), blur.get());
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,8 @@
 
 #include "impeller/display_list/image_filter.h"
 
+#include <vector>
+
 #include "flutter/display_list/effects/dl_image_filters.h"
 #include "fml/logging.h"
 #include "impeller/display_list/color_filter.h"
@@ -14,6 +16,25 @@
 
 namespace impeller {
 
+namespace {
+
+/// Appends the filters of a tree of compose filters to `chain` in the order
+/// in which they are applied.
+void FlattenComposeFilter(const flutter::DlImageFilter* filter,
+                          std::vector<const flutter::DlImageFilter*>& chain) {
+  if (!filter) {
+    return;
+  }
+  if (const flutter::DlComposeImageFilter* compose = filter->asCompose()) {
+    FlattenComposeFilter(compose->inner().get(), chain);
+    FlattenComposeFilter(compose->outer().get(), chain);
+    return;
+  }
+  chain.push_back(filter);
+}
+
+}  // namespace
+
 std::shared_ptr<FilterContents> WrapInput(const flutter::DlImageFilter* filter,
                                           const FilterInput::Ref& input) {
   FML_DCHECK(filter);
@@ -87,22 +108,40 @@ std::shared_ptr<FilterContents> WrapInput(const flutter::DlImageFilter* filter,
                                     ColorFilterContents::AbsorbOpacity::kNo);
     }
     case flutter::DlImageFilterType::kCompose: {
-      auto compose = filter->asCompose();
-      FML_DCHECK(compose);
+      // Nested compositions are flattened so that consecutive color filters
+      // are fused into as few passes as possible instead of rendering one
+      // pass each.
+      std::vector<const flutter::DlImageFilter*> chain;
+      FlattenComposeFilter(filter, chain);
+      FML_DCHECK(!chain.empty());
 
-      auto outer_dl_filter = compose->outer();
-      auto inner_dl_filter = compose->inner();
-      if (!outer_dl_filter) {
-        return WrapInput(inner_dl_filter.get(), input);
-      }
-      if (!inner_dl_filter) {
-        return WrapInput(outer_dl_filter.get(), input);
+      FilterInput::Ref chain_input = input;
+      std::shared_ptr<FilterContents> result;
+      std::vector<ColorFilterStage> stages;
+      for (size_t i = 0; i < chain.size(); i++) {
+        const flutter::DlColorFilterImageFilter* color_image_filter =
+            chain[i]->asColorFilter();
+        if (color_image_filter) {
+          FML_DCHECK(color_image_filter->color_filter());
+          stages.push_back(
+              ToColorFilterStage(color_image_filter->color_filter().get()));
+          if (i + 1 < chain.size() && chain[i + 1]->asColorFilter()) {
+            continue;
+          }
+          // As for a single color filter, the snapshot opacity is deferred
+          // until the result of the filter chain is blended with the layer.
+          result = ColorFilterContents::MakeFused(
+              chain_input, stages, ColorFilterContents::AbsorbOpacity::kNo);
+          stages.clear();
+        } else {
+          result = WrapInput(chain[i], chain_input);
+        }
+        if (!result) {
+          return nullptr;
+        }
+        chain_input = FilterInput::Make(result);
       }
-      FML_DCHECK(outer_dl_filter && inner_dl_filter);
-
-      return WrapInput(
-          outer_dl_filter.get(),
-          FilterInput::Make(WrapInput(inner_dl_filter.get(), input)));
+      return result;
     }
     case flutter::DlImageFilterType::kRuntimeEffect: {
       const flutter::DlRuntimeEffectImageFilter* runtime_filter =
@@ -184,22 +184,9 @@ std::shared_ptr<ColorSourceContents> Paint::CreateContents() const {
         TiledTextureContents::ColorFilterProc filter_proc =
             [color_filter = color_filter,
              invert_colors = invert_colors](const FilterInput::Ref& input) {
-              if (invert_colors && color_filter) {
-                std::shared_ptr<FilterContents> color_filter_output =
-                    WrapWithGPUColorFilter(
-                        color_filter, input,
-                        ColorFilterContents::AbsorbOpacity::kNo);
-                return WrapWithInvertColors(
-                    FilterInput::Make(color_filter_output),
-                    ColorFilterContents::AbsorbOpacity::kNo);
-              }
-              if (color_filter) {
-                return WrapWithGPUColorFilter(
-                    color_filter, input,
-                    ColorFilterContents::AbsorbOpacity::kNo);
-              }
-              return WrapWithInvertColors(
-                  input, ColorFilterContents::AbsorbOpacity::kNo);
+              return WrapWithGPUColorFilters(
+                  color_filter, invert_colors, input,
+                  ColorFilterContents::AbsorbOpacity::kNo);
             };
         contents->SetColorFilter(filter_proc);
       }
@@ -324,15 +311,8 @@ std::shared_ptr<Contents> Paint::WithColorFilter(
     return input;
   }
 
-  if (color_filter) {
-    input = WrapWithGPUColorFilter(color_filter, FilterInput::Make(input),
-                                   absorb_opacity);
-  }
-  if (invert_colors) {
-    input = WrapWithInvertColors(FilterInput::Make(input), absorb_opacity);
-  }
-
-  return input;
+  return WrapWithGPUColorFilters(color_filter, invert_colors,
+                                 FilterInput::Make(input), absorb_opacity);
 }
 
 std::shared_ptr<FilterContents> Paint::MaskBlurDescriptor::CreateMaskBlur(
@@ -403,15 +383,10 @@ std::shared_ptr<FilterContents> Paint::MaskBlurDescriptor::CreateMaskBlur(
   std::shared_ptr<Contents> color_contents = color_source_contents;
 
   /// 4. Apply the user set color filter on the GPU, if applicable.
-  if (color_filter) {
-    color_contents =
-        WrapWithGPUColorFilter(color_filter, FilterInput::Make(color_contents),
-                               ColorFilterContents::AbsorbOpacity::kYes);
-  }
-  if (invert_colors) {
-    color_contents =
-        WrapWithInvertColors(FilterInput::Make(color_contents),
-                             ColorFilterContents::AbsorbOpacity::kYes);
+  if (color_filter || invert_colors) {
+    color_contents = WrapWithGPUColorFilters(
+        color_filter, invert_colors, FilterInput::Make(color_contents),
+        ColorFilterContents::AbsorbOpacity::kYes);
   }
 
   /// 5. Composite the color source with the blurred mask.
@@ -5,6 +5,7 @@
 #include "impeller/entity/contents/content_context.h"
 
 #include <memory>
+#include <sstream>
 #include <utility>
 
 #include "fml/trace_event.h"
@@ -303,6 +304,11 @@ ContentContext::ContentContext(
     fast_gradient_pipelines_.CreateDefault(*context_, options);
 
     if (context_->GetCapabilities()->SupportsSSBO()) {
+      glyph_atlas_instanced_pipelines_.CreateDefault(
+          *context_, options,
+          {static_cast<Scalar>(
+              GetContext()->GetCapabilities()->GetDefaultGlyphAtlasFormat() ==
+              PixelFormat::kA8UNormInt)});
       linear_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
       radial_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
       conical_gradient_ssbo_fill_pipelines_.CreateDefault(*context_, options);
@@ -346,10 +352,19 @@ ContentContext::ContentContext(
                                                 options_trianglestrip);
     rrect_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
     texture_strict_src_pipelines_.CreateDefault(*context_, options);
+    glyph_atlas_sdf_pipelines_.CreateDefault(
+        *context_, options,
+        {static_cast<Scalar>(
+            GetContext()->GetCapabilities()->GetDefaultGlyphAtlasFormat() ==
+            PixelFormat::kA8UNormInt)});
     tiled_texture_pipelines_.CreateDefault(*context_, options,
                                            {supports_decal});
     gaussian_blur_pipelines_.CreateDefault(*context_, options_trianglestrip,
                                            {supports_decal});
+    dual_kawase_downsample_pipelines_.CreateDefault(
+        *context_, options_trianglestrip, {supports_decal});
+    dual_kawase_upsample_pipelines_.CreateDefault(
+        *context_, options_trianglestrip, {supports_decal});
     border_mask_blur_pipelines_.CreateDefault(*context_, options_trianglestrip);
     color_matrix_color_filter_pipelines_.CreateDefault(*context_,
                                                        options_trianglestrip);
@@ -454,6 +469,7 @@ ContentContext::ContentContext(
 
   morphology_filter_pipelines_.CreateDefault(*context_, options_trianglestrip,
                                              {supports_decal});
+  fused_color_filter_pipelines_.CreateDefault(*context_, options_trianglestrip);
   linear_to_srgb_filter_pipelines_.CreateDefault(*context_,
                                                  options_trianglestrip);
   srgb_to_linear_filter_pipelines_.CreateDefault(*context_,
@@ -473,6 +489,7 @@ ContentContext::ContentContext(
 
   is_valid_ = true;
   InitializeCommonlyUsedShadersIfNeeded();
+  PrewarmPipelineVariants();
 }
 
 ContentContext::~ContentContext() = default;
@@ -569,6 +586,16 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetBlurAlgorithm(BlurAlgorithm algorithm,
+                                      BlurQuality quality) {
+  blur_algorithm_ = algorithm;
+  blur_quality_ = quality;
+}
+
+void ContentContext::SetComputeTessellationEnabled(bool enabled) {
+  compute_tessellation_enabled_ = enabled;
+}
+
 std::shared_ptr<Pipeline<PipelineDescriptor>>
 ContentContext::GetCachedRuntimeEffectPipeline(
     const std::string& unique_entrypoint_name,
@@ -595,6 +622,139 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+template <class Visitor>
+void ContentContext::ForEachVariants(Visitor&& visitor) const {
+  visitor(solid_fill_pipelines_);
+  visitor(fast_gradient_pipelines_);
+  visitor(linear_gradient_fill_pipelines_);
+  visitor(radial_gradient_fill_pipelines_);
+  visitor(conical_gradient_fill_pipelines_);
+  visitor(sweep_gradient_fill_pipelines_);
+  visitor(linear_gradient_uniform_fill_pipelines_);
+  visitor(radial_gradient_uniform_fill_pipelines_);
+  visitor(conical_gradient_uniform_fill_pipelines_);
+  visitor(sweep_gradient_uniform_fill_pipelines_);
+  visitor(linear_gradient_ssbo_fill_pipelines_);
+  visitor(radial_gradient_ssbo_fill_pipelines_);
+  visitor(conical_gradient_ssbo_fill_pipelines_);
+  visitor(sweep_gradient_ssbo_fill_pipelines_);
+  visitor(rrect_blur_pipelines_);
+  visitor(texture_pipelines_);
+  visitor(texture_downsample_pipelines_);
+  visitor(texture_strict_src_pipelines_);
+  visitor(tiled_texture_pipelines_);
+  visitor(gaussian_blur_pipelines_);
+  visitor(dual_kawase_downsample_pipelines_);
+  visitor(dual_kawase_upsample_pipelines_);
+  visitor(border_mask_blur_pipelines_);
+  visitor(morphology_filter_pipelines_);
+  visitor(color_matrix_color_filter_pipelines_);
+  visitor(fused_color_filter_pipelines_);
+  visitor(linear_to_srgb_filter_pipelines_);
+  visitor(srgb_to_linear_filter_pipelines_);
+  visitor(clip_pipelines_);
+  visitor(glyph_atlas_pipelines_);
+  visitor(glyph_atlas_sdf_pipelines_);
+  visitor(glyph_atlas_instanced_pipelines_);
+  visitor(yuv_to_rgb_filter_pipelines_);
+  visitor(porter_duff_blend_pipelines_);
+  visitor(blend_color_pipelines_);
+  visitor(blend_colorburn_pipelines_);
+  visitor(blend_colordodge_pipelines_);
+  visitor(blend_darken_pipelines_);
+  visitor(blend_difference_pipelines_);
+  visitor(blend_exclusion_pipelines_);
+  visitor(blend_hardlight_pipelines_);
+  visitor(blend_hue_pipelines_);
+  visitor(blend_lighten_pipelines_);
+  visitor(blend_luminosity_pipelines_);
+  visitor(blend_multiply_pipelines_);
+  visitor(blend_overlay_pipelines_);
+  visitor(blend_saturation_pipelines_);
+  visitor(blend_screen_pipelines_);
+  visitor(blend_softlight_pipelines_);
+  visitor(framebuffer_blend_color_pipelines_);
+  visitor(framebuffer_blend_colorburn_pipelines_);
+  visitor(framebuffer_blend_colordodge_pipelines_);
+  visitor(framebuffer_blend_darken_pipelines_);
+  visitor(framebuffer_blend_difference_pipelines_);
+  visitor(framebuffer_blend_exclusion_pipelines_);
+  visitor(framebuffer_blend_hardlight_pipelines_);
+  visitor(framebuffer_blend_hue_pipelines_);
+  visitor(framebuffer_blend_lighten_pipelines_);
+  visitor(framebuffer_blend_luminosity_pipelines_);
+  visitor(framebuffer_blend_multiply_pipelines_);
+  visitor(framebuffer_blend_overlay_pipelines_);
+  visitor(framebuffer_blend_saturation_pipelines_);
+  visitor(framebuffer_blend_screen_pipelines_);
+  visitor(framebuffer_blend_softlight_pipelines_);
+  visitor(vertices_uber_shader_);
+#ifdef IMPELLER_ENABLE_OPENGLES
+  visitor(tiled_texture_external_pipelines_);
+  visitor(texture_downsample_gles_pipelines_);
+#endif  // IMPELLER_ENABLE_OPENGLES
+}
+
+void ContentContext::PrewarmPipelineVariants() {
+  std::shared_ptr<const fml::Mapping> persisted_manifest =
+      GetContext()->GetPipelineLibrary()->GetPersistedPipelineVariantManifest();
+  if (!persisted_manifest) {
+    return;
+  }
+  std::optional<PipelineVariantManifest> manifest =
+      PipelineVariantManifest::Parse(*persisted_manifest);
+  if (!manifest.has_value()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PrewarmPipelineVariants");
+
+  std::unordered_map<std::string_view, std::vector<uint64_t>> keys_by_name;
+  for (const auto& entry : manifest->GetEntries()) {
+    keys_by_name[entry.pipeline_name].push_back(entry.options_key);
+  }
+
+  ForEachVariants([&](auto& container) {
+    if (container.GetName().empty()) {
+      return;
+    }
+    auto found = keys_by_name.find(container.GetName());
+    if (found == keys_by_name.end()) {
+      return;
+    }
+    for (uint64_t key : found->second) {
+      ContentContextOptions opts = ContentContextOptions::FromKey(key);
+      // Disregard keys that could not have been produced by this version.
+      if (opts.ToKey() != key ||
+          opts.blend_mode > Entity::kLastPipelineBlendMode) {
+        continue;
+      }
+      PrewarmVariant(container, opts);
+      // Carry the variant over so the next session prewarms it too.
+      variant_manifest_.Record(container.GetName(), key);
+    }
+  });
+}
+
+void ContentContext::RecordPipelineVariant(
+    const std::string& pipeline_name,
+    const ContentContextOptions& opts) const {
+  if (pipeline_name.empty() ||
+      !variant_manifest_.Record(pipeline_name, opts.ToKey())) {
+    return;
+  }
+  GetContext()->GetPipelineLibrary()->SetPipelineVariantManifest(
+      variant_manifest_.Serialize());
+}
+
+std::string ContentContext::GetVariantsName(const PipelineDescriptor& desc) {
+  std::stringstream stream;
+  stream << desc.GetLabel();
+  for (Scalar constant : desc.GetSpecializationConstants()) {
+    stream << " " << constant;
+  }
+  return stream.str();
+}
+
 void ContentContext::InitializeCommonlyUsedShadersIfNeeded() const {
   TRACE_EVENT0("flutter", "InitializeCommonlyUsedShadersIfNeeded");
   GetContext()->InitializeCommonlyUsedShadersIfNeeded();
@@ -15,10 +15,12 @@
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/typographer_context.h"
@@ -28,13 +30,19 @@
 #include "impeller/entity/clip.vert.h"
 #include "impeller/entity/color_matrix_color_filter.frag.h"
 #include "impeller/entity/conical_gradient_fill.frag.h"
+#include "impeller/entity/dual_kawase_downsample.frag.h"
+#include "impeller/entity/dual_kawase_upsample.frag.h"
 #include "impeller/entity/fast_gradient.frag.h"
 #include "impeller/entity/fast_gradient.vert.h"
 #include "impeller/entity/filter_position.vert.h"
 #include "impeller/entity/filter_position_uv.vert.h"
+#include "impeller/entity/fused_color_filter.frag.h"
 #include "impeller/entity/gaussian.frag.h"
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
+#include "impeller/entity/glyph_atlas_instanced.vert.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.vert.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -136,6 +144,12 @@ using TiledTexturePipeline =
                          TiledTextureFillFragmentShader>;
 using GaussianBlurPipeline =
     RenderPipelineHandle<FilterPositionUvVertexShader, GaussianFragmentShader>;
+using DualKawaseDownsamplePipeline =
+    RenderPipelineHandle<FilterPositionUvVertexShader,
+                         DualKawaseDownsampleFragmentShader>;
+using DualKawaseUpsamplePipeline =
+    RenderPipelineHandle<FilterPositionUvVertexShader,
+                         DualKawaseUpsampleFragmentShader>;
 using BorderMaskBlurPipeline =
     RenderPipelineHandle<FilterPositionUvVertexShader,
                          BorderMaskBlurFragmentShader>;
@@ -145,6 +159,9 @@ using MorphologyFilterPipeline =
 using ColorMatrixColorFilterPipeline =
     RenderPipelineHandle<FilterPositionVertexShader,
                          ColorMatrixColorFilterFragmentShader>;
+using FusedColorFilterPipeline =
+    RenderPipelineHandle<FilterPositionVertexShader,
+                         FusedColorFilterFragmentShader>;
 using LinearToSrgbFilterPipeline =
     RenderPipelineHandle<FilterPositionVertexShader,
                          LinearToSrgbFilterFragmentShader>;
@@ -157,6 +174,12 @@ using YUVToRGBFilterPipeline =
 
 using GlyphAtlasPipeline =
     RenderPipelineHandle<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineHandle<GlyphAtlasSdfVertexShader,
+                         GlyphAtlasSdfFragmentShader>;
+using GlyphAtlasInstancedPipeline =
+    RenderPipelineHandle<GlyphAtlasInstancedVertexShader,
+                         GlyphAtlasFragmentShader>;
 
 using PorterDuffBlendPipeline =
     RenderPipelineHandle<PorterDuffBlendVertexShader,
@@ -262,6 +285,28 @@ using TextureDownsampleGlesPipeline =
                          TextureDownsampleGlesFragmentShader>;
 #endif  // IMPELLER_ENABLE_OPENGLES
 
+/// The algorithm used to render Gaussian blurs with large sigmas.
+enum class BlurAlgorithm {
+  /// Two separable Gaussian passes over a downsampled copy of the input.
+  kGaussian,
+  /// A chain of dual filter (dual Kawase) passes that halve and then double
+  /// the size of the input. Approximates the Gaussian at a fraction of the
+  /// texture reads for large sigmas.
+  kDualKawase,
+};
+
+/// How many levels of a dual filter blur are rendered by its own passes rather
+/// than by the initial downsample. Starting from a smaller copy of the input
+/// is cheaper, but moving content shimmers more.
+enum class BlurQuality {
+  /// Up to four levels of dual filter passes.
+  kHigh,
+  /// Up to three levels of dual filter passes.
+  kMedium,
+  /// Two levels of dual filter passes.
+  kLow,
+};
+
 /// Pipeline state configuration.
 ///
 /// Each unique combination of these options requires a different pipeline state
@@ -358,6 +403,23 @@ struct ContentContextOptions {
            static_cast<uint64_t>(sample_count) << 48;
   }
 
+  /// The inverse of `ToKey`.
+  static constexpr ContentContextOptions FromKey(uint64_t key) {
+    return ContentContextOptions{
+        .sample_count = static_cast<SampleCount>((key >> 48) & 0xff),
+        .blend_mode = static_cast<BlendMode>((key >> 40) & 0xff),
+        .depth_compare = static_cast<CompareFunction>((key >> 32) & 0xff),
+        .stencil_mode = static_cast<StencilMode>((key >> 24) & 0xff),
+        .primitive_type = static_cast<PrimitiveType>((key >> 16) & 0xff),
+        .color_attachment_pixel_format =
+            static_cast<PixelFormat>((key >> 8) & 0xff),
+        .has_depth_stencil_attachments = ((key >> 2) & 1) != 0,
+        .depth_write_enabled = ((key >> 3) & 1) != 0,
+        .wireframe = ((key >> 1) & 1) != 0,
+        .is_for_rrect_blur_clear = (key & 1) != 0,
+    };
+  }
+
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
@@ -490,6 +552,16 @@ class ContentContext {
     return GetPipeline(gaussian_blur_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetDualKawaseDownsamplePipeline(ContentContextOptions opts) const {
+    return GetPipeline(dual_kawase_downsample_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetDualKawaseUpsamplePipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(dual_kawase_upsample_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBorderMaskBlurPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(border_mask_blur_pipelines_, opts);
@@ -505,6 +577,11 @@ class ContentContext {
     return GetPipeline(color_matrix_color_filter_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetFusedColorFilterPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(fused_color_filter_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetLinearToSrgbFilterPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(linear_to_srgb_filter_pipelines_, opts);
@@ -525,6 +602,17 @@ class ContentContext {
     return GetPipeline(glyph_atlas_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetGlyphAtlasInstancedPipeline(ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsSSBO());
+    return GetPipeline(glyph_atlas_instanced_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetYUVToRGBFilterPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(yuv_to_rgb_filter_pipelines_, opts);
@@ -723,6 +811,23 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  /// @brief  Selects the algorithm used for Gaussian blurs with large sigmas.
+  ///         The quality only applies to |BlurAlgorithm::kDualKawase|.
+  void SetBlurAlgorithm(BlurAlgorithm algorithm,
+                        BlurQuality quality = BlurQuality::kHigh);
+
+  BlurAlgorithm GetBlurAlgorithm() const { return blur_algorithm_; }
+
+  BlurQuality GetBlurQuality() const { return blur_quality_; }
+
+  /// @brief  Whether complex paths may be tessellated with compute shaders.
+  ///         Off by default, as each such path is submitted separately.
+  void SetComputeTessellationEnabled(bool enabled);
+
+  bool IsComputeTessellationEnabled() const {
+    return compute_tessellation_enabled_;
+  }
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -848,6 +953,10 @@ class ContentContext {
     void SetDefault(const ContentContextOptions& options,
                     std::unique_ptr<PipelineHandleT> pipeline) {
       default_options_ = options;
+      if (std::optional<PipelineDescriptor> desc = pipeline->GetDescriptor();
+          desc.has_value()) {
+        name_ = GetVariantsName(desc.value());
+      }
       Set(options, std::move(pipeline));
     }
 
@@ -883,8 +992,13 @@ class ContentContext {
 
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
+    /// A name for this family of pipelines that is stable between launches.
+    /// Used to record variants in the `PipelineVariantManifest`.
+    const std::string& GetName() const { return name_; }
+
    private:
     std::optional<ContentContextOptions> default_options_;
+    std::string name_;
     std::vector<std::pair<uint64_t, std::unique_ptr<PipelineHandleT>>>
         pipelines_;
 
@@ -932,14 +1046,21 @@ class ContentContext {
 #endif  // IMPELLER_ENABLE_OPENGLES
   mutable Variants<TiledTexturePipeline> tiled_texture_pipelines_;
   mutable Variants<GaussianBlurPipeline> gaussian_blur_pipelines_;
+  mutable Variants<DualKawaseDownsamplePipeline>
+      dual_kawase_downsample_pipelines_;
+  mutable Variants<DualKawaseUpsamplePipeline> dual_kawase_upsample_pipelines_;
   mutable Variants<BorderMaskBlurPipeline> border_mask_blur_pipelines_;
   mutable Variants<MorphologyFilterPipeline> morphology_filter_pipelines_;
   mutable Variants<ColorMatrixColorFilterPipeline>
       color_matrix_color_filter_pipelines_;
+  mutable Variants<FusedColorFilterPipeline> fused_color_filter_pipelines_;
   mutable Variants<LinearToSrgbFilterPipeline> linear_to_srgb_filter_pipelines_;
   mutable Variants<SrgbToLinearFilterPipeline> srgb_to_linear_filter_pipelines_;
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
+  mutable Variants<GlyphAtlasInstancedPipeline>
+      glyph_atlas_instanced_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
   // Advanced blends.
@@ -1039,15 +1160,57 @@ class ContentContext {
     std::unique_ptr<RenderPipelineHandleT> variant =
         std::make_unique<RenderPipelineHandleT>(std::move(variant_future));
     container.Set(opts, std::move(variant));
+    RecordPipelineVariant(container.GetName(), opts);
     return container.Get(opts);
   }
 
+  /// Start creating a variant recorded by a previous session on a
+  /// background thread without waiting on any pipeline.
+  template <class RenderPipelineHandleT>
+  void PrewarmVariant(Variants<RenderPipelineHandleT>& container,
+                      ContentContextOptions opts) const {
+    if (container.Get(opts)) {
+      return;
+    }
+    RenderPipelineHandleT* default_handle = container.GetDefault();
+    if (!default_handle) {
+      return;
+    }
+    std::optional<PipelineDescriptor> desc = default_handle->GetDescriptor();
+    if (!desc.has_value()) {
+      return;
+    }
+    opts.ApplyToPipelineDescriptor(desc.value());
+    desc->SetLabel(SPrintF("%s V#%zu", desc->GetLabel().data(),
+                           container.GetPipelineCount()));
+    container.Set(opts, std::make_unique<RenderPipelineHandleT>(
+                            GetContext()->GetPipelineLibrary()->GetPipeline(
+                                desc, /*async=*/true)));
+  }
+
+  /// Invokes the visitor with every `Variants` member.
+  template <class Visitor>
+  void ForEachVariants(Visitor&& visitor) const;
+
+  /// Create the pipeline variants recorded in the manifest persisted by the
+  /// previous session so they are ready before first use.
+  void PrewarmPipelineVariants();
+
+  void RecordPipelineVariant(const std::string& pipeline_name,
+                             const ContentContextOptions& opts) const;
+
+  static std::string GetVariantsName(const PipelineDescriptor& desc);
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
+  mutable PipelineVariantManifest variant_manifest_;
   bool wireframe_ = false;
+  BlurAlgorithm blur_algorithm_ = BlurAlgorithm::kGaussian;
+  BlurQuality blur_quality_ = BlurQuality::kHigh;
+  bool compute_tessellation_enabled_ = false;
 
   ContentContext(const ContentContext&) = delete;
 
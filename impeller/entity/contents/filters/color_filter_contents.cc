@@ -6,9 +6,11 @@
 
 #include <utility>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_matrix_filter_contents.h"
+#include "impeller/entity/contents/filters/fused_color_filter_contents.h"
 #include "impeller/entity/contents/filters/linear_to_srgb_filter_contents.h"
 #include "impeller/entity/contents/filters/srgb_to_linear_filter_contents.h"
 
@@ -78,6 +80,51 @@ ColorFilterContents::MakeSrgbToLinearFilter(FilterInput::Ref input) {
   return filter;
 }
 
+std::shared_ptr<ColorFilterContents> ColorFilterContents::MakeFused(
+    FilterInput::Ref input,
+    const std::vector<ColorFilterStage>& stages,
+    AbsorbOpacity absorb_opacity) {
+  std::vector<std::vector<ColorFilterStage>> passes =
+      PlanColorFilterPasses(stages);
+  FML_TRACE_EVENT("impeller", "ColorFilterContents::MakeFused", "stages",
+                  stages.size(), "passes", passes.size());
+
+  std::shared_ptr<ColorFilterContents> filter;
+  for (const std::vector<ColorFilterStage>& pass : passes) {
+    if (filter) {
+      input =
+          FilterInput::Make(std::static_pointer_cast<FilterContents>(filter));
+    }
+    if (pass.size() > 1) {
+      auto fused = std::make_shared<FusedColorFilterContents>();
+      fused->SetInputs({input});
+      fused->SetStages(pass);
+      filter = std::move(fused);
+    } else {
+      const ColorFilterStage& stage = pass.front();
+      switch (stage.type) {
+        case ColorFilterStage::Type::kColorMatrix:
+          filter = MakeColorMatrix(input, stage.color_matrix);
+          break;
+        case ColorFilterStage::Type::kSrgbToLinear:
+          filter = MakeSrgbToLinearFilter(input);
+          break;
+        case ColorFilterStage::Type::kLinearToSrgb:
+          filter = MakeLinearToSrgbFilter(input);
+          break;
+        case ColorFilterStage::Type::kBlend:
+          filter = MakeBlend(stage.blend_mode, {input}, stage.color);
+          break;
+      }
+      if (!filter) {
+        return nullptr;
+      }
+    }
+    filter->SetAbsorbOpacity(absorb_opacity);
+  }
+  return filter;
+}
+
 ColorFilterContents::ColorFilterContents() = default;
 
 ColorFilterContents::~ColorFilterContents() = default;
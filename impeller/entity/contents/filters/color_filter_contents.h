@@ -5,10 +5,31 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_COLOR_FILTER_CONTENTS_H_
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_COLOR_FILTER_CONTENTS_H_
 
+#include <vector>
+
 #include "impeller/entity/contents/filters/filter_contents.h"
 
 namespace impeller {
 
+/// A per-pixel color filter that can be chained with others by
+/// |ColorFilterContents::MakeFused|.
+struct ColorFilterStage {
+  enum class Type {
+    kColorMatrix,
+    kSrgbToLinear,
+    kLinearToSrgb,
+    kBlend,
+  };
+
+  Type type = Type::kColorMatrix;
+  /// The matrix applied by a |Type::kColorMatrix| stage.
+  ColorMatrix color_matrix = {};
+  /// The mode and unpremultiplied source color of a |Type::kBlend| stage. The
+  /// filtered color is the destination.
+  BlendMode blend_mode = BlendMode::kSourceOver;
+  Color color;
+};
+
 class ColorFilterContents : public FilterContents {
  public:
   enum class AbsorbOpacity {
@@ -32,6 +53,14 @@ class ColorFilterContents : public FilterContents {
   static std::shared_ptr<ColorFilterContents> MakeSrgbToLinearFilter(
       FilterInput::Ref input);
 
+  /// @brief  Applies the `stages` to `input` in order, using as few passes as
+  ///         possible. Returns the filter for the last pass, or nullptr if a
+  ///         stage is invalid.
+  static std::shared_ptr<ColorFilterContents> MakeFused(
+      FilterInput::Ref input,
+      const std::vector<ColorFilterStage>& stages,
+      AbsorbOpacity absorb_opacity);
+
   ColorFilterContents();
 
   ~ColorFilterContents() override;
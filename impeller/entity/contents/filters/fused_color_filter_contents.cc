@@ -0,0 +1,250 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/fused_color_filter_contents.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+#include "impeller/entity/contents/anonymous_contents.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/contents/filters/blend_filter_contents.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+namespace {
+
+// Must match the stage constants in fused_color_filter.frag.
+constexpr size_t kStageDataSize = 5u;
+
+Scalar GetStageTypeValue(ColorFilterStage::Type type) {
+  switch (type) {
+    case ColorFilterStage::Type::kColorMatrix:
+      return 0.0f;
+    case ColorFilterStage::Type::kSrgbToLinear:
+      return 1.0f;
+    case ColorFilterStage::Type::kLinearToSrgb:
+      return 2.0f;
+    case ColorFilterStage::Type::kBlend:
+      return 3.0f;
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace
+
+std::optional<ColorMatrix> ComposeColorMatrices(const ColorMatrix& first,
+                                                const ColorMatrix& second) {
+  const Scalar* a = first.array;
+  const Scalar* b = second.array;
+
+  // Between two separate filters the color is clamped, premultiplied and
+  // unpremultiplied again. That is a no-op when the first matrix keeps alpha
+  // as is and maps every unpremultiplied color into the unit range, and the
+  // second matrix keeps transparent colors transparent.
+  if (a[15] != 0 || a[16] != 0 || a[17] != 0 || a[18] != 1 || a[19] != 0) {
+    return std::nullopt;
+  }
+  if (b[15] != 0 || b[16] != 0 || b[17] != 0 || b[19] != 0) {
+    return std::nullopt;
+  }
+  for (size_t row = 0; row < 3; row++) {
+    const Scalar* m = a + row * 5;
+    Scalar min = m[4];
+    Scalar max = m[4];
+    for (size_t column = 0; column < 4; column++) {
+      min += std::min(0.0f, m[column]);
+      max += std::max(0.0f, m[column]);
+    }
+    if (min < -kEhCloseEnough || max > 1.0f + kEhCloseEnough) {
+      return std::nullopt;
+    }
+  }
+
+  ColorMatrix result;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? b[row * 5 + 4] : 0.0f;
+      for (size_t k = 0; k < 4; k++) {
+        value += b[row * 5 + k] * a[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
+bool CanFuseColorFilterStage(const ColorFilterStage& stage) {
+  return stage.type != ColorFilterStage::Type::kBlend ||
+         stage.blend_mode <= Entity::kLastPipelineBlendMode;
+}
+
+std::vector<std::vector<ColorFilterStage>> PlanColorFilterPasses(
+    const std::vector<ColorFilterStage>& stages) {
+  std::vector<ColorFilterStage> composed;
+  composed.reserve(stages.size());
+  for (const ColorFilterStage& stage : stages) {
+    if (stage.type == ColorFilterStage::Type::kColorMatrix &&
+        !composed.empty() &&
+        composed.back().type == ColorFilterStage::Type::kColorMatrix) {
+      std::optional<ColorMatrix> matrix = ComposeColorMatrices(
+          composed.back().color_matrix, stage.color_matrix);
+      if (matrix.has_value()) {
+        composed.back().color_matrix = matrix.value();
+        continue;
+      }
+    }
+    composed.push_back(stage);
+  }
+
+  std::vector<std::vector<ColorFilterStage>> passes;
+  bool last_pass_fusable = false;
+  for (const ColorFilterStage& stage : composed) {
+    bool fusable = CanFuseColorFilterStage(stage);
+    if (fusable && last_pass_fusable &&
+        passes.back().size() < FusedColorFilterContents::kMaxStages) {
+      passes.back().push_back(stage);
+      continue;
+    }
+    passes.push_back({stage});
+    last_pass_fusable = fusable;
+  }
+  return passes;
+}
+
+FusedColorFilterContents::FusedColorFilterContents() = default;
+
+FusedColorFilterContents::~FusedColorFilterContents() = default;
+
+void FusedColorFilterContents::SetStages(std::vector<ColorFilterStage> stages) {
+  FML_DCHECK(stages.size() <= kMaxStages);
+  stages_ = std::move(stages);
+}
+
+std::optional<Entity> FusedColorFilterContents::RenderFilter(
+    const FilterInput::Vector& inputs,
+    const ContentContext& renderer,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& coverage,
+    const std::optional<Rect>& coverage_hint) const {
+  using VS = FusedColorFilterPipeline::VertexShader;
+  using FS = FusedColorFilterPipeline::FragmentShader;
+
+  //----------------------------------------------------------------------------
+  /// Handle inputs.
+  ///
+
+  if (inputs.empty() || stages_.empty()) {
+    return std::nullopt;
+  }
+
+  auto input_snapshot =
+      inputs[0]->GetSnapshot("FusedColorFilter", renderer, entity);
+  if (!input_snapshot.has_value()) {
+    return std::nullopt;
+  }
+
+  FS::FragInfo frag_info;
+  std::array<Scalar, kMaxStages> stage_types = {};
+  frag_info.stage_count = static_cast<Scalar>(stages_.size());
+  for (size_t i = 0; i < stages_.size(); i++) {
+    const ColorFilterStage& stage = stages_[i];
+    stage_types[i] = GetStageTypeValue(stage.type);
+    Vector4* data = &frag_info.stage_data[i * kStageDataSize];
+    switch (stage.type) {
+      case ColorFilterStage::Type::kColorMatrix: {
+        const Scalar* m = stage.color_matrix.array;
+        for (size_t column = 0; column < 5; column++) {
+          data[column] = Vector4(m[column], m[5 + column], m[10 + column],
+                                 m[15 + column]);
+        }
+        break;
+      }
+      case ColorFilterStage::Type::kSrgbToLinear:
+      case ColorFilterStage::Type::kLinearToSrgb:
+        break;
+      case ColorFilterStage::Type::kBlend: {
+        Color src = stage.color.Premultiply();
+        const auto& coefficients =
+            kPorterDuffCoefficients[static_cast<int>(stage.blend_mode)];
+        data[0] = Vector4(src.red, src.green, src.blue, src.alpha);
+        data[1] = Vector4(coefficients[0], coefficients[1], coefficients[2],
+                          coefficients[3]);
+        data[2] = Vector4(coefficients[4], 0, 0, 0);
+        break;
+      }
+    }
+  }
+  frag_info.stage_types =
+      Vector4(stage_types[0], stage_types[1], stage_types[2], stage_types[3]);
+
+  //----------------------------------------------------------------------------
+  /// Create AnonymousContents for rendering.
+  ///
+  RenderProc render_proc = [input_snapshot, frag_info,
+                            absorb_opacity = GetAbsorbOpacity(),
+                            alpha = GetAlpha()](const ContentContext& renderer,
+                                                const Entity& entity,
+                                                RenderPass& pass) -> bool {
+    pass.SetCommandLabel("Fused Color Filter");
+
+    auto options = OptionsFromPassAndEntity(pass, entity);
+    options.primitive_type = PrimitiveType::kTriangleStrip;
+    pass.SetPipeline(renderer.GetFusedColorFilterPipeline(options));
+
+    auto size = input_snapshot->texture->GetSize();
+
+    std::array<VS::PerVertexData, 4> vertices = {
+        VS::PerVertexData{Point(0, 0)},
+        VS::PerVertexData{Point(1, 0)},
+        VS::PerVertexData{Point(0, 1)},
+        VS::PerVertexData{Point(1, 1)},
+    };
+    auto& host_buffer = renderer.GetTransientsBuffer();
+    pass.SetVertexBuffer(CreateVertexBuffer(vertices, host_buffer));
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = Entity::GetShaderTransform(
+        entity.GetShaderClipDepth(), pass,
+        entity.GetTransform() * input_snapshot->transform *
+            Matrix::MakeScale(Vector2(size)));
+    frame_info.texture_sampler_y_coord_scale =
+        input_snapshot->texture->GetYCoordScale();
+
+    FS::FragInfo pass_frag_info = frag_info;
+    pass_frag_info.input_alpha =
+        absorb_opacity == ColorFilterContents::AbsorbOpacity::kYes
+            ? input_snapshot->opacity * alpha.value_or(1.0)
+            : 1.0f;
+    const std::unique_ptr<const Sampler>& sampler =
+        renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
+    FS::BindInputTexture(pass, input_snapshot->texture, sampler);
+    FS::BindFragInfo(pass, host_buffer.EmplaceUniform(pass_frag_info));
+
+    VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+
+    return pass.Draw().ok();
+  };
+
+  CoverageProc coverage_proc =
+      [coverage](const Entity& entity) -> std::optional<Rect> {
+    return coverage.TransformBounds(entity.GetTransform());
+  };
+
+  auto contents = AnonymousContents::Make(render_proc, coverage_proc);
+
+  Entity sub_entity;
+  sub_entity.SetContents(std::move(contents));
+  sub_entity.SetBlendMode(entity.GetBlendMode());
+  return sub_entity;
+}
+
+}  // namespace impeller
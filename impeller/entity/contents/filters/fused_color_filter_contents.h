@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_FUSED_COLOR_FILTER_CONTENTS_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_FUSED_COLOR_FILTER_CONTENTS_H_
+
+#include <optional>
+#include <vector>
+
+#include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/inputs/filter_input.h"
+
+namespace impeller {
+
+/// @brief  Returns a single matrix equivalent to applying `first` and then
+///         `second` as separate filters, or std::nullopt if the clamp and
+///         premultiplication between the two would change the result.
+std::optional<ColorMatrix> ComposeColorMatrices(const ColorMatrix& first,
+                                                const ColorMatrix& second);
+
+/// @brief  Whether the stage can share a pass with other stages. Advanced
+///         blends need their own pipeline and always get a separate pass.
+bool CanFuseColorFilterStage(const ColorFilterStage& stage);
+
+/// @brief  Splits a chain of color filter stages into the passes used to
+///         render it. Adjacent color matrices are composed where exact and
+///         runs of fusable stages share a pass of at most
+///         |FusedColorFilterContents::kMaxStages| stages.
+std::vector<std::vector<ColorFilterStage>> PlanColorFilterPasses(
+    const std::vector<ColorFilterStage>& stages);
+
+/// Applies up to |kMaxStages| color filter stages in a single pass.
+class FusedColorFilterContents final : public ColorFilterContents {
+ public:
+  /// Must match kMaxStages in fused_color_filter.frag.
+  static constexpr size_t kMaxStages = 4u;
+
+  FusedColorFilterContents();
+
+  ~FusedColorFilterContents() override;
+
+  void SetStages(std::vector<ColorFilterStage> stages);
+
+ private:
+  // |FilterContents|
+  std::optional<Entity> RenderFilter(
+      const FilterInput::Vector& input_textures,
+      const ContentContext& renderer,
+      const Entity& entity,
+      const Matrix& effect_transform,
+      const Rect& coverage,
+      const std::optional<Rect>& coverage_hint) const override;
+
+  std::vector<ColorFilterStage> stages_;
+
+  FusedColorFilterContents(const FusedColorFilterContents&) = delete;
+
+  FusedColorFilterContents& operator=(const FusedColorFilterContents&) =
+      delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_FUSED_COLOR_FILTER_CONTENTS_H_
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "impeller/entity/contents/filters/fused_color_filter_contents.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/geometry_asserts.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+// clang-format off
+constexpr ColorMatrix kGrayscale = {
+  .array = {
+    0.2126, 0.7152, 0.0722, 0, 0, //
+    0.2126, 0.7152, 0.0722, 0, 0, //
+    0.2126, 0.7152, 0.0722, 0, 0, //
+    0,      0,      0,      1, 0  //
+  }
+};
+
+constexpr ColorMatrix kTintAndFade = {
+  .array = {
+    0.5, 0,   0,   0,   0.25, //
+    0,   0.8, 0,   0,   0,    //
+    0,   0,   1.2, 0,   0.1,  //
+    0,   0,   0,   0.5, 0     //
+  }
+};
+
+constexpr ColorMatrix kBrighten = {
+  .array = {
+    1, 0, 0, 0, 0.5, //
+    0, 1, 0, 0, 0.5, //
+    0, 0, 1, 0, 0.5, //
+    0, 0, 0, 1, 0    //
+  }
+};
+
+constexpr ColorMatrix kInvertColors = {
+  .array = {
+    -1.0,    0,    0, 1.0, 0, //
+       0, -1.0,    0, 1.0, 0, //
+       0,    0, -1.0, 1.0, 0, //
+     1.0,  1.0,  1.0, 1.0, 0  //
+  }
+};
+// clang-format on
+
+ColorFilterStage MatrixStage(const ColorMatrix& matrix) {
+  return ColorFilterStage{.type = ColorFilterStage::Type::kColorMatrix,
+                          .color_matrix = matrix};
+}
+
+ColorFilterStage BlendStage(BlendMode blend_mode) {
+  return ColorFilterStage{.type = ColorFilterStage::Type::kBlend,
+                          .blend_mode = blend_mode,
+                          .color = Color::Red()};
+}
+
+std::vector<size_t> PassSizes(
+    const std::vector<std::vector<ColorFilterStage>>& passes) {
+  std::vector<size_t> sizes;
+  for (const auto& pass : passes) {
+    sizes.push_back(pass.size());
+  }
+  return sizes;
+}
+
+}  // namespace
+
+TEST(FusedColorFilterContentsTest, ComposedMatrixMatchesSeparateFilters) {
+  std::optional<ColorMatrix> composed =
+      ComposeColorMatrices(kGrayscale, kTintAndFade);
+  ASSERT_TRUE(composed.has_value());
+
+  std::vector<Color> colors = {
+      Color(1, 0, 0, 1),
+      Color(0.2, 0.4, 0.6, 0.8),
+      Color(1, 1, 1, 0.5),
+      Color(0, 0, 0, 1),
+  };
+  for (const Color& color : colors) {
+    Color expected =
+        color.ApplyColorMatrix(kGrayscale).ApplyColorMatrix(kTintAndFade);
+    EXPECT_COLOR_NEAR(color.ApplyColorMatrix(composed.value()), expected);
+  }
+}
+
+TEST(FusedColorFilterContentsTest, DoesNotComposeWhenIntermediateIsClamped) {
+  EXPECT_FALSE(ComposeColorMatrices(kBrighten, kGrayscale).has_value());
+  EXPECT_FALSE(ComposeColorMatrices(kInvertColors, kGrayscale).has_value());
+}
+
+TEST(FusedColorFilterContentsTest, DoesNotComposeWhenAlphaChanges) {
+  EXPECT_FALSE(ComposeColorMatrices(kTintAndFade, kGrayscale).has_value());
+  // Inversion derives alpha from the color channels.
+  EXPECT_FALSE(ComposeColorMatrices(kGrayscale, kInvertColors).has_value());
+}
+
+TEST(FusedColorFilterContentsTest, PlanComposesAdjacentMatrices) {
+  auto passes = PlanColorFilterPasses(
+      {MatrixStage(kGrayscale), MatrixStage(kGrayscale),
+       MatrixStage(kTintAndFade)});
+
+  ASSERT_EQ(passes.size(), 1u);
+  ASSERT_EQ(passes[0].size(), 1u);
+  EXPECT_EQ(passes[0][0].type, ColorFilterStage::Type::kColorMatrix);
+}
+
+TEST(FusedColorFilterContentsTest, PlanFusesUpToMaxStagesPerPass) {
+  auto passes = PlanColorFilterPasses({
+      {.type = ColorFilterStage::Type::kSrgbToLinear},
+      MatrixStage(kGrayscale),
+      MatrixStage(kInvertColors),
+      BlendStage(BlendMode::kSourceOver),
+      {.type = ColorFilterStage::Type::kLinearToSrgb},
+      MatrixStage(kBrighten),
+  });
+
+  EXPECT_THAT(PassSizes(passes), ::testing::ElementsAre(4u, 2u));
+}
+
+TEST(FusedColorFilterContentsTest, PlanKeepsAdvancedBlendsSeparate) {
+  auto passes = PlanColorFilterPasses({
+      MatrixStage(kBrighten),
+      {.type = ColorFilterStage::Type::kSrgbToLinear},
+      BlendStage(BlendMode::kMultiply),
+      {.type = ColorFilterStage::Type::kLinearToSrgb},
+      BlendStage(BlendMode::kModulate),
+  });
+
+  EXPECT_THAT(PassSizes(passes), ::testing::ElementsAre(2u, 1u, 2u));
+}
+
+}  // namespace testing
+}  // namespace impeller
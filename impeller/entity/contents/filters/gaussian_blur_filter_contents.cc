@@ -5,10 +5,13 @@
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 
 #include <cmath>
+#include <vector>
 
 #include "flutter/fml/make_copyable.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/dual_kawase_downsample.frag.h"
+#include "impeller/entity/dual_kawase_upsample.frag.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_downsample.frag.h"
 #include "impeller/entity/texture_fill.frag.h"
@@ -26,6 +29,29 @@ namespace {
 
 constexpr Scalar kMaxSigma = 500.0f;
 
+// A dual filter blur with |level_count| levels and a sample offset of |offset|
+// has a standard deviation close to
+// 2^level_count * (kDualKawaseSigmaBase + kDualKawaseSigmaPerOffset * offset)
+// pixels of the input. This was fitted by simulating the passes. It holds as
+// long as at least two levels are rendered by dual filter passes, however many
+// were skipped by the initial downsample.
+constexpr Scalar kDualKawaseSigmaBase = 0.2f;
+constexpr Scalar kDualKawaseSigmaPerOffset = 0.65f;
+// Smaller offsets can't reach the sigma between two levels, and larger ones
+// leave gaps between the samples that show up as banding.
+constexpr Scalar kDualKawaseMinOffset = 0.5f;
+constexpr Scalar kDualKawaseMaxOffset = 1.5f;
+// Below this only two levels are used, where the fit is poor and the Gaussian
+// passes are cheap anyway.
+constexpr Scalar kDualKawaseMinSigma = 5.0f;
+// The downsample pass can't scale below 1/16th, see MakeDownsampleSubpass.
+constexpr int kDualKawaseMaxDownsampleLevel = 4;
+
+enum class DualKawasePass {
+  kDownsample,
+  kUpsample,
+};
+
 SamplerDescriptor MakeSamplerDescriptor(MinMagFilter filter,
                                         SamplerAddressMode address_mode) {
   SamplerDescriptor sampler_desc;
@@ -197,6 +223,49 @@ Scalar FloorToDivisible(Scalar val, Scalar divisor) {
   }
 }
 
+/// The downsample pass of a whole input with the transparent gutter for the
+/// blur halo.
+struct PaddedDownsample {
+  /// The output size of the down-sampling pass.
+  ISize subpass_size;
+  /// The effective scalar of the down-sample pass.
+  Vector2 effective_scalar;
+  /// The gutter, grown to be divisible by the down-sample divisor.
+  Vector2 padding;
+};
+
+PaddedDownsample CalculatePaddedDownsample(ISize input_size,
+                                           Vector2 padding,
+                                           Vector2 downsample_scalar) {
+  Rect source_rect = Rect::MakeSize(input_size);
+  Rect source_rect_padded = source_rect.Expand(padding);
+  Vector2 downsampled_size = source_rect_padded.GetSize() * downsample_scalar;
+  ISize subpass_size =
+      ISize(ceil(downsampled_size.x), ceil(downsampled_size.y));
+  Vector2 divisible_size(CeilToDivisible(source_rect_padded.GetSize().width,
+                                         1.0 / downsample_scalar.x),
+                         CeilToDivisible(source_rect_padded.GetSize().height,
+                                         1.0 / downsample_scalar.y));
+  // Only make the padding divisible if we already have padding.  If we don't
+  // have padding adding more can add artifacts to hard blur edges.
+  Vector2 divisible_padding(
+      padding.x > 0
+          ? padding.x +
+                (divisible_size.x - source_rect_padded.GetSize().width) / 2.0
+          : 0.f,
+      padding.y > 0
+          ? padding.y +
+                (divisible_size.y - source_rect_padded.GetSize().height) / 2.0
+          : 0.f);
+  source_rect_padded = source_rect.Expand(divisible_padding);
+
+  return {
+      .subpass_size = subpass_size,
+      .effective_scalar = Vector2(subpass_size) / source_rect_padded.GetSize(),
+      .padding = divisible_padding,
+  };
+}
+
 struct DownsamplePassArgs {
   /// The output size of the down-sampling pass.
   ISize subpass_size;
@@ -216,16 +285,12 @@ struct DownsamplePassArgs {
 
 /// Calculates info required for the down-sampling pass.
 DownsamplePassArgs CalculateDownsamplePassArgs(
-    Vector2 scaled_sigma,
     Vector2 padding,
     const Snapshot& input_snapshot,
     const std::optional<Rect>& source_expanded_coverage_hint,
     const std::shared_ptr<FilterInput>& input,
-    const Entity& snapshot_entity) {
-  Scalar desired_scalar =
-      std::min(GaussianBlurFilterContents::CalculateScale(scaled_sigma.x),
-               GaussianBlurFilterContents::CalculateScale(scaled_sigma.y));
-
+    const Entity& snapshot_entity,
+    Scalar desired_scalar) {
   // TODO(jonahwilliams): If desired_scalar is 1.0 and we fully acquired the
   // gutter from the expanded_coverage_hint, we can skip the downsample pass.
   // pass.
@@ -283,42 +348,48 @@ DownsamplePassArgs CalculateDownsamplePassArgs(
   } else {
     //////////////////////////////////////////////////////////////////////////////
     auto input_snapshot_size = input_snapshot.texture->GetSize();
-    Rect source_rect = Rect::MakeSize(input_snapshot_size);
-    Rect source_rect_padded = source_rect.Expand(padding);
-    Vector2 downsampled_size = source_rect_padded.GetSize() * downsample_scalar;
-    ISize subpass_size =
-        ISize(ceil(downsampled_size.x), ceil(downsampled_size.y));
-    Vector2 divisible_size(CeilToDivisible(source_rect_padded.GetSize().width,
-                                           1.0 / downsample_scalar.x),
-                           CeilToDivisible(source_rect_padded.GetSize().height,
-                                           1.0 / downsample_scalar.y));
-    // Only make the padding divisible if we already have padding.  If we don't
-    // have padding adding more can add artifacts to hard blur edges.
-    Vector2 divisible_padding(
-        padding.x > 0
-            ? padding.x +
-                  (divisible_size.x - source_rect_padded.GetSize().width) / 2.0
-            : 0.f,
-        padding.y > 0
-            ? padding.y +
-                  (divisible_size.y - source_rect_padded.GetSize().height) / 2.0
-            : 0.f);
-    source_rect_padded = source_rect.Expand(divisible_padding);
-
-    Vector2 effective_scalar =
-        Vector2(subpass_size) / source_rect_padded.GetSize();
+    PaddedDownsample downsample = CalculatePaddedDownsample(
+        input_snapshot_size, padding, downsample_scalar);
+    Rect source_rect_padded =
+        Rect::MakeSize(input_snapshot_size).Expand(downsample.padding);
     Quad uvs = GaussianBlurFilterContents::CalculateUVs(
         input, snapshot_entity, source_rect_padded, input_snapshot_size);
     return {
-        .subpass_size = subpass_size,
+        .subpass_size = downsample.subpass_size,
         .uvs = uvs,
-        .effective_scalar = effective_scalar,
+        .effective_scalar = downsample.effective_scalar,
         .transform = input_snapshot.transform *
-                     Matrix::MakeTranslation(-divisible_padding),
+                     Matrix::MakeTranslation(-downsample.padding),
     };
   }
 }
 
+/// The grid of samples that the downsample shader averages for every output
+/// pixel.
+struct DownsampleKernel {
+  Scalar edge = 0.0;
+  Scalar ratio = 1.0;
+  int sample_count = 1;
+};
+
+/// Calculates the kernel of a downsample pass by |effective_scalar|. A single
+/// sample is enough when the scale is at least 1/2 or the input has mip levels,
+/// which the texture shader reads instead.
+DownsampleKernel CalculateDownsampleKernel(Scalar effective_scalar,
+                                           bool has_mip_levels) {
+  if (effective_scalar >= 0.5f || has_mip_levels) {
+    return {};
+  }
+  // This assumes we don't scale below 1/16.
+  if (effective_scalar <= 0.0625f) {
+    return {.edge = 7.0, .ratio = 1.0f / 64.0f, .sample_count = 64};
+  }
+  if (effective_scalar <= 0.125f) {
+    return {.edge = 3.0, .ratio = 1.0f / 16.0f, .sample_count = 16};
+  }
+  return {.edge = 1.0, .ratio = 0.25, .sample_count = 4};
+}
+
 /// Makes a subpass that will render the scaled down input and add the
 /// transparent gutter required for the blur halo.
 fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
@@ -330,11 +401,11 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
     Entity::TileMode tile_mode) {
   using VS = TextureFillVertexShader;
 
-  // If the texture already had mip levels generated, then we can use the
-  // original downsample shader.
-  if (pass_args.effective_scalar.x >= 0.5f ||
-      (!input_texture->NeedsMipmapGeneration() &&
-       input_texture->GetTextureDescriptor().mip_count > 1)) {
+  DownsampleKernel kernel = CalculateDownsampleKernel(
+      pass_args.effective_scalar.x,
+      /*has_mip_levels=*/!input_texture->NeedsMipmapGeneration() &&
+          input_texture->GetTextureDescriptor().mip_count > 1);
+  if (kernel.sample_count == 1) {
     ContentContext::SubpassCallback subpass_callback =
         [&](const ContentContext& renderer, RenderPass& pass) {
           HostBuffer& host_buffer = renderer.GetTransientsBuffer();
@@ -379,16 +450,6 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
     return renderer.MakeSubpass("Gaussian Blur Filter", pass_args.subpass_size,
                                 command_buffer, subpass_callback);
   } else {
-    // This assumes we don't scale below 1/16.
-    Scalar edge = 1.0;
-    Scalar ratio = 0.25;
-    if (pass_args.effective_scalar.x <= 0.0625f) {
-      edge = 7.0;
-      ratio = 1.0f / 64.0f;
-    } else if (pass_args.effective_scalar.x <= 0.125f) {
-      edge = 3.0;
-      ratio = 1.0f / 16.0f;
-    }
     ContentContext::SubpassCallback subpass_callback =
         [&](const ContentContext& renderer, RenderPass& pass) {
           HostBuffer& host_buffer = renderer.GetTransientsBuffer();
@@ -417,8 +478,8 @@ fml::StatusOr<RenderTarget> MakeDownsampleSubpass(
               input_texture->GetYCoordScale();
 
           TextureDownsampleFragmentShader::FragInfo frag_info;
-          frag_info.edge = edge;
-          frag_info.ratio = ratio;
+          frag_info.edge = kernel.edge;
+          frag_info.ratio = kernel.ratio;
           frag_info.pixel_size = Vector2(1.0f / Size(input_texture->GetSize()));
 
           const Quad& uvs = pass_args.uvs;
@@ -516,10 +577,193 @@ fml::StatusOr<RenderTarget> MakeBlurSubpass(
   }
 }
 
+/// Renders one pass of a dual filter blur into a texture of |subpass_size|.
+///
+/// Every output pixel covers exactly two input pixels when downsampling, and
+/// half of one when upsampling, so that all of the levels stay aligned with
+/// level 1. When a level has an odd size, part of the last row and column of
+/// the next one reads past the edge of the input.
+fml::StatusOr<RenderTarget> MakeDualKawaseSubpass(
+    const ContentContext& renderer,
+    const std::shared_ptr<CommandBuffer>& command_buffer,
+    const RenderTarget& input_pass,
+    const SamplerDescriptor& sampler_descriptor,
+    DualKawasePass pass_type,
+    ISize subpass_size,
+    Vector2 sample_offset) {
+  using VS = FilterPositionUvVertexShader;
+
+  const std::shared_ptr<Texture>& input_texture =
+      input_pass.GetRenderTargetTexture();
+  Vector2 input_size(input_texture->GetSize());
+  Scalar output_pixel_size =
+      pass_type == DualKawasePass::kDownsample ? 2.0f : 0.5f;
+  Point uv_extent = Vector2(subpass_size) * output_pixel_size / input_size;
+  Vector2 uv_sample_offset = sample_offset * 0.5f / input_size;
+
+  ContentContext::SubpassCallback subpass_callback =
+      [&](const ContentContext& renderer, RenderPass& pass) {
+        HostBuffer& host_buffer = renderer.GetTransientsBuffer();
+
+        ContentContextOptions options = OptionsFromPass(pass);
+        options.primitive_type = PrimitiveType::kTriangleStrip;
+
+        VS::FrameInfo frame_info;
+        frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+        frame_info.texture_sampler_y_coord_scale =
+            input_texture->GetYCoordScale();
+
+        std::array<VS::PerVertexData, 4> vertices = {
+            VS::PerVertexData{Point(0, 0), Point(0, 0)},
+            VS::PerVertexData{Point(1, 0), Point(uv_extent.x, 0)},
+            VS::PerVertexData{Point(0, 1), Point(0, uv_extent.y)},
+            VS::PerVertexData{Point(1, 1), uv_extent},
+        };
+        pass.SetVertexBuffer(CreateVertexBuffer(vertices, host_buffer));
+
+        SamplerDescriptor linear_sampler_descriptor = sampler_descriptor;
+        linear_sampler_descriptor.mag_filter = MinMagFilter::kLinear;
+        linear_sampler_descriptor.min_filter = MinMagFilter::kLinear;
+        const std::unique_ptr<const Sampler>& sampler =
+            renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                linear_sampler_descriptor);
+
+        VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+        switch (pass_type) {
+          case DualKawasePass::kDownsample: {
+            pass.SetCommandLabel("Dual Kawase blur downsample");
+            pass.SetPipeline(
+                renderer.GetDualKawaseDownsamplePipeline(options));
+            DualKawaseDownsampleFragmentShader::FragInfo frag_info;
+            frag_info.sample_offset = uv_sample_offset;
+            DualKawaseDownsampleFragmentShader::BindFragInfo(
+                pass, host_buffer.EmplaceUniform(frag_info));
+            DualKawaseDownsampleFragmentShader::BindTextureSampler(
+                pass, input_texture, sampler);
+            break;
+          }
+          case DualKawasePass::kUpsample: {
+            pass.SetCommandLabel("Dual Kawase blur upsample");
+            pass.SetPipeline(renderer.GetDualKawaseUpsamplePipeline(options));
+            DualKawaseUpsampleFragmentShader::FragInfo frag_info;
+            frag_info.sample_offset = uv_sample_offset;
+            DualKawaseUpsampleFragmentShader::BindFragInfo(
+                pass, host_buffer.EmplaceUniform(frag_info));
+            DualKawaseUpsampleFragmentShader::BindTextureSampler(
+                pass, input_texture, sampler);
+            break;
+          }
+        }
+        return pass.Draw().ok();
+      };
+  return renderer.MakeSubpass("Gaussian Blur Filter", subpass_size,
+                              command_buffer, subpass_callback);
+}
+
+/// Renders the dual filter blur of |input_pass|, the output of the initial
+/// downsample pass, and returns a texture of the same size.
+///
+/// Like the Gaussian passes, every pass is recorded into its own command
+/// buffer. They are appended to |command_buffers| and must be enqueued after
+/// the command buffer of the first downsample pass.
+fml::StatusOr<RenderTarget> MakeDualKawaseSubpasses(
+    const ContentContext& renderer,
+    const RenderTarget& input_pass,
+    const SamplerDescriptor& sampler_descriptor,
+    const DualKawaseParameters& parameters,
+    std::vector<std::shared_ptr<CommandBuffer>>& command_buffers) {
+  RenderTarget level_pass = input_pass;
+
+  auto make_subpass = [&](DualKawasePass pass_type,
+                          ISize subpass_size) -> fml::Status {
+    std::shared_ptr<CommandBuffer> command_buffer =
+        renderer.GetContext()->CreateCommandBuffer();
+    if (!command_buffer) {
+      return fml::Status(fml::StatusCode::kUnknown, "");
+    }
+    fml::StatusOr<RenderTarget> pass_out = MakeDualKawaseSubpass(
+        renderer, command_buffer, level_pass, sampler_descriptor, pass_type,
+        subpass_size, parameters.sample_offset);
+    if (!pass_out.ok()) {
+      return pass_out.status();
+    }
+    command_buffers.push_back(std::move(command_buffer));
+    level_pass = pass_out.value();
+    return fml::Status();
+  };
+
+  std::vector<ISize> pass_sizes = CalculateDualKawasePassSizes(
+      input_pass.GetRenderTargetSize(), parameters);
+  size_t downsample_pass_count =
+      parameters.level_count - parameters.downsample_level;
+  for (size_t i = 0; i < pass_sizes.size(); i++) {
+    fml::Status status = make_subpass(i < downsample_pass_count
+                                          ? DualKawasePass::kDownsample
+                                          : DualKawasePass::kUpsample,
+                                      pass_sizes[i]);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return level_pass;
+}
+
+/// Makes the entity that draws the blurred |texture|, which is scaled by
+/// |effective_scalar| relative to the unrotated local space placement of the
+/// downsample pass.
+Entity MakeBlurOutputEntity(const Entity& entity,
+                            const BlurInfo& blur_info,
+                            const DownsamplePassArgs& downsample_pass_args,
+                            const std::shared_ptr<Texture>& texture,
+                            Vector2 effective_scalar,
+                            Scalar opacity) {
+  SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
+      MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
+
+  return Entity::FromSnapshot(
+      Snapshot{.texture = texture,
+               .transform =
+                   entity.GetTransform() *                                   //
+                   Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
+                   Matrix::MakeTranslation(-1 * blur_info.source_space_offset) *
+                   downsample_pass_args.transform *  //
+                   Matrix::MakeScale(1 / effective_scalar),
+               .sampler_descriptor = sampler_desc,
+               .opacity = opacity},
+      entity.GetBlendMode());
+}
+
 int ScaleBlurRadius(Scalar radius, Scalar scalar) {
   return static_cast<int>(std::round(radius * scalar));
 }
 
+/// Calculates the scale of the downsample pass. When the dual filter passes
+/// approximate the blur, it scales the input to their first level.
+Scalar CalculateDownsampleScalar(
+    Vector2 scaled_sigma,
+    const std::optional<DualKawaseParameters>& dual_kawase_parameters) {
+  if (dual_kawase_parameters.has_value()) {
+    return std::exp2(
+        static_cast<Scalar>(-dual_kawase_parameters->downsample_level));
+  }
+  return std::min(GaussianBlurFilterContents::CalculateScale(scaled_sigma.x),
+                  GaussianBlurFilterContents::CalculateScale(scaled_sigma.y));
+}
+
+/// Calculates the parameters of the Gaussian pass along one axis, which blurs
+/// the output of a downsample pass by |effective_scalar|.
+BlurParameters CalculateGaussianPassParameters(Point blur_uv_offset,
+                                               Scalar scaled_sigma,
+                                               Scalar blur_radius,
+                                               Scalar effective_scalar) {
+  return BlurParameters{
+      .blur_uv_offset = blur_uv_offset,
+      .blur_sigma = scaled_sigma * effective_scalar,
+      .blur_radius = ScaleBlurRadius(blur_radius, effective_scalar),
+      .step_size = 1,
+  };
+}
+
 Entity ApplyClippedBlurStyle(Entity::ClipOperation clip_operation,
                              const Entity& entity,
                              const std::shared_ptr<FilterInput>& input,
@@ -701,6 +945,8 @@ std::optional<Rect> GaussianBlurFilterContents::GetFilterCoverage(
 //    snapshot since the blur can render outside the bounds of the snapshot.
 // 3) Perform 1D horizontal blur pass.
 // 4) Perform 1D vertical blur pass.
+//    When approximating the blur with dual filter passes, the input is instead
+//    repeatedly halved and then doubled in size.
 // 5) Apply the blur style to the blur result. This may just mask the output or
 //    draw the original snapshot over the result.
 std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
@@ -768,9 +1014,17 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
+  std::optional<DualKawaseParameters> dual_kawase_parameters;
+  if (renderer.GetBlurAlgorithm() == BlurAlgorithm::kDualKawase) {
+    dual_kawase_parameters = CalculateDualKawaseParameters(
+        blur_info.scaled_sigma, renderer.GetBlurQuality());
+  }
+
+  Scalar desired_scalar = CalculateDownsampleScalar(blur_info.scaled_sigma,
+                                                    dual_kawase_parameters);
   DownsamplePassArgs downsample_pass_args = CalculateDownsamplePassArgs(
-      blur_info.scaled_sigma, blur_info.padding, input_snapshot.value(),
-      source_expanded_coverage_hint, inputs[0], snapshot_entity);
+      blur_info.padding, input_snapshot.value(), source_expanded_coverage_hint,
+      inputs[0], snapshot_entity, desired_scalar);
 
   fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleSubpass(
       renderer, command_buffer_1, input_snapshot->texture,
@@ -780,6 +1034,33 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
+  if (dual_kawase_parameters.has_value()) {
+    std::vector<std::shared_ptr<CommandBuffer>> command_buffers = {
+        std::move(command_buffer_1)};
+    fml::StatusOr<RenderTarget> dual_kawase_out = MakeDualKawaseSubpasses(
+        renderer, pass1_out.value(), input_snapshot->sampler_descriptor,
+        dual_kawase_parameters.value(), command_buffers);
+    if (!dual_kawase_out.ok()) {
+      return std::nullopt;
+    }
+    for (std::shared_ptr<CommandBuffer>& command_buffer : command_buffers) {
+      if (!renderer.GetContext()->EnqueueCommandBuffer(
+              std::move(command_buffer))) {
+        return std::nullopt;
+      }
+    }
+
+    Entity blur_output_entity = MakeBlurOutputEntity(
+        entity, blur_info, downsample_pass_args,
+        dual_kawase_out.value().GetRenderTargetTexture(),
+        downsample_pass_args.effective_scalar, input_snapshot->opacity);
+
+    return ApplyBlurStyle(mask_blur_style_, entity, inputs[0],
+                          input_snapshot.value(), std::move(blur_output_entity),
+                          mask_geometry_, blur_info.source_space_scalar,
+                          blur_info.source_space_offset);
+  }
+
   Vector2 pass1_pixel_size =
       1.0 / Vector2(pass1_out.value().GetRenderTargetTexture()->GetSize());
 
@@ -794,14 +1075,9 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   fml::StatusOr<RenderTarget> pass2_out = MakeBlurSubpass(
       renderer, command_buffer_2, /*input_pass=*/pass1_out.value(),
       input_snapshot->sampler_descriptor, tile_mode_,
-      BlurParameters{
-          .blur_uv_offset = Point(0.0, pass1_pixel_size.y),
-          .blur_sigma = blur_info.scaled_sigma.y *
-                        downsample_pass_args.effective_scalar.y,
-          .blur_radius = ScaleBlurRadius(
-              blur_info.blur_radius.y, downsample_pass_args.effective_scalar.y),
-          .step_size = 1,
-      },
+      CalculateGaussianPassParameters(
+          Point(0.0, pass1_pixel_size.y), blur_info.scaled_sigma.y,
+          blur_info.blur_radius.y, downsample_pass_args.effective_scalar.y),
       /*destination_target=*/std::nullopt, blur_uvs);
 
   if (!pass2_out.ok()) {
@@ -823,14 +1099,9 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   fml::StatusOr<RenderTarget> pass3_out = MakeBlurSubpass(
       renderer, command_buffer_3, /*input_pass=*/pass2_out.value(),
       input_snapshot->sampler_descriptor, tile_mode_,
-      BlurParameters{
-          .blur_uv_offset = Point(pass1_pixel_size.x, 0.0),
-          .blur_sigma = blur_info.scaled_sigma.x *
-                        downsample_pass_args.effective_scalar.x,
-          .blur_radius = ScaleBlurRadius(
-              blur_info.blur_radius.x, downsample_pass_args.effective_scalar.x),
-          .step_size = 1,
-      },
+      CalculateGaussianPassParameters(
+          Point(pass1_pixel_size.x, 0.0), blur_info.scaled_sigma.x,
+          blur_info.blur_radius.x, downsample_pass_args.effective_scalar.x),
       pass3_destination, blur_uvs);
 
   if (!pass3_out.ok()) {
@@ -853,20 +1124,10 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
              (pass2_out.value().GetRenderTargetSize() ==
               pass3_out.value().GetRenderTargetSize()));
 
-  SamplerDescriptor sampler_desc = MakeSamplerDescriptor(
-      MinMagFilter::kLinear, SamplerAddressMode::kClampToEdge);
-
-  Entity blur_output_entity = Entity::FromSnapshot(
-      Snapshot{.texture = pass3_out.value().GetRenderTargetTexture(),
-               .transform =
-                   entity.GetTransform() *                                   //
-                   Matrix::MakeScale(1.f / blur_info.source_space_scalar) *  //
-                   Matrix::MakeTranslation(-1 * blur_info.source_space_offset) *
-                   downsample_pass_args.transform *  //
-                   Matrix::MakeScale(1 / downsample_pass_args.effective_scalar),
-               .sampler_descriptor = sampler_desc,
-               .opacity = input_snapshot->opacity},
-      entity.GetBlendMode());
+  Entity blur_output_entity = MakeBlurOutputEntity(
+      entity, blur_info, downsample_pass_args,
+      pass3_out.value().GetRenderTargetTexture(),
+      downsample_pass_args.effective_scalar, input_snapshot->opacity);
 
   return ApplyBlurStyle(mask_blur_style_, entity, inputs[0],
                         input_snapshot.value(), std::move(blur_output_entity),
@@ -904,6 +1165,135 @@ Scalar GaussianBlurFilterContents::ScaleSigma(Scalar sigma) {
   return clamped * scalar;
 }
 
+std::vector<BlurPass> GaussianBlurFilterContents::CalculatePasses(
+    ISize input_size,
+    BlurAlgorithm algorithm,
+    BlurQuality quality) const {
+  BlurInfo blur_info = CalculateBlurInfo(Entity(), Matrix(), sigma_);
+  if (blur_info.scaled_sigma.x < kEhCloseEnough &&
+      blur_info.scaled_sigma.y < kEhCloseEnough) {
+    return {};
+  }
+
+  std::optional<DualKawaseParameters> dual_kawase_parameters;
+  if (algorithm == BlurAlgorithm::kDualKawase) {
+    dual_kawase_parameters =
+        CalculateDualKawaseParameters(blur_info.scaled_sigma, quality);
+  }
+  Scalar desired_scalar = CalculateDownsampleScalar(blur_info.scaled_sigma,
+                                                    dual_kawase_parameters);
+  PaddedDownsample downsample = CalculatePaddedDownsample(
+      input_size, blur_info.padding, Vector2(desired_scalar, desired_scalar));
+  std::vector<BlurPass> passes = {BlurPass{
+      .size = downsample.subpass_size,
+      .sample_count = CalculateDownsampleKernel(downsample.effective_scalar.x,
+                                                /*has_mip_levels=*/false)
+                          .sample_count,
+  }};
+
+  if (dual_kawase_parameters.has_value()) {
+    std::vector<ISize> pass_sizes = CalculateDualKawasePassSizes(
+        downsample.subpass_size, dual_kawase_parameters.value());
+    size_t downsample_pass_count = dual_kawase_parameters->level_count -
+                                   dual_kawase_parameters->downsample_level;
+    for (size_t i = 0; i < pass_sizes.size(); i++) {
+      passes.push_back(BlurPass{
+          .size = pass_sizes[i],
+          .sample_count = i < downsample_pass_count
+                              ? kDualKawaseDownsampleSampleCount
+                              : kDualKawaseUpsampleSampleCount,
+      });
+    }
+    return passes;
+  }
+
+  auto add_gaussian_pass = [&](const BlurParameters& parameters) {
+    // Like MakeBlurSubpass, skip the passes that wouldn't blur.
+    if (parameters.blur_sigma < kEhCloseEnough) {
+      return;
+    }
+    passes.push_back(BlurPass{
+        .size = downsample.subpass_size,
+        .sample_count =
+            LerpHackKernelSamples(GenerateBlurInfo(parameters)).sample_count,
+    });
+  };
+  add_gaussian_pass(CalculateGaussianPassParameters(
+      Point(0.0, 1.0), blur_info.scaled_sigma.y, blur_info.blur_radius.y,
+      downsample.effective_scalar.y));
+  add_gaussian_pass(CalculateGaussianPassParameters(
+      Point(1.0, 0.0), blur_info.scaled_sigma.x, blur_info.blur_radius.x,
+      downsample.effective_scalar.x));
+  return passes;
+}
+
+std::vector<ISize> CalculateDualKawasePassSizes(
+    ISize downsample_size,
+    const DualKawaseParameters& parameters) {
+  // The size of every level, starting with the downsample level.
+  std::vector<ISize> level_sizes = {downsample_size};
+  for (int level = parameters.downsample_level + 1;
+       level <= parameters.level_count; level++) {
+    ISize previous_size = level_sizes.back();
+    level_sizes.push_back(ISize((previous_size.width + 1) / 2,
+                                (previous_size.height + 1) / 2));
+  }
+  std::vector<ISize> pass_sizes(level_sizes.begin() + 1, level_sizes.end());
+  for (int level = parameters.level_count - 1;
+       level >= parameters.downsample_level; level--) {
+    pass_sizes.push_back(level_sizes[level - parameters.downsample_level]);
+  }
+  return pass_sizes;
+}
+
+std::optional<DualKawaseParameters> CalculateDualKawaseParameters(
+    Vector2 sigma,
+    BlurQuality quality) {
+  if (std::min(sigma.x, sigma.y) < kDualKawaseMinSigma) {
+    return std::nullopt;
+  }
+
+  // Use as few levels as the largest offset allows. The offset makes up the
+  // rest of the sigma.
+  Scalar max_sigma_per_level =
+      kDualKawaseSigmaBase + kDualKawaseSigmaPerOffset * kDualKawaseMaxOffset;
+  int level_count = std::max(
+      2, static_cast<int>(
+             std::ceil(std::log2(std::max(sigma.x, sigma.y) /
+                                 max_sigma_per_level))));
+  Vector2 sigma_per_level = sigma / std::exp2(static_cast<Scalar>(level_count));
+  Vector2 sample_offset =
+      (sigma_per_level - Vector2(kDualKawaseSigmaBase, kDualKawaseSigmaBase)) /
+      kDualKawaseSigmaPerOffset;
+  if (std::min(sample_offset.x, sample_offset.y) < kDualKawaseMinOffset) {
+    // The sigmas are too different for both axes to share the levels.
+    return std::nullopt;
+  }
+
+  // Levels past those the quality allows are skipped by the initial downsample
+  // pass, which writes far fewer pixels than the dual filter passes would.
+  int dual_filter_level_count = 0;
+  switch (quality) {
+    case BlurQuality::kHigh:
+      dual_filter_level_count = 4;
+      break;
+    case BlurQuality::kMedium:
+      dual_filter_level_count = 3;
+      break;
+    case BlurQuality::kLow:
+      dual_filter_level_count = 2;
+      break;
+  }
+
+  return DualKawaseParameters{
+      .downsample_level = std::clamp(level_count - dual_filter_level_count, 1,
+                                     kDualKawaseMaxDownsampleLevel),
+      .level_count = level_count,
+      .sample_offset = Clamp(sample_offset, kDualKawaseMinOffset,
+                             kDualKawaseMaxOffset),
+  };
+}
+
 KernelSamples GenerateBlurInfo(BlurParameters parameters) {
   KernelSamples result;
   result.sample_count =
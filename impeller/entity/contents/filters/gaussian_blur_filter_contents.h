@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_FILTER_CONTENTS_H_
 
 #include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/geometry/geometry.h"
@@ -49,9 +51,59 @@ KernelSamples GenerateBlurInfo(BlurParameters parameters);
 GaussianBlurPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
     KernelSamples samples);
 
+/// The passes of a dual filter (dual Kawase) blur.
+///
+/// Level k of the blur is 1/2^k of the size of the input. The input is first
+/// scaled down to |downsample_level| by the Gaussian blur's downsample pass.
+/// Each dual filter downsample pass halves the previous level until
+/// |level_count| is reached, then upsample passes double it again until it is
+/// back at |downsample_level|, which is what gets composited.
+struct DualKawaseParameters {
+  /// The level produced by the initial downsample pass.
+  int downsample_level = 1;
+  /// The number of levels, including those skipped by the initial downsample.
+  int level_count = 0;
+  /// The distance of the samples of every pass from the center of the output
+  /// pixel, in half texels of the pass's input.
+  Vector2 sample_offset;
+};
+
+/// Chooses the passes that approximate a Gaussian blur of |sigma|, in pixels
+/// of the input.
+///
+/// Returns std::nullopt when the sigma is too small, or too different between
+/// the axes, to be approximated. Those blurs use the Gaussian passes.
+std::optional<DualKawaseParameters> CalculateDualKawaseParameters(
+    Vector2 sigma,
+    BlurQuality quality);
+
+// Comes from dual_kawase_downsample.frag.
+static constexpr int kDualKawaseDownsampleSampleCount = 5;
+// Comes from dual_kawase_upsample.frag.
+static constexpr int kDualKawaseUpsampleSampleCount = 8;
+
+/// Calculates the sizes of the dual filter passes that follow an initial
+/// downsample pass of |downsample_size|, in the order they are rendered.
+///
+/// The first |level_count - downsample_level| passes are downsample passes and
+/// the rest are upsample passes.
+std::vector<ISize> CalculateDualKawasePassSizes(
+    ISize downsample_size,
+    const DualKawaseParameters& parameters);
+
+/// A render pass of a blur.
+struct BlurPass {
+  /// The size of the render target of the pass.
+  ISize size;
+  /// The number of texture samples read for every pixel of the pass.
+  int sample_count = 0;
+};
+
 /// Performs a bidirectional Gaussian blur.
 ///
 /// This is accomplished by rendering multiple passes in multiple directions.
+/// When the content context selects |BlurAlgorithm::kDualKawase|, large blurs
+/// are approximated by dual filter passes instead.
 /// Note: This will replace `DirectionalGaussianBlurFilterContents`.
 class GaussianBlurFilterContents final : public FilterContents {
  public:
@@ -103,6 +155,16 @@ class GaussianBlurFilterContents final : public FilterContents {
   /// equation that puts the minima there and a f(0)=1.
   static Scalar ScaleSigma(Scalar sigma);
 
+  /// Calculates the passes that render the blur of an untransformed input of
+  /// |input_size| without mip levels, when the content context selects
+  /// |algorithm| and |quality|.
+  ///
+  /// These are planned by the same functions as the passes of RenderFilter.
+  /// Visible for benchmarking.
+  std::vector<BlurPass> CalculatePasses(ISize input_size,
+                                        BlurAlgorithm algorithm,
+                                        BlurQuality quality) const;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(
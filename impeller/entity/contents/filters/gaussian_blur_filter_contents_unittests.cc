@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <numeric>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "fml/status_or.h"
 #include "gmock/gmock.h"
@@ -78,6 +81,80 @@ fml::StatusOr<Scalar> CalculateSigmaForBlurRadius(
   return LowerBoundNewtonianMethod(f, radius, 2.f, 0.001f);
 }
 
+/// Samples |signal| at |x|, in texels, with linear filtering and clamping to
+/// the edges.
+Scalar SampleLinear(const std::vector<Scalar>& signal, Scalar x) {
+  Scalar position = x - 0.5f;
+  int index = static_cast<int>(std::floor(position));
+  Scalar fract = position - index;
+  int last = static_cast<int>(signal.size()) - 1;
+  Scalar left = signal[std::clamp(index, 0, last)];
+  Scalar right = signal[std::clamp(index + 1, 0, last)];
+  return left + (right - left) * fract;
+}
+
+/// Simulates the horizontal profile of the dual filter passes blurring a
+/// single pixel at |pixel| of a row of |size| pixels, composited back at the
+/// size of the input. Returns the profile normalized to add up to 1.
+///
+/// Summing the samples of each pass over the vertical axis gives the taps of
+/// a one dimensional pass, so the profile matches a row of the shaders'
+/// output.
+std::vector<Scalar> SimulateDualKawaseProfile(
+    const DualKawaseParameters& parameters,
+    size_t size,
+    size_t pixel) {
+  struct Tap {
+    // In half texels of the input, before the sample offset is applied.
+    Scalar offset;
+    Scalar weight;
+  };
+  auto resample = [&](const std::vector<Scalar>& input, size_t output_size,
+                      Scalar output_pixel_size, const std::vector<Tap>& taps) {
+    std::vector<Scalar> output(output_size);
+    for (size_t i = 0; i < output_size; i++) {
+      Scalar x = (i + 0.5f) * output_pixel_size;
+      for (const Tap& tap : taps) {
+        output[i] += tap.weight *
+                     SampleLinear(input, x + tap.offset * 0.5f *
+                                                 parameters.sample_offset.x);
+      }
+    }
+    return output;
+  };
+  const std::vector<Tap> downsample_taps = {
+      {0.0f, 4.0f / 8.0f}, {-1.0f, 2.0f / 8.0f}, {1.0f, 2.0f / 8.0f}};
+  const std::vector<Tap> upsample_taps = {
+      {-2.0f, 1.0f / 12.0f}, {2.0f, 1.0f / 12.0f}, {0.0f, 2.0f / 12.0f},
+      {-1.0f, 4.0f / 12.0f}, {1.0f, 4.0f / 12.0f}};
+
+  // The downsample pass of the Gaussian blur averages boxes of pixels.
+  size_t box_size = 1u << parameters.downsample_level;
+  std::vector<std::vector<Scalar>> levels = {
+      std::vector<Scalar>((size + box_size - 1) / box_size)};
+  levels[0][pixel / box_size] = 1.0f / box_size;
+  for (int level = parameters.downsample_level + 1;
+       level <= parameters.level_count; level++) {
+    const std::vector<Scalar>& previous = levels.back();
+    levels.push_back(resample(previous, (previous.size() + 1) / 2, 2.0f,
+                              downsample_taps));
+  }
+  std::vector<Scalar> output = levels.back();
+  for (int level = parameters.level_count - 1;
+       level >= parameters.downsample_level; level--) {
+    size_t level_size = levels[level - parameters.downsample_level].size();
+    output = resample(output, level_size, 0.5f, upsample_taps);
+  }
+  // The output is magnified to the size of the input when composited.
+  output = resample(output, size, 1.0f / box_size, {{0.0f, 1.0f}});
+
+  Scalar total = std::accumulate(output.begin(), output.end(), 0.0f);
+  for (Scalar& value : output) {
+    value /= total;
+  }
+  return output;
+}
+
 }  // namespace
 
 class GaussianBlurFilterContentsTest : public EntityPlayground {
@@ -618,6 +695,154 @@ TEST(GaussianBlurFilterContentsTest, LerpHackKernelSamplesComplex) {
   EXPECT_NEAR(output, fast_output, 0.1);
 }
 
+TEST(GaussianBlurFilterContentsTest, DualKawaseFallsBackForSmallBlurs) {
+  EXPECT_FALSE(CalculateDualKawaseParameters(Vector2(4, 4), BlurQuality::kHigh)
+                   .has_value());
+  EXPECT_FALSE(
+      CalculateDualKawaseParameters(Vector2(60, 4), BlurQuality::kHigh)
+          .has_value());
+  // Too different to share levels.
+  EXPECT_FALSE(
+      CalculateDualKawaseParameters(Vector2(60, 10), BlurQuality::kHigh)
+          .has_value());
+  EXPECT_TRUE(CalculateDualKawaseParameters(Vector2(5, 5), BlurQuality::kHigh)
+                  .has_value());
+  EXPECT_TRUE(
+      CalculateDualKawaseParameters(Vector2(60, 40), BlurQuality::kHigh)
+          .has_value());
+}
+
+TEST(GaussianBlurFilterContentsTest, DualKawaseQualityChoosesDownsampleLevel) {
+  std::optional<DualKawaseParameters> high =
+      CalculateDualKawaseParameters(Vector2(60, 60), BlurQuality::kHigh);
+  std::optional<DualKawaseParameters> medium =
+      CalculateDualKawaseParameters(Vector2(60, 60), BlurQuality::kMedium);
+  std::optional<DualKawaseParameters> low =
+      CalculateDualKawaseParameters(Vector2(60, 60), BlurQuality::kLow);
+  ASSERT_TRUE(high.has_value() && medium.has_value() && low.has_value());
+  EXPECT_EQ(high->level_count, 6);
+  EXPECT_EQ(high->downsample_level, 2);
+  EXPECT_EQ(medium->level_count, 6);
+  EXPECT_EQ(medium->downsample_level, 3);
+  EXPECT_EQ(low->level_count, 6);
+  EXPECT_EQ(low->downsample_level, 4);
+  EXPECT_TRUE(PointNear(high->sample_offset, low->sample_offset));
+
+  // The downsample pass always leaves two levels to the dual filter passes.
+  std::optional<DualKawaseParameters> small_high =
+      CalculateDualKawaseParameters(Vector2(5, 5), BlurQuality::kHigh);
+  ASSERT_TRUE(small_high.has_value());
+  EXPECT_EQ(small_high->level_count, 3);
+  EXPECT_EQ(small_high->downsample_level, 1);
+
+  // And never scales below 1/16th.
+  std::optional<DualKawaseParameters> huge_low =
+      CalculateDualKawaseParameters(Vector2(500, 500), BlurQuality::kLow);
+  ASSERT_TRUE(huge_low.has_value());
+  EXPECT_EQ(huge_low->level_count, 9);
+  EXPECT_EQ(huge_low->downsample_level, 4);
+}
+
+TEST(GaussianBlurFilterContentsTest, DualKawasePassSizes) {
+  std::vector<ISize> pass_sizes = CalculateDualKawasePassSizes(
+      ISize(101, 50),
+      DualKawaseParameters{.downsample_level = 1, .level_count = 3});
+  std::vector<ISize> expected = {ISize(51, 25), ISize(26, 13), ISize(51, 25),
+                                 ISize(101, 50)};
+  EXPECT_EQ(pass_sizes, expected);
+}
+
+TEST(GaussianBlurFilterContentsTest, CalculatePasses) {
+  GaussianBlurFilterContents contents(
+      /*sigma_x=*/60, /*sigma_y=*/60, Entity::TileMode::kDecal,
+      FilterContents::BlurStyle::kNormal);
+
+  std::vector<BlurPass> gaussian_passes = contents.CalculatePasses(
+      ISize(1920, 1080), BlurAlgorithm::kGaussian, BlurQuality::kHigh);
+  ASSERT_EQ(gaussian_passes.size(), 3u);
+  EXPECT_EQ(gaussian_passes[1].size, gaussian_passes[0].size);
+  EXPECT_EQ(gaussian_passes[2].size, gaussian_passes[0].size);
+  EXPECT_GT(gaussian_passes[1].sample_count, 1);
+
+  Scalar scaled_sigma = GaussianBlurFilterContents::ScaleSigma(60);
+  std::optional<DualKawaseParameters> parameters =
+      CalculateDualKawaseParameters(Vector2(scaled_sigma, scaled_sigma),
+                                    BlurQuality::kHigh);
+  ASSERT_TRUE(parameters.has_value());
+  std::vector<BlurPass> dual_kawase_passes = contents.CalculatePasses(
+      ISize(1920, 1080), BlurAlgorithm::kDualKawase, BlurQuality::kHigh);
+  ASSERT_EQ(dual_kawase_passes.size(),
+            1u + 2u * (parameters->level_count - parameters->downsample_level));
+  EXPECT_EQ(dual_kawase_passes[1].sample_count,
+            kDualKawaseDownsampleSampleCount);
+  EXPECT_EQ(dual_kawase_passes.back().sample_count,
+            kDualKawaseUpsampleSampleCount);
+  EXPECT_EQ(dual_kawase_passes.back().size, dual_kawase_passes[0].size);
+}
+
+TEST(GaussianBlurFilterContentsTest, DualKawaseMatchesGaussian) {
+  constexpr size_t kSize = 2048;
+  for (BlurQuality quality :
+       {BlurQuality::kHigh, BlurQuality::kMedium, BlurQuality::kLow}) {
+    for (Scalar sigma = 5; sigma <= 100; sigma += 5) {
+      std::optional<DualKawaseParameters> parameters =
+          CalculateDualKawaseParameters(Vector2(sigma, sigma), quality);
+      ASSERT_TRUE(parameters.has_value()) << sigma;
+      // The profile depends on where the pixel lands within the levels.
+      for (size_t pixel = kSize / 2; pixel < kSize / 2 + 16; pixel += 5) {
+        std::vector<Scalar> profile =
+            SimulateDualKawaseProfile(parameters.value(), kSize, pixel);
+        Scalar mean = 0;
+        for (size_t i = 0; i < kSize; i++) {
+          mean += (i + 0.5f) * profile[i];
+        }
+        Scalar variance = 0;
+        for (size_t i = 0; i < kSize; i++) {
+          variance += (i + 0.5f - mean) * (i + 0.5f - mean) * profile[i];
+        }
+        EXPECT_NEAR(std::sqrt(variance), sigma, sigma * 0.06f)
+            << "sigma " << sigma << " pixel " << pixel;
+
+        Scalar peak = 1.0f / (std::sqrt(2.0f * kPi) * sigma);
+        Scalar max_difference = 0;
+        for (size_t i = 0; i < kSize; i++) {
+          Scalar x = (i + 0.5f - mean) / sigma;
+          Scalar gaussian = peak * std::exp(-0.5f * x * x);
+          max_difference =
+              std::max(max_difference, std::abs(profile[i] - gaussian));
+        }
+        EXPECT_LT(max_difference, peak * 0.12f)
+            << "sigma " << sigma << " pixel " << pixel;
+      }
+    }
+  }
+}
+
+TEST_P(GaussianBlurFilterContentsTest,
+       DualKawaseRenderCoverageMatchesGetCoverage) {
+  std::shared_ptr<Texture> texture = MakeTexture(ISize(100, 100));
+  auto contents = std::make_unique<GaussianBlurFilterContents>(
+      20, 20, Entity::TileMode::kDecal, FilterContents::BlurStyle::kNormal,
+      /*mask_geometry=*/nullptr);
+  contents->SetInputs({FilterInput::Make(texture)});
+  std::shared_ptr<ContentContext> renderer = GetContentContext();
+  renderer->SetBlurAlgorithm(BlurAlgorithm::kDualKawase, BlurQuality::kHigh);
+
+  Entity entity;
+  std::optional<Entity> result =
+      contents->GetEntity(*renderer, entity, /*coverage_hint=*/{});
+  EXPECT_TRUE(result.has_value());
+  if (result.has_value()) {
+    std::optional<Rect> result_coverage = result.value().GetCoverage();
+    std::optional<Rect> contents_coverage = contents->GetCoverage(entity);
+    EXPECT_TRUE(result_coverage.has_value());
+    EXPECT_TRUE(contents_coverage.has_value());
+    if (result_coverage.has_value() && contents_coverage.has_value()) {
+      EXPECT_TRUE(RectNear(result_coverage.value(), contents_coverage.value()));
+    }
+  }
+}
+
 TEST(GaussianBlurFilterContentsTest, ChopHugeBlurs) {
   Scalar sigma = 30.5f;
   int32_t blur_radius = static_cast<int32_t>(
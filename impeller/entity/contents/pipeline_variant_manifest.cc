@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace impeller {
+
+// Bump the version whenever the meaning of the option keys or pipeline names
+// changes so that stale manifests are disregarded.
+static constexpr std::string_view kManifestHeader =
+    "impeller-pipeline-variants 1\n";
+
+// Option keys are written as fixed width hexadecimal numbers followed by a
+// space and the pipeline name.
+static constexpr size_t kKeyLength = 16u;
+
+PipelineVariantManifest::PipelineVariantManifest() = default;
+
+PipelineVariantManifest::~PipelineVariantManifest() = default;
+
+std::optional<PipelineVariantManifest> PipelineVariantManifest::Parse(
+    const fml::Mapping& mapping) {
+  std::string_view data(reinterpret_cast<const char*>(mapping.GetMapping()),
+                        mapping.GetSize());
+  if (data.substr(0, kManifestHeader.size()) != kManifestHeader) {
+    return std::nullopt;
+  }
+  data.remove_prefix(kManifestHeader.size());
+
+  PipelineVariantManifest manifest;
+  while (!data.empty()) {
+    size_t line_end = data.find('\n');
+    if (line_end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    std::string_view line = data.substr(0, line_end);
+    data.remove_prefix(line_end + 1);
+
+    if (line.size() < kKeyLength + 2 || line[kKeyLength] != ' ') {
+      return std::nullopt;
+    }
+    uint64_t key = 0u;
+    for (size_t i = 0; i < kKeyLength; i++) {
+      char c = line[i];
+      uint64_t digit;
+      if (c >= '0' && c <= '9') {
+        digit = c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        digit = c - 'a' + 10;
+      } else {
+        return std::nullopt;
+      }
+      key = (key << 4) | digit;
+    }
+    manifest.Record(line.substr(kKeyLength + 1), key);
+  }
+  return manifest;
+}
+
+bool PipelineVariantManifest::Record(std::string_view pipeline_name,
+                                     uint64_t options_key) {
+  auto found = std::find_if(entries_.begin(), entries_.end(),
+                            [&](const Entry& entry) {
+                              return entry.options_key == options_key &&
+                                     entry.pipeline_name == pipeline_name;
+                            });
+  if (found != entries_.end()) {
+    return false;
+  }
+  entries_.push_back(Entry{std::string(pipeline_name), options_key});
+  return true;
+}
+
+const std::vector<PipelineVariantManifest::Entry>&
+PipelineVariantManifest::GetEntries() const {
+  return entries_;
+}
+
+std::shared_ptr<fml::Mapping> PipelineVariantManifest::Serialize() const {
+  std::string data(kManifestHeader);
+  char key[kKeyLength + 1];
+  for (const auto& entry : entries_) {
+    std::snprintf(key, sizeof(key), "%016" PRIx64, entry.options_key);
+    data.append(key, kKeyLength);
+    data.push_back(' ');
+    data.append(entry.pipeline_name);
+    data.push_back('\n');
+  }
+  return std::make_shared<fml::DataMapping>(data);
+}
+
+}  // namespace impeller
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_VARIANT_MANIFEST_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_VARIANT_MANIFEST_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A record of the pipeline variants created during a session.
+///
+///             Each entry names a family of pipelines (all variants of the
+///             same shaders and specialization constants) along with the
+///             `ContentContextOptions::ToKey` value of one variant. The
+///             manifest is persisted by the pipeline library so that the
+///             next session can create the same variants before they are
+///             first used.
+///
+///             Entries are kept in the order they were recorded so that
+///             variants needed earliest are also created first.
+///
+class PipelineVariantManifest {
+ public:
+  struct Entry {
+    std::string pipeline_name;
+    uint64_t options_key = 0u;
+  };
+
+  PipelineVariantManifest();
+
+  ~PipelineVariantManifest();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parse a manifest previously created with `Serialize`.
+  ///
+  /// @return     The manifest or std::nullopt if the data was not produced by
+  ///             a compatible version of `Serialize`.
+  ///
+  static std::optional<PipelineVariantManifest> Parse(
+      const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record the use of a pipeline variant.
+  ///
+  /// @return     If the variant was not already present in the manifest.
+  ///
+  bool Record(std::string_view pipeline_name, uint64_t options_key);
+
+  const std::vector<Entry>& GetEntries() const;
+
+  std::shared_ptr<fml::Mapping> Serialize() const;
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_VARIANT_MANIFEST_H_
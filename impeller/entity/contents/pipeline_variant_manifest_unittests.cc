@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineVariantManifestTest, RecordsEachVariantOnce) {
+  PipelineVariantManifest manifest;
+  EXPECT_TRUE(manifest.Record("SolidFill Pipeline", 1u));
+  EXPECT_TRUE(manifest.Record("SolidFill Pipeline", 2u));
+  EXPECT_TRUE(manifest.Record("TextureFill Pipeline", 1u));
+  EXPECT_FALSE(manifest.Record("SolidFill Pipeline", 1u));
+
+  ASSERT_EQ(manifest.GetEntries().size(), 3u);
+  EXPECT_EQ(manifest.GetEntries()[0].pipeline_name, "SolidFill Pipeline");
+  EXPECT_EQ(manifest.GetEntries()[0].options_key, 1u);
+  EXPECT_EQ(manifest.GetEntries()[2].pipeline_name, "TextureFill Pipeline");
+}
+
+TEST(PipelineVariantManifestTest, CanSerializeAndParse) {
+  PipelineVariantManifest manifest;
+  manifest.Record("SolidFill Pipeline", 0x0001020304050607u);
+  manifest.Record("BlendColor Pipeline 3 1", 0xffffffffffffffffu);
+
+  auto mapping = manifest.Serialize();
+  ASSERT_NE(mapping, nullptr);
+
+  std::optional<PipelineVariantManifest> parsed =
+      PipelineVariantManifest::Parse(*mapping);
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_EQ(parsed->GetEntries().size(), 2u);
+  EXPECT_EQ(parsed->GetEntries()[0].pipeline_name, "SolidFill Pipeline");
+  EXPECT_EQ(parsed->GetEntries()[0].options_key, 0x0001020304050607u);
+  EXPECT_EQ(parsed->GetEntries()[1].pipeline_name, "BlendColor Pipeline 3 1");
+  EXPECT_EQ(parsed->GetEntries()[1].options_key, 0xffffffffffffffffu);
+}
+
+TEST(PipelineVariantManifestTest, RejectsMalformedData) {
+  EXPECT_FALSE(
+      PipelineVariantManifest::Parse(fml::DataMapping(std::string("")))
+          .has_value());
+  EXPECT_FALSE(PipelineVariantManifest::Parse(
+                   fml::DataMapping(std::string("impeller-pipeline-variants "
+                                                "0\n")))
+                   .has_value());
+  EXPECT_FALSE(PipelineVariantManifest::Parse(
+                   fml::DataMapping(std::string("impeller-pipeline-variants "
+                                                "1\nnot-a-key Pipeline\n")))
+                   .has_value());
+  // Truncated writes are rejected.
+  EXPECT_FALSE(PipelineVariantManifest::Parse(
+                   fml::DataMapping(std::string("impeller-pipeline-variants "
+                                                "1\n0000000000000001 Pipe")))
+                   .has_value());
+}
+
+TEST(PipelineVariantManifestTest, OptionsRoundTripThroughKeys) {
+  ContentContextOptions options{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kScreen,
+      .depth_compare = CompareFunction::kLessEqual,
+      .stencil_mode = ContentContextOptions::StencilMode::kCoverCompare,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      .has_depth_stencil_attachments = false,
+      .depth_write_enabled = true,
+      .wireframe = false,
+      .is_for_rrect_blur_clear = true,
+  };
+  uint64_t key = options.ToKey();
+  ContentContextOptions restored = ContentContextOptions::FromKey(key);
+  EXPECT_EQ(restored.ToKey(), key);
+  EXPECT_EQ(restored.sample_count, options.sample_count);
+  EXPECT_EQ(restored.blend_mode, options.blend_mode);
+  EXPECT_EQ(restored.depth_compare, options.depth_compare);
+  EXPECT_EQ(restored.stencil_mode, options.stencil_mode);
+  EXPECT_EQ(restored.primitive_type, options.primitive_type);
+  EXPECT_EQ(restored.color_attachment_pixel_format,
+            options.color_attachment_pixel_format);
+  EXPECT_EQ(restored.has_depth_stencil_attachments,
+            options.has_depth_stencil_attachments);
+  EXPECT_EQ(restored.depth_write_enabled, options.depth_write_enabled);
+  EXPECT_EQ(restored.is_for_rrect_blur_clear, options.is_for_rrect_blur_clear);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -4,13 +4,22 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <optional>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
+#include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/platform.h"
 #include "impeller/core/sampler_descriptor.h"
+#include "impeller/core/shader_types.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/color.h"
@@ -20,6 +29,57 @@
 
 namespace impeller {
 
+namespace {
+
+// All glyphs are drawn as a unit-sized quad that the vertex shader scales to
+// the size of the glyph. The interpolated position within the quad is also
+// used to sample from the glyph atlas.
+constexpr std::array<Point, 6> kUnitPoints = {Point{0, 0}, Point{1, 0},
+                                              Point{0, 1}, Point{1, 0},
+                                              Point{0, 1}, Point{1, 1}};
+
+// The per-glyph data of the instanced glyph atlas shader.
+struct GlyphInstance {
+  Point position;
+  Scalar glyph_index;
+  Padding<4> _padding_;
+};
+
+static_assert(sizeof(GlyphInstance) == 16);
+
+// A glyph in the atlas, shared by every instance of it in a text frame.
+struct AtlasGlyph {
+  Vector4 atlas_bounds;
+  Vector4 glyph_bounds;
+  Point subpixel_adjustment;
+  Padding<8> _padding_;
+};
+
+static_assert(sizeof(AtlasGlyph) == 48);
+
+// Glyph positions are adjusted based on the subpixel rounding used by the
+// font before they are snapped to the pixel grid.
+Point ComputeSubpixelAdjustment(AxisAlignment alignment) {
+  Point subpixel_adjustment(0.5, 0.5);
+  switch (alignment) {
+    case AxisAlignment::kNone:
+      break;
+    case AxisAlignment::kX:
+      subpixel_adjustment.x = 0.125;
+      break;
+    case AxisAlignment::kY:
+      subpixel_adjustment.y = 0.125;
+      break;
+    case AxisAlignment::kAll:
+      subpixel_adjustment.x = 0.125;
+      subpixel_adjustment.y = 0.125;
+      break;
+  }
+  return subpixel_adjustment;
+}
+
+}  // namespace
+
 TextContents::TextContents() = default;
 
 TextContents::~TextContents() = default;
@@ -95,36 +155,31 @@ bool TextContents::Render(const ContentContext& renderer,
   }
 
   // Information shared by all glyph draw calls.
-  pass.SetCommandLabel("TextFrame");
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  pass.SetPipeline(renderer.GetGlyphAtlasPipeline(opts));
 
   using VS = GlyphAtlasPipeline::VertexShader;
   using FS = GlyphAtlasPipeline::FragmentShader;
+  using SdfVS = GlyphAtlasSdfPipeline::VertexShader;
+  using SdfFS = GlyphAtlasSdfPipeline::FragmentShader;
+
+  const bool is_sdf = type == GlyphAtlas::Type::kSignedDistanceField;
 
   // Common vertex uniforms for all glyphs.
   VS::FrameInfo frame_info;
   frame_info.mvp =
       Entity::GetShaderTransform(entity.GetShaderClipDepth(), pass, Matrix());
-  ISize atlas_size = atlas->GetTexture()->GetSize();
   bool is_translation_scale = entity.GetTransform().IsTranslationScaleOnly();
   Matrix entity_transform = entity.GetTransform();
   Matrix basis_transform = entity_transform.Basis();
 
-  VS::BindFrameInfo(pass,
-                    renderer.GetTransientsBuffer().EmplaceUniform(frame_info));
-
   FS::FragInfo frag_info;
   frag_info.use_text_color = force_text_color_ ? 1.0 : 0.0;
   frag_info.text_color = ToVector(color.Premultiply());
   frag_info.is_color_glyph = type == GlyphAtlas::Type::kColorBitmap;
 
-  FS::BindFragInfo(pass,
-                   renderer.GetTransientsBuffer().EmplaceUniform(frag_info));
-
   SamplerDescriptor sampler_desc;
-  if (is_translation_scale) {
+  if (is_translation_scale && !is_sdf) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -133,6 +188,8 @@ bool TextContents::Render(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Distance fields are always drawn at a different scale than they were
+    // rasterized at and rely on linear sampling to reconstruct the outline.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
@@ -140,148 +197,435 @@ bool TextContents::Render(const ContentContext& renderer,
   // No mipmaps for glyph atlas (glyphs are generated at exact scales).
   sampler_desc.mip_filter = MipFilter::kBase;
 
-  FS::BindGlyphAtlasSampler(
-      pass,                 // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  // Where storage buffers are available, bitmap glyphs are drawn as instances
+  // of a single quad. Distance field glyphs and glyphs that are new to the
+  // atlas this frame write every vertex instead.
+  if (!is_sdf && renderer.GetDeviceCapabilities().SupportsSSBO()) {
+    if (const TextFrame::InstanceData* instance_data =
+            GetOrCreateInstanceData(renderer, *atlas, type)) {
+      return RenderInstanced(renderer, entity, pass, *atlas, *instance_data,
+                             opts, frag_info, sampler_desc);
+    }
+  }
 
-  // Common vertex information for all glyphs.
-  // All glyphs are given the same vertex information in the form of a
-  // unit-sized quad. The size of the glyph is specified in per instance data
-  // and the vertex shader uses this to size the glyph correctly. The
-  // interpolated vertex information is also used in the fragment shader to
-  // sample from the glyph atlas.
+  // Find the atlas location of each glyph. If frame_bounds.is_placeholder is
+  // true, this is the first frame the glyph has been rendered and so its
+  // atlas position was not known when the glyph was recorded. Perform a slow
+  // lookup into the glyph atlas hash table.
+  auto resolve_frame_bounds =
+      [&](const FrameBounds& frame_bounds, const Font& font,
+          Scalar rounded_scale, const TextRun::GlyphPosition& glyph_position,
+          FontGlyphAtlas*& font_atlas) -> std::optional<FrameBounds> {
+    if (!frame_bounds.is_placeholder) {
+      return frame_bounds;
+    }
+    if (!font_atlas) {
+      font_atlas =
+          atlas->GetOrCreateFontGlyphAtlas(ScaledFont{font, rounded_scale});
+    }
+    if (!font_atlas) {
+      VALIDATION_LOG << "Could not find font in the atlas.";
+      return std::nullopt;
+    }
+    // Note: uses unrounded scale for more accurate subpixel position.
+    Point subpixel =
+        is_sdf ? Point(0, 0)
+               : TextFrame::ComputeSubpixelPosition(
+                     glyph_position, font.GetAxisAlignment(), offset_, scale_);
+
+    std::optional<FrameBounds> maybe_atlas_glyph_bounds =
+        font_atlas->FindGlyphBounds(SubpixelGlyph{
+            glyph_position.glyph,  //
+            subpixel,              //
+            GetGlyphProperties()   //
+        });
+    if (!maybe_atlas_glyph_bounds.has_value()) {
+      VALIDATION_LOG << "Could not find glyph position in the atlas.";
+      return std::nullopt;
+    }
+    FrameBounds resolved = maybe_atlas_glyph_bounds.value();
+    resolved.glyph_bounds = frame_bounds.glyph_bounds;
+    return resolved;
+  };
+
+  // Glyphs are drawn with one draw call per atlas page. Count the glyphs on
+  // each page so that the vertices of each page are contiguous.
+  const size_t page_count = atlas->GetPageCount();
+  std::vector<size_t> page_offsets(page_count + 1, 0u);
+  if (page_count == 1) {
+    for (const auto& run : frame_->GetRuns()) {
+      page_offsets[1] += run.GetGlyphPositions().size();
+    }
+  } else {
+    size_t bounds_offset = 0u;
+    for (const TextRun& run : frame_->GetRuns()) {
+      const Font& font = run.GetFont();
+      Scalar rounded_scale = TextFrame::ComputeAtlasScale(
+          type, scale_, font.GetMetrics().point_size);
+      FontGlyphAtlas* font_atlas = nullptr;
+      for (const TextRun::GlyphPosition& glyph_position :
+           run.GetGlyphPositions()) {
+        std::optional<FrameBounds> frame_bounds = resolve_frame_bounds(
+            frame_->GetFrameBounds(bounds_offset++), font, rounded_scale,
+            glyph_position, font_atlas);
+        if (frame_bounds.has_value() &&
+            frame_bounds->page_index < page_count) {
+          page_offsets[frame_bounds->page_index + 1]++;
+        }
+      }
+    }
+  }
+  for (size_t i = 1; i <= page_count; i++) {
+    page_offsets[i] += page_offsets[i - 1];
+  }
+  const size_t vertex_count = page_offsets[page_count] * kUnitPoints.size();
+  if (vertex_count == 0) {
+    return true;
+  }
 
-  constexpr std::array<Point, 6> unit_points = {Point{0, 0}, Point{1, 0},
-                                                Point{0, 1}, Point{1, 0},
-                                                Point{0, 1}, Point{1, 1}};
+  // Write the vertices of every glyph. Signed distance field glyphs also
+  // record the number of device pixels covered by the range of the field,
+  // which varies with the font size of each run.
+  auto write_vertices = [&](auto* vtx_contents) {
+    using PerVertexData = std::remove_pointer_t<decltype(vtx_contents)>;
+    PerVertexData vtx;
+    // The next glyph to write on each page.
+    std::vector<size_t> page_cursors(page_offsets.begin(),
+                                     page_offsets.end() - 1);
+    size_t bounds_offset = 0u;
+    for (const TextRun& run : frame_->GetRuns()) {
+      const Font& font = run.GetFont();
+      Scalar rounded_scale = TextFrame::ComputeAtlasScale(
+          type, scale_, font.GetMetrics().point_size);
+      FontGlyphAtlas* font_atlas = nullptr;
+      if constexpr (std::is_same_v<PerVertexData, SdfVS::PerVertexData>) {
+        vtx.distance_scale =
+            2.0f * GlyphAtlas::kSignedDistanceFieldSpread * scale_ /
+            rounded_scale;
+      }
+
+      Point subpixel_adjustment =
+          ComputeSubpixelAdjustment(font.GetAxisAlignment());
+
+      Point screen_offset = (entity_transform * Point(0, 0));
+      for (const TextRun::GlyphPosition& glyph_position :
+           run.GetGlyphPositions()) {
+        std::optional<FrameBounds> frame_bounds = resolve_frame_bounds(
+            frame_->GetFrameBounds(bounds_offset++), font, rounded_scale,
+            glyph_position, font_atlas);
+        if (!frame_bounds.has_value() ||
+            frame_bounds->page_index >= page_count) {
+          continue;
+        }
+        auto atlas_glyph_bounds = frame_bounds->atlas_bounds;
+        auto glyph_bounds = frame_bounds->glyph_bounds;
+        ISize atlas_size =
+            atlas->GetPageTexture(frame_bounds->page_index)->GetSize();
+        size_t i =
+            page_cursors[frame_bounds->page_index]++ * kUnitPoints.size();
+
+        Rect scaled_bounds = glyph_bounds.Scale(1.0 / rounded_scale);
+        // For each glyph, we compute two rectangles. One for the vertex
+        // positions and one for the texture coordinates (UVs). The atlas
+        // glyph bounds are used to compute UVs in cases where the
+        // destination and source sizes may differ due to clamping the sizes
+        // of large glyphs.
+        Point uv_origin =
+            (atlas_glyph_bounds.GetLeftTop() - Point(0.5, 0.5)) / atlas_size;
+        Point uv_size =
+            (atlas_glyph_bounds.GetSize() + Point(1, 1)) / atlas_size;
+
+        Point unrounded_glyph_position =
+            basis_transform *
+            (glyph_position.position + scaled_bounds.GetLeftTop());
+
+        Point screen_glyph_position =
+            (screen_offset + unrounded_glyph_position + subpixel_adjustment)
+                .Floor();
+
+        for (const Point& point : kUnitPoints) {
+          Point position;
+          // Distance fields are not rasterized at the scale they are drawn
+          // at, so snapping them to the pixel grid doesn't make them sharper.
+          if (is_translation_scale && !is_sdf) {
+            position = (screen_glyph_position +
+                        (basis_transform * point * scaled_bounds.GetSize()))
+                           .Round();
+          } else {
+            position = entity_transform * (glyph_position.position +
+                                           scaled_bounds.GetLeftTop() +
+                                           point * scaled_bounds.GetSize());
+          }
+          vtx.uv = uv_origin + (uv_size * point);
+          vtx.position = position;
+          vtx_contents[i++] = vtx;
+        }
+      }
+    }
+  };
 
   auto& host_buffer = renderer.GetTransientsBuffer();
-  size_t vertex_count = 0;
-  for (const auto& run : frame_->GetRuns()) {
-    vertex_count += run.GetGlyphPositions().size();
+  BufferView buffer_view;
+  if (is_sdf) {
+    buffer_view = host_buffer.Emplace(
+        vertex_count * sizeof(SdfVS::PerVertexData),
+        alignof(SdfVS::PerVertexData), [&](uint8_t* contents) {
+          write_vertices(reinterpret_cast<SdfVS::PerVertexData*>(contents));
+        });
+  } else {
+    buffer_view = host_buffer.Emplace(
+        vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+        [&](uint8_t* contents) {
+          write_vertices(reinterpret_cast<VS::PerVertexData*>(contents));
+        });
   }
-  vertex_count *= 6;
-
-  BufferView buffer_view = host_buffer.Emplace(
-      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
-      [&](uint8_t* contents) {
-        VS::PerVertexData vtx;
-        VS::PerVertexData* vtx_contents =
-            reinterpret_cast<VS::PerVertexData*>(contents);
-        size_t i = 0u;
-        size_t bounds_offset = 0u;
-        for (const TextRun& run : frame_->GetRuns()) {
-          const Font& font = run.GetFont();
-          Scalar rounded_scale = TextFrame::RoundScaledFontSize(
-              scale_, font.GetMetrics().point_size);
-          FontGlyphAtlas* font_atlas = nullptr;
-
-          // Adjust glyph position based on the subpixel rounding
-          // used by the font.
-          Point subpixel_adjustment(0.5, 0.5);
-          switch (font.GetAxisAlignment()) {
-            case AxisAlignment::kNone:
-              break;
-            case AxisAlignment::kX:
-              subpixel_adjustment.x = 0.125;
-              break;
-            case AxisAlignment::kY:
-              subpixel_adjustment.y = 0.125;
-              break;
-            case AxisAlignment::kAll:
-              subpixel_adjustment.x = 0.125;
-              subpixel_adjustment.y = 0.125;
-              break;
-          }
 
-          Point screen_offset = (entity_transform * Point(0, 0));
-          for (const TextRun::GlyphPosition& glyph_position :
-               run.GetGlyphPositions()) {
-            const FrameBounds& frame_bounds =
-                frame_->GetFrameBounds(bounds_offset);
-            bounds_offset++;
-            auto atlas_glyph_bounds = frame_bounds.atlas_bounds;
-            auto glyph_bounds = frame_bounds.glyph_bounds;
-
-            // If frame_bounds.is_placeholder is true, this is the first frame
-            // the glyph has been rendered and so its atlas position was not
-            // known when the glyph was recorded. Perform a slow lookup into the
-            // glyph atlas hash table.
-            if (frame_bounds.is_placeholder) {
-              if (!font_atlas) {
-                font_atlas = atlas->GetOrCreateFontGlyphAtlas(
-                    ScaledFont{font, rounded_scale});
-              }
-
-              if (!font_atlas) {
-                VALIDATION_LOG << "Could not find font in the atlas.";
-                continue;
-              }
-              // Note: uses unrounded scale for more accurate subpixel position.
-              Point subpixel = TextFrame::ComputeSubpixelPosition(
-                  glyph_position, font.GetAxisAlignment(), offset_, scale_);
-
-              std::optional<FrameBounds> maybe_atlas_glyph_bounds =
-                  font_atlas->FindGlyphBounds(SubpixelGlyph{
-                      glyph_position.glyph,  //
-                      subpixel,              //
-                      GetGlyphProperties()   //
-                  });
-              if (!maybe_atlas_glyph_bounds.has_value()) {
-                VALIDATION_LOG << "Could not find glyph position in the atlas.";
-                continue;
-              }
-              atlas_glyph_bounds =
-                  maybe_atlas_glyph_bounds.value().atlas_bounds;
-            }
-
-            Rect scaled_bounds = glyph_bounds.Scale(1.0 / rounded_scale);
-            // For each glyph, we compute two rectangles. One for the vertex
-            // positions and one for the texture coordinates (UVs). The atlas
-            // glyph bounds are used to compute UVs in cases where the
-            // destination and source sizes may differ due to clamping the sizes
-            // of large glyphs.
-            Point uv_origin =
-                (atlas_glyph_bounds.GetLeftTop() - Point(0.5, 0.5)) /
-                atlas_size;
-            Point uv_size =
-                (atlas_glyph_bounds.GetSize() + Point(1, 1)) / atlas_size;
-
-            Point unrounded_glyph_position =
-                basis_transform *
-                (glyph_position.position + scaled_bounds.GetLeftTop());
-
-            Point screen_glyph_position =
-                (screen_offset + unrounded_glyph_position + subpixel_adjustment)
-                    .Floor();
-
-            for (const Point& point : unit_points) {
-              Point position;
-              if (is_translation_scale) {
-                position = (screen_glyph_position +
-                            (basis_transform * point * scaled_bounds.GetSize()))
-                               .Round();
-              } else {
-                position = entity_transform * (glyph_position.position +
-                                               scaled_bounds.GetLeftTop() +
-                                               point * scaled_bounds.GetSize());
-              }
-              vtx.uv = uv_origin + (uv_size * point);
-              vtx.position = position;
-              vtx_contents[i++] = vtx;
-            }
-          }
-        }
+  BufferView frame_info_view =
+      renderer.GetTransientsBuffer().EmplaceUniform(frame_info);
+  BufferView frag_info_view;
+  if (is_sdf) {
+    SdfFS::FragInfo sdf_frag_info;
+    sdf_frag_info.text_color = frag_info.text_color;
+    frag_info_view =
+        renderer.GetTransientsBuffer().EmplaceUniform(sdf_frag_info);
+  } else {
+    frag_info_view = renderer.GetTransientsBuffer().EmplaceUniform(frag_info);
+  }
+  const std::unique_ptr<const Sampler>& sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+
+  for (size_t page = 0; page < page_count; page++) {
+    size_t page_glyph_count = page_offsets[page + 1] - page_offsets[page];
+    if (page_glyph_count == 0) {
+      continue;
+    }
+    pass.SetCommandLabel("TextFrame");
+    if (is_sdf) {
+      pass.SetPipeline(renderer.GetGlyphAtlasSdfPipeline(opts));
+      // The frame info of both vertex shaders has the same layout.
+      SdfVS::BindFrameInfo(pass, frame_info_view);
+      SdfFS::BindFragInfo(pass, frag_info_view);
+      SdfFS::BindGlyphAtlasSampler(pass,                         // command
+                                   atlas->GetPageTexture(page),  // texture
+                                   sampler                       // sampler
+      );
+    } else {
+      pass.SetPipeline(renderer.GetGlyphAtlasPipeline(opts));
+      VS::BindFrameInfo(pass, frame_info_view);
+      FS::BindFragInfo(pass, frag_info_view);
+      FS::BindGlyphAtlasSampler(pass,                         // command
+                                atlas->GetPageTexture(page),  // texture
+                                sampler                       // sampler
+      );
+    }
+    pass.SetVertexBuffer(buffer_view);
+    pass.SetIndexBuffer({}, IndexType::kNone);
+    pass.SetBaseVertex(page_offsets[page] * kUnitPoints.size());
+    pass.SetElementCount(page_glyph_count * kUnitPoints.size());
+    if (!pass.Draw().ok()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const TextFrame::InstanceData* TextContents::GetOrCreateInstanceData(
+    const ContentContext& renderer,
+    const GlyphAtlas& atlas,
+    GlyphAtlas::Type type) const {
+  if (TextFrame::InstanceData* cached = frame_->GetInstanceData(type)) {
+    cached->stable_frame_count++;
+    return UploadInstanceData(renderer, *cached) ? cached : nullptr;
+  }
+
+  const size_t page_count = atlas.GetPageCount();
+  std::vector<std::vector<GlyphInstance>> page_instances(page_count);
+  std::vector<AtlasGlyph> atlas_glyphs;
+  // Maps the page and atlas location of a glyph to its index in
+  // |atlas_glyphs|.
+  std::unordered_map<uint64_t, size_t> atlas_glyph_indices;
+  size_t bounds_offset = 0u;
+  for (const TextRun& run : frame_->GetRuns()) {
+    const Font& font = run.GetFont();
+    Scalar rounded_scale = TextFrame::ComputeAtlasScale(
+        type, scale_, font.GetMetrics().point_size);
+    Point subpixel_adjustment =
+        ComputeSubpixelAdjustment(font.GetAxisAlignment());
+    for (const TextRun::GlyphPosition& glyph_position :
+         run.GetGlyphPositions()) {
+      const FrameBounds& frame_bounds =
+          frame_->GetFrameBounds(bounds_offset++);
+      if (frame_bounds.is_placeholder) {
+        // The glyph was added to the atlas this frame, so its location has to
+        // be looked up while writing the vertices.
+        return nullptr;
+      }
+      if (frame_bounds.page_index >= page_count) {
+        continue;
+      }
+      const Rect& atlas_bounds = frame_bounds.atlas_bounds;
+      uint64_t key = (static_cast<uint64_t>(frame_bounds.page_index) << 48) |
+                     (static_cast<uint64_t>(atlas_bounds.GetX()) << 24) |
+                     static_cast<uint64_t>(atlas_bounds.GetY());
+      auto [found, inserted] =
+          atlas_glyph_indices.try_emplace(key, atlas_glyphs.size());
+      if (inserted) {
+        Rect scaled_bounds =
+            frame_bounds.glyph_bounds.Scale(1.0 / rounded_scale);
+        atlas_glyphs.push_back(AtlasGlyph{
+            .atlas_bounds = Vector4(atlas_bounds.GetX(), atlas_bounds.GetY(),
+                                    atlas_bounds.GetWidth(),
+                                    atlas_bounds.GetHeight()),
+            .glyph_bounds =
+                Vector4(scaled_bounds.GetX(), scaled_bounds.GetY(),
+                        scaled_bounds.GetWidth(), scaled_bounds.GetHeight()),
+            .subpixel_adjustment = subpixel_adjustment,
+        });
+      }
+      page_instances[frame_bounds.page_index].push_back(GlyphInstance{
+          .position = glyph_position.position,
+          .glyph_index = static_cast<Scalar>(found->second),
       });
+    }
+  }
+  if (atlas_glyphs.empty()) {
+    return nullptr;
+  }
 
-  pass.SetVertexBuffer(std::move(buffer_view));
-  pass.SetIndexBuffer({}, IndexType::kNone);
-  pass.SetElementCount(vertex_count);
+  TextFrame::InstanceData instance_data;
+  instance_data.type = type;
+  instance_data.scale = scale_;
+  instance_data.page_offsets.reserve(page_count + 1);
+  std::vector<GlyphInstance> instances;
+  for (const std::vector<GlyphInstance>& page : page_instances) {
+    instance_data.page_offsets.push_back(instances.size());
+    instances.insert(instances.end(), page.begin(), page.end());
+  }
+  instance_data.page_offsets.push_back(instances.size());
+
+  auto as_bytes = [](const auto& values) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(values.data());
+    return std::vector<uint8_t>(
+        data, data + values.size() * sizeof(*values.data()));
+  };
+  instance_data.instance_bytes = as_bytes(instances);
+  instance_data.atlas_glyph_bytes = as_bytes(atlas_glyphs);
+  // Compare against the bounds of the next frame to decide whether the data
+  // can be drawn again.
+  for (size_t i = 0; i < bounds_offset; i++) {
+    instance_data.frame_bounds.push_back(frame_->GetFrameBounds(i));
+  }
+  if (!UploadInstanceData(renderer, instance_data)) {
+    return nullptr;
+  }
+  frame_->SetInstanceData(std::move(instance_data));
+  return frame_->GetInstanceData(type);
+}
+
+bool TextContents::UploadInstanceData(
+    const ContentContext& renderer,
+    TextFrame::InstanceData& instance_data) {
+  // Already promoted to device buffers.
+  if (instance_data.instance_bytes.empty()) {
+    return true;
+  }
 
-  return pass.Draw().ok();
+  // Text that is only drawn for a few frames, or whose glyphs keep moving
+  // within the atlas, is uploaded to the transients buffer like any other
+  // per-frame data. Only once the data has been reused for a few frames is it
+  // worth allocating buffers of its own so that later frames can draw the
+  // text frame without uploading it again.
+  if (instance_data.stable_frame_count <
+      TextFrame::kInstanceDataStableFrameCount) {
+    auto& host_buffer = renderer.GetTransientsBuffer();
+    instance_data.instances = host_buffer.Emplace(
+        instance_data.instance_bytes.data(),
+        instance_data.instance_bytes.size(),
+        std::max(alignof(GlyphInstance), DefaultUniformAlignment()));
+    instance_data.atlas_glyphs = host_buffer.Emplace(
+        instance_data.atlas_glyph_bytes.data(),
+        instance_data.atlas_glyph_bytes.size(),
+        std::max(alignof(AtlasGlyph), DefaultUniformAlignment()));
+    return true;
+  }
+
+  const std::shared_ptr<Allocator>& allocator =
+      renderer.GetContext()->GetResourceAllocator();
+  auto instance_buffer =
+      allocator->CreateBufferWithCopy(instance_data.instance_bytes.data(),
+                                      instance_data.instance_bytes.size());
+  auto atlas_glyph_buffer =
+      allocator->CreateBufferWithCopy(instance_data.atlas_glyph_bytes.data(),
+                                      instance_data.atlas_glyph_bytes.size());
+  if (!instance_buffer || !atlas_glyph_buffer) {
+    return false;
+  }
+  instance_data.instances =
+      DeviceBuffer::AsBufferView(std::move(instance_buffer));
+  instance_data.atlas_glyphs =
+      DeviceBuffer::AsBufferView(std::move(atlas_glyph_buffer));
+  instance_data.instance_bytes = {};
+  instance_data.atlas_glyph_bytes = {};
+  return true;
+}
+
+bool TextContents::RenderInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const GlyphAtlas& atlas,
+    const TextFrame::InstanceData& instance_data,
+    ContentContextOptions opts,
+    const GlyphAtlasInstancedPipeline::FragmentShader::FragInfo& frag_info,
+    const SamplerDescriptor& sampler_desc) const {
+  using VS = GlyphAtlasInstancedPipeline::VertexShader;
+  using FS = GlyphAtlasInstancedPipeline::FragmentShader;
+
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  BufferView unit_points_view = host_buffer.Emplace(
+      kUnitPoints.data(), sizeof(kUnitPoints), alignof(Point));
+  BufferView frag_info_view = host_buffer.EmplaceUniform(frag_info);
+  const std::unique_ptr<const Sampler>& sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+
+  // Only the translation of the entity changes while text scrolls, which is
+  // applied by the vertex shader.
+  VS::FrameInfo frame_info;
+  frame_info.mvp =
+      Entity::GetShaderTransform(entity.GetShaderClipDepth(), pass, Matrix());
+  frame_info.entity_transform = entity.GetTransform();
+  frame_info.snap_to_pixels =
+      entity.GetTransform().IsTranslationScaleOnly() ? 1.0 : 0.0;
+
+  const std::vector<size_t>& page_offsets = instance_data.page_offsets;
+  for (size_t page = 0; page + 1 < page_offsets.size(); page++) {
+    size_t page_glyph_count = page_offsets[page + 1] - page_offsets[page];
+    if (page_glyph_count == 0) {
+      continue;
+    }
+    const std::shared_ptr<Texture>& texture = atlas.GetPageTexture(page);
+    frame_info.atlas_size = Point(texture->GetSize());
+    frame_info.instance_offset = page_offsets[page];
+
+    pass.SetCommandLabel("TextFrame");
+    pass.SetPipeline(renderer.GetGlyphAtlasInstancedPipeline(opts));
+    VS::BindFrameInfo(pass, host_buffer.EmplaceUniform(frame_info));
+    VS::BindGlyphInstanceData(pass, instance_data.instances);
+    VS::BindAtlasGlyphData(pass, instance_data.atlas_glyphs);
+    FS::BindFragInfo(pass, frag_info_view);
+    FS::BindGlyphAtlasSampler(pass,     // command
+                              texture,  // texture
+                              sampler   // sampler
+    );
+    pass.SetVertexBuffer(unit_points_view);
+    pass.SetIndexBuffer({}, IndexType::kNone);
+    pass.SetElementCount(kUnitPoints.size());
+    pass.SetInstanceCount(page_glyph_count);
+    if (!pass.Draw().ok()) {
+      return false;
+    }
+  }
+  return true;
 }
 
 std::optional<GlyphProperties> TextContents::GetGlyphProperties() const {
@@ -7,6 +7,8 @@
 
 #include <memory>
 
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/contents.h"
 #include "impeller/geometry/color.h"
 #include "impeller/typographer/font_glyph_pair.h"
@@ -64,6 +66,33 @@ class TextContents final : public Contents {
  private:
   std::optional<GlyphProperties> GetGlyphProperties() const;
 
+  // Returns the instance data of the text frame for the glyph bounds of the
+  // current frame, generating it if they changed and uploading it if it is
+  // not yet held in device buffers of its own. Returns nullptr if the text
+  // frame cannot be drawn with instancing this frame.
+  const TextFrame::InstanceData* GetOrCreateInstanceData(
+      const ContentContext& renderer,
+      const GlyphAtlas& atlas,
+      GlyphAtlas::Type type) const;
+
+  // Uploads instance data that is not yet held in device buffers of its own
+  // to the transients buffer, or promotes it to device buffers once it has
+  // been reused for |TextFrame::kInstanceDataStableFrameCount| frames.
+  static bool UploadInstanceData(const ContentContext& renderer,
+                                 TextFrame::InstanceData& instance_data);
+
+  // Draws every glyph of the text frame as an instance of a quad, with one
+  // draw call per atlas page.
+  bool RenderInstanced(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      const GlyphAtlas& atlas,
+      const TextFrame::InstanceData& instance_data,
+      ContentContextOptions opts,
+      const GlyphAtlasInstancedPipeline::FragmentShader::FragInfo& frag_info,
+      const SamplerDescriptor& sampler_desc) const;
+
   std::shared_ptr<TextFrame> frame_;
   Scalar scale_ = 1.0;
   Scalar inherited_opacity_ = 1.0;
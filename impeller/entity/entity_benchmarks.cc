@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
+
+namespace impeller {
+
+namespace {
+/// The texture reads and writes of the passes of a blur.
+struct BlurPassCost {
+  size_t pass_count = 0u;
+  size_t texture_reads = 0u;
+  size_t pixels_written = 0u;
+};
+
+/// The cost of the passes that GaussianBlurFilterContents plans for a blur of
+/// an input of |size|.
+BlurPassCost CalculateBlurCost(ISize size,
+                               Scalar sigma,
+                               BlurAlgorithm algorithm,
+                               BlurQuality quality) {
+  GaussianBlurFilterContents contents(sigma, sigma, Entity::TileMode::kDecal,
+                                      FilterContents::BlurStyle::kNormal);
+  BlurPassCost cost;
+  for (const BlurPass& pass :
+       contents.CalculatePasses(size, algorithm, quality)) {
+    cost.pass_count++;
+    cost.texture_reads += pass.size.Area() * pass.sample_count;
+    cost.pixels_written += pass.size.Area();
+  }
+  return cost;
+}
+
+void ReportBlurCost(benchmark::State& state, const BlurPassCost& cost) {
+  state.counters["Passes"] = cost.pass_count;
+  state.counters["TextureReads"] = cost.texture_reads;
+  state.counters["PixelsWritten"] = cost.pixels_written;
+}
+
+void BlurSigmaArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int sigma : {5, 10, 20, 40, 60, 80, 100}) {
+    benchmark->Arg(sigma);
+  }
+}
+}  // namespace
+
+/// Plan the passes of a blur of a whole target of the given size, and count
+/// the texture reads and writes of the plan. GPU time is dominated by those
+/// for large blurs, but isn't measured here: these run without a GPU context.
+static void BM_GaussianBlurPasses(benchmark::State& state, ISize size) {
+  Scalar sigma = state.range(0);
+  BlurPassCost cost;
+  while (state.KeepRunning()) {
+    cost = CalculateBlurCost(size, sigma, BlurAlgorithm::kGaussian,
+                             BlurQuality::kHigh);
+  }
+  ReportBlurCost(state, cost);
+}
+
+static void BM_DualKawaseBlurPasses(benchmark::State& state,
+                                    ISize size,
+                                    BlurQuality quality) {
+  Scalar sigma = state.range(0);
+  BlurPassCost cost;
+  while (state.KeepRunning()) {
+    cost = CalculateBlurCost(size, sigma, BlurAlgorithm::kDualKawase, quality);
+  }
+  ReportBlurCost(state, cost);
+}
+
+BENCHMARK_CAPTURE(BM_GaussianBlurPasses, 1080p, ISize(1920, 1080))
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_GaussianBlurPasses, 4k, ISize(3840, 2160))
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_DualKawaseBlurPasses,
+                  1080p_high,
+                  ISize(1920, 1080),
+                  BlurQuality::kHigh)
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_DualKawaseBlurPasses,
+                  1080p_medium,
+                  ISize(1920, 1080),
+                  BlurQuality::kMedium)
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_DualKawaseBlurPasses,
+                  1080p_low,
+                  ISize(1920, 1080),
+                  BlurQuality::kLow)
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_DualKawaseBlurPasses,
+                  4k_high,
+                  ISize(3840, 2160),
+                  BlurQuality::kHigh)
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_DualKawaseBlurPasses,
+                  4k_medium,
+                  ISize(3840, 2160),
+                  BlurQuality::kMedium)
+    ->Apply(BlurSigmaArguments);
+BENCHMARK_CAPTURE(BM_DualKawaseBlurPasses,
+                  4k_low,
+                  ISize(3840, 2160),
+                  BlurQuality::kLow)
+    ->Apply(BlurSigmaArguments);
+
+}  // namespace impeller
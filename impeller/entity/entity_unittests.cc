@@ -11,6 +11,7 @@
 
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "fml/logging.h"
+#include "fml/synchronization/waitable_event.h"
 #include "gtest/gtest.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
@@ -22,6 +23,7 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/fused_color_filter_contents.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
@@ -1574,6 +1576,155 @@ TEST_P(EntityTest, SrgbToLinearFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+static std::shared_ptr<Texture> CreateTestPixelsTexture(
+    Context& context,
+    const std::vector<uint8_t>& pixels) {
+  TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = StorageMode::kHostVisible;
+  texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_descriptor.size = {static_cast<int64_t>(pixels.size() / 4), 1};
+  auto texture =
+      context.GetResourceAllocator()->CreateTexture(texture_descriptor);
+  auto buffer = context.GetResourceAllocator()->CreateBufferWithCopy(
+      pixels.data(), pixels.size());
+
+  auto cmd_buffer = context.CreateCommandBuffer();
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!texture || !buffer ||
+      !blit_pass->AddCopy(DeviceBuffer::AsBufferView(buffer), texture) ||
+      !blit_pass->EncodeCommands(context.GetResourceAllocator()) ||
+      !context.GetCommandQueue()->Submit({cmd_buffer}).ok()) {
+    return nullptr;
+  }
+  return texture;
+}
+
+static std::vector<uint8_t> ReadTestPixels(
+    Context& context,
+    const std::shared_ptr<Texture>& texture) {
+  DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.storage_mode = StorageMode::kHostVisible;
+  buffer_descriptor.size =
+      texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  auto buffer = context.GetResourceAllocator()->CreateBuffer(buffer_descriptor);
+
+  auto cmd_buffer = context.CreateCommandBuffer();
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!buffer || !blit_pass->AddCopy(texture, buffer) ||
+      !blit_pass->EncodeCommands(context.GetResourceAllocator())) {
+    return {};
+  }
+  fml::AutoResetWaitableEvent latch;
+  if (!context.GetCommandQueue()
+           ->Submit({cmd_buffer},
+                    [&latch](CommandBuffer::Status status) { latch.Signal(); })
+           .ok()) {
+    return {};
+  }
+  latch.Wait();
+  const uint8_t* contents = buffer->OnGetContents();
+  return std::vector<uint8_t>(contents, contents + buffer_descriptor.size);
+}
+
+TEST_P(EntityTest, FusedColorFilterMatchesSeparateFilters) {
+  // clang-format off
+  ColorMatrix brighten = {
+    .array = {
+      1, 0, 0, 0, 0.5, //
+      0, 1, 0, 0, 0.5, //
+      0, 0, 1, 0, 0.5, //
+      0, 0, 0, 1, 0    //
+    }
+  };
+  ColorMatrix invert_colors = {
+    .array = {
+      -1.0,    0,    0, 1.0, 0, //
+         0, -1.0,    0, 1.0, 0, //
+         0,    0, -1.0, 1.0, 0, //
+       1.0,  1.0,  1.0, 1.0, 0  //
+    }
+  };
+  ColorMatrix grayscale = {
+    .array = {
+      0.2126, 0.7152, 0.0722, 0, 0, //
+      0.2126, 0.7152, 0.0722, 0, 0, //
+      0.2126, 0.7152, 0.0722, 0, 0, //
+      0,      0,      0,      1, 0  //
+    }
+  };
+  // clang-format on
+  auto matrix = [](const ColorMatrix& color_matrix) {
+    return ColorFilterStage{.type = ColorFilterStage::Type::kColorMatrix,
+                            .color_matrix = color_matrix};
+  };
+  auto blend = [](BlendMode blend_mode, Color color) {
+    return ColorFilterStage{.type = ColorFilterStage::Type::kBlend,
+                            .blend_mode = blend_mode,
+                            .color = color};
+  };
+
+  // Every chain saturates between stages, either in a matrix or in a blend,
+  // and must still match the separate filters which clamp when they store
+  // each intermediate.
+  std::vector<std::vector<ColorFilterStage>> chains = {
+      {{.type = ColorFilterStage::Type::kSrgbToLinear},
+       matrix(brighten),
+       blend(BlendMode::kPlus, Color(0.5, 0.25, 0.0, 0.5)),
+       {.type = ColorFilterStage::Type::kLinearToSrgb}},
+      {matrix(invert_colors),
+       blend(BlendMode::kSourceOver, Color(0.0, 0.0, 1.0, 0.5)),
+       matrix(grayscale),
+       blend(BlendMode::kDestinationOver, Color::Red())},
+  };
+
+  // Premultiplied. Channels are either zero or well above it so that storing
+  // linear colors in 8 bits between the separate sRGB filters stays within
+  // the tolerance below.
+  // clang-format off
+  std::vector<uint8_t> pixels = {
+    255, 0,   0,   255, //
+    41,  82,  122, 204, //
+    128, 128, 128, 128, //
+    0,   0,   0,   0,   //
+  };
+  // clang-format on
+  auto texture = CreateTestPixelsTexture(*GetContext(), pixels);
+  ASSERT_TRUE(texture);
+
+  ContentContext renderer(GetContext(), /*typographer_context=*/nullptr);
+  Entity entity;
+  for (size_t i = 0; i < chains.size(); i++) {
+    ASSERT_EQ(PlanColorFilterPasses(chains[i]).size(), 1u) << i;
+
+    std::shared_ptr<FilterContents> fused = ColorFilterContents::MakeFused(
+        FilterInput::Make(texture), chains[i],
+        ColorFilterContents::AbsorbOpacity::kYes);
+    std::shared_ptr<FilterContents> separate;
+    for (const ColorFilterStage& stage : chains[i]) {
+      separate = ColorFilterContents::MakeFused(
+          separate ? FilterInput::Make(separate) : FilterInput::Make(texture),
+          {stage}, ColorFilterContents::AbsorbOpacity::kYes);
+    }
+    ASSERT_TRUE(fused && separate) << i;
+
+    std::optional<Snapshot> fused_snapshot =
+        fused->RenderToSnapshot(renderer, entity);
+    std::optional<Snapshot> separate_snapshot =
+        separate->RenderToSnapshot(renderer, entity);
+    ASSERT_TRUE(fused_snapshot.has_value() && separate_snapshot.has_value());
+
+    std::vector<uint8_t> fused_pixels =
+        ReadTestPixels(*GetContext(), fused_snapshot->texture);
+    std::vector<uint8_t> separate_pixels =
+        ReadTestPixels(*GetContext(), separate_snapshot->texture);
+    ASSERT_FALSE(fused_pixels.empty());
+    ASSERT_EQ(fused_pixels.size(), separate_pixels.size());
+    for (size_t j = 0; j < fused_pixels.size(); j++) {
+      EXPECT_NEAR(fused_pixels[j], separate_pixels[j], 3) << i << ", " << j;
+    }
+  }
+}
+
 static Vector3 RGBToYUV(Vector3 rgb, YUVColorSpace yuv_color_space) {
   Vector3 yuv;
   switch (yuv_color_space) {
@@ -2385,41 +2536,20 @@ TEST_P(EntityTest, GiantStrokePathAllocation) {
   GeometryResult result =
       geom->GetPositionBuffer(content_context, entity, *pass);
 
-  // Validate the buffer data overflowed the small buffer
-  EXPECT_GT(result.vertex_buffer.vertex_count, kPointArenaSize);
+  // The vertices written directly into the host buffer must match the ones
+  // generated into a vector for the same polyline.
+  std::vector<Point> expected = StrokePathGeometry::GenerateSolidStrokeVertices(
+      path.CreatePolyline(1.0f), /*stroke_width=*/10, /*miter_limit=*/4.0,
+      Join::kMiter, Cap::kButt, /*scale=*/1.0);
+  ASSERT_EQ(result.vertex_buffer.vertex_count, expected.size());
 
-  // Validate that there are no uninitialized points near the gap.
   Point* written_data = reinterpret_cast<Point*>(
       (result.vertex_buffer.vertex_buffer.GetBuffer()->OnGetContents() +
        result.vertex_buffer.vertex_buffer.GetRange().offset));
-
-  std::vector<Point> expected = {
-      Point(1019.46, 1026.54),  //
-      Point(1026.54, 1019.46),  //
-      Point(1020.45, 1027.54),  //
-      Point(1027.54, 1020.46),  //
-      Point(1020.46, 1027.53)   //
-  };
-
-  Point point = written_data[kPointArenaSize - 2];
-  EXPECT_NEAR(point.x, expected[0].x, 0.1);
-  EXPECT_NEAR(point.y, expected[0].y, 0.1);
-
-  point = written_data[kPointArenaSize - 1];
-  EXPECT_NEAR(point.x, expected[1].x, 0.1);
-  EXPECT_NEAR(point.y, expected[1].y, 0.1);
-
-  point = written_data[kPointArenaSize];
-  EXPECT_NEAR(point.x, expected[2].x, 0.1);
-  EXPECT_NEAR(point.y, expected[2].y, 0.1);
-
-  point = written_data[kPointArenaSize + 1];
-  EXPECT_NEAR(point.x, expected[3].x, 0.1);
-  EXPECT_NEAR(point.y, expected[3].y, 0.1);
-
-  point = written_data[kPointArenaSize + 2];
-  EXPECT_NEAR(point.x, expected[4].x, 0.1);
-  EXPECT_NEAR(point.y, expected[4].y, 0.1);
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(written_data[i].x, expected[i].x, 0.1) << i;
+    EXPECT_NEAR(written_data[i].y, expected[i].y, 0.1) << i;
+  }
 }
 
 TEST_P(EntityTest, GiantLineStripPathAllocation) {
@@ -2438,41 +2568,17 @@ TEST_P(EntityTest, GiantLineStripPathAllocation) {
 
   auto vertex_buffer = tessellator.GenerateLineStrip(path, *host_buffer, 1.0);
 
-  // Validate the buffer data overflowed the small buffer
-  EXPECT_GT(vertex_buffer.vertex_count, kPointArenaSize);
-
-  // Validate that there are no uninitialized points near the gap.
+  // Every vertex of the line strip is written, in order. The first line goes
+  // from the origin to (0, 0), so the origin is written twice.
+  ASSERT_EQ(vertex_buffer.vertex_count, 10001u);
   Point* written_data = reinterpret_cast<Point*>(
       (vertex_buffer.vertex_buffer.GetBuffer()->OnGetContents() +
        vertex_buffer.vertex_buffer.GetRange().offset));
-
-  std::vector<Point> expected = {
-      Point(4093, 4093),  //
-      Point(4094, 4094),  //
-      Point(4095, 4095),  //
-      Point(4096, 4096),  //
-      Point(4097, 4097)   //
-  };
-
-  Point point = written_data[kPointArenaSize - 2];
-  EXPECT_NEAR(point.x, expected[0].x, 0.1);
-  EXPECT_NEAR(point.y, expected[0].y, 0.1);
-
-  point = written_data[kPointArenaSize - 1];
-  EXPECT_NEAR(point.x, expected[1].x, 0.1);
-  EXPECT_NEAR(point.y, expected[1].y, 0.1);
-
-  point = written_data[kPointArenaSize];
-  EXPECT_NEAR(point.x, expected[2].x, 0.1);
-  EXPECT_NEAR(point.y, expected[2].y, 0.1);
-
-  point = written_data[kPointArenaSize + 1];
-  EXPECT_NEAR(point.x, expected[3].x, 0.1);
-  EXPECT_NEAR(point.y, expected[3].y, 0.1);
-
-  point = written_data[kPointArenaSize + 2];
-  EXPECT_NEAR(point.x, expected[4].x, 0.1);
-  EXPECT_NEAR(point.y, expected[4].y, 0.1);
+  EXPECT_EQ(written_data[0], Point(0, 0));
+  for (size_t i = 1; i < vertex_buffer.vertex_count; i++) {
+    EXPECT_NEAR(written_data[i].x, i - 1, 0.1) << i;
+    EXPECT_NEAR(written_data[i].y, i - 1, 0.1) << i;
+  }
 }
 
 }  // namespace testing
@@ -4,17 +4,102 @@
 
 #include "impeller/entity/geometry/fill_path_geometry.h"
 
+#include <array>
+
 #include "fml/logging.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/renderer/compute_tessellator.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
+namespace {
+
+/// Paths with more linear components than this are always stenciled, as the
+/// cost of proving convexity on the CPU is no longer worth the saved stencil
+/// pass.
+constexpr size_t kMaxConvexityCheckComponents = 64u;
+
+/// Whether the path is a single polygon made only of lines that is convex
+/// and does not self intersect.
+///
+/// Paths built from rects, ovals and round rects are already marked convex
+/// by the |PathBuilder|. This catches the remaining small polygons, such as
+/// icons and SVG shapes, which can then be drawn directly instead of with
+/// stencil-then-cover.
+bool IsSmallConvexPolygon(const Path& path) {
+  if (!path.IsSingleContour() ||
+      path.GetComponentCount() > kMaxConvexityCheckComponents ||
+      path.GetComponentCount(Path::ComponentType::kQuadratic) > 0 ||
+      path.GetComponentCount(Path::ComponentType::kCubic) > 0) {
+    return false;
+  }
+
+  // The first line adds two points and every other line at most one.
+  std::array<Point, kMaxConvexityCheckComponents + 1> points;
+  size_t point_count = 0;
+  path.EnumerateComponents(
+      [&points, &point_count](size_t index, const LinearPathComponent& linear) {
+        if (point_count == 0) {
+          points[point_count++] = linear.p1;
+        }
+        if (points[point_count - 1] != linear.p2) {
+          points[point_count++] = linear.p2;
+        }
+      },
+      {}, {}, {});
+  // The fill implicitly closes the contour.
+  while (point_count > 1 && points[point_count - 1] == points[0]) {
+    point_count--;
+  }
+  if (point_count < 3) {
+    return false;
+  }
+
+  // A polygon is convex if every corner turns in the same direction and the
+  // edges sweep through the x axis direction at most twice. The second check
+  // rejects self intersecting shapes, such as stars, that still turn in a
+  // consistent direction.
+  Scalar turn_direction = 0;
+  size_t x_direction_changes = 0;
+  Scalar previous_dx = points[0].x - points[point_count - 1].x;
+  for (size_t i = 0; i < point_count; i++) {
+    const Point& prev = points[(i + point_count - 1) % point_count];
+    const Point& current = points[i];
+    const Point& next = points[(i + 1) % point_count];
+
+    Scalar cross = (current - prev).Cross(next - current);
+    if (cross != 0) {
+      if (turn_direction == 0) {
+        turn_direction = cross;
+      } else if ((cross > 0) != (turn_direction > 0)) {
+        return false;
+      }
+    }
+
+    Scalar dx = next.x - current.x;
+    if (dx != 0) {
+      if (previous_dx != 0 && (dx > 0) != (previous_dx > 0)) {
+        x_direction_changes++;
+      }
+      previous_dx = dx;
+    }
+  }
+  return turn_direction != 0 && x_direction_changes <= 2;
+}
+
+}  // namespace
+
 FillPathGeometry::FillPathGeometry(const Path& path,
                                    std::optional<Rect> inner_rect)
-    : path_(path), inner_rect_(inner_rect) {}
+    : path_(path),
+      inner_rect_(inner_rect),
+      is_convex_(path.IsConvex() || IsSmallConvexPolygon(path)) {}
 
 FillPathGeometry::~FillPathGeometry() {}
 
@@ -38,6 +123,30 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     };
   }
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+  // Complex paths that are stenciled anyway are flattened on the GPU. The
+  // fan written by the compute tessellator has the same winding as the one
+  // generated on the CPU below.
+  if (!is_convex_ && renderer.IsComputeTessellationEnabled() &&
+      ComputeTessellator::ShouldTessellate(path_,
+                                           renderer.GetDeviceCapabilities())) {
+    ComputeTessellator tessellator;
+    tessellator.SetStyle(ComputeTessellator::Style::kFill)
+        .SetScale(entity.GetTransform().GetMaxBasisLengthXY());
+    VertexBuffer vertex_buffer;
+    if (tessellator.Tessellate(path_, host_buffer, renderer.GetContext(),
+                               vertex_buffer) ==
+        ComputeTessellator::Status::kOk) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = std::move(vertex_buffer),
+          .transform = entity.GetShaderTransform(pass),
+          .mode = GetResultMode(),
+      };
+    }
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
   bool supports_primitive_restart =
       renderer.GetDeviceCapabilities().SupportsPrimitiveRestart();
   bool supports_triangle_fan =
@@ -59,8 +168,7 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
 
 GeometryResult::Mode FillPathGeometry::GetResultMode() const {
   const auto& bounding_box = path_.GetBoundingBox();
-  if (path_.IsConvex() ||
-      (bounding_box.has_value() && bounding_box->IsEmpty())) {
+  if (is_convex_ || (bounding_box.has_value() && bounding_box->IsEmpty())) {
     return GeometryResult::Mode::kNormal;
   }
 
@@ -13,6 +13,11 @@
 namespace impeller {
 
 /// @brief A geometry that is created from a filled path object.
+///
+///        Convex paths are drawn directly as a triangle fan. All other paths
+///        are drawn with stencil-then-cover: the same fan is first
+///        accumulated into the stencil buffer using the path's fill rule and
+///        the covered region is then shaded.
 class FillPathGeometry final : public Geometry {
  public:
   explicit FillPathGeometry(const Path& path,
@@ -37,6 +42,7 @@ class FillPathGeometry final : public Geometry {
 
   Path path_;
   std::optional<Rect> inner_rect_;
+  bool is_convex_;
 
   FillPathGeometry(const FillPathGeometry&) = delete;
 
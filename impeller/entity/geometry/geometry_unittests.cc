@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <map>
 #include <memory>
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
@@ -94,6 +95,47 @@ TEST(EntityGeometryTest, FillPathGeometryCoversAreaNoInnerRect) {
   ASSERT_FALSE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, FillPathGeometryDrawsSmallConvexPolygonsDirectly) {
+  auto triangle = PathBuilder{}
+                      .MoveTo({0, 0})
+                      .LineTo({10, 0})
+                      .LineTo({5, 10})
+                      .Close()
+                      .TakePath();
+  EXPECT_EQ(Geometry::MakeFillPath(triangle)->GetResultMode(),
+            GeometryResult::Mode::kNormal);
+
+  auto concave = PathBuilder{}
+                     .MoveTo({0, 0})
+                     .LineTo({10, 0})
+                     .LineTo({5, 2})
+                     .LineTo({5, 10})
+                     .Close()
+                     .TakePath();
+  EXPECT_EQ(Geometry::MakeFillPath(concave)->GetResultMode(),
+            GeometryResult::Mode::kNonZero);
+
+  // A pentagram turns in a consistent direction but intersects itself.
+  auto star = PathBuilder{}
+                  .MoveTo({50, 0})
+                  .LineTo({79.39, 90.45})
+                  .LineTo({2.45, 34.55})
+                  .LineTo({97.55, 34.55})
+                  .LineTo({20.61, 90.45})
+                  .Close()
+                  .TakePath(FillType::kOdd);
+  EXPECT_EQ(Geometry::MakeFillPath(star)->GetResultMode(),
+            GeometryResult::Mode::kEvenOdd);
+
+  auto curved = PathBuilder{}
+                    .MoveTo({0, 0})
+                    .QuadraticCurveTo({5, 10}, {10, 0})
+                    .Close()
+                    .TakePath();
+  EXPECT_EQ(Geometry::MakeFillPath(curved)->GetResultMode(),
+            GeometryResult::Mode::kNonZero);
+}
+
 TEST(EntityGeometryTest, LineGeometryCoverage) {
   {
     auto geometry = Geometry::MakeLine({10, 10}, {20, 10}, 2, Cap::kButt);
@@ -152,5 +194,109 @@ TEST(EntityGeometryTest, AlphaCoverageStrokePaths) {
   EXPECT_EQ(Geometry::MakeStrokePath({}, 40)->ComputeAlphaCoverage(matrix), 1);
 }
 
+TEST(EntityGeometryTest, SimpleStrokeVerticesAreExactlySized) {
+  Path path = PathBuilder{}.MoveTo({10, 10}).LineTo({100, 10}).TakePath();
+  Path::Polyline polyline = path.CreatePolyline(1.0f);
+
+  std::vector<Point> vertices =
+      ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+          polyline, /*stroke_width=*/10.0f, /*miter_limit=*/4.0f,
+          Join::kBevel, Cap::kButt, /*scale=*/1.0f);
+
+  std::vector<Point> expected = {
+      // Start cap.
+      Point(10, 15),
+      Point(10, 5),
+      // Line segment.
+      Point(10, 15),
+      Point(10, 5),
+      Point(100, 15),
+      Point(100, 5),
+      // End cap.
+      Point(100, 15),
+      Point(100, 5),
+  };
+  EXPECT_SOLID_VERTICES_NEAR(vertices, expected);
+}
+
+TEST(EntityGeometryTest, SquareCapStrokeVerticesAreExactlySized) {
+  Path path = PathBuilder{}.MoveTo({10, 10}).LineTo({100, 10}).TakePath();
+  Path::Polyline polyline = path.CreatePolyline(1.0f);
+
+  std::vector<Point> vertices =
+      ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+          polyline, /*stroke_width=*/10.0f, /*miter_limit=*/4.0f,
+          Join::kBevel, Cap::kSquare, /*scale=*/1.0f);
+
+  std::vector<Point> expected = {
+      // Start cap.
+      Point(10, 15),
+      Point(10, 5),
+      Point(5, 15),
+      Point(5, 5),
+      // Line segment.
+      Point(10, 15),
+      Point(10, 5),
+      Point(100, 15),
+      Point(100, 5),
+      // End cap.
+      Point(100, 15),
+      Point(100, 5),
+      Point(105, 15),
+      Point(105, 5),
+  };
+  EXPECT_SOLID_VERTICES_NEAR(vertices, expected);
+}
+
+TEST(EntityGeometryTest, StrokeVerticesAreExactlySizedForAllJoinsAndCaps) {
+  // An open contour with sharp and shallow corners and a curve, followed by a
+  // closed contour, so that every join and cap is generated. The path is away
+  // from the origin, so a vertex that was counted but never written would be
+  // left at the origin.
+  Path path = PathBuilder{}
+                  .MoveTo({100, 100})
+                  .LineTo({200, 100})
+                  .LineTo({110, 130})
+                  .QuadraticCurveTo({250, 250}, {300, 110})
+                  .MoveTo({400, 100})
+                  .LineTo({500, 100})
+                  .LineTo({450, 180})
+                  .Close()
+                  .TakePath();
+  Path::Polyline polyline = path.CreatePolyline(1.0f);
+  const Scalar stroke_width = 10.0f;
+  const Scalar miter_limit = 4.0f;
+  const Rect bounds = path.GetBoundingBox().value().Expand(
+      stroke_width * miter_limit);
+
+  std::map<std::pair<Join, Cap>, size_t> vertex_counts;
+  for (Join join : {Join::kBevel, Join::kMiter, Join::kRound}) {
+    for (Cap cap : {Cap::kButt, Cap::kSquare, Cap::kRound}) {
+      std::vector<Point> vertices =
+          ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+              polyline, stroke_width, miter_limit, join, cap,
+              /*scale=*/1.0f);
+      ASSERT_FALSE(vertices.empty());
+      for (const Point& vertex : vertices) {
+        EXPECT_NE(vertex, Point()) << static_cast<int>(join) << ", "
+                                   << static_cast<int>(cap);
+        EXPECT_TRUE(bounds.Contains(vertex)) << vertex;
+      }
+      vertex_counts[{join, cap}] = vertices.size();
+    }
+  }
+
+  // Miter joins add a vertex to each corner within the limit, and round joins
+  // and caps add an arc.
+  EXPECT_LT(vertex_counts[{Join::kBevel, Cap::kButt}],
+            vertex_counts[{Join::kMiter, Cap::kButt}]);
+  EXPECT_LT(vertex_counts[{Join::kMiter, Cap::kButt}],
+            vertex_counts[{Join::kRound, Cap::kButt}]);
+  EXPECT_LT(vertex_counts[{Join::kBevel, Cap::kButt}],
+            vertex_counts[{Join::kBevel, Cap::kSquare}]);
+  EXPECT_LT(vertex_counts[{Join::kBevel, Cap::kSquare}],
+            vertex_counts[{Join::kBevel, Cap::kRound}]);
+}
+
 }  // namespace testing
 }  // namespace impeller
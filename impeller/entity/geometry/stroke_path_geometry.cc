@@ -14,61 +14,74 @@
 #include "impeller/geometry/separated_vector.h"
 #include "impeller/geometry/wangs_formula.h"
 
+#ifdef IMPELLER_ENABLE_COMPUTE
+#include "impeller/renderer/compute_tessellator.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
 namespace {
 
+/// @brief A vertex writer that only counts the vertices a stroke would
+///        produce.
+///
+///        The stroke generator is run once with this writer to compute the
+///        exact number of vertices so that the second pass can write directly
+///        into host buffer memory without any intermediate storage.
+class VertexCounter {
+ public:
+  void AppendVertex(const Point& point) { count_++; }
+
+  size_t GetCount() const { return count_; }
+
+ private:
+  size_t count_ = 0u;
+};
+
+/// @brief A vertex writer that writes into pre-sized storage, such as the
+///        contents of a host buffer allocation sized by a |VertexCounter|
+///        pass over the same polyline.
 class PositionWriter {
  public:
-  explicit PositionWriter(std::vector<Point>& points)
-      : points_(points), oversized_() {
-    FML_DCHECK(points_.size() == kPointArenaSize);
-  }
+  PositionWriter(Point* points, size_t capacity)
+      : points_(points), capacity_(capacity) {}
 
   void AppendVertex(const Point& point) {
-    if (offset_ >= kPointArenaSize) {
-      oversized_.push_back(point);
-    } else {
-      points_[offset_++] = point;
-    }
-  }
-
-  /// @brief Return the number of points used in the arena, followed by
-  ///        the number of points allocated in the overized buffer.
-  std::pair<size_t, size_t> GetUsedSize() const {
-    return std::make_pair(offset_, oversized_.size());
+    FML_DCHECK(offset_ < capacity_);
+    points_[offset_++] = point;
   }
 
-  bool HasOversizedBuffer() const { return !oversized_.empty(); }
-
-  const std::vector<Point>& GetOversizedBuffer() const { return oversized_; }
+  size_t GetUsedSize() const { return offset_; }
 
  private:
-  std::vector<Point>& points_;
-  std::vector<Point> oversized_;
+  Point* points_;
+  size_t capacity_;
   size_t offset_ = 0u;
 };
 
-using CapProc = std::function<void(PositionWriter& vtx_builder,
-                                   const Point& position,
-                                   const Point& offset,
-                                   Scalar scale,
-                                   bool reverse)>;
-
-using JoinProc = std::function<void(PositionWriter& vtx_builder,
-                                    const Point& position,
-                                    const Point& start_offset,
-                                    const Point& end_offset,
-                                    Scalar miter_limit,
-                                    Scalar scale)>;
-
+template <typename VertexWriter>
+using CapProc = void (*)(VertexWriter& vtx_builder,
+                         const Point& position,
+                         const Point& offset,
+                         Scalar scale,
+                         bool reverse);
+
+template <typename VertexWriter>
+using JoinProc = void (*)(VertexWriter& vtx_builder,
+                          const Point& position,
+                          const Point& start_offset,
+                          const Point& end_offset,
+                          Scalar miter_limit,
+                          Scalar scale);
+
+template <typename VertexWriter>
 class StrokeGenerator {
  public:
   StrokeGenerator(const Path::Polyline& p_polyline,
                   const Scalar p_stroke_width,
                   const Scalar p_scaled_miter_limit,
-                  const JoinProc& p_join_proc,
-                  const CapProc& p_cap_proc,
+                  JoinProc<VertexWriter> p_join_proc,
+                  CapProc<VertexWriter> p_cap_proc,
                   const Scalar p_scale)
       : polyline(p_polyline),
         stroke_width(p_stroke_width),
@@ -77,7 +90,7 @@ class StrokeGenerator {
         cap_proc(p_cap_proc),
         scale(p_scale) {}
 
-  void Generate(PositionWriter& vtx_builder) {
+  void Generate(VertexWriter& vtx_builder) {
     for (size_t contour_i = 0; contour_i < polyline.contours.size();
          contour_i++) {
       const Path::PolylineContour& contour = polyline.contours[contour_i];
@@ -192,7 +205,7 @@ class StrokeGenerator {
                             stroke_width * 0.5f);
   }
 
-  void AddVerticesForLinearComponent(PositionWriter& vtx_builder,
+  void AddVerticesForLinearComponent(VertexWriter& vtx_builder,
                                      const size_t component_start_index,
                                      const size_t component_end_index,
                                      const size_t contour_start_point_i,
@@ -231,7 +244,7 @@ class StrokeGenerator {
     }
   }
 
-  void AddVerticesForCurveComponent(PositionWriter& vtx_builder,
+  void AddVerticesForCurveComponent(VertexWriter& vtx_builder,
                                     const size_t component_start_index,
                                     const size_t component_end_index,
                                     const size_t contour_start_point_i,
@@ -311,8 +324,8 @@ class StrokeGenerator {
   const Path::Polyline& polyline;
   const Scalar stroke_width;
   const Scalar scaled_miter_limit;
-  const JoinProc& join_proc;
-  const CapProc& cap_proc;
+  const JoinProc<VertexWriter> join_proc;
+  const CapProc<VertexWriter> cap_proc;
   const Scalar scale;
 
   SeparatedVector2 previous_offset;
@@ -320,7 +333,8 @@ class StrokeGenerator {
   SolidFillVertexShader::PerVertexData vtx;
 };
 
-void CreateButtCap(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+void CreateButtCap(VertexWriter& vtx_builder,
                    const Point& position,
                    const Point& offset,
                    Scalar scale,
@@ -330,7 +344,8 @@ void CreateButtCap(PositionWriter& vtx_builder,
   vtx_builder.AppendVertex(position - orientation);
 }
 
-void CreateRoundCap(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+void CreateRoundCap(VertexWriter& vtx_builder,
                     const Point& position,
                     const Point& offset,
                     Scalar scale,
@@ -373,7 +388,8 @@ void CreateRoundCap(PositionWriter& vtx_builder,
   vtx_builder.AppendVertex(vtx);
 }
 
-void CreateSquareCap(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+void CreateSquareCap(VertexWriter& vtx_builder,
                      const Point& position,
                      const Point& offset,
                      Scalar scale,
@@ -391,7 +407,8 @@ void CreateSquareCap(PositionWriter& vtx_builder,
   vtx_builder.AppendVertex(vtx);
 }
 
-Scalar CreateBevelAndGetDirection(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+Scalar CreateBevelAndGetDirection(VertexWriter& vtx_builder,
                                   const Point& position,
                                   const Point& start_offset,
                                   const Point& end_offset) {
@@ -407,7 +424,8 @@ Scalar CreateBevelAndGetDirection(PositionWriter& vtx_builder,
   return dir;
 }
 
-void CreateMiterJoin(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+void CreateMiterJoin(VertexWriter& vtx_builder,
                      const Point& position,
                      const Point& start_offset,
                      const Point& end_offset,
@@ -434,7 +452,8 @@ void CreateMiterJoin(PositionWriter& vtx_builder,
   vtx_builder.AppendVertex(position + miter_point * direction);
 }
 
-void CreateRoundJoin(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+void CreateRoundJoin(VertexWriter& vtx_builder,
                      const Point& position,
                      const Point& start_offset,
                      const Point& end_offset,
@@ -476,7 +495,8 @@ void CreateRoundJoin(PositionWriter& vtx_builder,
                            (-arc.p2 * direction).Reflect(middle_normal));
 }
 
-void CreateBevelJoin(PositionWriter& vtx_builder,
+template <typename VertexWriter>
+void CreateBevelJoin(VertexWriter& vtx_builder,
                      const Point& position,
                      const Point& start_offset,
                      const Point& end_offset,
@@ -485,41 +505,59 @@ void CreateBevelJoin(PositionWriter& vtx_builder,
   CreateBevelAndGetDirection(vtx_builder, position, start_offset, end_offset);
 }
 
-void CreateSolidStrokeVertices(PositionWriter& vtx_builder,
-                               const Path::Polyline& polyline,
-                               Scalar stroke_width,
-                               Scalar scaled_miter_limit,
-                               const JoinProc& join_proc,
-                               const CapProc& cap_proc,
-                               Scalar scale) {
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
-  stroke_generator.Generate(vtx_builder);
-}
-
-// static
-
-JoinProc GetJoinProc(Join stroke_join) {
+template <typename VertexWriter>
+JoinProc<VertexWriter> GetJoinProc(Join stroke_join) {
   switch (stroke_join) {
     case Join::kBevel:
-      return &CreateBevelJoin;
+      return &CreateBevelJoin<VertexWriter>;
     case Join::kMiter:
-      return &CreateMiterJoin;
+      return &CreateMiterJoin<VertexWriter>;
     case Join::kRound:
-      return &CreateRoundJoin;
+      return &CreateRoundJoin<VertexWriter>;
   }
 }
 
-CapProc GetCapProc(Cap stroke_cap) {
+template <typename VertexWriter>
+CapProc<VertexWriter> GetCapProc(Cap stroke_cap) {
   switch (stroke_cap) {
     case Cap::kButt:
-      return &CreateButtCap;
+      return &CreateButtCap<VertexWriter>;
     case Cap::kRound:
-      return &CreateRoundCap;
+      return &CreateRoundCap<VertexWriter>;
     case Cap::kSquare:
-      return &CreateSquareCap;
+      return &CreateSquareCap<VertexWriter>;
   }
 }
+
+template <typename VertexWriter>
+void CreateSolidStrokeVertices(VertexWriter& vtx_builder,
+                               const Path::Polyline& polyline,
+                               Scalar stroke_width,
+                               Scalar scaled_miter_limit,
+                               Join stroke_join,
+                               Cap stroke_cap,
+                               Scalar scale) {
+  StrokeGenerator<VertexWriter> stroke_generator(
+      polyline, stroke_width, scaled_miter_limit,
+      GetJoinProc<VertexWriter>(stroke_join),
+      GetCapProc<VertexWriter>(stroke_cap), scale);
+  stroke_generator.Generate(vtx_builder);
+}
+
+/// Runs the stroke generator in counting mode to determine the exact number
+/// of vertices the write pass will produce for the same arguments.
+size_t CountSolidStrokeVertices(const Path::Polyline& polyline,
+                                Scalar stroke_width,
+                                Scalar scaled_miter_limit,
+                                Join stroke_join,
+                                Cap stroke_cap,
+                                Scalar scale) {
+  VertexCounter counter;
+  CreateSolidStrokeVertices(counter, polyline, stroke_width,
+                            scaled_miter_limit, stroke_join, stroke_cap,
+                            scale);
+  return counter.GetCount();
+}
 }  // namespace
 
 std::vector<Point> StrokePathGeometry::GenerateSolidStrokeVertices(
@@ -530,13 +568,14 @@ std::vector<Point> StrokePathGeometry::GenerateSolidStrokeVertices(
     Cap stroke_cap,
     Scalar scale) {
   auto scaled_miter_limit = stroke_width * miter_limit * 0.5f;
-  JoinProc join_proc = GetJoinProc(stroke_join);
-  CapProc cap_proc = GetCapProc(stroke_cap);
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
-  std::vector<Point> points(4096);
-  PositionWriter vtx_builder(points);
-  stroke_generator.Generate(vtx_builder);
+  size_t vertex_count =
+      CountSolidStrokeVertices(polyline, stroke_width, scaled_miter_limit,
+                               stroke_join, stroke_cap, scale);
+  std::vector<Point> points(vertex_count);
+  PositionWriter vtx_builder(points.data(), points.size());
+  CreateSolidStrokeVertices(vtx_builder, polyline, stroke_width,
+                            scaled_miter_limit, stroke_join, stroke_cap,
+                            scale);
   return points;
 }
 
@@ -591,56 +630,58 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   auto& host_buffer = renderer.GetTransientsBuffer();
   auto scale = entity.GetTransform().GetMaxBasisLengthXY();
 
-  PositionWriter position_writer(
-      renderer.GetTessellator().GetStrokePointCache());
+#ifdef IMPELLER_ENABLE_COMPUTE
+  if (renderer.IsComputeTessellationEnabled() &&
+      ComputeTessellator::ShouldTessellateStroke(
+          path_, renderer.GetDeviceCapabilities(), stroke_join_,
+          stroke_cap_)) {
+    ComputeTessellator tessellator;
+    tessellator.SetStyle(ComputeTessellator::Style::kStroke)
+        .SetStrokeWidth(stroke_width)
+        .SetMiterLimit(miter_limit_)
+        .SetStrokeJoin(stroke_join_)
+        .SetStrokeCap(stroke_cap_)
+        .SetScale(scale);
+    VertexBuffer vertex_buffer;
+    if (tessellator.Tessellate(path_, host_buffer, renderer.GetContext(),
+                               vertex_buffer) ==
+        ComputeTessellator::Status::kOk) {
+      return GeometryResult{.type = PrimitiveType::kTriangle,
+                            .vertex_buffer = std::move(vertex_buffer),
+                            .transform = entity.GetShaderTransform(pass),
+                            .mode = GeometryResult::Mode::kPreventOverdraw};
+    }
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
   Path::Polyline polyline =
       renderer.GetTessellator().CreateTempPolyline(path_, scale);
+  Scalar scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5f;
 
-  CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-                            scale);
+  // The stroke is generated in two passes. The first pass only counts the
+  // vertices so that the second pass can write them directly into the host
+  // buffer without staging them in intermediate storage.
+  size_t vertex_count =
+      CountSolidStrokeVertices(polyline, stroke_width, scaled_miter_limit,
+                               stroke_join_, stroke_cap_, scale);
 
-  const auto [arena_length, oversized_length] = position_writer.GetUsedSize();
-  if (!position_writer.HasOversizedBuffer()) {
-    BufferView buffer_view = host_buffer.Emplace(
-        renderer.GetTessellator().GetStrokePointCache().data(),
-        arena_length * sizeof(Point), alignof(Point));
-
-    return GeometryResult{.type = PrimitiveType::kTriangleStrip,
-                          .vertex_buffer =
-                              {
-                                  .vertex_buffer = buffer_view,
-                                  .vertex_count = arena_length,
-                                  .index_type = IndexType::kNone,
-                              },
-                          .transform = entity.GetShaderTransform(pass),
-                          .mode = GeometryResult::Mode::kPreventOverdraw};
-  }
-  const std::vector<Point>& oversized_data =
-      position_writer.GetOversizedBuffer();
   BufferView buffer_view = host_buffer.Emplace(
-      /*buffer=*/nullptr,                                 //
-      (arena_length + oversized_length) * sizeof(Point),  //
-      alignof(Point)                                      //
-  );
-  memcpy(buffer_view.GetBuffer()->OnGetContents() +
-             buffer_view.GetRange().offset,                       //
-         renderer.GetTessellator().GetStrokePointCache().data(),  //
-         arena_length * sizeof(Point)                             //
-  );
-  memcpy(buffer_view.GetBuffer()->OnGetContents() +
-             buffer_view.GetRange().offset + arena_length * sizeof(Point),  //
-         oversized_data.data(),                                             //
-         oversized_data.size() * sizeof(Point)                              //
-  );
+      nullptr, vertex_count * sizeof(Point), alignof(Point));
+  PositionWriter position_writer(
+      reinterpret_cast<Point*>(buffer_view.GetBuffer()->OnGetContents() +
+                               buffer_view.GetRange().offset),
+      vertex_count);
+  CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
+                            scaled_miter_limit, stroke_join_, stroke_cap_,
+                            scale);
+  FML_DCHECK(position_writer.GetUsedSize() == vertex_count);
   buffer_view.GetBuffer()->Flush(buffer_view.GetRange());
 
   return GeometryResult{.type = PrimitiveType::kTriangleStrip,
                         .vertex_buffer =
                             {
                                 .vertex_buffer = buffer_view,
-                                .vertex_count = arena_length + oversized_length,
+                                .vertex_count = vertex_count,
                                 .index_type = IndexType::kNone,
                             },
                         .transform = entity.GetShaderTransform(pass),
@@ -3,28 +3,163 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+namespace {
+
+// Collect every texture of the render target. Depth and stencil attachments
+// usually share a texture, so a texture may appear more than once.
+std::vector<const std::shared_ptr<Texture>*> GetAttachmentTextures(
+    const RenderTarget& render_target) {
+  std::vector<const std::shared_ptr<Texture>*> textures;
+  render_target.IterateAllAttachments([&textures](const Attachment& attachment) {
+    if (attachment.texture) {
+      textures.push_back(&attachment.texture);
+    }
+    if (attachment.resolve_texture) {
+      textures.push_back(&attachment.resolve_texture);
+    }
+    return true;
+  });
+  return textures;
+}
+
+// Whether any texture of the cached render target is still referenced by
+// something other than the cache, such as a render pass, a snapshot, or the
+// caller that requested it.
+bool IsReferencedOutsideCache(const RenderTarget& render_target) {
+  auto textures = GetAttachmentTextures(render_target);
+  for (const auto* texture : textures) {
+    auto own_references =
+        std::count_if(textures.begin(), textures.end(),
+                      [&](const auto* other) { return *other == *texture; });
+    if (texture->use_count() > own_references) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t ComputeByteSize(const RenderTarget& render_target) {
+  std::vector<const Texture*> counted;
+  size_t byte_size = 0u;
+  for (const auto* texture : GetAttachmentTextures(render_target)) {
+    if (std::find(counted.begin(), counted.end(), texture->get()) !=
+        counted.end()) {
+      continue;
+    }
+    counted.push_back(texture->get());
+    const auto& desc = (*texture)->GetTextureDescriptor();
+    byte_size += desc.GetByteSizeOfAllMipLevels() *
+                 static_cast<size_t>(desc.sample_count);
+  }
+  return byte_size;
+}
+
+}  // namespace
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t idle_bytes_budget)
+    : RenderTargetAllocator(std::move(allocator)),
+      idle_bytes_budget_(idle_bytes_budget) {}
 
 void RenderTargetCache::Start() {
   for (auto& td : render_target_data_) {
     td.used_this_frame = false;
   }
+  aliased_count_this_frame_ = 0u;
 }
 
 void RenderTargetCache::End() {
   std::vector<RenderTargetData> retain;
 
+  cached_bytes_ = 0u;
   for (const auto& td : render_target_data_) {
     if (td.used_this_frame) {
       retain.push_back(td);
+      cached_bytes_ += td.byte_size;
     }
   }
   render_target_data_.swap(retain);
+
+  FML_TRACE_COUNTER("flutter", "RenderTargetCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "CachedBytes", cached_bytes_,     //
+                    "AliasedTargets", aliased_count_this_frame_);
+}
+
+RenderTargetCache::RenderTargetData* RenderTargetCache::TakeReusableTarget(
+    const RenderTargetConfig& config) {
+  // Prefer idle targets so that targets that were just released this frame
+  // are not written to again sooner than necessary.
+  for (auto& render_target_data : render_target_data_) {
+    if (!render_target_data.used_this_frame &&
+        render_target_data.config == config) {
+      render_target_data.used_this_frame = true;
+      return &render_target_data;
+    }
+  }
+  for (auto& render_target_data : render_target_data_) {
+    if (render_target_data.config == config &&
+        !IsReferencedOutsideCache(render_target_data.render_target)) {
+      aliased_count_this_frame_++;
+      return &render_target_data;
+    }
+  }
+  return nullptr;
+}
+
+void RenderTargetCache::EvictIdleTargets() {
+  size_t idle_bytes = 0u;
+  for (const auto& td : render_target_data_) {
+    if (!td.used_this_frame) {
+      idle_bytes += td.byte_size;
+    }
+  }
+  if (idle_bytes <= idle_bytes_budget_) {
+    return;
+  }
+  // Release the largest idle targets first as they are the least likely to
+  // match a later request.
+  std::vector<size_t> idle_indices;
+  for (size_t i = 0; i < render_target_data_.size(); i++) {
+    if (!render_target_data_[i].used_this_frame) {
+      idle_indices.push_back(i);
+    }
+  }
+  std::sort(idle_indices.begin(), idle_indices.end(), [&](size_t a, size_t b) {
+    return render_target_data_[a].byte_size > render_target_data_[b].byte_size;
+  });
+  std::vector<bool> evict(render_target_data_.size(), false);
+  for (size_t index : idle_indices) {
+    if (idle_bytes <= idle_bytes_budget_) {
+      break;
+    }
+    evict[index] = true;
+    idle_bytes -= render_target_data_[index].byte_size;
+    cached_bytes_ -= render_target_data_[index].byte_size;
+  }
+  size_t index = 0u;
+  render_target_data_.erase(
+      std::remove_if(render_target_data_.begin(), render_target_data_.end(),
+                     [&](const RenderTargetData&) { return evict[index++]; }),
+      render_target_data_.end());
+}
+
+void RenderTargetCache::TrackCreatedTarget(const RenderTargetConfig& config,
+                                           const RenderTarget& render_target) {
+  size_t byte_size = ComputeByteSize(render_target);
+  cached_bytes_ += byte_size;
+  render_target_data_.push_back(RenderTargetData{.used_this_frame = true,
+                                                 .config = config,
+                                                 .render_target = render_target,
+                                                 .byte_size = byte_size});
 }
 
 RenderTarget RenderTargetCache::CreateOffscreen(
@@ -48,30 +183,23 @@ RenderTarget RenderTargetCache::CreateOffscreen(
       .has_msaa = false,
       .has_depth_stencil = stencil_attachment_config.has_value(),
   };
-  for (auto& render_target_data : render_target_data_) {
-    const auto other_config = render_target_data.config;
-    if (!render_target_data.used_this_frame && other_config == config) {
-      render_target_data.used_this_frame = true;
-      auto color0 = render_target_data.render_target.GetColorAttachments()
-                        .find(0u)
-                        ->second;
-      auto depth = render_target_data.render_target.GetDepthAttachment();
-      std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
-      return RenderTargetAllocator::CreateOffscreen(
-          context, size, mip_count, label, color_attachment_config,
-          stencil_attachment_config, color0.texture, depth_tex);
-    }
+  if (RenderTargetData* render_target_data = TakeReusableTarget(config)) {
+    auto color0 =
+        render_target_data->render_target.GetColorAttachments().find(0u)->second;
+    auto depth = render_target_data->render_target.GetDepthAttachment();
+    std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
+    return RenderTargetAllocator::CreateOffscreen(
+        context, size, mip_count, label, color_attachment_config,
+        stencil_attachment_config, color0.texture, depth_tex);
   }
+  EvictIdleTargets();
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreen(
       context, size, mip_count, label, color_attachment_config,
       stencil_attachment_config);
   if (!created_target.IsValid()) {
     return created_target;
   }
-  render_target_data_.push_back(
-      RenderTargetData{.used_this_frame = true,
-                       .config = config,
-                       .render_target = created_target});
+  TrackCreatedTarget(config, created_target);
   return created_target;
 }
 
@@ -98,31 +226,24 @@ RenderTarget RenderTargetCache::CreateOffscreenMSAA(
       .has_msaa = true,
       .has_depth_stencil = stencil_attachment_config.has_value(),
   };
-  for (auto& render_target_data : render_target_data_) {
-    const auto other_config = render_target_data.config;
-    if (!render_target_data.used_this_frame && other_config == config) {
-      render_target_data.used_this_frame = true;
-      auto color0 = render_target_data.render_target.GetColorAttachments()
-                        .find(0u)
-                        ->second;
-      auto depth = render_target_data.render_target.GetDepthAttachment();
-      std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
-      return RenderTargetAllocator::CreateOffscreenMSAA(
-          context, size, mip_count, label, color_attachment_config,
-          stencil_attachment_config, color0.texture, color0.resolve_texture,
-          depth_tex);
-    }
+  if (RenderTargetData* render_target_data = TakeReusableTarget(config)) {
+    auto color0 =
+        render_target_data->render_target.GetColorAttachments().find(0u)->second;
+    auto depth = render_target_data->render_target.GetDepthAttachment();
+    std::shared_ptr<Texture> depth_tex = depth ? depth->texture : nullptr;
+    return RenderTargetAllocator::CreateOffscreenMSAA(
+        context, size, mip_count, label, color_attachment_config,
+        stencil_attachment_config, color0.texture, color0.resolve_texture,
+        depth_tex);
   }
+  EvictIdleTargets();
   RenderTarget created_target = RenderTargetAllocator::CreateOffscreenMSAA(
       context, size, mip_count, label, color_attachment_config,
       stencil_attachment_config);
   if (!created_target.IsValid()) {
     return created_target;
   }
-  render_target_data_.push_back(
-      RenderTargetData{.used_this_frame = true,
-                       .config = config,
-                       .render_target = created_target});
+  TrackCreatedTarget(config, created_target);
   return created_target;
 }
 
@@ -130,4 +251,12 @@ size_t RenderTargetCache::CachedTextureCount() const {
   return render_target_data_.size();
 }
 
+size_t RenderTargetCache::GetCachedBytes() const {
+  return cached_bytes_;
+}
+
+size_t RenderTargetCache::GetAliasedCountThisFrame() const {
+  return aliased_count_this_frame_;
+}
+
 }  // namespace impeller
@@ -14,9 +14,28 @@ namespace impeller {
 ///        allocated texture data for one frame.
 ///
 ///        Any textures unused after a frame are immediately discarded.
+///
+///        Within a frame, a render target whose textures are no longer
+///        referenced outside of the cache is handed out again for a later
+///        request with the same configuration. This aliases transient
+///        offscreen targets whose lifetimes don't overlap, such as the
+///        intermediate passes of a blur, instead of allocating new textures
+///        for each of them.
+///
+///        Targets retained from the previous frame that have not been used yet
+///        are idle. When a request can't be satisfied from the cache and the
+///        idle targets exceed the idle byte budget, idle targets are released
+///        before new textures are allocated. This bounds peak memory when the
+///        set of target sizes changes between frames.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  /// The default number of bytes of idle targets kept alive while new
+  /// targets are being allocated.
+  static constexpr size_t kDefaultIdleBytesBudget = 32u * 1024u * 1024u;
+
+  explicit RenderTargetCache(
+      std::shared_ptr<Allocator> allocator,
+      size_t idle_bytes_budget = kDefaultIdleBytesBudget);
 
   ~RenderTargetCache() = default;
 
@@ -56,14 +75,35 @@ class RenderTargetCache : public RenderTargetAllocator {
   // visible for testing.
   size_t CachedTextureCount() const;
 
+  /// The number of bytes of texture memory held by cached render targets.
+  size_t GetCachedBytes() const;
+
+  /// The number of requests this frame that reused a target already used
+  /// earlier in the same frame.
+  size_t GetAliasedCountThisFrame() const;
+
  private:
   struct RenderTargetData {
     bool used_this_frame;
     RenderTargetConfig config;
     RenderTarget render_target;
+    size_t byte_size = 0u;
   };
 
   std::vector<RenderTargetData> render_target_data_;
+  const size_t idle_bytes_budget_;
+  size_t cached_bytes_ = 0u;
+  size_t aliased_count_this_frame_ = 0u;
+
+  /// Find a cached target with the given configuration that is either idle
+  /// or whose previous use this frame has ended, and mark it as used.
+  RenderTargetData* TakeReusableTarget(const RenderTargetConfig& config);
+
+  /// Release idle targets until they fit in the idle byte budget.
+  void EvictIdleTargets();
+
+  void TrackCreatedTarget(const RenderTargetConfig& config,
+                          const RenderTarget& render_target);
 
   RenderTargetCache(const RenderTargetCache&) = delete;
 
@@ -55,8 +55,11 @@ TEST_P(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   render_target_cache.Start();
   // Create two render targets of the same exact size/shape. Both should be
   // marked as used this frame, so the cached data set will contain two.
-  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
-  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  // Both are held so that the second can't alias the first.
+  RenderTarget target1 =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  RenderTarget target2 =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
 
   EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
 
@@ -130,5 +133,75 @@ TEST_P(RenderTargetCacheTest, CreateWithEmptySize) {
   }
 }
 
+TEST_P(RenderTargetCacheTest, AliasesReleasedTargetsWithinAFrame) {
+  auto render_target_cache =
+      RenderTargetCache(GetContext()->GetResourceAllocator());
+
+  render_target_cache.Start();
+  std::shared_ptr<Texture> first_texture;
+  {
+    RenderTarget target =
+        render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+    first_texture = target.GetRenderTargetTexture();
+  }
+  // The first target's texture is still referenced, so it can't be reused.
+  RenderTarget second =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  EXPECT_NE(second.GetRenderTargetTexture(), first_texture);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_EQ(render_target_cache.GetAliasedCountThisFrame(), 0u);
+
+  // Once released, the next request of the same shape shares its textures.
+  first_texture.reset();
+  RenderTarget third =
+      render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_EQ(render_target_cache.GetAliasedCountThisFrame(), 1u);
+  EXPECT_NE(third.GetRenderTargetTexture(), second.GetRenderTargetTexture());
+  render_target_cache.End();
+
+  render_target_cache.Start();
+  EXPECT_EQ(render_target_cache.GetAliasedCountThisFrame(), 0u);
+  render_target_cache.End();
+}
+
+TEST_P(RenderTargetCacheTest, EvictsIdleTargetsOverBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator, 0u);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  size_t small_bytes = render_target_cache.GetCachedBytes();
+  EXPECT_GT(small_bytes, 0u);
+
+  // A request of a different size can't use the idle target, which is then
+  // released before the new textures are allocated.
+  render_target_cache.Start();
+  RenderTarget target =
+      render_target_cache.CreateOffscreen(*GetContext(), {200, 200}, 1);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  EXPECT_GT(render_target_cache.GetCachedBytes(), small_bytes);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
+TEST_P(RenderTargetCacheTest, KeepsIdleTargetsWithinBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+
+  render_target_cache.Start();
+  render_target_cache.CreateOffscreen(*GetContext(), {100, 100}, 1);
+  render_target_cache.End();
+
+  render_target_cache.Start();
+  RenderTarget target =
+      render_target_cache.CreateOffscreen(*GetContext(), {200, 200}, 1);
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  render_target_cache.End();
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
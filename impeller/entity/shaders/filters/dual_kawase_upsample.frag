@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/texture.glsl>
+#include <impeller/types.glsl>
+
+// The upsample pass of a dual filter (dual Kawase) blur. Renders the input at
+// twice its size, averaging a ring of eight samples around each output pixel.
+
+uniform f16sampler2D texture_sampler;
+
+layout(constant_id = 0) const float supports_decal = 1.0;
+
+uniform FragInfo {
+  // The distance of the diagonal samples from the center of the output pixel,
+  // in uv coordinates of the input. The samples along the axes are twice as
+  // far away.
+  vec2 sample_offset;
+}
+frag_info;
+
+f16vec4 Sample(f16sampler2D tex, vec2 coords) {
+  if (supports_decal == 1.0) {
+    return texture(tex, coords);
+  }
+  return IPHalfSampleDecal(tex, coords);
+}
+
+in vec2 v_texture_coords;
+
+out f16vec4 frag_color;
+
+void main() {
+  vec2 offset = frag_info.sample_offset;
+  vec2 flipped_offset = vec2(offset.x, -offset.y);
+
+  f16vec4 total_color =
+      Sample(texture_sampler, v_texture_coords + vec2(-2.0 * offset.x, 0.0));
+  total_color +=
+      Sample(texture_sampler, v_texture_coords + vec2(2.0 * offset.x, 0.0));
+  total_color +=
+      Sample(texture_sampler, v_texture_coords + vec2(0.0, -2.0 * offset.y));
+  total_color +=
+      Sample(texture_sampler, v_texture_coords + vec2(0.0, 2.0 * offset.y));
+  total_color += Sample(texture_sampler, v_texture_coords - offset) * 2.0hf;
+  total_color += Sample(texture_sampler, v_texture_coords + offset) * 2.0hf;
+  total_color +=
+      Sample(texture_sampler, v_texture_coords - flipped_offset) * 2.0hf;
+  total_color +=
+      Sample(texture_sampler, v_texture_coords + flipped_offset) * 2.0hf;
+
+  frag_color = total_color / 12.0hf;
+}
@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision highp float;
+
+#include <impeller/color.glsl>
+#include <impeller/types.glsl>
+
+// Applies up to four per-pixel color filters in a single pass.
+//
+// Each stage is described by its type in `stage_types` and five vec4s in
+// `stage_data`:
+//
+//   0 - color matrix:   the four columns of the matrix followed by the offset.
+//   1 - sRGB to linear: unused.
+//   2 - linear to sRGB: unused.
+//   3 - Porter-Duff blend with a constant color: the premultiplied source
+//       color, the (src_coeff, src_coeff_dst_alpha, dst_coeff,
+//       dst_coeff_src_alpha) coefficients and dst_coeff_src_color in the x
+//       component of the third vec4.
+//
+// Every stage reads and writes premultiplied colors and clamps its output, so
+// the result matches running the stages as separate filters.
+
+const int kMaxStages = 4;
+const int kStageDataSize = 5;
+
+const float kStageColorMatrix = 0.0;
+const float kStageSrgbToLinear = 1.0;
+const float kStageLinearToSrgb = 2.0;
+const float kStageBlend = 3.0;
+
+uniform FragInfo {
+  vec4 stage_types;
+  vec4 stage_data[20];
+  float stage_count;
+  float input_alpha;
+}
+frag_info;
+
+uniform sampler2D input_texture;
+
+in highp vec2 v_texture_coords;
+out vec4 frag_color;
+
+vec4 ApplyColorMatrix(vec4 color, int base) {
+  mat4 color_m =
+      mat4(frag_info.stage_data[base], frag_info.stage_data[base + 1],
+           frag_info.stage_data[base + 2], frag_info.stage_data[base + 3]);
+  vec4 color_v = frag_info.stage_data[base + 4];
+  return IPPremultiply(
+      clamp(color_m * IPUnpremultiply(color) + color_v, 0.0, 1.0));
+}
+
+vec4 ApplySrgbToLinear(vec4 color) {
+  color = IPUnpremultiply(color);
+  for (int i = 0; i < 3; i++) {
+    if (color[i] <= 0.04045) {
+      color[i] = color[i] / 12.92;
+    } else {
+      color[i] = pow((color[i] + 0.055) / 1.055, 2.4);
+    }
+  }
+  return IPPremultiply(color);
+}
+
+vec4 ApplyLinearToSrgb(vec4 color) {
+  color = IPUnpremultiply(color);
+  for (int i = 0; i < 3; i++) {
+    if (color[i] <= 0.0031308) {
+      color[i] = color[i] * 12.92;
+    } else {
+      color[i] = 1.055 * pow(color[i], 1.0 / 2.4) - 0.055;
+    }
+  }
+  return IPPremultiply(color);
+}
+
+vec4 ApplyBlend(vec4 dst, int base) {
+  vec4 src = frag_info.stage_data[base];
+  vec4 coefficients = frag_info.stage_data[base + 1];
+  float dst_coeff_src_color = frag_info.stage_data[base + 2].x;
+  vec4 result = src * (coefficients.x + dst.a * coefficients.y) +
+                dst * (coefficients.z + src.a * coefficients.w +
+                       src * dst_coeff_src_color);
+  return clamp(result, 0.0, 1.0);
+}
+
+void main() {
+  vec4 color = texture(input_texture, v_texture_coords) * frag_info.input_alpha;
+
+  for (int i = 0; i < kMaxStages; i++) {
+    if (i >= int(frag_info.stage_count)) {
+      break;
+    }
+    float type = frag_info.stage_types[i];
+    int base = i * kStageDataSize;
+    if (type == kStageColorMatrix) {
+      color = ApplyColorMatrix(color, base);
+    } else if (type == kStageSrgbToLinear) {
+      color = ApplySrgbToLinear(color);
+    } else if (type == kStageLinearToSrgb) {
+      color = ApplyLinearToSrgb(color);
+    } else if (type == kStageBlend) {
+      color = ApplyBlend(color, base);
+    }
+  }
+
+  frag_color = color;
+}
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+  mat4 entity_transform;
+  vec2 atlas_size;
+  // The index of the first glyph instance of this draw.
+  float instance_offset;
+  // Whether the glyphs are snapped to the pixel grid. Only done when the
+  // entity transform is a translation and scale.
+  float snap_to_pixels;
+}
+frame_info;
+
+struct GlyphInstance {
+  // The position of the glyph in the text frame.
+  vec2 position;
+  // The index of the glyph in the atlas glyph data.
+  float glyph_index;
+  float padding;
+};
+
+layout(std140) readonly buffer GlyphInstanceData {
+  GlyphInstance instances[];
+}
+glyph_instance_data;
+
+struct AtlasGlyph {
+  // The origin and size of the glyph within its atlas page, in pixels.
+  vec4 atlas_bounds;
+  // The origin and size of the glyph relative to its position, in the
+  // coordinate space of the text frame.
+  vec4 glyph_bounds;
+  // The offset applied before snapping, which depends on the subpixel
+  // positioning of the font.
+  vec2 subpixel_adjustment;
+  vec2 padding;
+};
+
+layout(std140) readonly buffer AtlasGlyphData {
+  AtlasGlyph glyphs[];
+}
+atlas_glyph_data;
+
+// A corner of the unit square.
+in vec2 unit_position;
+
+out vec2 v_uv;
+
+void main() {
+  int instance_index = int(frame_info.instance_offset) + gl_InstanceIndex;
+  GlyphInstance instance = glyph_instance_data.instances[instance_index];
+  AtlasGlyph glyph = atlas_glyph_data.glyphs[int(instance.glyph_index)];
+
+  vec2 glyph_origin = instance.position + glyph.glyph_bounds.xy;
+  vec2 glyph_size = glyph.glyph_bounds.zw;
+  vec2 position;
+  if (frame_info.snap_to_pixels == 1.0) {
+    mat2 basis = mat2(frame_info.entity_transform);
+    vec2 screen_offset = frame_info.entity_transform[3].xy;
+    vec2 screen_glyph_position = floor(screen_offset + basis * glyph_origin +
+                                       glyph.subpixel_adjustment);
+    position =
+        round(screen_glyph_position + basis * (unit_position * glyph_size));
+  } else {
+    vec4 transformed = frame_info.entity_transform *
+                       vec4(glyph_origin + unit_position * glyph_size, 0, 1);
+    position = transformed.xy / transformed.w;
+  }
+  gl_Position = frame_info.mvp * vec4(position, 0, 1);
+
+  // Sample half a pixel beyond the glyph on every side, as the per-vertex
+  // glyph atlas shader does.
+  v_uv = (glyph.atlas_bounds.xy - vec2(0.5) +
+          unit_position * (glyph.atlas_bounds.zw + vec2(1.0))) /
+         frame_info.atlas_size;
+}
@@ -0,0 +1,32 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+layout(constant_id = 0) const float use_alpha_color_channel = 1.0;
+
+uniform FragInfo {
+  f16vec4 text_color;
+}
+frag_info;
+
+in highp vec2 v_uv;
+in highp float v_distance_scale;
+
+out f16vec4 frag_color;
+
+void main() {
+  f16vec4 value = texture(glyph_atlas_sampler, v_uv);
+  float16_t distance = use_alpha_color_channel == 1.0 ? value.a : value.r;
+
+  // The outline lies at 0.5. Convert the distance to device pixels and cover
+  // one pixel across the outline for anti-aliasing.
+  float16_t coverage = float16_t(clamp(
+      (float(distance) - 0.5) * v_distance_scale + 0.5, 0.0, 1.0));
+  frag_color = coverage * frag_info.text_color;
+}
@@ -114,6 +114,29 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+template <class... Args>
+static void BM_Libtess(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    tess.Tessellate(path, 1.0f,
+                    [&single_point_count](const float* vertices,
+                                          size_t vertices_count,
+                                          const uint16_t* indices,
+                                          size_t indices_count) {
+                      single_point_count =
+                          indices_count > 0 ? indices_count : vertices_count;
+                      return true;
+                    });
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+}
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed)         \
   BENCHMARK_CAPTURE(BM_StrokePolyline, stroke_##path##_##cap##_##join, \
                     Create##path(closed), Cap::k##cap, Join::k##join)
@@ -129,10 +152,23 @@ BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(true));
 BENCHMARK_CAPTURE(BM_Polyline, unclosed_cubic_polyline, CreateCubic(false));
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Cubic, false);
 
+// Non-convex fills are drawn with stencil-then-cover using the same fan
+// tessellation as convex fills. Compare its CPU cost against a full
+// triangulation with libtess.
+//
+// These only time the CPU side, on single synthetic paths. The GPU cost of
+// the extra stencil pass, and whole scenes such as SVG icons, are not measured
+// here, as these benchmarks run without a GPU context.
+BENCHMARK_CAPTURE(BM_Convex, cubic_stencil_fan, CreateCubic(true));
+BENCHMARK_CAPTURE(BM_Libtess, cubic_libtess, CreateCubic(true));
+
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(true));
 BENCHMARK_CAPTURE(BM_Polyline, unclosed_quad_polyline, CreateQuadratic(false));
 MAKE_STROKE_BENCHMARK_CAPTURE_ALL_CAPS_JOINS(Quadratic, false);
 
+BENCHMARK_CAPTURE(BM_Convex, quad_stencil_fan, CreateQuadratic(true));
+BENCHMARK_CAPTURE(BM_Libtess, quad_libtess, CreateQuadratic(true));
+
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
 // A round rect has no ends so we don't need to try it with all cap values
 // but it does have joins and even though they should all be almost
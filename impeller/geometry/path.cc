@@ -247,6 +247,46 @@ bool Path::GetContourComponentAtIndex(size_t index,
   return true;
 }
 
+void Path::EnumerateComponents(
+    const Applier<LinearPathComponent>& linear_applier,
+    const Applier<QuadraticPathComponent>& quad_applier,
+    const Applier<CubicPathComponent>& cubic_applier,
+    const Applier<ContourComponent>& contour_applier) const {
+  auto& components = data_->components;
+  auto& points = data_->points;
+
+  size_t storage_offset = 0u;
+  for (size_t i = 0; i < components.size(); i++) {
+    switch (components[i]) {
+      case ComponentType::kLinear:
+        if (linear_applier) {
+          linear_applier(i, *reinterpret_cast<const LinearPathComponent*>(
+                                &points[storage_offset]));
+        }
+        break;
+      case ComponentType::kQuadratic:
+        if (quad_applier) {
+          quad_applier(i, *reinterpret_cast<const QuadraticPathComponent*>(
+                              &points[storage_offset]));
+        }
+        break;
+      case ComponentType::kCubic:
+        if (cubic_applier) {
+          cubic_applier(i, *reinterpret_cast<const CubicPathComponent*>(
+                               &points[storage_offset]));
+        }
+        break;
+      case ComponentType::kContour:
+        if (contour_applier) {
+          contour_applier(i, *reinterpret_cast<const ContourComponent*>(
+                                 &points[storage_offset]));
+        }
+        break;
+    }
+    storage_offset += VerbToOffset(components[i]);
+  }
+}
+
 Path::Polyline::Polyline(Path::Polyline::PointBufferPtr point_buffer,
                          Path::Polyline::ReclaimPointBufferCallback reclaim)
     : points(std::move(point_buffer)), reclaim_points_(std::move(reclaim)) {
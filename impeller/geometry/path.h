@@ -167,6 +167,19 @@ class Path {
   bool GetContourComponentAtIndex(size_t index,
                                   ContourComponent& contour) const;
 
+  template <class T>
+  using Applier = std::function<void(size_t index, const T& component)>;
+
+  /// @brief Visit every component of the path in order, invoking the applier
+  ///        that matches each component type. Unlike the
+  ///        `Get*ComponentAtIndex` accessors, this walks the component
+  ///        storage once.
+  void EnumerateComponents(
+      const Applier<LinearPathComponent>& linear_applier,
+      const Applier<QuadraticPathComponent>& quad_applier,
+      const Applier<CubicPathComponent>& cubic_applier,
+      const Applier<ContourComponent>& contour_applier) const;
+
   /// Callers must provide the scale factor for how this path will be
   /// transformed.
   ///
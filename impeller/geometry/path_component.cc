@@ -80,25 +80,20 @@ void StripVertexWriter::Write(Point point) {
 
 /////////// LineStripVertexWriter ////////
 
-LineStripVertexWriter::LineStripVertexWriter(std::vector<Point>& points)
+LineStripVertexWriter::LineStripVertexWriter(Point* points)
     : points_(points) {}
 
 void LineStripVertexWriter::EndContour() {}
 
 void LineStripVertexWriter::Write(Point point) {
-  if (offset_ >= points_.size()) {
-    overflow_.push_back(point);
-  } else {
-    points_[offset_++] = point;
+  if (points_) {
+    points_[count_] = point;
   }
+  count_++;
 }
 
-const std::vector<Point>& LineStripVertexWriter::GetOversizedBuffer() const {
-  return overflow_;
-}
-
-std::pair<size_t, size_t> LineStripVertexWriter::GetVertexCount() const {
-  return std::make_pair(offset_, overflow_.size());
+size_t LineStripVertexWriter::GetVertexCount() const {
+  return count_;
 }
 
 /////////// GLESVertexWriter ///////////
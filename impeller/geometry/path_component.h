@@ -67,10 +67,12 @@ class StripVertexWriter : public VertexWriter {
   uint16_t* index_buffer_ = nullptr;
 };
 
-/// @brief A vertex writer that generates a line strip topology.
+/// @brief A vertex writer that generates a line strip topology into storage
+///        sized for it by a previous pass. If |points| is null, the vertices
+///        are only counted.
 class LineStripVertexWriter : public VertexWriter {
  public:
-  explicit LineStripVertexWriter(std::vector<Point>& points);
+  explicit LineStripVertexWriter(Point* points = nullptr);
 
   ~LineStripVertexWriter() = default;
 
@@ -78,14 +80,11 @@ class LineStripVertexWriter : public VertexWriter {
 
   void Write(Point point) override;
 
-  std::pair<size_t, size_t> GetVertexCount() const;
-
-  const std::vector<Point>& GetOversizedBuffer() const;
+  size_t GetVertexCount() const;
 
  private:
-  size_t offset_ = 0u;
-  std::vector<Point>& points_;
-  std::vector<Point> overflow_;
+  size_t count_ = 0u;
+  Point* points_ = nullptr;
 };
 
 /// @brief A vertex writer that has no hardware requirements.
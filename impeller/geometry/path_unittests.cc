@@ -663,6 +663,57 @@ TEST(PathTest, CloseAtOriginDoesNotAddNewLineSegment) {
   EXPECT_EQ(path.GetComponentCount(Path::ComponentType::kContour), 2u);
 }
 
+TEST(PathTest, EnumerateComponentsVisitsComponentsInOrder) {
+  Path path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .QuadraticCurveTo({20, 0}, {20, 10})
+                  .CubicCurveTo({20, 20}, {10, 20}, {0, 20})
+                  .TakePath();
+
+  std::vector<size_t> indices;
+  std::vector<Path::ComponentType> types;
+  LinearPathComponent linear;
+  QuadraticPathComponent quad;
+  CubicPathComponent cubic;
+  path.EnumerateComponents(
+      [&](size_t index, const LinearPathComponent& component) {
+        indices.push_back(index);
+        types.push_back(Path::ComponentType::kLinear);
+        linear = component;
+      },
+      [&](size_t index, const QuadraticPathComponent& component) {
+        indices.push_back(index);
+        types.push_back(Path::ComponentType::kQuadratic);
+        quad = component;
+      },
+      [&](size_t index, const CubicPathComponent& component) {
+        indices.push_back(index);
+        types.push_back(Path::ComponentType::kCubic);
+        cubic = component;
+      },
+      [&](size_t index, const ContourComponent& component) {
+        indices.push_back(index);
+        types.push_back(Path::ComponentType::kContour);
+      });
+
+  ASSERT_EQ(indices.size(), path.GetComponentCount());
+  for (size_t i = 0; i < indices.size(); i++) {
+    EXPECT_EQ(indices[i], i);
+  }
+  EXPECT_EQ(types[0], Path::ComponentType::kContour);
+  EXPECT_EQ(types[1], Path::ComponentType::kLinear);
+  EXPECT_EQ(types[2], Path::ComponentType::kQuadratic);
+  EXPECT_EQ(types[3], Path::ComponentType::kCubic);
+
+  EXPECT_EQ(linear.p1, Point(0, 0));
+  EXPECT_EQ(linear.p2, Point(10, 0));
+  EXPECT_EQ(quad.cp, Point(20, 0));
+  EXPECT_EQ(quad.p2, Point(20, 10));
+  EXPECT_EQ(cubic.cp1, Point(20, 20));
+  EXPECT_EQ(cubic.p2, Point(0, 20));
+}
+
 TEST(PathTest, CanBeCloned) {
   PathBuilder builder;
   builder.MoveTo({10, 10});
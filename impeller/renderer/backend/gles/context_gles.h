@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CONTEXT_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_CONTEXT_GLES_H_
 
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
 #include "impeller/renderer/backend/gles/capabilities_gles.h"
@@ -23,10 +24,21 @@ class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context>,
                           public std::enable_shared_from_this<ContextGLES> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Create a new OpenGL ES context.
+  ///
+  /// @param[in]  gl                  The proc table.
+  /// @param[in]  shader_libraries    The shader library mappings.
+  /// @param[in]  enable_gpu_tracing  Whether to enable GPU tracing.
+  /// @param[in]  cache_directory     An optional directory used to persist
+  ///                                 linked program binaries and the pipeline
+  ///                                 variant manifest between sessions.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      fml::UniqueFD cache_directory = {});
 
   // |Context|
   ~ContextGLES() override;
@@ -61,7 +73,8 @@ class ContextGLES final : public Context,
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
-      bool enable_gpu_tracing);
+      bool enable_gpu_tracing,
+      fml::UniqueFD cache_directory);
 
   // |Context|
   std::string DescribeGpuModel() const override;
@@ -4,10 +4,15 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
 #include <sstream>
 #include <string>
 
 #include "flutter/fml/container.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
 #include "impeller/base/promise.h"
@@ -16,8 +21,101 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+static constexpr const char* kPipelineVariantManifestFileName =
+    "flutter.impeller.glvariants";
+
+static constexpr uint64_t kFNVOffsetBasis = 0xcbf29ce484222325u;
+
+// FNV-1a. Unlike std::hash, the result is stable between launches which is
+// required of anything used to name or validate persisted data.
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3u;
+  }
+  return hash;
+}
+
+static uint64_t HashString(uint64_t hash, std::string_view string) {
+  return HashBytes(hash, string.data(), string.size());
+}
+
+//------------------------------------------------------------------------------
+/// @brief      Prepended to all data persisted by the pipeline library.
+///
+struct PersistedDataHeaderGLES {
+  // This can be used by Impeller to manually invalidate all old data.
+  uint32_t magic = 0xC0DEB17E;
+  // The program binary format or zero for data that is not a program binary.
+  uint32_t format = 0u;
+  uint64_t fingerprint = 0u;
+  uint64_t data_size = 0u;
+};
+
+static std::shared_ptr<fml::Mapping> CreatePersistedData(
+    const PersistedDataHeaderGLES& header,
+    const uint8_t* data) {
+  std::vector<uint8_t> bytes(sizeof(header) + header.data_size);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  std::memcpy(bytes.data() + sizeof(header), data, header.data_size);
+  return std::make_shared<fml::DataMapping>(std::move(bytes));
+}
+
+static bool PersistedDataWrite(const fml::UniqueFD& cache_directory,
+                               const std::string& file_name,
+                               const fml::Mapping& data) {
+  if (!fml::WriteAtomically(cache_directory, file_name.c_str(), data)) {
+    VALIDATION_LOG << "Could not write " << file_name << " to disk.";
+    return false;
+  }
+  return true;
+}
+
+static std::unique_ptr<fml::Mapping> PersistedDataRead(
+    const fml::UniqueFD& cache_directory,
+    const std::string& file_name,
+    uint64_t fingerprint,
+    uint32_t* format) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  std::shared_ptr<fml::FileMapping> on_disk_data =
+      fml::FileMapping::CreateReadOnly(cache_directory, file_name);
+  if (!on_disk_data ||
+      on_disk_data->GetSize() < sizeof(PersistedDataHeaderGLES)) {
+    return nullptr;
+  }
+  auto header = PersistedDataHeaderGLES{};
+  std::memcpy(&header, on_disk_data->GetMapping(), sizeof(header));
+  if (header.magic != PersistedDataHeaderGLES{}.magic ||
+      header.fingerprint != fingerprint ||
+      header.data_size != on_disk_data->GetSize() - sizeof(header)) {
+    return nullptr;
+  }
+  if (format) {
+    *format = header.format;
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      on_disk_data->GetMapping() + sizeof(header), header.data_size,
+      [on_disk_data](auto, auto) {});
+}
+
+PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor,
+                                         fml::UniqueFD cache_directory)
+    : reactor_(std::move(reactor)),
+      cache_directory_(std::move(cache_directory)) {
+  if (!reactor_ || !cache_directory_.is_valid()) {
+    return;
+  }
+  const auto* description = reactor_->GetProcTable().GetDescription();
+  driver_fingerprint_ =
+      HashString(kFNVOffsetBasis, description ? description->GetString() : "");
+  persisted_variant_manifest_ =
+      PersistedDataRead(cache_directory_, kPipelineVariantManifestFileName,
+                        driver_fingerprint_, nullptr);
+  disk_message_loop_ = fml::ConcurrentMessageLoop::Create(1u);
+}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -78,7 +176,8 @@ static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    bool retrievable_binary) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
@@ -160,6 +259,10 @@ static bool LinkProgram(
     );
   }
 
+  if (retrievable_binary) {
+    gl.ProgramParameteri(*program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   gl.LinkProgram(*program);
 
   GLint link_status = GL_FALSE;
@@ -221,18 +324,32 @@ std::shared_ptr<PipelineGLES> PipelineLibraryGLES::CreatePipeline(
     return nullptr;
   }
 
-  const auto link_result = !has_cached_program ? LinkProgram(*reactor,       //
-                                                             pipeline,       //
-                                                             vert_function,  //
-                                                             frag_function   //
-                                                             )
-                                               : true;
+  const auto use_program_binaries =
+      !has_cached_program &&
+      library.SupportsProgramBinaries(reactor->GetProcTable());
+  const auto loaded_program_binary =
+      use_program_binaries &&
+      library.LoadProgramBinary(program_key, program.value());
+
+  const auto link_result =
+      !has_cached_program && !loaded_program_binary
+          ? LinkProgram(*reactor,             //
+                        pipeline,             //
+                        vert_function,        //
+                        frag_function,        //
+                        use_program_binaries  //
+                        )
+          : true;
 
   if (!link_result) {
     VALIDATION_LOG << "Could not link pipeline program.";
     return nullptr;
   }
 
+  if (use_program_binaries && !loaded_program_binary) {
+    library.StoreProgramBinary(program_key, program.value());
+  }
+
   if (!pipeline->BuildVertexDescriptor(reactor->GetProcTable(),
                                        program.value())) {
     VALIDATION_LOG << "Could not build pipeline vertex descriptors.";
@@ -323,10 +440,173 @@ void PipelineLibraryGLES::RemovePipelinesWithEntryPoint(
 // |PipelineLibrary|
 PipelineLibraryGLES::~PipelineLibraryGLES() = default;
 
+// |PipelineLibrary|
+std::shared_ptr<const fml::Mapping>
+PipelineLibraryGLES::GetPersistedPipelineVariantManifest() const {
+  return persisted_variant_manifest_;
+}
+
+// |PipelineLibrary|
+void PipelineLibraryGLES::SetPipelineVariantManifest(
+    std::shared_ptr<const fml::Mapping> manifest) {
+  if (!cache_directory_.is_valid() || !manifest) {
+    return;
+  }
+  Lock lock(pending_writes_mutex_);
+  pending_variant_manifest_ = std::move(manifest);
+}
+
+void PipelineLibraryGLES::DidAcquireSurfaceFrame() {
+  if (++frames_acquired_ == 50u) {
+    PersistPendingDataToDisk();
+    frames_acquired_ = 0;
+  }
+}
+
+void PipelineLibraryGLES::PersistPendingDataToDisk() {
+  std::shared_ptr<const fml::Mapping> manifest;
+  std::vector<std::pair<std::string, std::shared_ptr<const fml::Mapping>>>
+      program_binaries;
+  {
+    Lock lock(pending_writes_mutex_);
+    manifest = std::move(pending_variant_manifest_);
+    program_binaries.swap(pending_program_binaries_);
+  }
+  if (!disk_message_loop_ || (!manifest && program_binaries.empty())) {
+    return;
+  }
+  // The task must not keep the library alive, as the last reference to it
+  // would then join the worker from the worker itself.
+  disk_message_loop_->GetTaskRunner()->PostTask(
+      [cache_directory = std::make_shared<fml::UniqueFD>(
+           fml::Duplicate(cache_directory_.get())),
+       fingerprint = driver_fingerprint_, manifest = std::move(manifest),
+       program_binaries = std::move(program_binaries)]() {
+        TRACE_EVENT0("impeller", "PipelineLibraryGLES::PersistToDisk");
+        if (!cache_directory->is_valid()) {
+          return;
+        }
+        for (const auto& [file_name, data] : program_binaries) {
+          PersistedDataWrite(*cache_directory, file_name, *data);
+        }
+        if (manifest) {
+          PersistedDataHeaderGLES header;
+          header.fingerprint = fingerprint;
+          header.data_size = manifest->GetSize();
+          PersistedDataWrite(
+              *cache_directory, kPipelineVariantManifestFileName,
+              *CreatePersistedData(header, manifest->GetMapping()));
+        }
+      });
+}
+
 const ReactorGLES::Ref& PipelineLibraryGLES::GetReactor() const {
   return reactor_;
 }
 
+bool PipelineLibraryGLES::SupportsProgramBinaries(const ProcTableGLES& gl) {
+  std::call_once(program_binary_formats_once_, [&]() {
+    if (!cache_directory_.is_valid() || !gl.GetProgramBinary.IsAvailable() ||
+        !gl.ProgramBinary.IsAvailable() ||
+        !gl.ProgramParameteri.IsAvailable()) {
+      return;
+    }
+    GLint format_count = 0;
+    gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    if (format_count <= 0) {
+      return;
+    }
+    program_binary_formats_.resize(format_count);
+    gl.GetIntegerv(GL_PROGRAM_BINARY_FORMATS, program_binary_formats_.data());
+  });
+  return !program_binary_formats_.empty();
+}
+
+static std::string GetProgramBinaryFileName(
+    const std::string& vertex_name,
+    const std::string& fragment_name,
+    const std::vector<Scalar>& specialization_constants) {
+  auto hash = HashString(kFNVOffsetBasis, vertex_name);
+  hash = HashString(hash, fragment_name);
+  hash = HashBytes(hash, specialization_constants.data(),
+                   specialization_constants.size() * sizeof(Scalar));
+  return SPrintF("flutter.impeller.glprogram.%016" PRIx64, hash);
+}
+
+uint64_t PipelineLibraryGLES::GetProgramFingerprint(
+    const ProgramKey& key) const {
+  // The shader names identify the program. The sources ensure binaries linked
+  // from shaders that have since changed are not used.
+  auto hash = driver_fingerprint_;
+  for (const auto& function : {key.vertex_shader, key.fragment_shader}) {
+    auto mapping = ShaderFunctionGLES::Cast(*function).GetSourceMapping();
+    if (mapping) {
+      hash = HashBytes(hash, mapping->GetMapping(), mapping->GetSize());
+    }
+  }
+  return hash;
+}
+
+bool PipelineLibraryGLES::LoadProgramBinary(const ProgramKey& key,
+                                            GLuint program) const {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  uint32_t format = 0u;
+  auto binary = PersistedDataRead(
+      cache_directory_,
+      GetProgramBinaryFileName(key.vertex_shader->GetName(),
+                               key.fragment_shader->GetName(),
+                               key.specialization_constants),
+      GetProgramFingerprint(key), &format);
+  if (!binary || binary->GetSize() == 0u) {
+    return false;
+  }
+  if (std::find(program_binary_formats_.begin(), program_binary_formats_.end(),
+                static_cast<GLint>(format)) == program_binary_formats_.end()) {
+    return false;
+  }
+  const auto& gl = reactor_->GetProcTable();
+  gl.ProgramBinary(program, format, binary->GetMapping(), binary->GetSize());
+  // The driver may reject a binary for reasons of its own. That just means
+  // the program needs to be compiled and linked from source.
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  return link_status == GL_TRUE;
+}
+
+void PipelineLibraryGLES::StoreProgramBinary(const ProgramKey& key,
+                                             GLuint program) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  const auto& gl = reactor_->GetProcTable();
+  GLint length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+  // The binary is read back directly after the space for its header so that
+  // it does not need to be copied again before it is written.
+  PersistedDataHeaderGLES header;
+  std::vector<uint8_t> data(sizeof(header) + length);
+  GLsizei written = 0;
+  GLenum format = 0;
+  gl.GetProgramBinary(program, length, &written, &format,
+                      data.data() + sizeof(header));
+  if (written <= 0) {
+    return;
+  }
+  header.format = format;
+  header.fingerprint = GetProgramFingerprint(key);
+  header.data_size = static_cast<uint64_t>(written);
+  data.resize(sizeof(header) + written);
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  Lock lock(pending_writes_mutex_);
+  pending_program_binaries_.emplace_back(
+      GetProgramBinaryFileName(key.vertex_shader->GetName(),
+                               key.fragment_shader->GetName(),
+                               key.specialization_constants),
+      std::make_shared<fml::DataMapping>(std::move(data)));
+}
+
 std::shared_ptr<UniqueHandleGLES> PipelineLibraryGLES::GetProgramForKey(
     const ProgramKey& key) {
   Lock lock(programs_mutex_);
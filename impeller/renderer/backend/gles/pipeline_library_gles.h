@@ -5,10 +5,16 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_GLES_PIPELINE_LIBRARY_GLES_H_
 
+#include <atomic>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/hash_combine.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/backend/gles/unique_handle_gles.h"
@@ -31,6 +37,13 @@ class PipelineLibraryGLES final
 
   PipelineLibraryGLES& operator=(const PipelineLibraryGLES&) = delete;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called once per onscreen surface. Pending program binaries
+  ///             and variant manifests are written to the cache directory by
+  ///             a worker every few frames rather than as they are produced.
+  ///
+  void DidAcquireSurfaceFrame();
+
  private:
   friend ContextGLES;
 
@@ -91,8 +104,26 @@ class PipelineLibraryGLES final
   PipelineMap pipelines_;
   Mutex programs_mutex_;
   ProgramMap programs_ IPLR_GUARDED_BY(programs_mutex_);
-
-  explicit PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  const fml::UniqueFD cache_directory_;
+  // Identifies the driver that produced persisted program binaries and
+  // variant manifests so that data from a different driver is disregarded.
+  uint64_t driver_fingerprint_ = 0u;
+  std::shared_ptr<const fml::Mapping> persisted_variant_manifest_;
+  Mutex pending_writes_mutex_;
+  std::shared_ptr<const fml::Mapping> pending_variant_manifest_
+      IPLR_GUARDED_BY(pending_writes_mutex_);
+  // File names and contents, headers included, of program binaries that are
+  // yet to be written.
+  std::vector<std::pair<std::string, std::shared_ptr<const fml::Mapping>>>
+      pending_program_binaries_ IPLR_GUARDED_BY(pending_writes_mutex_);
+  std::atomic_size_t frames_acquired_ = 0u;
+  std::once_flag program_binary_formats_once_;
+  std::vector<GLint> program_binary_formats_;
+  // Performs all disk writes so that neither the reactor nor the raster
+  // thread waits on them. Declared last so that it is joined first.
+  std::shared_ptr<fml::ConcurrentMessageLoop> disk_message_loop_;
+
+  PipelineLibraryGLES(ReactorGLES::Ref reactor, fml::UniqueFD cache_directory);
 
   // |PipelineLibrary|
   bool IsValid() const override;
@@ -113,8 +144,42 @@ class PipelineLibraryGLES final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
+  // |PipelineLibrary|
+  std::shared_ptr<const fml::Mapping> GetPersistedPipelineVariantManifest()
+      const override;
+
+  // |PipelineLibrary|
+  void SetPipelineVariantManifest(
+      std::shared_ptr<const fml::Mapping> manifest) override;
+
+  void PersistPendingDataToDisk();
+
   const ReactorGLES::Ref& GetReactor() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether linked programs can be persisted to and restored from
+  ///             the cache directory. Must be called on a thread with a
+  ///             current context.
+  ///
+  bool SupportsProgramBinaries(const ProcTableGLES& gl);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Restore a program previously linked for the same key from its
+  ///             persisted binary. This skips shader compilation entirely.
+  ///
+  /// @return     If the program was restored and is linked.
+  ///
+  bool LoadProgramBinary(const ProgramKey& key, GLuint program) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read back the binary of a linked program and queue it to be
+  ///             written to the cache directory. Only the readback happens on
+  ///             the calling thread.
+  ///
+  void StoreProgramBinary(const ProgramKey& key, GLuint program);
+
+  uint64_t GetProgramFingerprint(const ProgramKey& key) const;
+
   static std::shared_ptr<PipelineGLES> CreatePipeline(
       const std::weak_ptr<PipelineLibrary>& weak_library,
       const PipelineDescriptor& desc,
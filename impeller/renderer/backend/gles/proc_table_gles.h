@@ -242,7 +242,10 @@ void(glDepthRange)(GLdouble n, GLdouble f);
   PROC(FenceSync);                         \
   PROC(DeleteSync);                        \
   PROC(WaitSync);                          \
-  PROC(BlitFramebuffer);
+  PROC(BlitFramebuffer);                   \
+  PROC(GetProgramBinary);                  \
+  PROC(ProgramBinary);                     \
+  PROC(ProgramParameteri);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC)    \
   PROC(DebugMessageControlKHR);             \
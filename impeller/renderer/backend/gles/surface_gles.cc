@@ -7,6 +7,7 @@
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
 #include "impeller/renderer/backend/gles/context_gles.h"
+#include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
 namespace impeller {
@@ -74,6 +75,10 @@ std::unique_ptr<Surface> SurfaceGLES::WrapFBO(
   gl_context.GetGPUTracer()->RecordRasterThread();
 #endif  // IMPELLER_DEBUG
 
+  if (auto pipeline_library = context->GetPipelineLibrary()) {
+    PipelineLibraryGLES::Cast(*pipeline_library).DidAcquireSurfaceFrame();
+  }
+
   return std::unique_ptr<SurfaceGLES>(
       new SurfaceGLES(std::move(swap_callback), render_target_desc));
 }
@@ -13,6 +13,9 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+static constexpr const char* kPipelineVariantManifestFileName =
+    "flutter.impeller.vkvariants";
+
 bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
                               const VkPhysicalDeviceProperties& props,
                               const vk::UniquePipelineCache& cache) {
@@ -91,6 +94,66 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
       on_disk_header.data_size, [on_disk_data](auto, auto) {});
 }
 
+bool PipelineVariantManifestPersist(const fml::UniqueFD& cache_directory,
+                                    const VkPhysicalDeviceProperties& props,
+                                    const fml::Mapping& manifest) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  auto allocation = std::make_shared<Allocation>();
+  if (!allocation->Truncate(
+          Bytes{sizeof(PipelineCacheHeaderVK) + manifest.GetSize()}, false)) {
+    VALIDATION_LOG << "Could not allocate pipeline variant manifest buffer.";
+    return false;
+  }
+  const auto header = PipelineCacheHeaderVK{props, manifest.GetSize()};
+  std::memcpy(allocation->GetBuffer(), &header, sizeof(header));
+  std::memcpy(allocation->GetBuffer() + sizeof(header), manifest.GetMapping(),
+              manifest.GetSize());
+
+  auto allocation_mapping = CreateMappingFromAllocation(allocation);
+  if (!allocation_mapping) {
+    return false;
+  }
+  if (!fml::WriteAtomically(cache_directory, kPipelineVariantManifestFileName,
+                            *allocation_mapping)) {
+    VALIDATION_LOG << "Could not write pipeline variant manifest to disk.";
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> PipelineVariantManifestRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  std::shared_ptr<fml::FileMapping> on_disk_data =
+      fml::FileMapping::CreateReadOnly(cache_directory,
+                                       kPipelineVariantManifestFileName);
+  if (!on_disk_data) {
+    return nullptr;
+  }
+  if (on_disk_data->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+  auto on_disk_header = PipelineCacheHeaderVK{};
+  std::memcpy(&on_disk_header,             //
+              on_disk_data->GetMapping(),  //
+              sizeof(on_disk_header)       //
+  );
+  const auto current_header = PipelineCacheHeaderVK{props, 0u};
+  if (!on_disk_header.IsCompatibleWith(current_header) ||
+      on_disk_header.data_size !=
+          on_disk_data->GetSize() - sizeof(on_disk_header)) {
+    return nullptr;
+  }
+  return std::make_unique<fml::NonOwnedMapping>(
+      on_disk_data->GetMapping() + sizeof(on_disk_header),
+      on_disk_header.data_size, [on_disk_data](auto, auto) {});
+}
+
 PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
 
 PipelineCacheHeaderVK::PipelineCacheHeaderVK(
@@ -104,6 +104,36 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
     const fml::UniqueFD& cache_directory,
     const VkPhysicalDeviceProperties& props);
 
+//------------------------------------------------------------------------------
+/// @brief      Persist a pipeline variant manifest to a file in the given
+///             cache directory. The manifest is prefixed with the same header
+///             as the pipeline cache so that manifests recorded on a
+///             different device or driver are disregarded.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  props            The physical device properties
+/// @param[in]  manifest         The manifest
+///
+/// @return     If the manifest could be persisted to disk.
+///
+bool PipelineVariantManifestPersist(const fml::UniqueFD& cache_directory,
+                                    const VkPhysicalDeviceProperties& props,
+                                    const fml::Mapping& manifest);
+
+//------------------------------------------------------------------------------
+/// @brief      Retrieve a pipeline variant manifest previously persisted with
+///             `PipelineVariantManifestPersist`.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  props            The physical device properties
+///
+/// @return     The manifest if it was found and was recorded on a compatible
+///             device.
+///
+std::unique_ptr<fml::Mapping> PipelineVariantManifestRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const VkPhysicalDeviceProperties& props);
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
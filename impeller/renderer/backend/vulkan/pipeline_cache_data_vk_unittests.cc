@@ -92,6 +92,29 @@ TEST(PipelineCacheDataVKTest, CanCreateFromDeviceProperties) {
   }
 }
 
+TEST(PipelineCacheDataVKTest, CanPersistAndRetrieveVariantManifest) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  vk::PhysicalDeviceProperties props;
+  props.deviceID = 10;
+  props.vendorID = 11;
+  props.driverVersion = 12;
+
+  fml::DataMapping manifest(std::string("variants"));
+  ASSERT_TRUE(PipelineVariantManifestPersist(temp_dir.fd(), props, manifest));
+  ASSERT_TRUE(fml::FileExists(temp_dir.fd(), "flutter.impeller.vkvariants"));
+
+  auto mapping = PipelineVariantManifestRetrieve(temp_dir.fd(), props);
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(mapping->GetSize(), manifest.GetSize());
+  EXPECT_EQ(std::memcmp(mapping->GetMapping(), manifest.GetMapping(),
+                        manifest.GetSize()),
+            0);
+
+  // Manifests recorded with a different driver are disregarded.
+  props.driverVersion = 13;
+  EXPECT_EQ(PipelineVariantManifestRetrieve(temp_dir.fd(), props), nullptr);
+}
+
 using PipelineCacheDataVKPlaygroundTest = PlaygroundTest;
 INSTANTIATE_VULKAN_PLAYGROUND_SUITE(PipelineCacheDataVKPlaygroundTest);
 
@@ -118,6 +118,28 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   );
 }
 
+void PipelineCacheVK::PersistVariantManifestToDisk(
+    const fml::Mapping& manifest) const {
+  if (!is_valid_) {
+    return;
+  }
+  const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
+  PipelineVariantManifestPersist(cache_directory_,                       //
+                                 vk_caps.GetPhysicalDeviceProperties(),  //
+                                 manifest                                //
+  );
+}
+
+std::unique_ptr<fml::Mapping> PipelineCacheVK::RetrieveVariantManifestFromDisk()
+    const {
+  if (!is_valid_) {
+    return nullptr;
+  }
+  const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
+  return PipelineVariantManifestRetrieve(cache_directory_,
+                                         vk_caps.GetPhysicalDeviceProperties());
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
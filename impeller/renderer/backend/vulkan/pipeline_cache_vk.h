@@ -33,6 +33,10 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  void PersistVariantManifestToDisk(const fml::Mapping& manifest) const;
+
+  std::unique_ptr<fml::Mapping> RetrieveVariantManifestFromDisk() const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
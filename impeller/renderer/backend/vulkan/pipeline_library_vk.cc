@@ -39,6 +39,7 @@ PipelineLibraryVK::PipelineLibraryVK(
     return;
   }
 
+  persisted_variant_manifest_ = pso_cache_->RetrieveVariantManifestFromDisk();
   is_valid_ = true;
 }
 
@@ -276,6 +277,20 @@ void PipelineLibraryVK::RemovePipelinesWithEntryPoint(
   });
 }
 
+// |PipelineLibrary|
+std::shared_ptr<const fml::Mapping>
+PipelineLibraryVK::GetPersistedPipelineVariantManifest() const {
+  return persisted_variant_manifest_;
+}
+
+// |PipelineLibrary|
+void PipelineLibraryVK::SetPipelineVariantManifest(
+    std::shared_ptr<const fml::Mapping> manifest) {
+  Lock lock(variant_manifest_mutex_);
+  pending_variant_manifest_ = std::move(manifest);
+  cache_dirty_ = true;
+}
+
 void PipelineLibraryVK::DidAcquireSurfaceFrame() {
   if (++frames_acquired_ == 50u) {
     if (cache_dirty_) {
@@ -287,13 +302,22 @@ void PipelineLibraryVK::DidAcquireSurfaceFrame() {
 }
 
 void PipelineLibraryVK::PersistPipelineCacheToDisk() {
+  std::shared_ptr<const fml::Mapping> variant_manifest;
+  {
+    Lock lock(variant_manifest_mutex_);
+    variant_manifest = std::move(pending_variant_manifest_);
+  }
   worker_task_runner_->PostTask(
-      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_)]() {
+      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_),
+       variant_manifest = std::move(variant_manifest)]() {
         auto cache = weak_cache.lock();
         if (!cache) {
           return;
         }
         cache->PersistCacheToDisk();
+        if (variant_manifest) {
+          cache->PersistVariantManifestToDisk(*variant_manifest);
+        }
       });
 }
 
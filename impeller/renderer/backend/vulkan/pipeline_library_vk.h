@@ -45,6 +45,10 @@ class PipelineLibraryVK final
   Mutex compute_pipelines_mutex_;
   ComputePipelineMap compute_pipelines_ IPLR_GUARDED_BY(
       compute_pipelines_mutex_);
+  std::shared_ptr<const fml::Mapping> persisted_variant_manifest_;
+  Mutex variant_manifest_mutex_;
+  std::shared_ptr<const fml::Mapping> pending_variant_manifest_
+      IPLR_GUARDED_BY(variant_manifest_mutex_);
   std::atomic_size_t frames_acquired_ = 0u;
   bool is_valid_ = false;
   bool cache_dirty_ = false;
@@ -74,6 +78,14 @@ class PipelineLibraryVK final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
+  // |PipelineLibrary|
+  std::shared_ptr<const fml::Mapping> GetPersistedPipelineVariantManifest()
+      const override;
+
+  // |PipelineLibrary|
+  void SetPipelineVariantManifest(
+      std::shared_ptr<const fml::Mapping> manifest) override;
+
   std::unique_ptr<ComputePipelineVK> CreateComputePipeline(
       const ComputePipelineDescriptor& desc);
 
@@ -0,0 +1,341 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/compute_tessellator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "impeller/core/platform.h"
+#include "impeller/geometry/wangs_formula.h"
+#include "impeller/renderer/command_queue.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
+#include "impeller/renderer/path_fill.comp.h"
+#include "impeller/renderer/path_polyline.comp.h"
+#include "impeller/renderer/path_stroke.comp.h"
+#include "impeller/renderer/pipeline_library.h"
+
+namespace impeller {
+
+namespace {
+
+// Segment kinds understood by path_polyline.comp.
+constexpr uint32_t kSegmentContour = 0u;
+constexpr uint32_t kSegmentLinear = 1u;
+constexpr uint32_t kSegmentQuadratic = 2u;
+constexpr uint32_t kSegmentCubic = 3u;
+
+// Set in the contour word of the points of a closed contour. The remaining
+// bits hold the index of the first point of the contour.
+constexpr uint32_t kContourClosedBit = 0x80000000u;
+
+// Join and cap styles understood by path_stroke.comp.
+constexpr uint32_t kJoinBevel = 0u;
+constexpr uint32_t kJoinMiter = 1u;
+constexpr uint32_t kCapButt = 0u;
+constexpr uint32_t kCapSquare = 1u;
+
+// Vertices written per polyline point by path_stroke.comp and
+// path_fill.comp respectively.
+constexpr size_t kStrokeVerticesPerPoint = 12u;
+constexpr size_t kFillVerticesPerPoint = 3u;
+
+// A segment as read by path_polyline.comp: its kind, the index of its first
+// polyline point, the number of points it writes and its contour word.
+using SegmentData = std::array<uint32_t, 4>;
+
+struct Segments {
+  std::vector<SegmentData> data;
+  // Four points per segment, laid out as (p1, cp1, cp2, p2).
+  std::vector<Point> points;
+  size_t point_count = 0u;
+};
+
+// The number of points a curve flattens into, which matches the points
+// written by the curve's |ToLinearPathComponents|.
+uint32_t CurvePointCount(Scalar subdivisions) {
+  return static_cast<uint32_t>(std::max(std::ceilf(subdivisions), 1.0f));
+}
+
+Segments GatherSegments(const Path& path, Scalar scale) {
+  Segments segments;
+  size_t component_count = path.GetComponentCount();
+  segments.data.reserve(component_count);
+  segments.points.reserve(component_count * 4);
+
+  uint32_t contour_word = 0u;
+  Point last_point;
+  auto add_segment = [&segments, &contour_word, &last_point](
+                         uint32_t kind, Point p1, Point cp1, Point cp2,
+                         Point p2, uint32_t point_count) {
+    segments.data.push_back({kind, static_cast<uint32_t>(segments.point_count),
+                             point_count, contour_word});
+    segments.points.push_back(p1);
+    segments.points.push_back(cp1);
+    segments.points.push_back(cp2);
+    segments.points.push_back(p2);
+    segments.point_count += point_count;
+    last_point = kind == kSegmentContour ? p1 : p2;
+  };
+
+  path.EnumerateComponents(
+      [&add_segment, &last_point](size_t index,
+                                  const LinearPathComponent& linear) {
+        // Repeated points are dropped, the same as in
+        // |LinearPathComponent::AppendPolylinePoints|.
+        if (linear.p2 == last_point) {
+          return;
+        }
+        add_segment(kSegmentLinear, linear.p1, {}, {}, linear.p2, 1u);
+      },
+      [&add_segment, scale](size_t index, const QuadraticPathComponent& quad) {
+        add_segment(
+            kSegmentQuadratic, quad.p1, quad.cp, {}, quad.p2,
+            CurvePointCount(ComputeQuadradicSubdivisions(scale, quad)));
+      },
+      [&add_segment, scale](size_t index, const CubicPathComponent& cubic) {
+        add_segment(kSegmentCubic, cubic.p1, cubic.cp1, cubic.cp2, cubic.p2,
+                    CurvePointCount(ComputeCubicSubdivisions(scale, cubic)));
+      },
+      [&add_segment, &segments, &contour_word, component_count](
+          size_t index, const ContourComponent& contour) {
+        // A trailing contour component has no segments and is skipped, the
+        // same as in |Path::CreatePolyline|.
+        if (index == component_count - 1) {
+          return;
+        }
+        contour_word = static_cast<uint32_t>(segments.point_count);
+        if (contour.IsClosed()) {
+          contour_word |= kContourClosedBit;
+        }
+        add_segment(kSegmentContour, contour.destination, {}, {}, {}, 1u);
+      });
+  return segments;
+}
+
+size_t GetVerticesPerPoint(ComputeTessellator::Style style) {
+  switch (style) {
+    case ComputeTessellator::Style::kStroke:
+      return kStrokeVerticesPerPoint;
+    case ComputeTessellator::Style::kFill:
+      return kFillVerticesPerPoint;
+  }
+  FML_UNREACHABLE();
+}
+
+template <class ComputeShader>
+std::shared_ptr<Pipeline<ComputePipelineDescriptor>> GetComputePipeline(
+    const Context& context) {
+  auto desc =
+      ComputePipelineBuilder<ComputeShader>::MakeDefaultPipelineDescriptor(
+          context);
+  if (!desc.has_value()) {
+    return nullptr;
+  }
+  return context.GetPipelineLibrary()->GetPipeline(desc).Get();
+}
+
+}  // namespace
+
+ComputeTessellator::ComputeTessellator() = default;
+
+ComputeTessellator::~ComputeTessellator() = default;
+
+bool ComputeTessellator::ShouldTessellate(const Path& path,
+                                          const Capabilities& capabilities) {
+  return capabilities.SupportsCompute() &&
+         path.GetComponentCount() >= kComplexityThreshold;
+}
+
+bool ComputeTessellator::ShouldTessellateStroke(
+    const Path& path,
+    const Capabilities& capabilities,
+    Join join,
+    Cap cap) {
+  return join != Join::kRound && cap != Cap::kRound &&
+         ShouldTessellate(path, capabilities);
+}
+
+ComputeTessellator& ComputeTessellator::SetStyle(Style value) {
+  style_ = value;
+  return *this;
+}
+
+ComputeTessellator& ComputeTessellator::SetStrokeWidth(Scalar value) {
+  stroke_width_ = value;
+  return *this;
+}
+
+ComputeTessellator& ComputeTessellator::SetMiterLimit(Scalar value) {
+  miter_limit_ = value;
+  return *this;
+}
+
+ComputeTessellator& ComputeTessellator::SetStrokeJoin(Join value) {
+  stroke_join_ = value;
+  return *this;
+}
+
+ComputeTessellator& ComputeTessellator::SetStrokeCap(Cap value) {
+  stroke_cap_ = value;
+  return *this;
+}
+
+ComputeTessellator& ComputeTessellator::SetScale(Scalar value) {
+  scale_ = value;
+  return *this;
+}
+
+ComputeTessellator::Style ComputeTessellator::GetStyle() const {
+  return style_;
+}
+
+Scalar ComputeTessellator::GetStrokeWidth() const {
+  return stroke_width_;
+}
+
+Scalar ComputeTessellator::GetMiterLimit() const {
+  return miter_limit_;
+}
+
+Join ComputeTessellator::GetStrokeJoin() const {
+  return stroke_join_;
+}
+
+Cap ComputeTessellator::GetStrokeCap() const {
+  return stroke_cap_;
+}
+
+Scalar ComputeTessellator::GetScale() const {
+  return scale_;
+}
+
+size_t ComputeTessellator::ComputeVertexCount(const Path& path) const {
+  return GatherSegments(path, scale_).point_count * GetVerticesPerPoint(style_);
+}
+
+ComputeTessellator::Status ComputeTessellator::Tessellate(
+    const Path& path,
+    HostBuffer& host_buffer,
+    const std::shared_ptr<Context>& context,
+    VertexBuffer& vertex_buffer,
+    const CommandBuffer::CompletionCallback& callback) const {
+  if (style_ == Style::kStroke &&
+      (stroke_join_ == Join::kRound || stroke_cap_ == Cap::kRound)) {
+    return Status::kCommandInvalid;
+  }
+  Segments segments = GatherSegments(path, scale_);
+  if (segments.data.empty()) {
+    return Status::kCommandInvalid;
+  }
+
+  auto polyline_pipeline =
+      GetComputePipeline<PathPolylineComputeShader>(*context);
+  auto stroke_pipeline =
+      style_ == Style::kStroke
+          ? GetComputePipeline<PathStrokeComputeShader>(*context)
+          : nullptr;
+  auto fill_pipeline = style_ == Style::kFill
+                           ? GetComputePipeline<PathFillComputeShader>(*context)
+                           : nullptr;
+  if (!polyline_pipeline || !(stroke_pipeline || fill_pipeline)) {
+    return Status::kCommandInvalid;
+  }
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  auto pass = cmd_buffer->CreateComputePass();
+  if (!pass || !pass->IsValid()) {
+    return Status::kCommandInvalid;
+  }
+  pass->SetLabel("Compute Tessellator");
+
+  // The polyline and the output vertices are only ever written on the GPU,
+  // so they only need space in the host buffer and no upload.
+  size_t point_count = segments.point_count;
+  size_t vertex_count = point_count * GetVerticesPerPoint(style_);
+  BufferView polyline = host_buffer.Emplace(
+      nullptr, point_count * sizeof(Point), DefaultUniformAlignment());
+  BufferView polyline_contours = host_buffer.Emplace(
+      nullptr, point_count * sizeof(uint32_t), DefaultUniformAlignment());
+  BufferView vertices = host_buffer.Emplace(
+      nullptr, vertex_count * sizeof(Point), DefaultUniformAlignment());
+
+  {
+    using PS = PathPolylineComputeShader;
+    pass->SetCommandLabel("Flatten Path");
+    pass->SetPipeline(polyline_pipeline);
+
+    PS::Config config{
+        .segment_count = static_cast<uint32_t>(segments.data.size())};
+    PS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    PS::BindSegments(
+        *pass, host_buffer.Emplace(segments.data.data(),
+                                   segments.data.size() * sizeof(SegmentData),
+                                   DefaultUniformAlignment()));
+    PS::BindSegmentPoints(
+        *pass, host_buffer.Emplace(segments.points.data(),
+                                   segments.points.size() * sizeof(Point),
+                                   DefaultUniformAlignment()));
+    PS::BindPolyline(*pass, polyline);
+    PS::BindPolylineContours(*pass, polyline_contours);
+
+    if (!pass->Compute(ISize(segments.data.size(), 1)).ok()) {
+      return Status::kCommandInvalid;
+    }
+  }
+
+  pass->AddBufferMemoryBarrier();
+
+  if (style_ == Style::kStroke) {
+    using SS = PathStrokeComputeShader;
+    pass->SetCommandLabel("Stroke Polyline");
+    pass->SetPipeline(stroke_pipeline);
+
+    SS::Config config{
+        .half_stroke_width = stroke_width_ * 0.5f,
+        .scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5f,
+        .point_count = static_cast<uint32_t>(point_count),
+        .join = stroke_join_ == Join::kMiter ? kJoinMiter : kJoinBevel,
+        .cap = stroke_cap_ == Cap::kSquare ? kCapSquare : kCapButt,
+    };
+    SS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    SS::BindPolyline(*pass, polyline);
+    SS::BindPolylineContours(*pass, polyline_contours);
+    SS::BindVertexBuffer(*pass, vertices);
+  } else {
+    using FS = PathFillComputeShader;
+    pass->SetCommandLabel("Fill Polyline");
+    pass->SetPipeline(fill_pipeline);
+
+    FS::Config config{.point_count = static_cast<uint32_t>(point_count)};
+    FS::BindConfig(*pass, host_buffer.EmplaceUniform(config));
+    FS::BindPolyline(*pass, polyline);
+    FS::BindPolylineContours(*pass, polyline_contours);
+    FS::BindVertexBuffer(*pass, vertices);
+  }
+
+  if (!pass->Compute(ISize(point_count, 1)).ok()) {
+    return Status::kCommandInvalid;
+  }
+
+  if (!pass->EncodeCommands()) {
+    return Status::kCommandInvalid;
+  }
+
+  if (!context->GetCommandQueue()->Submit({cmd_buffer}, callback).ok()) {
+    return Status::kCommandInvalid;
+  }
+
+  vertex_buffer = VertexBuffer{
+      .vertex_buffer = std::move(vertices),
+      .vertex_count = vertex_count,
+      .index_type = IndexType::kNone,
+  };
+  return Status::kOk;
+}
+
+}  // namespace impeller
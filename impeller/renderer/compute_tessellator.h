@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_COMPUTE_TESSELLATOR_H_
+#define FLUTTER_IMPELLER_RENDERER_COMPUTE_TESSELLATOR_H_
+
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A utility that generates triangles for a path using compute
+///             shaders.
+///
+///             The number of polyline points each path component flattens
+///             into is computed on the CPU with the same Wang's formula
+///             estimates as |Path::CreatePolyline|, so every component knows
+///             where its points go before any work is dispatched. The first
+///             dispatch then flattens every component in parallel, and the
+///             second expands the polyline into either a stroke or a
+///             stencil-then-cover fill fan.
+///
+///             Both outputs are triangle lists of `Point`s written into the
+///             host buffer. Strokes support bevel and miter joins and butt and
+///             square caps; paths stroked with round joins or caps must be
+///             tessellated on the CPU. Fills must be drawn with a stencil
+///             winding pass followed by a cover pass.
+///
+///             Every call to `Tessellate` submits its own command buffer, so
+///             path geometry only uses this when compute tessellation is
+///             enabled on the content context.
+///
+class ComputeTessellator {
+ public:
+  ComputeTessellator();
+
+  ~ComputeTessellator();
+
+  enum class Status {
+    kCommandInvalid,
+    kOk,
+  };
+
+  enum class Style {
+    kStroke,
+    kFill,
+  };
+
+  /// Paths with fewer components than this are cheaper to tessellate on
+  /// the CPU than to round trip through a compute dispatch.
+  static constexpr size_t kComplexityThreshold = 256;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the given path is complex enough to benefit from
+  ///             compute tessellation on a device with the given
+  ///             capabilities.
+  ///
+  static bool ShouldTessellate(const Path& path,
+                               const Capabilities& capabilities);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a stroke of the given path with the given join and
+  ///             cap should be tessellated with compute shaders.
+  ///
+  ///             Round joins and caps are not supported and always return
+  ///             false.
+  ///
+  static bool ShouldTessellateStroke(const Path& path,
+                                     const Capabilities& capabilities,
+                                     Join join,
+                                     Cap cap);
+
+  ComputeTessellator& SetStyle(Style value);
+
+  ComputeTessellator& SetStrokeWidth(Scalar value);
+
+  ComputeTessellator& SetMiterLimit(Scalar value);
+
+  ComputeTessellator& SetStrokeJoin(Join value);
+
+  ComputeTessellator& SetStrokeCap(Cap value);
+
+  /// The max basis length of the transform the path will be drawn with.
+  /// Curves are flattened more finely as the scale increases.
+  ComputeTessellator& SetScale(Scalar value);
+
+  Style GetStyle() const;
+
+  Scalar GetStrokeWidth() const;
+
+  Scalar GetMiterLimit() const;
+
+  Join GetStrokeJoin() const;
+
+  Cap GetStrokeCap() const;
+
+  Scalar GetScale() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of vertices `Tessellate` writes for the given
+  ///             path.
+  ///
+  size_t ComputeVertexCount(const Path& path) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode and submit the compute work to tessellate a path.
+  ///
+  ///             The command buffer is submitted immediately, so the
+  ///             vertices are ready for any render pass submitted to the
+  ///             same queue afterwards.
+  ///
+  /// @param[in]  path           The path to tessellate.
+  /// @param[in]  host_buffer    The host buffer used to upload the path
+  ///                            components and shader configuration, and that
+  ///                            holds the intermediate polyline and the
+  ///                            output vertices.
+  /// @param[in]  context        The context to use for the compute passes.
+  /// @param[out] vertex_buffer  Receives the non-indexed triangle list.
+  /// @param[in]  callback       Invoked when the command buffer completes.
+  ///
+  /// @return     A |Status| value indicating success or failure.
+  ///
+  Status Tessellate(const Path& path,
+                    HostBuffer& host_buffer,
+                    const std::shared_ptr<Context>& context,
+                    VertexBuffer& vertex_buffer,
+                    const CommandBuffer::CompletionCallback& callback =
+                        nullptr) const;
+
+ private:
+  Style style_ = Style::kStroke;
+  Scalar stroke_width_ = 1.0f;
+  Scalar miter_limit_ = 4.0f;
+  Join stroke_join_ = Join::kMiter;
+  Cap stroke_cap_ = Cap::kButt;
+  Scalar scale_ = 1.0f;
+
+  ComputeTessellator(const ComputeTessellator&) = delete;
+
+  ComputeTessellator& operator=(const ComputeTessellator&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_COMPUTE_TESSELLATOR_H_
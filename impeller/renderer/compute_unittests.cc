@@ -6,12 +6,15 @@
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/geometry/geometry_asserts.h"
+#include "impeller/geometry/path_builder.h"
 #include "impeller/fixtures/sample.comp.h"
 #include "impeller/fixtures/stage1.comp.h"
 #include "impeller/fixtures/stage2.comp.h"
 #include "impeller/playground/compute_playground_test.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/compute_pipeline_builder.h"
+#include "impeller/renderer/compute_tessellator.h"
 #include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/prefix_sum_test.comp.h"
 #include "impeller/renderer/threadgroup_sizing_test.comp.h"
@@ -505,5 +508,207 @@ TEST_P(ComputeTest, ReturnsEarlyWhenAnyGridDimensionIsZero) {
   pass->EncodeCommands();
 }
 
+TEST_P(ComputeTest, ComputeTessellatorSelectsComplexPaths) {
+  auto capabilities = CapabilitiesBuilder().SetSupportsCompute(true).Build();
+  auto no_compute = CapabilitiesBuilder().SetSupportsCompute(false).Build();
+
+  PathBuilder simple;
+  simple.AddRect(Rect::MakeLTRB(0, 0, 10, 10));
+  EXPECT_FALSE(ComputeTessellator::ShouldTessellate(simple.TakePath(),
+                                                    *capabilities));
+
+  PathBuilder complex;
+  for (size_t i = 0; i < ComputeTessellator::kComplexityThreshold; i++) {
+    complex.LineTo(Point(i, i % 2));
+  }
+  Path complex_path = complex.TakePath();
+  EXPECT_TRUE(
+      ComputeTessellator::ShouldTessellate(complex_path, *capabilities));
+  EXPECT_FALSE(ComputeTessellator::ShouldTessellate(complex_path, *no_compute));
+
+  // The number of components is not bounded by the workgroup size.
+  PathBuilder very_complex;
+  for (size_t i = 0; i < 16 * 1024; i++) {
+    very_complex.LineTo(Point(i, i % 2));
+  }
+  EXPECT_TRUE(ComputeTessellator::ShouldTessellate(very_complex.TakePath(),
+                                                   *capabilities));
+}
+
+TEST_P(ComputeTest, ComputeTessellatorRejectsRoundStrokes) {
+  auto capabilities = CapabilitiesBuilder().SetSupportsCompute(true).Build();
+
+  PathBuilder builder;
+  for (size_t i = 0; i < ComputeTessellator::kComplexityThreshold; i++) {
+    builder.LineTo(Point(i, i % 2));
+  }
+  Path path = builder.TakePath();
+
+  EXPECT_TRUE(ComputeTessellator::ShouldTessellateStroke(
+      path, *capabilities, Join::kMiter, Cap::kButt));
+  EXPECT_TRUE(ComputeTessellator::ShouldTessellateStroke(
+      path, *capabilities, Join::kBevel, Cap::kSquare));
+  EXPECT_FALSE(ComputeTessellator::ShouldTessellateStroke(
+      path, *capabilities, Join::kRound, Cap::kButt));
+  EXPECT_FALSE(ComputeTessellator::ShouldTessellateStroke(
+      path, *capabilities, Join::kMiter, Cap::kRound));
+}
+
+namespace {
+
+const Point* GetPoints(const BufferView& view) {
+  return reinterpret_cast<const Point*>(view.GetBuffer()->OnGetContents() +
+                                        view.GetRange().offset);
+}
+
+// Tessellates |path| and calls |check| with the vertices once the GPU is
+// done.
+void TessellateAndCheck(
+    const std::shared_ptr<Context>& context,
+    const ComputeTessellator& tessellator,
+    const Path& path,
+    const std::function<void(const Point* points, size_t count)>& check) {
+  auto host_buffer = HostBuffer::Create(context->GetResourceAllocator(),
+                                        context->GetIdleWaiter());
+  VertexBuffer vertex_buffer;
+  fml::AutoResetWaitableEvent latch;
+  auto callback = [&latch](CommandBuffer::Status status) {
+    EXPECT_EQ(status, CommandBuffer::Status::kCompleted);
+    latch.Signal();
+  };
+  ASSERT_EQ(tessellator.Tessellate(path, *host_buffer, context, vertex_buffer,
+                                   callback),
+            ComputeTessellator::Status::kOk);
+  latch.Wait();
+
+  EXPECT_EQ(vertex_buffer.index_type, IndexType::kNone);
+  EXPECT_EQ(vertex_buffer.vertex_count, tessellator.ComputeVertexCount(path));
+  check(GetPoints(vertex_buffer.vertex_buffer), vertex_buffer.vertex_count);
+}
+
+}  // namespace
+
+TEST_P(ComputeTest, ComputeTessellatorCanStrokeLine) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsCompute());
+
+  Path path = PathBuilder{}.MoveTo({0, 0}).LineTo({100, 0}).TakePath();
+
+  ComputeTessellator tessellator;
+  tessellator.SetStyle(ComputeTessellator::Style::kStroke)
+      .SetStrokeWidth(10.0f)
+      .SetStrokeCap(Cap::kButt);
+  ASSERT_EQ(tessellator.ComputeVertexCount(path), 24u);
+
+  TessellateAndCheck(context, tessellator, path,
+                     [](const Point* points, size_t count) {
+                       EXPECT_POINT_NEAR(points[0], Point(0, 5));
+                       EXPECT_POINT_NEAR(points[1], Point(0, -5));
+                       EXPECT_POINT_NEAR(points[2], Point(100, 5));
+                       EXPECT_POINT_NEAR(points[5], Point(100, -5));
+                       // An open contour has no join after its last segment,
+                       // and its last point has no segment.
+                       for (size_t i = 6; i < count; i++) {
+                         EXPECT_POINT_NEAR(points[i], Point(100, 0));
+                       }
+                     });
+}
+
+TEST_P(ComputeTest, ComputeTessellatorExtendsSquareCaps) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsCompute());
+
+  Path path = PathBuilder{}.MoveTo({0, 0}).LineTo({100, 0}).TakePath();
+
+  ComputeTessellator tessellator;
+  tessellator.SetStyle(ComputeTessellator::Style::kStroke)
+      .SetStrokeWidth(10.0f)
+      .SetStrokeCap(Cap::kSquare);
+
+  TessellateAndCheck(context, tessellator, path,
+                     [](const Point* points, size_t count) {
+                       EXPECT_POINT_NEAR(points[0], Point(-5, 5));
+                       EXPECT_POINT_NEAR(points[1], Point(-5, -5));
+                       EXPECT_POINT_NEAR(points[2], Point(105, 5));
+                       EXPECT_POINT_NEAR(points[5], Point(105, -5));
+                     });
+}
+
+TEST_P(ComputeTest, ComputeTessellatorJoinsClosedContoursWithMiters) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsCompute());
+
+  Path path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 100, 100)).TakePath();
+
+  ComputeTessellator tessellator;
+  tessellator.SetStyle(ComputeTessellator::Style::kStroke)
+      .SetStrokeWidth(10.0f)
+      .SetStrokeJoin(Join::kMiter)
+      .SetStrokeCap(Cap::kSquare);
+
+  TessellateAndCheck(
+      context, tessellator, path, [](const Point* points, size_t count) {
+        // Every corner, including the one where the contour closes, gets a
+        // miter instead of a cap.
+        std::vector<Point> expected_miters = {
+            Point(-5, -5), Point(105, -5), Point(105, 105), Point(-5, 105)};
+        for (const Point& miter : expected_miters) {
+          bool found = false;
+          for (size_t i = 0; i < count; i++) {
+            found |= points[i].GetDistance(miter) < 1e-3;
+          }
+          EXPECT_TRUE(found) << miter;
+        }
+        // No square cap extends a side of the closed contour.
+        for (size_t i = 0; i < count; i++) {
+          EXPECT_GE(points[i].x, -5 - 1e-3);
+          EXPECT_GE(points[i].y, -5 - 1e-3);
+          EXPECT_LE(points[i].x, 105 + 1e-3);
+          EXPECT_LE(points[i].y, 105 + 1e-3);
+        }
+      });
+
+  tessellator.SetStrokeJoin(Join::kBevel);
+  TessellateAndCheck(context, tessellator, path,
+                     [](const Point* points, size_t count) {
+                       for (size_t i = 0; i < count; i++) {
+                         EXPECT_GT(points[i].GetDistance(Point(-5, -5)), 1);
+                       }
+                     });
+}
+
+TEST_P(ComputeTest, ComputeTessellatorCanFillMultipleContours) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsCompute());
+
+  Path path = PathBuilder{}
+                  .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+                  .AddCircle(Point(50, 50), 10)
+                  .TakePath();
+
+  ComputeTessellator tessellator;
+  tessellator.SetStyle(ComputeTessellator::Style::kFill);
+
+  // The fill flattens curves into as many points as the CPU polyline.
+  size_t polyline_point_count = path.CreatePolyline(1.0f).points->size();
+  EXPECT_EQ(tessellator.ComputeVertexCount(path), polyline_point_count * 3);
+
+  TessellateAndCheck(context, tessellator, path,
+                     [](const Point* points, size_t count) {
+                       EXPECT_GT(count, 0u);
+                       EXPECT_EQ(count % 3, 0u);
+
+                       // Every triangle of the fan shares the first point of
+                       // the path as its apex.
+                       for (size_t i = 0; i < count; i += 3) {
+                         EXPECT_POINT_NEAR(points[i], Point(0, 0));
+                       }
+                     });
+}
+
 }  // namespace testing
 }  // namespace impeller
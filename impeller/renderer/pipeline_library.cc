@@ -34,4 +34,12 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibrary::GetPipeline(
   return {descriptor, promise->get_future()};
 }
 
+std::shared_ptr<const fml::Mapping>
+PipelineLibrary::GetPersistedPipelineVariantManifest() const {
+  return nullptr;
+}
+
+void PipelineLibrary::SetPipelineVariantManifest(
+    std::shared_ptr<const fml::Mapping> manifest) {}
+
 }  // namespace impeller
@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "compute_pipeline_descriptor.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 
@@ -53,6 +54,33 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the pipeline variant manifest persisted by a previous
+  ///             session using the same cache directory.
+  ///
+  ///             The manifest is opaque to the pipeline library. Its contents
+  ///             are owned by whoever creates pipeline variants and are used
+  ///             to create those variants again ahead of first use.
+  ///
+  /// @return     The persisted manifest or nullptr if the backend does not
+  ///             persist manifests or none was found.
+  ///
+  virtual std::shared_ptr<const fml::Mapping>
+  GetPersistedPipelineVariantManifest() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replace the pipeline variant manifest that will be persisted
+  ///             for use by the next session.
+  ///
+  ///             Backends may write the manifest lazily, for example along
+  ///             with their pipeline caches. This call must not block on disk
+  ///             access.
+  ///
+  /// @param[in]  manifest  The manifest to persist.
+  ///
+  virtual void SetPipelineVariantManifest(
+      std::shared_ptr<const fml::Mapping> manifest);
+
  protected:
   PipelineLibrary();
 
@@ -4,7 +4,6 @@
 
 #include "impeller/tessellator/tessellator.h"
 #include <cstdint>
-#include <cstring>
 
 #include "impeller/core/device_buffer.h"
 #include "impeller/geometry/path_component.h"
@@ -13,18 +12,13 @@ namespace impeller {
 
 Tessellator::Tessellator()
     : point_buffer_(std::make_unique<std::vector<Point>>()),
-      index_buffer_(std::make_unique<std::vector<uint16_t>>()),
-      stroke_points_(kPointArenaSize) {
+      index_buffer_(std::make_unique<std::vector<uint16_t>>()) {
   point_buffer_->reserve(2048);
   index_buffer_->reserve(2048);
 }
 
 Tessellator::~Tessellator() = default;
 
-std::vector<Point>& Tessellator::GetStrokePointCache() {
-  return stroke_points_;
-}
-
 Path::Polyline Tessellator::CreateTempPolyline(const Path& path,
                                                Scalar tolerance) {
   FML_DCHECK(point_buffer_);
@@ -120,43 +114,25 @@ VertexBuffer Tessellator::TessellateConvex(const Path& path,
 VertexBuffer Tessellator::GenerateLineStrip(const Path& path,
                                             HostBuffer& host_buffer,
                                             Scalar tolerance) {
-  LineStripVertexWriter writer(stroke_points_);
-  path.WritePolyline(tolerance, writer);
+  // The polyline is generated twice. The first pass only counts the vertices
+  // so that the second pass can write them directly into the host buffer.
+  LineStripVertexWriter counter;
+  path.WritePolyline(tolerance, counter);
+  const size_t vertex_count = counter.GetVertexCount();
 
-  const auto [arena_length, oversized_length] = writer.GetVertexCount();
-
-  if (oversized_length == 0) {
-    return VertexBuffer{
-        .vertex_buffer =
-            host_buffer.Emplace(stroke_points_.data(),
-                                arena_length * sizeof(Point), alignof(Point)),
-        .index_buffer = {},
-        .vertex_count = arena_length,
-        .index_type = IndexType::kNone,
-    };
-  }
-  const std::vector<Point>& oversized_data = writer.GetOversizedBuffer();
   BufferView buffer_view = host_buffer.Emplace(
-      /*buffer=*/nullptr,                                 //
-      (arena_length + oversized_length) * sizeof(Point),  //
-      alignof(Point)                                      //
-  );
-  memcpy(buffer_view.GetBuffer()->OnGetContents() +
-             buffer_view.GetRange().offset,  //
-         stroke_points_.data(),              //
-         arena_length * sizeof(Point)        //
-  );
-  memcpy(buffer_view.GetBuffer()->OnGetContents() +
-             buffer_view.GetRange().offset + arena_length * sizeof(Point),  //
-         oversized_data.data(),                                             //
-         oversized_data.size() * sizeof(Point)                              //
-  );
+      nullptr, vertex_count * sizeof(Point), alignof(Point));
+  LineStripVertexWriter writer(
+      reinterpret_cast<Point*>(buffer_view.GetBuffer()->OnGetContents() +
+                               buffer_view.GetRange().offset));
+  path.WritePolyline(tolerance, writer);
+  FML_DCHECK(writer.GetVertexCount() == vertex_count);
   buffer_view.GetBuffer()->Flush(buffer_view.GetRange());
 
   return VertexBuffer{
       .vertex_buffer = buffer_view,
       .index_buffer = {},
-      .vertex_count = arena_length + oversized_length,
+      .vertex_count = vertex_count,
       .index_type = IndexType::kNone,
   };
 }
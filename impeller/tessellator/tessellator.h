@@ -18,9 +18,6 @@
 
 namespace impeller {
 
-/// The size of the point arena buffer stored on the tessellator.
-static constexpr size_t kPointArenaSize = 4096u;
-
 //------------------------------------------------------------------------------
 /// @brief      A utility that generates triangles of the specified fill type
 ///             given a polyline. This happens on the CPU.
@@ -306,15 +303,10 @@ class Tessellator {
                                             const Rect& bounds,
                                             const Size& radii);
 
-  /// Retrieve a pre-allocated arena of kPointArenaSize points.
-  std::vector<Point>& GetStrokePointCache();
-
  protected:
   /// Used for polyline generation.
   std::unique_ptr<std::vector<Point>> point_buffer_;
   std::unique_ptr<std::vector<uint16_t>> index_buffer_;
-  /// Used for stroke path generation.
-  std::vector<Point> stroke_points_;
 
  private:
   // Data for various Circle/EllipseGenerator classes, cached per
@@ -4,6 +4,8 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <numeric>
@@ -11,6 +13,7 @@
 #include <vector>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/task_group.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/closure.h"
 
@@ -31,6 +34,7 @@
 #include "impeller/typographer/glyph.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "impeller/typographer/typographer_context.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkImageInfo.h"
@@ -41,6 +45,7 @@
 #include "third_party/skia/include/core/SkBlendMode.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace impeller {
@@ -73,11 +78,15 @@ SkPaint::Join ToSkiaJoin(Join join) {
 }
 }  // namespace
 
-std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
-  return std::make_shared<TypographerContextSkia>();
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner) {
+  return std::make_shared<TypographerContextSkia>(
+      std::move(worker_task_runner));
 }
 
-TypographerContextSkia::TypographerContextSkia() = default;
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : worker_task_runner_(std::move(worker_task_runner)) {}
 
 TypographerContextSkia::~TypographerContextSkia() = default;
 
@@ -89,6 +98,7 @@ TypographerContextSkia::CreateGlyphAtlasContext(GlyphAtlas::Type type) const {
 static SkImageInfo GetImageInfo(const GlyphAtlas& atlas, Size size) {
   switch (atlas.GetType()) {
     case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
       return SkImageInfo::MakeA8(SkISize{static_cast<int32_t>(size.width),
                                          static_cast<int32_t>(size.height)});
     case GlyphAtlas::Type::kColorBitmap:
@@ -97,111 +107,165 @@ static SkImageInfo GetImageInfo(const GlyphAtlas& atlas, Size size) {
   FML_UNREACHABLE();
 }
 
-/// Append as many glyphs to the texture as will fit, and return the first index
-/// of [extra_pairs] that did not fit.
-static size_t AppendToExistingAtlas(
-    const std::shared_ptr<GlyphAtlas>& atlas,
-    const std::vector<FontGlyphPair>& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    const std::vector<Rect>& glyph_sizes,
-    ISize atlas_size,
-    int64_t height_adjustment,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
-    return 0;
-  }
+// Pages are never resized once created, since the glyphs in them would have to
+// be repacked, so pick a reasonable large width for all atlas pages.
+static constexpr int64_t kAtlasWidth = 4096;
+static constexpr int64_t kMinAtlasPageHeight = 1024;
 
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
-    ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
-    IPoint16 location_in_atlas;
-    if (!rect_packer->AddRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return i;
-    }
-    // Position the glyph in the center of the 1px padding.
-    glyph_positions.push_back(Rect::MakeXYWH(
-        location_in_atlas.x() + 1,                      //
-        location_in_atlas.y() + height_adjustment + 1,  //
-        glyph_size.width,                               //
-        glyph_size.height                               //
-        ));
-  }
+namespace {
+/// The locations chosen for new glyphs within the pages of an atlas.
+struct GlyphPlacement {
+  /// The position of each new glyph within its page.
+  std::vector<Rect> positions;
+  /// The page index of each new glyph.
+  std::vector<size_t> pages;
+  /// The sizes of the pages to append to the atlas.
+  std::vector<ISize> new_page_sizes;
+};
+}  // namespace
 
-  return extra_pairs.size();
+/// Compute the size of a new atlas page that can hold a glyph of the given
+/// size.
+static ISize ComputeNewPageSize(ISize glyph_size, ISize max_texture_size) {
+  int64_t height = kMinAtlasPageHeight;
+  while (height < glyph_size.height + kPadding) {
+    height *= 2;
+  }
+  return ISize(std::min(kAtlasWidth, max_texture_size.width),
+               std::min(height, max_texture_size.height));
 }
 
-static size_t PairsFitInAtlasOfSize(
-    const std::vector<FontGlyphPair>& pairs,
-    const ISize& atlas_size,
-    std::vector<Rect>& glyph_positions,
-    const std::vector<Rect>& glyph_sizes,
-    int64_t height_adjustment,
-    const std::shared_ptr<RectanglePacker>& rect_packer,
-    size_t start_index) {
-  FML_DCHECK(!atlas_size.IsEmpty());
+/// Order the first [page_count] pages of the atlas from the least to the most
+/// recently used.
+static std::vector<size_t> SortPagesByLastUse(const GlyphAtlas& atlas,
+                                              size_t page_count) {
+  std::vector<uint64_t> last_used_frames(page_count);
+  for (size_t i = 0; i < page_count; i++) {
+    last_used_frames[i] = atlas.GetPageLastUsedFrame(i);
+  }
+  std::vector<size_t> pages(page_count);
+  std::iota(pages.begin(), pages.end(), 0u);
+  std::stable_sort(pages.begin(), pages.end(), [&](size_t a, size_t b) {
+    return last_used_frames[a] < last_used_frames[b];
+  });
+  return pages;
+}
 
-  for (size_t i = start_index; i < pairs.size(); i++) {
-    ISize glyph_size = ISize::Ceil(glyph_sizes[i].GetSize());
+/// Find a location for each of the [new_glyphs] in the pages of the atlas.
+///
+/// Glyphs are added to the first page with enough free space. If no page
+/// has room, a new page is appended. Once the atlas has the maximum number
+/// of pages, the glyphs the current frame doesn't use are evicted from the
+/// least recently used pages until the glyph fits. Pages whose packer can't
+/// remove individual rectangles are only cleared as a whole, if they hold no
+/// glyph of the current frame.
+///
+/// Returns false if the glyphs don't fit without evicting glyphs used by the
+/// current frame.
+static bool PlaceGlyphs(GlyphAtlas& atlas,
+                        GlyphAtlasContext& atlas_context,
+                        const std::vector<Rect>& glyph_sizes,
+                        ISize max_texture_size,
+                        GlyphPlacement& placement) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  const uint64_t frame_number = atlas_context.GetFrameNumber();
+  const size_t existing_page_count = atlas.GetPageCount();
+  // Whether each page holds a glyph placed by this call, in which case it
+  // can't be evicted as a whole.
+  std::vector<bool> page_in_use(existing_page_count, false);
+  // Whether the unused glyphs of each page were already evicted by this call.
+  std::vector<bool> page_reclaimed(existing_page_count, false);
+  // The existing pages, least recently used first. Only computed once the
+  // atlas is full.
+  std::vector<size_t> pages_by_age;
+
+  placement.positions.reserve(glyph_sizes.size());
+  placement.pages.reserve(glyph_sizes.size());
+  for (const Rect& glyph_bounds : glyph_sizes) {
+    ISize glyph_size = ISize::Ceil(glyph_bounds.GetSize());
     IPoint16 location_in_atlas;
-    if (!rect_packer->AddRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return i;
+    auto add_to_page = [&](size_t page_index) {
+      std::shared_ptr<RectanglePacker> rect_packer =
+          atlas_context.GetRectPacker(page_index);
+      return rect_packer &&
+             rect_packer->AddRect(glyph_size.width + kPadding,   //
+                                  glyph_size.height + kPadding,  //
+                                  &location_in_atlas             //
+             );
+    };
+
+    std::optional<size_t> page;
+    size_t page_count = existing_page_count + placement.new_page_sizes.size();
+    for (size_t i = 0; i < page_count; i++) {
+      if (add_to_page(i)) {
+        page = i;
+        break;
+      }
     }
-    glyph_positions.push_back(Rect::MakeXYWH(
-        location_in_atlas.x() + 1,                      //
-        location_in_atlas.y() + height_adjustment + 1,  //
-        glyph_size.width,                               //
-        glyph_size.height                               //
-        ));
-  }
 
-  return pairs.size();
-}
-
-static ISize ComputeNextAtlasSize(
-    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
-    const std::vector<FontGlyphPair>& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    const std::vector<Rect>& glyph_sizes,
-    size_t glyph_index_start,
-    int64_t max_texture_height) {
-  // Because we can't grow the skyline packer horizontally, pick a reasonable
-  // large width for all atlases.
-  static constexpr int64_t kAtlasWidth = 4096;
-  static constexpr int64_t kMinAtlasHeight = 1024;
-
-  ISize current_size = ISize(kAtlasWidth, kMinAtlasHeight);
-  if (atlas_context->GetAtlasSize().height > current_size.height) {
-    current_size.height = atlas_context->GetAtlasSize().height * 2;
-  }
+    if (!page.has_value() && page_count < GlyphAtlas::kMaxPageCount) {
+      ISize page_size = ComputeNewPageSize(glyph_size, max_texture_size);
+      atlas_context.UpdateRectPacker(
+          page_count, RectanglePacker::GuillotineFactory(page_size.width,
+                                                         page_size.height));
+      placement.new_page_sizes.push_back(page_size);
+      page_in_use.push_back(false);
+      if (add_to_page(page_count)) {
+        page = page_count;
+      }
+    }
 
-  auto height_adjustment = atlas_context->GetAtlasSize().height;
-  while (current_size.height <= max_texture_height) {
-    std::shared_ptr<RectanglePacker> rect_packer;
-    if (atlas_context->GetRectPacker() || glyph_index_start) {
-      rect_packer = RectanglePacker::Factory(
-          kAtlasWidth,
-          current_size.height - atlas_context->GetAtlasSize().height);
-    } else {
-      rect_packer = RectanglePacker::Factory(kAtlasWidth, current_size.height);
+    if (!page.has_value()) {
+      if (pages_by_age.empty()) {
+        pages_by_age = SortPagesByLastUse(atlas, existing_page_count);
+      }
+      for (size_t i : pages_by_age) {
+        std::shared_ptr<RectanglePacker> rect_packer =
+            atlas_context.GetRectPacker(i);
+        if (page_reclaimed[i] || !rect_packer) {
+          continue;
+        }
+        if (rect_packer->SupportsRemoval()) {
+          // Release the area of the glyphs the current frame doesn't use,
+          // keeping the others in place.
+          atlas.EvictGlyphsUnusedSince(
+              i, frame_number, [&rect_packer](const Rect& atlas_bounds) {
+                IPoint16 location = {
+                    static_cast<int16_t>(atlas_bounds.GetLeft() - 1),
+                    static_cast<int16_t>(atlas_bounds.GetTop() - 1)};
+                rect_packer->RemoveRect(
+                    location,
+                    static_cast<int>(atlas_bounds.GetWidth()) + kPadding,
+                    static_cast<int>(atlas_bounds.GetHeight()) + kPadding);
+              });
+        } else if (!page_in_use[i] &&
+                   atlas.GetPageLastUsedFrame(i) < frame_number) {
+          atlas.EvictPage(i);
+          rect_packer->Reset();
+        } else {
+          continue;
+        }
+        page_reclaimed[i] = true;
+        if (add_to_page(i)) {
+          page = i;
+          break;
+        }
+      }
     }
-    glyph_positions.erase(glyph_positions.begin() + glyph_index_start,
-                          glyph_positions.end());
-    atlas_context->UpdateRectPacker(rect_packer);
-    auto next_index = PairsFitInAtlasOfSize(
-        extra_pairs, current_size, glyph_positions, glyph_sizes,
-        height_adjustment, rect_packer, glyph_index_start);
-    if (next_index == extra_pairs.size()) {
-      return current_size;
+
+    if (!page.has_value()) {
+      return false;
     }
-    current_size = ISize(current_size.width, current_size.height * 2);
+    page_in_use[page.value()] = true;
+    // Position the glyph in the center of the 1px padding.
+    placement.positions.push_back(Rect::MakeXYWH(location_in_atlas.x() + 1,  //
+                                                 location_in_atlas.y() + 1,  //
+                                                 glyph_size.width,           //
+                                                 glyph_size.height           //
+                                                 ));
+    placement.pages.push_back(page.value());
   }
-  return {};
+  return true;
 }
 
 static void DrawGlyph(SkCanvas* canvas,
@@ -248,121 +312,170 @@ static void DrawGlyph(SkCanvas* canvas,
   canvas->restore();
 }
 
-/// @brief Batch render to a single surface.
+namespace {
+/// A glyph to draw into a pixmap at the given position.
+struct GlyphRasterJob {
+  size_t glyph_index;
+  SkPixmap pixmap;
+  SkPoint position;
+};
+}  // namespace
+
+/// The number of glyphs rasterized by a single worker task.
+static constexpr size_t kGlyphsPerRasterTask = 8u;
+
+/// @brief Draw the glyphs of [jobs], in parallel on the worker task runner
+///        when one is available.
 ///
-/// This is only safe for use when updating a fresh texture.
-static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
-                                  std::shared_ptr<BlitPass>& blit_pass,
-                                  HostBuffer& host_buffer,
-                                  const std::shared_ptr<Texture>& texture,
-                                  const std::vector<FontGlyphPair>& new_pairs,
-                                  size_t start_index,
-                                  size_t end_index) {
+/// Glyphs of signed distance field atlases are converted to a distance field
+/// right after they are drawn, on the same thread.
+static bool RasterizeGlyphs(
+    const GlyphAtlas& atlas,
+    const std::vector<FontGlyphPair>& new_pairs,
+    const std::vector<Rect>& glyph_sizes,
+    const std::vector<GlyphRasterJob>& jobs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  bool is_sdf = atlas.GetType() == GlyphAtlas::Type::kSignedDistanceField;
+
+  std::atomic<bool> success = true;
+  fml::ParallelFor(
+      worker_task_runner, jobs.size(), kGlyphsPerRasterTask,
+      [&](size_t begin, size_t end) {
+        TRACE_EVENT0("impeller", "RasterizeGlyphsTask");
+        for (size_t i = begin; i < end; i++) {
+          const GlyphRasterJob& job = jobs[i];
+          // Jobs may share the pixmap of a page, but never its pixels, so
+          // each job draws through its own surface.
+          auto surface = SkSurfaces::WrapPixels(job.pixmap);
+          if (!surface || !surface->getCanvas()) {
+            success = false;
+            continue;
+          }
+          const FontGlyphPair& pair = new_pairs[job.glyph_index];
+          DrawGlyph(surface->getCanvas(), job.position, pair.scaled_font,
+                    pair.glyph, glyph_sizes[job.glyph_index],
+                    pair.glyph.properties, has_color);
+          if (is_sdf) {
+            // The glyph bounds include the spread of the field, so the
+            // conversion never reads or writes the pixels of other glyphs.
+            ISize size = ISize::Ceil(glyph_sizes[job.glyph_index].GetSize());
+            ComputeSignedDistanceField(
+                static_cast<uint8_t*>(job.pixmap.writable_addr(
+                    job.position.x(), job.position.y())),
+                size.width, size.height, job.pixmap.rowBytes(),
+                GlyphAtlas::kSignedDistanceFieldSpread);
+          }
+        }
+      });
+  return success;
+}
 
-  SkBitmap bitmap;
-  bitmap.setInfo(GetImageInfo(atlas, Size(texture->GetSize())));
-  if (!bitmap.tryAllocPixels()) {
-    return false;
-  }
+/// @brief Rasterize the new glyphs and encode their upload into the blit
+///        pass.
+///
+/// Fresh pages are drawn into a bitmap of the whole page and uploaded with a
+/// single copy. Glyphs added to pages that already hold other glyphs are
+/// drawn into one staging allocation, each expanded by 1px of padding on
+/// every side, and copied to their location individually.
+static bool UpdateAtlasBitmaps(
+    const GlyphAtlas& atlas,
+    size_t existing_page_count,
+    std::shared_ptr<BlitPass>& blit_pass,
+    HostBuffer& host_buffer,
+    const std::vector<FontGlyphPair>& new_pairs,
+    const std::vector<Rect>& glyph_sizes,
+    const GlyphPlacement& placement,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
 
-  auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
-  if (!surface) {
-    return false;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return false;
+  const size_t page_count = atlas.GetPageCount();
+  std::vector<SkBitmap> page_bitmaps(page_count);
+  for (size_t page = existing_page_count; page < page_count; page++) {
+    page_bitmaps[page].setInfo(
+        GetImageInfo(atlas, Size(atlas.GetPageTexture(page)->GetSize())));
+    if (!page_bitmaps[page].tryAllocPixels()) {
+      return false;
+    }
   }
 
-  for (size_t i = start_index; i < end_index; i++) {
-    const FontGlyphPair& pair = new_pairs[i];
-    auto data = atlas.FindFontGlyphBounds(pair);
-    if (!data.has_value()) {
-      continue;
-    }
-    auto [pos, bounds, placeholder] = data.value();
-    FML_DCHECK(!placeholder);
-    Size size = pos.GetSize();
-    if (size.IsEmpty()) {
+  std::vector<size_t> staging_offsets(new_pairs.size(), 0u);
+  size_t staging_size = 0u;
+  for (size_t i = 0; i < new_pairs.size(); i++) {
+    Size size = placement.positions[i].GetSize();
+    if (placement.pages[i] >= existing_page_count || size.IsEmpty()) {
       continue;
     }
-
-    DrawGlyph(canvas, SkPoint::Make(pos.GetLeft(), pos.GetTop()),
-              pair.scaled_font, pair.glyph, bounds, pair.glyph.properties,
-              has_color);
+    staging_offsets[i] = staging_size;
+    staging_size += GetImageInfo(atlas, Size(size.width + 2, size.height + 2))
+                        .computeMinByteSize();
   }
-
   // Writing to a malloc'd buffer and then copying to the staging buffers
   // benchmarks as substantially faster on a number of Android devices.
-  BufferView buffer_view = host_buffer.Emplace(
-      bitmap.getAddr(0, 0),
-      texture->GetSize().Area() *
-          BytesPerPixelForPixelFormat(
-              atlas.GetTexture()->GetTextureDescriptor().format),
-      DefaultUniformAlignment());
-
-  return blit_pass->AddCopy(std::move(buffer_view),  //
-                            texture,                 //
-                            IRect::MakeXYWH(0, 0, texture->GetSize().width,
-                                            texture->GetSize().height));
-}
-
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              std::shared_ptr<BlitPass>& blit_pass,
-                              HostBuffer& host_buffer,
-                              const std::shared_ptr<Texture>& texture,
-                              const std::vector<FontGlyphPair>& new_pairs,
-                              size_t start_index,
-                              size_t end_index) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  for (size_t i = start_index; i < end_index; i++) {
-    const FontGlyphPair& pair = new_pairs[i];
-    auto data = atlas.FindFontGlyphBounds(pair);
-    if (!data.has_value()) {
-      continue;
-    }
-    auto [pos, bounds, placeholder] = data.value();
-    FML_DCHECK(!placeholder);
+  std::vector<uint8_t> staging(staging_size, 0u);
 
+  std::vector<GlyphRasterJob> jobs;
+  jobs.reserve(new_pairs.size());
+  for (size_t i = 0; i < new_pairs.size(); i++) {
+    const Rect& pos = placement.positions[i];
     Size size = pos.GetSize();
     if (size.IsEmpty()) {
       continue;
     }
-    // The uploaded bitmap is expanded by 1px of padding
-    // on each side.
-    size.width += 2;
-    size.height += 2;
-
-    SkBitmap bitmap;
-    bitmap.setInfo(GetImageInfo(atlas, size));
-    if (!bitmap.tryAllocPixels()) {
-      return false;
+    size_t page = placement.pages[i];
+    if (page >= existing_page_count) {
+      jobs.push_back(GlyphRasterJob{
+          .glyph_index = i,
+          .pixmap = page_bitmaps[page].pixmap(),
+          .position = SkPoint::Make(pos.GetLeft(), pos.GetTop()),
+      });
+    } else {
+      SkImageInfo info =
+          GetImageInfo(atlas, Size(size.width + 2, size.height + 2));
+      jobs.push_back(GlyphRasterJob{
+          .glyph_index = i,
+          .pixmap = SkPixmap(info, staging.data() + staging_offsets[i],
+                             info.minRowBytes()),
+          .position = SkPoint::Make(1, 1),
+      });
     }
+  }
 
-    auto surface = SkSurfaces::WrapPixels(bitmap.pixmap());
-    if (!surface) {
-      return false;
-    }
-    auto canvas = surface->getCanvas();
-    if (!canvas) {
+  if (!RasterizeGlyphs(atlas, new_pairs, glyph_sizes, jobs,
+                       worker_task_runner)) {
+    return false;
+  }
+
+  for (size_t page = existing_page_count; page < page_count; page++) {
+    const std::shared_ptr<Texture>& texture = atlas.GetPageTexture(page);
+    BufferView buffer_view = host_buffer.Emplace(
+        page_bitmaps[page].getAddr(0, 0),
+        texture->GetSize().Area() *
+            BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format),
+        DefaultUniformAlignment());
+    if (!blit_pass->AddCopy(std::move(buffer_view),  //
+                            texture,                 //
+                            IRect::MakeXYWH(0, 0, texture->GetSize().width,
+                                            texture->GetSize().height))) {
       return false;
     }
+  }
 
-    DrawGlyph(canvas, SkPoint::Make(1, 1), pair.scaled_font, pair.glyph, bounds,
-              pair.glyph.properties, has_color);
-
-    // Writing to a malloc'd buffer and then copying to the staging buffers
-    // benchmarks as substantially faster on a number of Android devices.
+  std::vector<bool> page_updated(existing_page_count, false);
+  for (const GlyphRasterJob& job : jobs) {
+    size_t page = placement.pages[job.glyph_index];
+    if (page >= existing_page_count) {
+      continue;
+    }
+    const std::shared_ptr<Texture>& texture = atlas.GetPageTexture(page);
+    const Rect& pos = placement.positions[job.glyph_index];
+    ISize size(job.pixmap.width(), job.pixmap.height());
     BufferView buffer_view = host_buffer.Emplace(
-        bitmap.getAddr(0, 0),
-        size.Area() * BytesPerPixelForPixelFormat(
-                          atlas.GetTexture()->GetTextureDescriptor().format),
+        job.pixmap.addr(),
+        size.Area() *
+            BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format),
         DefaultUniformAlignment());
 
     // convert_to_read is set to false so that the texture remains in a transfer
@@ -379,8 +492,15 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                             )) {
       return false;
     }
+    page_updated[page] = true;
+  }
+  for (size_t page = 0; page < existing_page_count; page++) {
+    if (page_updated[page] &&
+        !blit_pass->ConvertTextureToShaderRead(atlas.GetPageTexture(page))) {
+      return false;
+    }
   }
-  return blit_pass->ConvertTextureToShaderRead(texture);
+  return true;
 }
 
 static Rect ComputeGlyphSize(const SkFont& font,
@@ -410,9 +530,12 @@ static Rect ComputeGlyphSize(const SkFont& font,
 std::pair<std::vector<FontGlyphPair>, std::vector<Rect>>
 TypographerContextSkia::CollectNewGlyphs(
     const std::shared_ptr<GlyphAtlas>& atlas,
-    const std::vector<std::shared_ptr<TextFrame>>& text_frames) {
+    const std::vector<std::shared_ptr<TextFrame>>& text_frames,
+    uint64_t frame_number) {
   std::vector<FontGlyphPair> new_glyphs;
   std::vector<Rect> glyph_sizes;
+  const bool is_sdf =
+      atlas->GetType() == GlyphAtlas::Type::kSignedDistanceField;
   for (const auto& frame : text_frames) {
     // TODO(jonahwilliams): unless we destroy the atlas (which we know about),
     // we could probably guarantee that a text frame that is complete does not
@@ -423,8 +546,8 @@ TypographerContextSkia::CollectNewGlyphs(
     for (const auto& run : frame->GetRuns()) {
       auto metrics = run.GetFont().GetMetrics();
 
-      auto rounded_scale =
-          TextFrame::RoundScaledFontSize(frame->GetScale(), metrics.point_size);
+      auto rounded_scale = TextFrame::ComputeAtlasScale(
+          atlas->GetType(), frame->GetScale(), metrics.point_size);
       ScaledFont scaled_font{.font = run.GetFont(), .scale = rounded_scale};
 
       FontGlyphAtlas* font_glyph_atlas =
@@ -444,18 +567,27 @@ TypographerContextSkia::CollectNewGlyphs(
       sk_font.setSubpixel(true);
 
       for (const auto& glyph_position : run.GetGlyphPositions()) {
-        Point subpixel = TextFrame::ComputeSubpixelPosition(
-            glyph_position, scaled_font.font.GetAxisAlignment(),
-            frame->GetOffset(), frame->GetScale());
+        // Distance fields are sampled with linear filtering at any scale,
+        // so their glyphs are not snapped to subpixel positions.
+        Point subpixel =
+            is_sdf ? Point(0, 0)
+                   : TextFrame::ComputeSubpixelPosition(
+                         glyph_position, scaled_font.font.GetAxisAlignment(),
+                         frame->GetOffset(), frame->GetScale());
         SubpixelGlyph subpixel_glyph(glyph_position.glyph, subpixel,
                                      frame->GetProperties());
         const auto& font_glyph_bounds =
-            font_glyph_atlas->FindGlyphBounds(subpixel_glyph);
+            font_glyph_atlas->FindGlyphBoundsAndMarkUsed(subpixel_glyph,
+                                                         frame_number);
 
         if (!font_glyph_bounds.has_value()) {
           new_glyphs.push_back(FontGlyphPair{scaled_font, subpixel_glyph});
           auto glyph_bounds =
               ComputeGlyphSize(sk_font, subpixel_glyph, scaled_font.scale);
+          if (is_sdf) {
+            glyph_bounds =
+                glyph_bounds.Expand(GlyphAtlas::kSignedDistanceFieldSpread);
+          }
           glyph_sizes.push_back(glyph_bounds);
 
           auto frame_bounds = FrameBounds{
@@ -465,7 +597,8 @@ TypographerContextSkia::CollectNewGlyphs(
           };
 
           frame->AppendFrameBounds(frame_bounds);
-          font_glyph_atlas->AppendGlyph(subpixel_glyph, frame_bounds);
+          font_glyph_atlas->AppendGlyph(subpixel_glyph, frame_bounds,
+                                        frame_number);
         } else {
           frame->AppendFrameBounds(font_glyph_bounds.value());
         }
@@ -497,127 +630,89 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   //         with the current atlas and reuse if possible. For each new font and
   //         glyph pair, compute the glyph size at scale.
   // ---------------------------------------------------------------------------
-  auto [new_glyphs, glyph_sizes] = CollectNewGlyphs(last_atlas, text_frames);
+  uint64_t frame_number = atlas_context->AdvanceFrameNumber();
+  auto [new_glyphs, glyph_sizes] =
+      CollectNewGlyphs(last_atlas, text_frames, frame_number);
   if (new_glyphs.size() == 0) {
     return last_atlas;
   }
 
   // ---------------------------------------------------------------------------
-  // Step 2: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas.
+  // Step 2: Find space for the new glyphs in the existing pages, in new pages,
+  //         or in the least recently used pages once the maximum page count
+  //         is reached.
   // ---------------------------------------------------------------------------
-  std::vector<Rect> glyph_positions;
-  glyph_positions.reserve(new_glyphs.size());
-  size_t first_missing_index = 0;
-
-  if (last_atlas->GetTexture()) {
-    // Append all glyphs that fit into the current atlas.
-    first_missing_index = AppendToExistingAtlas(
-        last_atlas, new_glyphs, glyph_positions, glyph_sizes,
-        atlas_context->GetAtlasSize(), atlas_context->GetHeightAdjustment(),
-        atlas_context->GetRectPacker());
-
-    // ---------------------------------------------------------------------------
-    // Step 3a: Record the positions in the glyph atlas of the newly added
-    //          glyphs.
-    // ---------------------------------------------------------------------------
-    for (size_t i = 0; i < first_missing_index; i++) {
-      last_atlas->AddTypefaceGlyphPositionAndBounds(
-          new_glyphs[i], glyph_positions[i], glyph_sizes[i]);
-    }
-
-    std::shared_ptr<CommandBuffer> cmd_buffer = context.CreateCommandBuffer();
-    std::shared_ptr<BlitPass> blit_pass = cmd_buffer->CreateBlitPass();
-
-    fml::ScopedCleanupClosure closure([&]() {
-      blit_pass->EncodeCommands(context.GetResourceAllocator());
-      if (!context.EnqueueCommandBuffer(std::move(cmd_buffer))) {
-        VALIDATION_LOG << "Failed to submit glyph atlas command buffer";
+  const ISize max_texture_size =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported();
+  std::shared_ptr<GlyphAtlas> atlas = last_atlas;
+  GlyphPlacement placement;
+  if (!PlaceGlyphs(*atlas, *atlas_context, glyph_sizes, max_texture_size,
+                   placement)) {
+    // Every page holds glyphs used by this frame. Start over with an atlas
+    // containing only the glyphs of this frame, keeping the page textures.
+    atlas = std::make_shared<GlyphAtlas>(type);
+    for (size_t i = 0; i < last_atlas->GetPageCount(); i++) {
+      atlas->AddPage(last_atlas->GetPageTexture(i));
+      if (auto rect_packer = atlas_context->GetRectPacker(i)) {
+        rect_packer->Reset();
       }
-    });
-
-    // ---------------------------------------------------------------------------
-    // Step 4a: Draw new font-glyph pairs into the a host buffer and encode
-    // the uploads into the blit pass.
-    // ---------------------------------------------------------------------------
-    if (!UpdateAtlasBitmap(*last_atlas, blit_pass, host_buffer,
-                           last_atlas->GetTexture(), new_glyphs, 0,
-                           first_missing_index)) {
-      return nullptr;
-    }
-
-    // If all glyphs fit, just return the old atlas.
-    if (first_missing_index == new_glyphs.size()) {
-      return last_atlas;
     }
-  }
-
-  int64_t height_adjustment = atlas_context->GetAtlasSize().height;
-  const int64_t max_texture_height =
-      context.GetResourceAllocator()->GetMaxTextureSizeSupported().height;
-
-  // IF the current atlas size is as big as it can get, then "GC" and create an
-  // atlas with only the required glyphs. OpenGLES cannot reliably perform the
-  // blit required here, as 1) it requires attaching textures as read and write
-  // framebuffers which has substantially smaller size limits that max textures
-  // and 2) is missing a GLES 2.0 implementation and cap check.
-  bool blit_old_atlas = true;
-  std::shared_ptr<GlyphAtlas> new_atlas = last_atlas;
-  if (atlas_context->GetAtlasSize().height >= max_texture_height ||
-      context.GetBackendType() == Context::BackendType::kOpenGLES) {
-    blit_old_atlas = false;
-    new_atlas = std::make_shared<GlyphAtlas>(type);
+    atlas_context->UpdateGlyphAtlas(atlas);
 
     auto [update_glyphs, update_sizes] =
-        CollectNewGlyphs(new_atlas, text_frames);
+        CollectNewGlyphs(atlas, text_frames, frame_number);
     new_glyphs = std::move(update_glyphs);
     glyph_sizes = std::move(update_sizes);
 
-    glyph_positions.clear();
-    glyph_positions.reserve(new_glyphs.size());
-    first_missing_index = 0;
-
-    height_adjustment = 0;
-    atlas_context->UpdateRectPacker(nullptr);
-    atlas_context->UpdateGlyphAtlas(new_atlas, {0, 0}, 0);
+    placement = GlyphPlacement{};
+    if (!PlaceGlyphs(*atlas, *atlas_context, glyph_sizes, max_texture_size,
+                     placement)) {
+      return nullptr;
+    }
   }
+  FML_DCHECK(new_glyphs.size() == placement.positions.size());
 
-  // A new glyph atlas must be created.
-  ISize atlas_size = ComputeNextAtlasSize(atlas_context,        //
-                                          new_glyphs,           //
-                                          glyph_positions,      //
-                                          glyph_sizes,          //
-                                          first_missing_index,  //
-                                          max_texture_height    //
-  );
-
-  atlas_context->UpdateGlyphAtlas(new_atlas, atlas_size, height_adjustment);
-  if (atlas_size.IsEmpty()) {
-    return nullptr;
+  // ---------------------------------------------------------------------------
+  // Step 3: Create the textures of any new pages.
+  // ---------------------------------------------------------------------------
+  const size_t existing_page_count = atlas->GetPageCount();
+  for (const ISize& page_size : placement.new_page_sizes) {
+    TextureDescriptor descriptor;
+    switch (type) {
+      case GlyphAtlas::Type::kAlphaBitmap:
+      case GlyphAtlas::Type::kSignedDistanceField:
+        descriptor.format =
+            context.GetCapabilities()->GetDefaultGlyphAtlasFormat();
+        break;
+      case GlyphAtlas::Type::kColorBitmap:
+        descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
+        break;
+    }
+    descriptor.size = page_size;
+    descriptor.storage_mode = StorageMode::kDevicePrivate;
+    descriptor.usage = TextureUsage::kShaderRead;
+    std::shared_ptr<Texture> new_texture =
+        context.GetResourceAllocator()->CreateTexture(descriptor);
+    if (!new_texture) {
+      return nullptr;
+    }
+    new_texture->SetLabel("GlyphAtlas");
+    atlas->AddPage(std::move(new_texture));
   }
-  FML_DCHECK(new_glyphs.size() == glyph_positions.size());
 
-  TextureDescriptor descriptor;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      descriptor.format =
-          context.GetCapabilities()->GetDefaultGlyphAtlasFormat();
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
-  descriptor.size = atlas_size;
-  descriptor.storage_mode = StorageMode::kDevicePrivate;
-  descriptor.usage = TextureUsage::kShaderRead;
-  std::shared_ptr<Texture> new_texture =
-      context.GetResourceAllocator()->CreateTexture(descriptor);
-  if (!new_texture) {
-    return nullptr;
+  // ---------------------------------------------------------------------------
+  // Step 4: Record the positions in the glyph atlas of the newly added glyphs.
+  // ---------------------------------------------------------------------------
+  for (size_t i = 0; i < new_glyphs.size(); i++) {
+    atlas->AddTypefaceGlyphPositionAndBounds(
+        new_glyphs[i], placement.positions[i], glyph_sizes[i],
+        placement.pages[i]);
   }
 
-  new_texture->SetLabel("GlyphAtlas");
-
+  // ---------------------------------------------------------------------------
+  // Step 5: Draw only the new font-glyph pairs, spread across the worker
+  //         task runner, and encode their upload into a single blit pass.
+  // ---------------------------------------------------------------------------
   std::shared_ptr<CommandBuffer> cmd_buffer = context.CreateCommandBuffer();
   std::shared_ptr<BlitPass> blit_pass = cmd_buffer->CreateBlitPass();
 
@@ -628,41 +723,13 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     }
   });
 
-  // Now append all remaining glyphs. This should never have any missing data...
-  auto old_texture = new_atlas->GetTexture();
-  new_atlas->SetTexture(std::move(new_texture));
-
-  // ---------------------------------------------------------------------------
-  // Step 3a: Record the positions in the glyph atlas of the newly added
-  //          glyphs.
-  // ---------------------------------------------------------------------------
-  for (size_t i = first_missing_index; i < glyph_positions.size(); i++) {
-    new_atlas->AddTypefaceGlyphPositionAndBounds(
-        new_glyphs[i], glyph_positions[i], glyph_sizes[i]);
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 4a: Draw new font-glyph pairs into the a host buffer and encode
-  // the uploads into the blit pass.
-  // ---------------------------------------------------------------------------
-  if (!BulkUpdateAtlasBitmap(*new_atlas, blit_pass, host_buffer,
-                             new_atlas->GetTexture(), new_glyphs,
-                             first_missing_index, new_glyphs.size())) {
+  if (!UpdateAtlasBitmaps(*atlas, existing_page_count, blit_pass, host_buffer,
+                          new_glyphs, glyph_sizes, placement,
+                          worker_task_runner_)) {
     return nullptr;
   }
 
-  // Blit the old texture to the top left of the new atlas.
-  if (blit_old_atlas && old_texture) {
-    blit_pass->AddCopy(old_texture, new_atlas->GetTexture(),
-                       IRect::MakeSize(new_atlas->GetTexture()->GetSize()),
-                       {0, 0});
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 8b: Record the texture in the glyph atlas.
-  // ---------------------------------------------------------------------------
-
-  return new_atlas;
+  return atlas;
 }
 
 }  // namespace impeller
@@ -5,15 +5,26 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
 
 class TypographerContextSkia : public TypographerContext {
  public:
-  static std::shared_ptr<TypographerContext> Make();
-
-  TypographerContextSkia();
+  //----------------------------------------------------------------------------
+  /// @brief      Create a typographer context.
+  ///
+  /// @param[in]  worker_task_runner  If provided, glyphs newly added to an
+  ///                                 atlas are rasterized in parallel on this
+  ///                                 task runner. Otherwise, they are
+  ///                                 rasterized on the calling thread.
+  ///
+  static std::shared_ptr<TypographerContext> Make(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner = nullptr);
+
+  explicit TypographerContextSkia(
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner = nullptr);
 
   ~TypographerContextSkia() override;
 
@@ -31,9 +42,14 @@ class TypographerContextSkia : public TypographerContext {
       const override;
 
  private:
+  friend class ImpellerBenchmarkAccessor;
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+
   static std::pair<std::vector<FontGlyphPair>, std::vector<Rect>>
   CollectNewGlyphs(const std::shared_ptr<GlyphAtlas>& atlas,
-                   const std::vector<std::shared_ptr<TextFrame>>& text_frames);
+                   const std::vector<std::shared_ptr<TextFrame>>& text_frames,
+                   uint64_t frame_number);
 
   TypographerContextSkia(const TypographerContextSkia&) = delete;
 
@@ -4,15 +4,18 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/logging.h"
 #include "impeller/typographer/font_glyph_pair.h"
 
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext(GlyphAtlas::Type type)
-    : atlas_(std::make_shared<GlyphAtlas>(type)), atlas_size_(ISize(0, 0)) {}
+    : atlas_(std::make_shared<GlyphAtlas>(type)) {}
 
 GlyphAtlasContext::~GlyphAtlasContext() {}
 
@@ -20,29 +23,33 @@ std::shared_ptr<GlyphAtlas> GlyphAtlasContext::GetGlyphAtlas() const {
   return atlas_;
 }
 
-const ISize& GlyphAtlasContext::GetAtlasSize() const {
-  return atlas_size_;
+std::shared_ptr<RectanglePacker> GlyphAtlasContext::GetRectPacker(
+    size_t page_index) const {
+  if (page_index >= rect_packers_.size()) {
+    return nullptr;
+  }
+  return rect_packers_[page_index];
 }
 
-int64_t GlyphAtlasContext::GetHeightAdjustment() const {
-  return height_adjustment_;
+uint64_t GlyphAtlasContext::GetFrameNumber() const {
+  return frame_number_;
 }
 
-std::shared_ptr<RectanglePacker> GlyphAtlasContext::GetRectPacker() const {
-  return rect_packer_;
+uint64_t GlyphAtlasContext::AdvanceFrameNumber() {
+  return ++frame_number_;
 }
 
-void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
-                                         ISize size,
-                                         int64_t height_adjustment) {
+void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas) {
   atlas_ = std::move(atlas);
-  atlas_size_ = size;
-  height_adjustment_ = height_adjustment;
 }
 
 void GlyphAtlasContext::UpdateRectPacker(
+    size_t page_index,
     std::shared_ptr<RectanglePacker> rect_packer) {
-  rect_packer_ = std::move(rect_packer);
+  if (page_index >= rect_packers_.size()) {
+    rect_packers_.resize(page_index + 1);
+  }
+  rect_packers_[page_index] = std::move(rect_packer);
 }
 
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
@@ -50,7 +57,7 @@ GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 GlyphAtlas::~GlyphAtlas() = default;
 
 bool GlyphAtlas::IsValid() const {
-  return !!texture_;
+  return !pages_.empty() && !!pages_[0];
 }
 
 GlyphAtlas::Type GlyphAtlas::GetType() const {
@@ -58,18 +65,93 @@ GlyphAtlas::Type GlyphAtlas::GetType() const {
 }
 
 const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
-  return texture_;
+  static const std::shared_ptr<Texture> kNullTexture;
+  return pages_.empty() ? kNullTexture : pages_[0];
 }
 
 void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
-  texture_ = std::move(texture);
+  if (pages_.empty()) {
+    pages_.push_back(std::move(texture));
+  } else {
+    pages_[0] = std::move(texture);
+  }
+}
+
+size_t GlyphAtlas::AddPage(std::shared_ptr<Texture> texture) {
+  pages_.push_back(std::move(texture));
+  return pages_.size() - 1;
+}
+
+size_t GlyphAtlas::GetPageCount() const {
+  return pages_.size();
+}
+
+const std::shared_ptr<Texture>& GlyphAtlas::GetPageTexture(
+    size_t page_index) const {
+  FML_DCHECK(page_index < pages_.size());
+  return pages_[page_index];
+}
+
+uint64_t GlyphAtlas::GetPageLastUsedFrame(size_t page_index) const {
+  if (page_index >= page_last_used_frames_.size()) {
+    return 0u;
+  }
+  return page_last_used_frames_[page_index];
+}
+
+size_t GlyphAtlas::EvictPage(size_t page_index) {
+  return EvictGlyphsUnusedSince(page_index,
+                                std::numeric_limits<uint64_t>::max(), nullptr);
+}
+
+size_t GlyphAtlas::EvictGlyphsUnusedSince(
+    size_t page_index,
+    uint64_t frame_number,
+    const std::function<void(const Rect& atlas_bounds)>& on_evicted) {
+  size_t evicted = 0u;
+  // The last used frame of the page is recomputed from the glyphs it keeps.
+  uint64_t page_last_used_frame = 0u;
+  for (auto font_it = font_atlas_map_.begin();
+       font_it != font_atlas_map_.end();) {
+    auto& positions = font_it->second.positions_;
+    for (auto it = positions.begin(); it != positions.end();) {
+      const FrameBounds& frame_bounds = it->second.frame_bounds;
+      if (frame_bounds.is_placeholder ||
+          frame_bounds.page_index != page_index) {
+        ++it;
+      } else if (it->second.last_used_frame < frame_number) {
+        if (on_evicted) {
+          on_evicted(frame_bounds.atlas_bounds);
+        }
+        it = positions.erase(it);
+        evicted++;
+      } else {
+        page_last_used_frame =
+            std::max(page_last_used_frame, it->second.last_used_frame);
+        ++it;
+      }
+    }
+    if (positions.empty()) {
+      font_it = font_atlas_map_.erase(font_it);
+    } else {
+      ++font_it;
+    }
+  }
+  if (page_index < page_last_used_frames_.size()) {
+    page_last_used_frames_[page_index] = page_last_used_frame;
+  }
+  return evicted;
 }
 
 void GlyphAtlas::AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                                    Rect position,
-                                                   Rect bounds) {
-  font_atlas_map_[pair.scaled_font].positions_[pair.glyph] =
-      FrameBounds{position, bounds, /*is_placeholder=*/false};
+                                                   Rect bounds,
+                                                   size_t page_index) {
+  FontGlyphAtlas* font_atlas = GetOrCreateFontGlyphAtlas(pair.scaled_font);
+  FontGlyphAtlas::GlyphData& data = font_atlas->positions_[pair.glyph];
+  data.frame_bounds =
+      FrameBounds{position, bounds, /*is_placeholder=*/false, page_index};
+  font_atlas->MarkPageUsed(data);
 }
 
 std::optional<FrameBounds> GlyphAtlas::FindFontGlyphBounds(
@@ -87,8 +169,9 @@ FontGlyphAtlas* GlyphAtlas::GetOrCreateFontGlyphAtlas(
   if (found != font_atlas_map_.end()) {
     return &found->second;
   }
-  font_atlas_map_[scaled_font] = FontGlyphAtlas();
-  return &font_atlas_map_[scaled_font];
+  FontGlyphAtlas& font_atlas = font_atlas_map_[scaled_font];
+  font_atlas.page_last_used_frames_ = &page_last_used_frames_;
+  return &font_atlas;
 }
 
 size_t GlyphAtlas::GetGlyphCount() const {
@@ -111,7 +194,7 @@ size_t GlyphAtlas::IterateGlyphs(
     for (const auto& glyph_value : font_value.second.positions_) {
       count++;
       if (!iterator(font_value.first, glyph_value.first,
-                    glyph_value.second.atlas_bounds)) {
+                    glyph_value.second.frame_bounds.atlas_bounds)) {
         return count;
       }
     }
@@ -125,12 +208,40 @@ std::optional<FrameBounds> FontGlyphAtlas::FindGlyphBounds(
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return found->second.frame_bounds;
+}
+
+std::optional<FrameBounds> FontGlyphAtlas::FindGlyphBoundsAndMarkUsed(
+    const SubpixelGlyph& glyph,
+    uint64_t frame_number) {
+  auto found = positions_.find(glyph);
+  if (found == positions_.end()) {
+    return std::nullopt;
+  }
+  found->second.last_used_frame = frame_number;
+  MarkPageUsed(found->second);
+  return found->second.frame_bounds;
 }
 
 void FontGlyphAtlas::AppendGlyph(const SubpixelGlyph& glyph,
-                                 const FrameBounds& frame_bounds) {
-  positions_[glyph] = frame_bounds;
+                                 const FrameBounds& frame_bounds,
+                                 uint64_t frame_number) {
+  GlyphData& data = positions_[glyph];
+  data = GlyphData{frame_bounds, frame_number};
+  MarkPageUsed(data);
+}
+
+void FontGlyphAtlas::MarkPageUsed(const GlyphData& data) {
+  // Placeholders are counted once they are placed on a page.
+  if (!page_last_used_frames_ || data.frame_bounds.is_placeholder) {
+    return;
+  }
+  std::vector<uint64_t>& frames = *page_last_used_frames_;
+  size_t page_index = data.frame_bounds.page_index;
+  if (page_index >= frames.size()) {
+    frames.resize(page_index + 1, 0u);
+  }
+  frames[page_index] = std::max(frames[page_index], data.last_used_frame);
 }
 
 }  // namespace impeller
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "impeller/core/texture.h"
 #include "impeller/geometry/rect.h"
@@ -27,15 +28,35 @@ struct FrameBounds {
   /// Whether [atlas_bounds] are still a placeholder and have
   /// not yet been computed.
   bool is_placeholder = true;
+  /// The page of the glyph atlas that [atlas_bounds] refer to.
+  size_t page_index = 0u;
+
+  bool operator==(const FrameBounds& other) const {
+    return atlas_bounds == other.atlas_bounds &&
+           glyph_bounds == other.glyph_bounds &&
+           is_placeholder == other.is_placeholder &&
+           page_index == other.page_index;
+  }
 };
 
 //------------------------------------------------------------------------------
-/// @brief      A texture containing the bitmap representation of glyphs in
-///             different fonts along with the ability to query the location of
-///             specific font glyphs within the texture.
+/// @brief      A set of textures containing the bitmap representation of
+///             glyphs in different fonts along with the ability to query the
+///             location of specific font glyphs within the textures.
+///
+///             The atlas is split into pages of a fixed size. New glyphs are
+///             added to a page with free space or to a new page. Once the
+///             maximum number of pages is reached, the glyphs the current
+///             frame doesn't use are evicted one by one from the least
+///             recently used pages, and their space is reused for the new
+///             glyphs instead of rebuilding the whole atlas.
 ///
 class GlyphAtlas {
  public:
+  //----------------------------------------------------------------------------
+  /// The maximum number of pages (textures) of a single glyph atlas.
+  static constexpr size_t kMaxPageCount = 8u;
+
   //----------------------------------------------------------------------------
   /// @brief      Describes how the glyphs are represented in the texture.
   enum class Type {
@@ -52,8 +73,28 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented as signed distance fields in an 8-bit color
+    /// channel, rasterized at a fixed size regardless of the requested scale.
+    ///
+    /// A single entry serves every scale the glyph is drawn at, which makes
+    /// this representation suitable for large text and text whose scale is
+    /// animating.
+    kSignedDistanceField,
   };
 
+  //----------------------------------------------------------------------------
+  /// The font size in pixels at which the glyphs of signed distance field
+  /// atlases are rasterized.
+  static constexpr Scalar kSignedDistanceFieldFontSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// The distance in pixels from the glyph outline at which the values of a
+  /// signed distance field saturate. Glyphs are padded by this amount on
+  /// every side.
+  static constexpr Scalar kSignedDistanceFieldSpread = 8.0f;
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
@@ -71,30 +112,81 @@ class GlyphAtlas {
   Type GetType() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Set the texture for the glyph atlas.
+  /// @brief      Set the texture for the first page of the glyph atlas.
   ///
   /// @param[in]  texture  The texture
   ///
   void SetTexture(std::shared_ptr<Texture> texture);
 
   //----------------------------------------------------------------------------
-  /// @brief      Get the texture for the glyph atlas.
+  /// @brief      Get the texture for the first page of the glyph atlas.
   ///
   /// @return     The texture.
   ///
   const std::shared_ptr<Texture>& GetTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Append a page backed by the given texture to the atlas.
+  ///
+  /// @return     The index of the new page.
+  ///
+  size_t AddPage(std::shared_ptr<Texture> texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the number of pages in the atlas.
+  ///
+  size_t GetPageCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture backing the page at the given index.
+  ///
+  const std::shared_ptr<Texture>& GetPageTexture(size_t page_index) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the most recent frame number any glyph on the given page
+  ///             was used in.
+  ///
+  /// @see        `FontGlyphAtlas::FindGlyphBoundsAndMarkUsed`
+  ///
+  uint64_t GetPageLastUsedFrame(size_t page_index) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove all glyphs located on the given page. The page keeps
+  ///             its texture so that it can be filled with other glyphs.
+  ///
+  /// @return     The number of glyphs removed.
+  ///
+  size_t EvictPage(size_t page_index);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove the glyphs located on the given page that were last
+  ///             used before the given frame.
+  ///
+  /// @param[in]  page_index    The page to remove glyphs from.
+  /// @param[in]  frame_number  Glyphs used by this frame or later are kept.
+  /// @param[in]  on_evicted    Invoked with the atlas bounds of each removed
+  ///                           glyph, so that its area can be reused.
+  ///
+  /// @return     The number of glyphs removed.
+  ///
+  size_t EvictGlyphsUnusedSince(
+      size_t page_index,
+      uint64_t frame_number,
+      const std::function<void(const Rect& atlas_bounds)>& on_evicted);
+
   //----------------------------------------------------------------------------
   /// @brief      Record the location of a specific font-glyph pair within the
   ///             atlas.
   ///
   /// @param[in]  pair  The font-glyph pair
-  /// @param[in]  rect  The position in the atlas
+  /// @param[in]  rect  The position in the atlas page
   /// @param[in]  bounds The bounds of the glyph at scale
+  /// @param[in]  page_index The page of the atlas containing the glyph
   ///
   void AddTypefaceGlyphPositionAndBounds(const FontGlyphPair& pair,
                                          Rect position,
-                                         Rect bounds);
+                                         Rect bounds,
+                                         size_t page_index = 0u);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -144,7 +236,10 @@ class GlyphAtlas {
 
  private:
   const Type type_;
-  std::shared_ptr<Texture> texture_;
+  std::vector<std::shared_ptr<Texture>> pages_;
+  /// The most recent frame any glyph on each page was used in, kept up to date
+  /// by the font atlases so that eviction doesn't scan every glyph.
+  std::vector<uint64_t> page_last_used_frames_;
 
   std::unordered_map<ScaledFont,
                      FontGlyphAtlas,
@@ -171,36 +266,34 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> GetGlyphAtlas() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the size of the current glyph atlas.
-  const ISize& GetAtlasSize() const;
+  /// @brief      Retrieve the rect packer of the given atlas page, or nullptr
+  ///             if the page has not been created.
+  std::shared_ptr<RectanglePacker> GetRectPacker(size_t page_index = 0u) const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the previous (if any) rect packer.
-  std::shared_ptr<RectanglePacker> GetRectPacker() const;
+  /// @brief      Retrieve the number of the current frame.
+  ///
+  ///             Glyphs used by the text frames of the current frame must not
+  ///             be evicted from the atlas.
+  uint64_t GetFrameNumber() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      A y-coordinate shift that must be applied to glyphs appended
-  /// to
-  ///             the atlas.
+  /// @brief      Begin collecting the glyphs of a new frame.
   ///
-  ///             The rectangle packer is only initialized for unfilled regions
-  ///             of the atlas. The area the rectangle packer covers is offset
-  ///             from the origin by this height adjustment.
-  int64_t GetHeightAdjustment() const;
+  /// @return     The number of the new frame.
+  uint64_t AdvanceFrameNumber();
 
   //----------------------------------------------------------------------------
   /// @brief      Update the context with a newly constructed glyph atlas.
-  void UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
-                        ISize size,
-                        int64_t height_adjustment_);
+  void UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas);
 
-  void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
+  void UpdateRectPacker(size_t page_index,
+                        std::shared_ptr<RectanglePacker> rect_packer);
 
  private:
   std::shared_ptr<GlyphAtlas> atlas_;
-  ISize atlas_size_;
-  std::shared_ptr<RectanglePacker> rect_packer_;
-  int64_t height_adjustment_;
+  std::vector<std::shared_ptr<RectanglePacker>> rect_packers_;
+  uint64_t frame_number_ = 0u;
 
   GlyphAtlasContext(const GlyphAtlasContext&) = delete;
 
@@ -225,21 +318,48 @@ class FontGlyphAtlas {
   ///
   std::optional<FrameBounds> FindGlyphBounds(const SubpixelGlyph& glyph) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Find the location of a glyph in the atlas and record that it
+  ///             is used by the given frame.
+  ///
+  /// @param[in]  glyph         The glyph
+  /// @param[in]  frame_number  The frame the glyph is used in
+  ///
+  /// @return     The location of the glyph in the atlas.
+  ///             `std::nullopt` if the glyph is not in the atlas.
+  ///
+  std::optional<FrameBounds> FindGlyphBoundsAndMarkUsed(
+      const SubpixelGlyph& glyph,
+      uint64_t frame_number);
+
   //----------------------------------------------------------------------------
   /// @brief      Append the frame bounds of a glyph to this atlas.
   ///
   ///             This may indicate a placeholder glyph location to be replaced
   ///             at a later time, as indicated by FrameBounds.placeholder.
-  void AppendGlyph(const SubpixelGlyph& glyph, const FrameBounds& frame_bounds);
+  void AppendGlyph(const SubpixelGlyph& glyph,
+                   const FrameBounds& frame_bounds,
+                   uint64_t frame_number = 0u);
 
  private:
   friend class GlyphAtlas;
 
+  struct GlyphData {
+    FrameBounds frame_bounds;
+    /// The most recent frame the glyph was used in.
+    uint64_t last_used_frame = 0u;
+  };
+
+  /// Record that the page of a placed glyph is used by the given frame.
+  void MarkPageUsed(const GlyphData& data);
+
   std::unordered_map<SubpixelGlyph,
-                     FrameBounds,
+                     GlyphData,
                      SubpixelGlyph::Hash,
                      SubpixelGlyph::Equal>
       positions_;
+  /// The last used frames of the pages of the owning GlyphAtlas.
+  std::vector<uint64_t>* page_last_used_frames_ = nullptr;
 
   FontGlyphAtlas(const FontGlyphAtlas&) = delete;
 };
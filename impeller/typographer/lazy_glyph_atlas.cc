@@ -27,7 +27,11 @@ LazyGlyphAtlas::LazyGlyphAtlas(
       color_context_(typographer_context_
                          ? typographer_context_->CreateGlyphAtlasContext(
                                GlyphAtlas::Type::kColorBitmap)
-                         : nullptr) {}
+                         : nullptr),
+      sdf_context_(typographer_context_
+                       ? typographer_context_->CreateGlyphAtlasContext(
+                             GlyphAtlas::Type::kSignedDistanceField)
+                       : nullptr) {}
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
@@ -36,19 +40,28 @@ void LazyGlyphAtlas::AddTextFrame(const std::shared_ptr<TextFrame>& frame,
                                   Point offset,
                                   std::optional<GlyphProperties> properties) {
   frame->SetPerFrameData(scale, offset, properties);
-  FML_DCHECK(alpha_atlas_ == nullptr && color_atlas_ == nullptr);
-  if (frame->GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    alpha_text_frames_.push_back(frame);
-  } else {
-    color_text_frames_.push_back(frame);
+  FML_DCHECK(alpha_atlas_ == nullptr && color_atlas_ == nullptr &&
+             sdf_atlas_ == nullptr);
+  switch (frame->GetAtlasType()) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      alpha_text_frames_.push_back(frame);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      color_text_frames_.push_back(frame);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      sdf_text_frames_.push_back(frame);
+      break;
   }
 }
 
 void LazyGlyphAtlas::ResetTextFrames() {
   alpha_text_frames_.clear();
   color_text_frames_.clear();
+  sdf_text_frames_.clear();
   alpha_atlas_.reset();
   color_atlas_.reset();
+  sdf_atlas_.reset();
 }
 
 const std::shared_ptr<GlyphAtlas>& LazyGlyphAtlas::CreateOrGetGlyphAtlas(
@@ -62,6 +75,9 @@ const std::shared_ptr<GlyphAtlas>& LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     if (type == GlyphAtlas::Type::kColorBitmap && color_atlas_) {
       return color_atlas_;
     }
+    if (type == GlyphAtlas::Type::kSignedDistanceField && sdf_atlas_) {
+      return sdf_atlas_;
+    }
   }
 
   if (!typographer_context_) {
@@ -75,12 +91,24 @@ const std::shared_ptr<GlyphAtlas>& LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return kNullGlyphAtlas;
   }
 
-  auto& glyph_map = type == GlyphAtlas::Type::kAlphaBitmap ? alpha_text_frames_
-                                                           : color_text_frames_;
-  const std::shared_ptr<GlyphAtlasContext>& atlas_context =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_context_ : color_context_;
+  const std::vector<std::shared_ptr<TextFrame>>* glyph_map = nullptr;
+  const std::shared_ptr<GlyphAtlasContext>* atlas_context = nullptr;
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      glyph_map = &alpha_text_frames_;
+      atlas_context = &alpha_context_;
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      glyph_map = &color_text_frames_;
+      atlas_context = &color_context_;
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      glyph_map = &sdf_text_frames_;
+      atlas_context = &sdf_context_;
+      break;
+  }
   std::shared_ptr<GlyphAtlas> atlas = typographer_context_->CreateGlyphAtlas(
-      context, type, host_buffer, atlas_context, glyph_map);
+      context, type, host_buffer, *atlas_context, *glyph_map);
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Could not create valid atlas.";
     return kNullGlyphAtlas;
@@ -93,6 +121,10 @@ const std::shared_ptr<GlyphAtlas>& LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     color_atlas_ = std::move(atlas);
     return color_atlas_;
   }
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    sdf_atlas_ = std::move(atlas);
+    return sdf_atlas_;
+  }
   FML_UNREACHABLE();
 }
 
@@ -36,10 +36,13 @@ class LazyGlyphAtlas {
 
   std::vector<std::shared_ptr<TextFrame>> alpha_text_frames_;
   std::vector<std::shared_ptr<TextFrame>> color_text_frames_;
+  std::vector<std::shared_ptr<TextFrame>> sdf_text_frames_;
   std::shared_ptr<GlyphAtlasContext> alpha_context_;
   std::shared_ptr<GlyphAtlasContext> color_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_context_;
   mutable std::shared_ptr<GlyphAtlas> alpha_atlas_;
   mutable std::shared_ptr<GlyphAtlas> color_atlas_;
+  mutable std::shared_ptr<GlyphAtlas> sdf_atlas_;
 
   LazyGlyphAtlas(const LazyGlyphAtlas&) = delete;
 
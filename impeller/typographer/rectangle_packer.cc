@@ -5,6 +5,7 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -29,10 +30,16 @@ class SkylineRectanglePacker final : public RectanglePacker {
 
   bool AddRect(int w, int h, IPoint16* loc) final;
 
+  bool SupportsRemoval() const final { return false; }
+
+  bool RemoveRect(IPoint16 loc, int w, int h) final { return false; }
+
   Scalar PercentFull() const final {
     return area_so_far_ / ((float)width() * height());
   }
 
+  Scalar Fragmentation() const final;
+
  private:
   struct SkylineSegment {
     int x_;
@@ -171,9 +178,226 @@ void SkylineRectanglePacker::AddSkylineLevel(size_t skyline_index,
   }
 }
 
+Scalar SkylineRectanglePacker::Fragmentation() const {
+  int64_t free_area = static_cast<int64_t>(width()) * height() - area_so_far_;
+  if (free_area <= 0) {
+    return 0;
+  }
+  // The largest free rectangle rests on the skyline. The skyline rarely has
+  // more than a few dozen segments, so try every run of segments.
+  int64_t largest_area = 0;
+  for (auto i = 0u; i < skyline_.size(); ++i) {
+    int y = 0;
+    for (auto j = i; j < skyline_.size(); ++j) {
+      y = std::max(y, skyline_[j].y_);
+      int64_t run_width = skyline_[j].x_ + skyline_[j].width_ - skyline_[i].x_;
+      largest_area = std::max(largest_area, run_width * (height() - y));
+    }
+  }
+  return 1.0f - static_cast<Scalar>(largest_area) / free_area;
+}
+
+// Pack rectangles into a list of disjoint free rectangles, splitting the
+// free rectangle a new rectangle is placed in along the axis with the
+// shorter leftover. Removed rectangles are merged back with free neighbors
+// that share a full edge with them.
+// See "A Thousand Ways to Pack the Bin" by Jukka Jylanki.
+class GuillotineRectanglePacker final : public RectanglePacker {
+ public:
+  GuillotineRectanglePacker(int w, int h) : RectanglePacker(w, h) { Reset(); }
+
+  ~GuillotineRectanglePacker() final {}
+
+  void Reset() final {
+    used_area_ = 0;
+    allocated_.clear();
+    free_rects_.clear();
+    if (width() > 0 && height() > 0) {
+      free_rects_.push_back(FreeRect{0, 0, width(), height()});
+    }
+  }
+
+  bool AddRect(int w, int h, IPoint16* loc) final;
+
+  bool SupportsRemoval() const final { return true; }
+
+  bool RemoveRect(IPoint16 loc, int w, int h) final;
+
+  Scalar PercentFull() const final {
+    return used_area_ / ((float)width() * height());
+  }
+
+  Scalar Fragmentation() const final;
+
+ private:
+  struct FreeRect {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+  };
+
+  static uint32_t LocationKey(int x, int y) {
+    return (static_cast<uint32_t>(x) << 16) | static_cast<uint32_t>(y);
+  }
+
+  // Add [rect] to the free list, merging it with free rectangles that share
+  // a full edge with it for as long as possible.
+  void AddFreeRect(FreeRect rect);
+
+  std::vector<FreeRect> free_rects_;
+  // The size of each added rectangle, keyed by its location.
+  std::unordered_map<uint32_t, std::pair<int, int>> allocated_;
+  int64_t used_area_;
+};
+
+bool GuillotineRectanglePacker::AddRect(int p_width,
+                                        int p_height,
+                                        IPoint16* loc) {
+  loc->x_ = 0;
+  loc->y_ = 0;
+  if (p_width <= 0 || p_height <= 0) {
+    return false;
+  }
+
+  // Find the free rectangle that leaves the least area unused, and then the
+  // shortest leftover side.
+  int best_index = -1;
+  int64_t best_area_fit = 0;
+  int best_short_side_fit = 0;
+  for (auto i = 0u; i < free_rects_.size(); ++i) {
+    const FreeRect& free_rect = free_rects_[i];
+    if (free_rect.width_ < p_width || free_rect.height_ < p_height) {
+      continue;
+    }
+    int64_t area_fit =
+        static_cast<int64_t>(free_rect.width_) * free_rect.height_ -
+        static_cast<int64_t>(p_width) * p_height;
+    int short_side_fit = std::min(free_rect.width_ - p_width,  //
+                                  free_rect.height_ - p_height);
+    if (best_index == -1 || area_fit < best_area_fit ||
+        (area_fit == best_area_fit && short_side_fit < best_short_side_fit)) {
+      best_index = i;
+      best_area_fit = area_fit;
+      best_short_side_fit = short_side_fit;
+    }
+  }
+  if (best_index == -1) {
+    return false;
+  }
+
+  FreeRect free_rect = free_rects_[best_index];
+  free_rects_.erase(free_rects_.begin() + best_index);
+
+  int leftover_width = free_rect.width_ - p_width;
+  int leftover_height = free_rect.height_ - p_height;
+  FreeRect right;
+  FreeRect bottom;
+  if (leftover_width < leftover_height) {
+    // Split horizontally, giving the bottom part the full width.
+    right = FreeRect{free_rect.x_ + p_width, free_rect.y_, leftover_width,
+                     p_height};
+    bottom = FreeRect{free_rect.x_, free_rect.y_ + p_height, free_rect.width_,
+                      leftover_height};
+  } else {
+    // Split vertically, giving the right part the full height.
+    right = FreeRect{free_rect.x_ + p_width, free_rect.y_, leftover_width,
+                     free_rect.height_};
+    bottom = FreeRect{free_rect.x_, free_rect.y_ + p_height, p_width,
+                      leftover_height};
+  }
+  if (right.width_ > 0 && right.height_ > 0) {
+    free_rects_.push_back(right);
+  }
+  if (bottom.width_ > 0 && bottom.height_ > 0) {
+    free_rects_.push_back(bottom);
+  }
+
+  loc->x_ = free_rect.x_;
+  loc->y_ = free_rect.y_;
+  allocated_[LocationKey(free_rect.x_, free_rect.y_)] = {p_width, p_height};
+  used_area_ += static_cast<int64_t>(p_width) * p_height;
+  return true;
+}
+
+bool GuillotineRectanglePacker::RemoveRect(IPoint16 loc,
+                                           int p_width,
+                                           int p_height) {
+  auto found = allocated_.find(LocationKey(loc.x(), loc.y()));
+  if (found == allocated_.end() ||
+      found->second != std::make_pair(p_width, p_height)) {
+    return false;
+  }
+  allocated_.erase(found);
+  used_area_ -= static_cast<int64_t>(p_width) * p_height;
+
+  if (allocated_.empty()) {
+    // Merging only along shared edges can't always restore a single free
+    // rectangle, so start over once nothing is left.
+    Reset();
+    return true;
+  }
+  AddFreeRect(FreeRect{loc.x(), loc.y(), p_width, p_height});
+  return true;
+}
+
+void GuillotineRectanglePacker::AddFreeRect(FreeRect rect) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto i = 0u; i < free_rects_.size(); ++i) {
+      const FreeRect& other = free_rects_[i];
+      if (other.x_ == rect.x_ && other.width_ == rect.width_) {
+        if (other.y_ + other.height_ == rect.y_) {
+          rect.y_ = other.y_;
+          rect.height_ += other.height_;
+          merged = true;
+        } else if (rect.y_ + rect.height_ == other.y_) {
+          rect.height_ += other.height_;
+          merged = true;
+        }
+      } else if (other.y_ == rect.y_ && other.height_ == rect.height_) {
+        if (other.x_ + other.width_ == rect.x_) {
+          rect.x_ = other.x_;
+          rect.width_ += other.width_;
+          merged = true;
+        } else if (rect.x_ + rect.width_ == other.x_) {
+          rect.width_ += other.width_;
+          merged = true;
+        }
+      }
+      if (merged) {
+        free_rects_.erase(free_rects_.begin() + i);
+        break;
+      }
+    }
+  }
+  free_rects_.push_back(rect);
+}
+
+Scalar GuillotineRectanglePacker::Fragmentation() const {
+  int64_t free_area = static_cast<int64_t>(width()) * height() - used_area_;
+  if (free_area <= 0) {
+    return 0;
+  }
+  int64_t largest_area = 0;
+  for (const FreeRect& free_rect : free_rects_) {
+    largest_area =
+        std::max(largest_area,
+                 static_cast<int64_t>(free_rect.width_) * free_rect.height_);
+  }
+  return 1.0f - static_cast<Scalar>(largest_area) / free_area;
+}
+
 std::shared_ptr<RectanglePacker> RectanglePacker::Factory(int width,
                                                           int height) {
   return std::make_shared<SkylineRectanglePacker>(width, height);
 }
 
+std::shared_ptr<RectanglePacker> RectanglePacker::GuillotineFactory(
+    int width,
+    int height) {
+  return std::make_shared<GuillotineRectanglePacker>(width, height);
+}
+
 }  // namespace impeller
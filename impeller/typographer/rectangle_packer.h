@@ -9,6 +9,7 @@
 #include "impeller/geometry/scalar.h"
 
 #include <cstdint>
+#include <memory>
 
 namespace impeller {
 
@@ -28,8 +29,22 @@ class RectanglePacker {
   //----------------------------------------------------------------------------
   /// @brief     Return an empty packer with area specified by width and height.
   ///
+  ///            Rectangles are packed along a skyline, which packs rectangles
+  ///            of similar heights tightly but can't remove them individually.
+  ///
   static std::shared_ptr<RectanglePacker> Factory(int width, int height);
 
+  //----------------------------------------------------------------------------
+  /// @brief     Return an empty packer with area specified by width and height
+  ///            that supports removing rectangles individually.
+  ///
+  ///            The free area is tracked as a list of disjoint rectangles,
+  ///            which are split when a rectangle is added and coalesced with
+  ///            their neighbors when a rectangle is removed.
+  ///
+  static std::shared_ptr<RectanglePacker> GuillotineFactory(int width,
+                                                            int height);
+
   virtual ~RectanglePacker() {}
 
   //----------------------------------------------------------------------------
@@ -44,6 +59,25 @@ class RectanglePacker {
   ///
   virtual bool AddRect(int width, int height, IPoint16* loc) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Whether rectangles can be removed from this packer with
+  ///            `RemoveRect`.
+  ///
+  virtual bool SupportsRemoval() const = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief     Release the area of a previously added rectangle so that it
+  ///            can be reused by rectangles added later.
+  ///
+  /// @param[in]  loc     The upper-left corner returned by `AddRect`.
+  /// @param[in]  width   The width the rectangle was added with.
+  /// @param[in]  height  The height the rectangle was added with.
+  ///
+  /// @return    Return true on success; false if the packer doesn't support
+  ///            removal or no such rectangle was added.
+  ///
+  virtual bool RemoveRect(IPoint16 loc, int width, int height) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief     Returns how much area has been filled with rectangles.
   ///
@@ -51,6 +85,18 @@ class RectanglePacker {
   ///
   virtual Scalar PercentFull() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Returns how fragmented the area without rectangles is.
+  ///
+  ///            This is the share of the free area that lies outside of the
+  ///            largest free rectangle. Area the packer can no longer reach,
+  ///            such as gaps below a skyline, counts as fragmented.
+  ///
+  /// @return    Percentage as a decimal between 0.0 and 1.0. 0.0 if the
+  ///            free area is a single rectangle or there is no free area.
+  ///
+  virtual Scalar Fragmentation() const = 0;
+
   //----------------------------------------------------------------------------
   /// @brief     Empty out all previously added rectangles.
   ///
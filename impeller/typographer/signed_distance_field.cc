@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace impeller {
+
+namespace {
+
+// A large finite value is used in place of infinity so that the parabola
+// intersections below never compute infinity minus infinity.
+constexpr float kFar = 1e20f;
+
+/// Compute the squared distance transform of the sampled function [f] of [n]
+/// values in one dimension, writing the result to [d].
+///
+/// See "Distance Transforms of Sampled Functions" by Felzenszwalb and
+/// Huttenlocher. [v] and [z] are scratch storage for the lower envelope of
+/// the parabolas and must hold at least [n] and [n] + 1 values.
+void DistanceTransform1D(const float* f,
+                         size_t n,
+                         float* d,
+                         size_t* v,
+                         float* z) {
+  size_t k = 0u;
+  v[0] = 0u;
+  z[0] = -kFar;
+  z[1] = kFar;
+  for (size_t q = 1; q < n; q++) {
+    float fq = f[q] + static_cast<float>(q * q);
+    auto intersect = [&](size_t p) {
+      return (fq - (f[p] + static_cast<float>(p * p))) /
+             static_cast<float>(2 * q - 2 * p);
+    };
+    float s = intersect(v[k]);
+    // z[0] is never reached since every intersection is greater than -kFar.
+    while (s <= z[k]) {
+      k--;
+      s = intersect(v[k]);
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kFar;
+  }
+  k = 0u;
+  for (size_t q = 0; q < n; q++) {
+    while (z[k + 1] < static_cast<float>(q)) {
+      k++;
+    }
+    float delta = static_cast<float>(q) - static_cast<float>(v[k]);
+    d[q] = delta * delta + f[v[k]];
+  }
+}
+
+/// Replace each value of the [width] x [height] grid by its squared distance
+/// to the nearest zero value of the grid.
+void DistanceTransform2D(std::vector<float>& grid,
+                         size_t width,
+                         size_t height) {
+  size_t n = std::max(width, height);
+  std::vector<float> f(n);
+  std::vector<float> d(n);
+  std::vector<size_t> v(n);
+  std::vector<float> z(n + 1);
+
+  for (size_t x = 0; x < width; x++) {
+    for (size_t y = 0; y < height; y++) {
+      f[y] = grid[y * width + x];
+    }
+    DistanceTransform1D(f.data(), height, d.data(), v.data(), z.data());
+    for (size_t y = 0; y < height; y++) {
+      grid[y * width + x] = d[y];
+    }
+  }
+  for (size_t y = 0; y < height; y++) {
+    float* row = grid.data() + y * width;
+    std::copy(row, row + width, f.begin());
+    DistanceTransform1D(f.data(), width, row, v.data(), z.data());
+  }
+}
+
+}  // namespace
+
+void ComputeSignedDistanceField(uint8_t* pixels,
+                                size_t width,
+                                size_t height,
+                                size_t row_bytes,
+                                Scalar spread) {
+  if (width == 0u || height == 0u || spread <= 0) {
+    return;
+  }
+
+  // The squared distance of each pixel to the nearest inside pixel, and to
+  // the nearest outside pixel.
+  std::vector<float> to_inside(width * height);
+  std::vector<float> to_outside(width * height);
+  for (size_t y = 0; y < height; y++) {
+    const uint8_t* row = pixels + y * row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      bool inside = row[x] >= 128u;
+      to_inside[y * width + x] = inside ? 0.0f : kFar;
+      to_outside[y * width + x] = inside ? kFar : 0.0f;
+    }
+  }
+  DistanceTransform2D(to_inside, width, height);
+  DistanceTransform2D(to_outside, width, height);
+
+  for (size_t y = 0; y < height; y++) {
+    uint8_t* row = pixels + y * row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      size_t index = y * width + x;
+      Scalar coverage = row[x] / 255.0f;
+      // The outline lies half way between the centers of neighboring inside
+      // and outside pixels. Partially covered pixels are on the outline, and
+      // their coverage gives a closer estimate of the distance to it.
+      Scalar distance;
+      if (coverage > 0.0f && coverage < 1.0f) {
+        distance = coverage - 0.5f;
+      } else if (coverage >= 0.5f) {
+        distance = std::sqrt(to_outside[index]) - 0.5f;
+      } else {
+        distance = 0.5f - std::sqrt(to_inside[index]);
+      }
+      Scalar value = std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+      row[x] = static_cast<uint8_t>(std::round(value * 255.0f));
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TYPOGRAPHER_SIGNED_DISTANCE_FIELD_H_
+#define FLUTTER_IMPELLER_TYPOGRAPHER_SIGNED_DISTANCE_FIELD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Convert an 8-bit coverage mask to a signed distance field in
+///             place.
+///
+///             Pixels with a coverage of at least one half are considered
+///             inside the shape. Each pixel is replaced by its distance to the
+///             outline of the shape, mapped so that 128 lies on the outline,
+///             255 lies [spread] pixels inside of it, and 0 lies [spread]
+///             pixels outside of it.
+///
+///             Distances are computed with an exact Euclidean distance
+///             transform, in time linear in the number of pixels.
+///
+/// @param[in]  pixels     The first pixel of the mask.
+/// @param[in]  width      The width of the mask in pixels.
+/// @param[in]  height     The height of the mask in pixels.
+/// @param[in]  row_bytes  The distance in bytes between consecutive rows.
+/// @param[in]  spread     The distance in pixels at which the field saturates.
+///
+void ComputeSignedDistanceField(uint8_t* pixels,
+                                size_t width,
+                                size_t height,
+                                size_t row_bytes,
+                                Scalar spread);
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TYPOGRAPHER_SIGNED_DISTANCE_FIELD_H_
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "impeller/typographer/text_frame.h"
+
+#include <algorithm>
+
 #include "impeller/typographer/font.h"
 #include "impeller/typographer/font_glyph_pair.h"
 
@@ -11,7 +14,12 @@ namespace impeller {
 TextFrame::TextFrame() = default;
 
 TextFrame::TextFrame(std::vector<TextRun>& runs, Rect bounds, bool has_color)
-    : runs_(std::move(runs)), bounds_(bounds), has_color_(has_color) {}
+    : runs_(std::move(runs)), bounds_(bounds), has_color_(has_color) {
+  for (const TextRun& run : runs_) {
+    max_point_size_ =
+        std::max(max_point_size_, run.GetFont().GetMetrics().point_size);
+  }
+}
 
 TextFrame::~TextFrame() = default;
 
@@ -28,8 +36,17 @@ const std::vector<TextRun>& TextFrame::GetRuns() const {
 }
 
 GlyphAtlas::Type TextFrame::GetAtlasType() const {
-  return has_color_ ? GlyphAtlas::Type::kColorBitmap
-                    : GlyphAtlas::Type::kAlphaBitmap;
+  if (has_color_) {
+    return GlyphAtlas::Type::kColorBitmap;
+  }
+  // Stroked glyphs depend on the stroke width at scale, so they can't share
+  // an entry between scales.
+  if (!properties_.has_value() &&
+      (scale_settle_frames_ < kScaleSettleFrameCount ||
+       max_point_size_ * scale_ >= kSignedDistanceFieldMinFontSize)) {
+    return GlyphAtlas::Type::kSignedDistanceField;
+  }
+  return GlyphAtlas::Type::kAlphaBitmap;
 }
 
 bool TextFrame::HasColor() const {
@@ -46,6 +63,18 @@ Scalar TextFrame::RoundScaledFontSize(Scalar scale, Scalar point_size) {
   return std::clamp(result, 0.0f, kMaximumTextScale);
 }
 
+// static
+Scalar TextFrame::ComputeAtlasScale(GlyphAtlas::Type type,
+                                    Scalar scale,
+                                    Scalar point_size) {
+  if (type == GlyphAtlas::Type::kSignedDistanceField) {
+    return point_size > 0
+               ? GlyphAtlas::kSignedDistanceFieldFontSize / point_size
+               : 1.0f;
+  }
+  return RoundScaledFontSize(scale, point_size);
+}
+
 static constexpr Scalar ComputeFractionalPosition(Scalar value) {
   value += 0.125;
   value = (value - floorf(value));
@@ -87,6 +116,12 @@ Point TextFrame::ComputeSubpixelPosition(
 void TextFrame::SetPerFrameData(Scalar scale,
                                 Point offset,
                                 std::optional<GlyphProperties> properties) {
+  // The first scale a frame is drawn at is not a change of scale.
+  if (scale_ != 0 && scale != scale_) {
+    scale_settle_frames_ = 0u;
+  } else if (scale_settle_frames_ < kScaleSettleFrameCount) {
+    scale_settle_frames_++;
+  }
   scale_ = scale;
   offset_ = offset;
   properties_ = properties;
@@ -112,6 +147,25 @@ void TextFrame::ClearFrameBounds() {
   bound_values_.clear();
 }
 
+const TextFrame::InstanceData* TextFrame::GetInstanceData(
+    GlyphAtlas::Type type) const {
+  if (!instance_data_.has_value() || instance_data_->type != type ||
+      instance_data_->scale != scale_ ||
+      instance_data_->frame_bounds != bound_values_) {
+    return nullptr;
+  }
+  return &instance_data_.value();
+}
+
+TextFrame::InstanceData* TextFrame::GetInstanceData(GlyphAtlas::Type type) {
+  return const_cast<InstanceData*>(
+      static_cast<const TextFrame*>(this)->GetInstanceData(type));
+}
+
+void TextFrame::SetInstanceData(InstanceData instance_data) {
+  instance_data_ = std::move(instance_data);
+}
+
 bool TextFrame::IsFrameComplete() const {
   size_t run_size = 0;
   for (const auto& x : runs_) {
@@ -5,6 +5,11 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_TEXT_FRAME_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_TEXT_FRAME_H_
 
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "impeller/core/buffer_view.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_run.h"
 
@@ -20,6 +25,49 @@ namespace impeller {
 /// as internally it is used as a cache for various glyph properties.
 class TextFrame {
  public:
+  //----------------------------------------------------------------------------
+  /// The minimum font size in device pixels at which text is drawn from a
+  /// signed distance field atlas instead of a bitmap atlas.
+  static constexpr Scalar kSignedDistanceFieldMinFontSize = 48.0f;
+
+  //----------------------------------------------------------------------------
+  /// The number of consecutive frames the scale of a text frame must remain
+  /// unchanged for before it is no longer considered to be animating.
+  static constexpr uint32_t kScaleSettleFrameCount = 4u;
+
+  //----------------------------------------------------------------------------
+  /// The number of consecutive frames the instance data of a text frame must
+  /// be reused for before it is moved out of the transients buffer into
+  /// device buffers of its own.
+  static constexpr uint32_t kInstanceDataStableFrameCount = 4u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The per-glyph data uploaded to draw a text frame with
+  ///             instancing, and the atlas placement it was generated for.
+  ///
+  struct InstanceData {
+    GlyphAtlas::Type type = GlyphAtlas::Type::kAlphaBitmap;
+    Scalar scale = 0;
+    /// The bounds of every glyph of the text frame in the atlas.
+    std::vector<FrameBounds> frame_bounds;
+    /// The position and atlas glyph of every glyph, ordered by atlas page.
+    /// Until the data is promoted, this refers to the transients buffer and
+    /// is only valid for the frame it was uploaded in.
+    BufferView instances;
+    /// The atlas glyphs referred to by the instances.
+    BufferView atlas_glyphs;
+    /// The contents of `instances` and `atlas_glyphs` while they are
+    /// uploaded to the transients buffer every frame. Both are cleared once
+    /// the data is promoted to device buffers.
+    std::vector<uint8_t> instance_bytes;
+    std::vector<uint8_t> atlas_glyph_bytes;
+    /// The number of consecutive frames the data has been reused for.
+    uint32_t stable_frame_count = 0u;
+    /// The index of the first instance of each atlas page, followed by the
+    /// total number of instances.
+    std::vector<size_t> page_offsets;
+  };
+
   TextFrame();
 
   TextFrame(std::vector<TextRun>& runs, Rect bounds, bool has_color);
@@ -34,6 +82,17 @@ class TextFrame {
 
   static Scalar RoundScaledFontSize(Scalar scale, Scalar point_size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Compute the scale at which glyphs of the given point size are
+  ///             placed in an atlas of the given type.
+  ///
+  ///             Signed distance field atlases hold glyphs at a fixed size, so
+  ///             the result does not depend on [scale] for them.
+  ///
+  static Scalar ComputeAtlasScale(GlyphAtlas::Type type,
+                                  Scalar scale,
+                                  Scalar point_size);
+
   //----------------------------------------------------------------------------
   /// @brief      The conservative bounding box for this text frame.
   ///
@@ -67,6 +126,12 @@ class TextFrame {
 
   //----------------------------------------------------------------------------
   /// @brief      The type of atlas this run should be place in.
+  ///
+  ///             Text without color or stroke properties is placed in a signed
+  ///             distance field atlas when it is at least
+  ///             `kSignedDistanceFieldMinFontSize` on screen or when its scale
+  ///             changed within the last `kScaleSettleFrameCount` frames. A
+  ///             single atlas entry then serves every scale of the animation.
   GlyphAtlas::Type GetAtlasType() const;
 
   /// @brief Verifies that all glyphs in this text frame have computed bounds
@@ -84,6 +149,21 @@ class TextFrame {
                        Point offset,
                        std::optional<GlyphProperties> properties);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the instance data stored for this text frame if it
+  ///             was generated for the current scale and glyph bounds in an
+  ///             atlas of the given type, or nullptr otherwise.
+  ///
+  ///             Translating a text frame, e.g. by scrolling it, leaves its
+  ///             instance data valid unless the subpixel positions of its
+  ///             glyphs change.
+  ///
+  const InstanceData* GetInstanceData(GlyphAtlas::Type type) const;
+
+  InstanceData* GetInstanceData(GlyphAtlas::Type type);
+
+  void SetInstanceData(InstanceData instance_data);
+
   TextFrame& operator=(TextFrame&& other) = default;
 
   TextFrame(const TextFrame& other) = default;
@@ -106,6 +186,7 @@ class TextFrame {
   std::vector<TextRun> runs_;
   Rect bounds_;
   bool has_color_;
+  Scalar max_point_size_ = 0;
 
   // Data that is cached when rendering the text frame and is only
   // valid for a single frame.
@@ -113,6 +194,9 @@ class TextFrame {
   Scalar scale_ = 0;
   Point offset_;
   std::optional<GlyphProperties> properties_;
+  // The number of frames the scale has remained unchanged for.
+  uint32_t scale_settle_frames_ = kScaleSettleFrameCount;
+  std::optional<InstanceData> instance_data_;
 };
 
 }  // namespace impeller
@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <random>
+
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/backends/skia/typographer_context_skia.h"
+#include "impeller/typographer/glyph_atlas.h"
+#include "impeller/typographer/rectangle_packer.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace impeller {
+
+class ImpellerBenchmarkAccessor {
+ public:
+  static std::pair<std::vector<FontGlyphPair>, std::vector<Rect>>
+  CollectNewGlyphs(const std::shared_ptr<GlyphAtlas>& atlas,
+                   const std::vector<std::shared_ptr<TextFrame>>& text_frames,
+                   uint64_t frame_number) {
+    return TypographerContextSkia::CollectNewGlyphs(atlas, text_frames,
+                                                    frame_number);
+  }
+};
+
+namespace {
+/// The number of frames of the simulated zoom animation.
+constexpr uint64_t kZoomFrameCount = 60u;
+
+/// The size of the packers in the packing benchmarks, in pixels.
+constexpr int kPackerSize = 1024;
+
+/// The range of the glyph sizes in the packing benchmarks, in pixels.
+constexpr int kMinGlyphSize = 8;
+constexpr int kMaxGlyphSize = 64;
+
+using PackerFactory = std::shared_ptr<RectanglePacker> (*)(int, int);
+}  // namespace
+
+/// Simulate text zooming from 1x to 4x over [kZoomFrameCount] frames and
+/// count the glyphs that have to be rasterized and uploaded to an atlas of
+/// the given type.
+static void BM_AtlasUploadsDuringZoom(benchmark::State& state,
+                                      GlyphAtlas::Type type) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(16);
+  auto blob = SkTextBlob::MakeFromString(
+      "the quick brown fox jumped over the lazy dog.", sk_font);
+  std::vector<std::shared_ptr<TextFrame>> frames = {
+      MakeTextFrameFromTextBlobSkia(blob)};
+
+  size_t uploaded_glyphs = 0u;
+  size_t uploaded_bytes = 0u;
+  while (state.KeepRunning()) {
+    auto atlas = std::make_shared<GlyphAtlas>(type);
+    for (uint64_t frame_number = 1; frame_number <= kZoomFrameCount;
+         frame_number++) {
+      Scalar t = static_cast<Scalar>(frame_number - 1) / (kZoomFrameCount - 1);
+      frames[0]->SetPerFrameData(1.0f + 3.0f * t, {0, 0}, std::nullopt);
+      auto [new_glyphs, glyph_sizes] =
+          ImpellerBenchmarkAccessor::CollectNewGlyphs(atlas, frames,
+                                                      frame_number);
+      uploaded_glyphs += new_glyphs.size();
+      for (const Rect& glyph_size : glyph_sizes) {
+        // Both atlas types hold a single 8-bit channel per pixel.
+        uploaded_bytes += ISize::Ceil(glyph_size.GetSize()).Area();
+      }
+    }
+  }
+  state.counters["UploadedGlyphs"] =
+      benchmark::Counter(uploaded_glyphs, benchmark::Counter::kAvgIterations);
+  state.counters["UploadedBytes"] =
+      benchmark::Counter(uploaded_bytes, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_AtlasUploadsDuringZoom,
+                  alpha_bitmap,
+                  GlyphAtlas::Type::kAlphaBitmap);
+BENCHMARK_CAPTURE(BM_AtlasUploadsDuringZoom,
+                  signed_distance_field,
+                  GlyphAtlas::Type::kSignedDistanceField);
+
+/// Add randomly sized glyphs to an empty packer until one no longer fits,
+/// and report how much of the packer was filled.
+static void BM_RectanglePackerFill(benchmark::State& state,
+                                   PackerFactory factory) {
+  double percent_full = 0.0;
+  double fragmentation = 0.0;
+  while (state.KeepRunning()) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> glyph_size(kMinGlyphSize, kMaxGlyphSize);
+    auto packer = factory(kPackerSize, kPackerSize);
+    IPoint16 location;
+    while (packer->AddRect(glyph_size(random), glyph_size(random), &location)) {
+      // Keep adding glyphs until the packer is full.
+    }
+    percent_full += packer->PercentFull();
+    fragmentation += packer->Fragmentation();
+  }
+  state.counters["PercentFull"] =
+      benchmark::Counter(percent_full, benchmark::Counter::kAvgIterations);
+  state.counters["Fragmentation"] =
+      benchmark::Counter(fragmentation, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_RectanglePackerFill, skyline, &RectanglePacker::Factory);
+BENCHMARK_CAPTURE(BM_RectanglePackerFill,
+                  guillotine,
+                  &RectanglePacker::GuillotineFactory);
+
+/// Fill a guillotine packer, then repeatedly remove a random glyph and add
+/// new ones until one no longer fits, as a glyph atlas that evicts unused
+/// glyphs would. Reports the occupancy and fragmentation that remain.
+static void BM_GuillotineRectanglePackerChurn(benchmark::State& state) {
+  constexpr size_t kChurnCount = 10000u;
+
+  double percent_full = 0.0;
+  double fragmentation = 0.0;
+  while (state.KeepRunning()) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> glyph_size(kMinGlyphSize, kMaxGlyphSize);
+    auto packer = RectanglePacker::GuillotineFactory(kPackerSize, kPackerSize);
+    std::vector<std::pair<IPoint16, ISize>> placed;
+    for (size_t i = 0; i < kChurnCount; i++) {
+      int width = glyph_size(random);
+      int height = glyph_size(random);
+      IPoint16 location;
+      if (packer->AddRect(width, height, &location)) {
+        placed.emplace_back(location, ISize(width, height));
+        continue;
+      }
+      if (placed.empty()) {
+        break;
+      }
+      size_t index = random() % placed.size();
+      const auto& [removed_location, removed_size] = placed[index];
+      packer->RemoveRect(removed_location, removed_size.width,
+                         removed_size.height);
+      placed[index] = placed.back();
+      placed.pop_back();
+    }
+    percent_full += packer->PercentFull();
+    fragmentation += packer->Fragmentation();
+  }
+  state.counters["PercentFull"] =
+      benchmark::Counter(percent_full, benchmark::Counter::kAvgIterations);
+  state.counters["Fragmentation"] =
+      benchmark::Counter(fragmentation, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_GuillotineRectanglePackerChurn);
+
+}  // namespace impeller
@@ -2,7 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <random>
+
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/core/host_buffer.h"
@@ -13,6 +16,7 @@
 #include "impeller/typographer/font_glyph_pair.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -253,6 +257,48 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   EXPECT_TRUE(atlas->GetTexture()->GetSize().height > 0);
 }
 
+TEST_P(TypographerTest, GlyphAtlasRasterizesGlyphsOnWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  auto serial_context = TypographerContextSkia::Make();
+  auto parallel_context = TypographerContextSkia::Make(loop->GetTaskRunner());
+  ASSERT_TRUE(parallel_context && parallel_context->IsValid());
+
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm1234567890", sk_font);
+  ASSERT_TRUE(blob);
+
+  auto serial_atlas_context =
+      serial_context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  auto serial_atlas = CreateGlyphAtlas(
+      *GetContext(), serial_context.get(), *host_buffer,
+      GlyphAtlas::Type::kAlphaBitmap, 1.0f, serial_atlas_context,
+      MakeTextFrameFromTextBlobSkia(blob));
+  auto parallel_atlas_context =
+      parallel_context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  auto parallel_atlas = CreateGlyphAtlas(
+      *GetContext(), parallel_context.get(), *host_buffer,
+      GlyphAtlas::Type::kAlphaBitmap, 1.0f, parallel_atlas_context,
+      MakeTextFrameFromTextBlobSkia(blob));
+  ASSERT_TRUE(serial_atlas && serial_atlas->IsValid());
+  ASSERT_TRUE(parallel_atlas && parallel_atlas->IsValid());
+  EXPECT_EQ(parallel_atlas->GetGlyphCount(), serial_atlas->GetGlyphCount());
+
+  // Glyphs appended to the existing page are rasterized on workers as well.
+  auto blob2 = SkTextBlob::MakeFromString(
+      "!@#$%^&*()_+-=[]{};':,./<>?`~|", sk_font);
+  parallel_atlas = CreateGlyphAtlas(
+      *GetContext(), parallel_context.get(), *host_buffer,
+      GlyphAtlas::Type::kAlphaBitmap, 1.0f, parallel_atlas_context,
+      MakeTextFrameFromTextBlobSkia(blob2));
+  ASSERT_TRUE(parallel_atlas && parallel_atlas->IsValid());
+  EXPECT_GT(parallel_atlas->GetGlyphCount(), serial_atlas->GetGlyphCount());
+
+  loop->Terminate();
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
                                         GetContext()->GetIdleWaiter());
@@ -422,11 +468,119 @@ TEST(TypographerTest, RectanglePackerFillsRows) {
   EXPECT_EQ(loc.y(), 16);
 }
 
-TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
-  if (GetBackend() == PlaygroundBackend::kOpenGLES) {
-    GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
+TEST(TypographerTest, GuillotineRectanglePackerRemovesAndCoalesces) {
+  auto packer = RectanglePacker::GuillotineFactory(64, 64);
+  ASSERT_TRUE(packer->SupportsRemoval());
+  EXPECT_EQ(packer->Fragmentation(), 0);
+
+  // Fill the packer with four quadrants.
+  std::vector<IPoint16> locations(4);
+  for (auto& location : locations) {
+    ASSERT_TRUE(packer->AddRect(32, 32, &location));
+  }
+  EXPECT_EQ(packer->PercentFull(), 1);
+  IPoint16 output;
+  EXPECT_FALSE(packer->AddRect(1, 1, &output));
+
+  // Rectangles can only be removed with the size they were added with.
+  EXPECT_FALSE(packer->RemoveRect(locations[0], 16, 16));
+  EXPECT_FALSE(packer->RemoveRect({1, 1}, 32, 32));
+
+  // Removing two neighboring quadrants leaves room for their union.
+  for (const auto& location : locations) {
+    if (location.y() == 0) {
+      ASSERT_TRUE(packer->RemoveRect(location, 32, 32));
+    }
+  }
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->PercentFull(), 0.5));
+  EXPECT_EQ(packer->Fragmentation(), 0);
+  ASSERT_TRUE(packer->AddRect(64, 32, &output));
+  EXPECT_EQ(output.y(), 0);
+  EXPECT_FALSE(packer->RemoveRect(output, 32, 32));
+}
+
+TEST(TypographerTest, RectanglePackerReportsFragmentation) {
+  auto packer = RectanglePacker::GuillotineFactory(100, 100);
+  IPoint16 first;
+  IPoint16 second;
+  ASSERT_TRUE(packer->AddRect(50, 100, &first));
+  ASSERT_TRUE(packer->AddRect(50, 50, &second));
+  // The free area is a single 50x50 rectangle.
+  EXPECT_EQ(packer->Fragmentation(), 0);
+
+  // Removing the tall rectangle leaves a free area of 50x100 and 50x50 that
+  // are not a rectangle together.
+  ASSERT_TRUE(packer->RemoveRect(first, 50, 100));
+  EXPECT_TRUE(flutter::testing::NumberNear(packer->Fragmentation(), 1.0 / 3));
+
+  // Skyline packers can't reach the area below the skyline.
+  auto skyline = RectanglePacker::Factory(100, 100);
+  EXPECT_FALSE(skyline->SupportsRemoval());
+  ASSERT_TRUE(skyline->AddRect(10, 50, &first));
+  ASSERT_TRUE(skyline->AddRect(90, 10, &second));
+  EXPECT_FALSE(skyline->RemoveRect(first, 10, 50));
+  // Of the 8600 free pixels, the largest free rectangle covers 90x90.
+  EXPECT_TRUE(flutter::testing::NumberNear(skyline->Fragmentation(),
+                                           1.0 - 8100.0 / 8600.0));
+}
+
+TEST(TypographerTest, GuillotineRectanglePackerRandomizedStress) {
+  constexpr int kWidth = 512;
+  constexpr int kHeight = 256;
+  auto packer = RectanglePacker::GuillotineFactory(kWidth, kHeight);
+
+  struct PackedRect {
+    IPoint16 location;
+    int width;
+    int height;
+  };
+  std::vector<PackedRect> packed;
+  int64_t packed_area = 0;
+  std::mt19937 random(42);
+  for (int i = 0; i < 20000; i++) {
+    if (packed.empty() || random() % 3 != 0) {
+      int width = 1 + random() % 40;
+      int height = 1 + random() % 40;
+      IPoint16 location;
+      if (!packer->AddRect(width, height, &location)) {
+        continue;
+      }
+      SkIRect rect =
+          SkIRect::MakeXYWH(location.x(), location.y(), width, height);
+      ASSERT_TRUE(SkIRect::MakeWH(kWidth, kHeight).contains(rect));
+      for (const PackedRect& other : packed) {
+        ASSERT_FALSE(SkIRect::Intersects(
+            rect, SkIRect::MakeXYWH(other.location.x(), other.location.y(),
+                                    other.width, other.height)));
+      }
+      packed.push_back({location, width, height});
+      packed_area += width * height;
+    } else {
+      size_t index = random() % packed.size();
+      PackedRect removed = packed[index];
+      packed.erase(packed.begin() + index);
+      ASSERT_TRUE(
+          packer->RemoveRect(removed.location, removed.width, removed.height));
+      packed_area -= removed.width * removed.height;
+    }
+    ASSERT_TRUE(flutter::testing::NumberNear(
+        packer->PercentFull(),
+        static_cast<Scalar>(packed_area) / (kWidth * kHeight)));
+    ASSERT_GE(packer->Fragmentation(), 0);
+    ASSERT_LE(packer->Fragmentation(), 1);
+  }
+
+  // Once every rectangle is removed, the whole area is available again.
+  for (const PackedRect& removed : packed) {
+    ASSERT_TRUE(
+        packer->RemoveRect(removed.location, removed.width, removed.height));
   }
+  EXPECT_EQ(packer->PercentFull(), 0);
+  IPoint16 location;
+  EXPECT_TRUE(packer->AddRect(kWidth, kHeight, &location));
+}
 
+TEST_P(TypographerTest, GlyphAtlasAddsPagesTilMaxPageCount) {
   auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
                                         GetContext()->GetIdleWaiter());
   auto context = TypographerContextSkia::Make();
@@ -440,29 +594,18 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
       CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
                        GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
                        MakeTextFrameFromTextBlobSkia(blob));
-  // Continually append new glyphs until the glyph size grows to the maximum.
-  // Note that the sizes here are more or less experimentally determined, but
-  // the important expectation is that the atlas size will shrink again after
-  // growing to the maximum size.
-  constexpr ISize expected_sizes[13] = {
-      {4096, 4096},   //
-      {4096, 4096},   //
-      {4096, 8192},   //
-      {4096, 8192},   //
-      {4096, 8192},   //
-      {4096, 8192},   //
-      {4096, 16384},  //
-      {4096, 16384},  //
-      {4096, 16384},  //
-      {4096, 16384},  //
-      {4096, 16384},  //
-      {4096, 16384},  //
-      {4096, 4096}    // Shrinks!
-  };
+  ASSERT_TRUE(!!atlas);
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+  const Texture* first_page = atlas->GetTexture().get();
 
+  // Continually append new large glyphs. Each of them needs most of a page,
+  // so new pages are added until the maximum page count is reached, after
+  // which the least recently used pages are reused.
   SkFont sk_font_small = flutter::testing::CreateTestFontOfSize(10);
 
-  for (int i = 0; i < 13; i++) {
+  constexpr int kFrameCount = 20;
+  std::shared_ptr<TextFrame> frame;
+  for (int i = 0; i < kFrameCount; i++) {
     SkTextBlobBuilder builder;
 
     auto add_char = [&](const SkFont& sk_font, char c) {
@@ -477,19 +620,160 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
     add_char(sk_font_small, 'B');
     auto blob = builder.make();
 
-    atlas =
-        CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
-                         GlyphAtlas::Type::kAlphaBitmap, 50 + i, atlas_context,
-                         MakeTextFrameFromTextBlobSkia(blob));
+    frame = MakeTextFrameFromTextBlobSkia(blob);
+    atlas = CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                             GlyphAtlas::Type::kAlphaBitmap, 50 + i,
+                             atlas_context, frame);
     ASSERT_TRUE(!!atlas);
-    EXPECT_EQ(atlas->GetTexture()->GetTextureDescriptor().size,
-              expected_sizes[i]);
+    EXPECT_LE(atlas->GetPageCount(), GlyphAtlas::kMaxPageCount);
+    for (size_t page = 0; page < atlas->GetPageCount(); page++) {
+      EXPECT_EQ(atlas->GetPageTexture(page)->GetSize().width, 4096);
+    }
+    // Pages are never reallocated to make room for more glyphs.
+    EXPECT_EQ(atlas->GetTexture().get(), first_page);
+  }
+
+  EXPECT_EQ(atlas->GetPageCount(), GlyphAtlas::kMaxPageCount);
+  // The glyphs of the most recent frame are always present.
+  for (const auto& run : frame->GetRuns()) {
+    ScaledFont scaled_font{
+        run.GetFont(), TextFrame::RoundScaledFontSize(
+                           50 + kFrameCount - 1,
+                           run.GetFont().GetMetrics().point_size)};
+    for (const auto& glyph_position : run.GetGlyphPositions()) {
+      EXPECT_TRUE(atlas
+                      ->FindFontGlyphBounds(FontGlyphPair{
+                          scaled_font,
+                          SubpixelGlyph(glyph_position.glyph, {0, 0},
+                                        std::nullopt)})
+                      .has_value());
+    }
   }
+}
 
-  // The final atlas should contain both the "A" glyph (which was not present
-  // in the previous atlas) and the "B" glyph (which existed in the previous
-  // atlas).
-  ASSERT_EQ(atlas->GetGlyphCount(), 2u);
+TEST(TypographerTest, GlyphAtlasEvictsGlyphsByPage) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("AB", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  ASSERT_EQ(frame->GetRuns().size(), 1u);
+  const TextRun& run = frame->GetRuns()[0];
+  ASSERT_EQ(run.GetGlyphPositions().size(), 2u);
+
+  ScaledFont scaled_font{run.GetFont(), 1.0f};
+  SubpixelGlyph glyph_a(run.GetGlyphPositions()[0].glyph, {0, 0},
+                        std::nullopt);
+  SubpixelGlyph glyph_b(run.GetGlyphPositions()[1].glyph, {0, 0},
+                        std::nullopt);
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  EXPECT_EQ(atlas.AddPage(nullptr), 0u);
+  EXPECT_EQ(atlas.AddPage(nullptr), 1u);
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      FontGlyphPair{scaled_font, glyph_a}, Rect::MakeXYWH(1, 1, 10, 10),
+      Rect::MakeXYWH(0, 0, 10, 10), /*page_index=*/0);
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      FontGlyphPair{scaled_font, glyph_b}, Rect::MakeXYWH(1, 1, 10, 10),
+      Rect::MakeXYWH(0, 0, 10, 10), /*page_index=*/1);
+
+  FontGlyphAtlas* font_atlas = atlas.GetOrCreateFontGlyphAtlas(scaled_font);
+  ASSERT_TRUE(font_atlas->FindGlyphBoundsAndMarkUsed(glyph_a, 3).has_value());
+  ASSERT_TRUE(font_atlas->FindGlyphBoundsAndMarkUsed(glyph_b, 5).has_value());
+  EXPECT_EQ(font_atlas->FindGlyphBounds(glyph_b)->page_index, 1u);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(0), 3u);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(1), 5u);
+
+  EXPECT_EQ(atlas.EvictPage(0), 1u);
+  EXPECT_EQ(atlas.GetPageCount(), 2u);
+  EXPECT_EQ(atlas.GetGlyphCount(), 1u);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(0), 0u);
+  EXPECT_FALSE(atlas.FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph_a})
+                   .has_value());
+  EXPECT_TRUE(atlas.FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph_b})
+                  .has_value());
+}
+
+TEST(TypographerTest, GlyphAtlasEvictsUnusedGlyphs) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("AB", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  const TextRun& run = frame->GetRuns()[0];
+
+  ScaledFont scaled_font{run.GetFont(), 1.0f};
+  SubpixelGlyph glyph_a(run.GetGlyphPositions()[0].glyph, {0, 0},
+                        std::nullopt);
+  SubpixelGlyph glyph_b(run.GetGlyphPositions()[1].glyph, {0, 0},
+                        std::nullopt);
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  atlas.AddPage(nullptr);
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      FontGlyphPair{scaled_font, glyph_a}, Rect::MakeXYWH(1, 1, 10, 10),
+      Rect::MakeXYWH(0, 0, 10, 10));
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      FontGlyphPair{scaled_font, glyph_b}, Rect::MakeXYWH(13, 1, 10, 10),
+      Rect::MakeXYWH(0, 0, 10, 10));
+  FontGlyphAtlas* font_atlas = atlas.GetOrCreateFontGlyphAtlas(scaled_font);
+  font_atlas->FindGlyphBoundsAndMarkUsed(glyph_a, 3);
+  font_atlas->FindGlyphBoundsAndMarkUsed(glyph_b, 5);
+
+  std::vector<Rect> evicted_bounds;
+  EXPECT_EQ(atlas.EvictGlyphsUnusedSince(
+                0, 5,
+                [&](const Rect& bounds) { evicted_bounds.push_back(bounds); }),
+            1u);
+  ASSERT_EQ(evicted_bounds.size(), 1u);
+  EXPECT_EQ(evicted_bounds[0], Rect::MakeXYWH(1, 1, 10, 10));
+  EXPECT_FALSE(atlas.FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph_a})
+                   .has_value());
+  EXPECT_TRUE(atlas.FindFontGlyphBounds(FontGlyphPair{scaled_font, glyph_b})
+                  .has_value());
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(0), 5u);
+}
+
+TEST(TypographerTest, GlyphAtlasTracksPageLastUsedFrame) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("AB", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+  const TextRun& run = frame->GetRuns()[0];
+
+  ScaledFont scaled_font{run.GetFont(), 1.0f};
+  SubpixelGlyph glyph_a(run.GetGlyphPositions()[0].glyph, {0, 0},
+                        std::nullopt);
+  SubpixelGlyph glyph_b(run.GetGlyphPositions()[1].glyph, {0, 0},
+                        std::nullopt);
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  atlas.AddPage(nullptr);
+  atlas.AddPage(nullptr);
+  FontGlyphAtlas* font_atlas = atlas.GetOrCreateFontGlyphAtlas(scaled_font);
+
+  // Placeholders don't count towards a page until they are placed.
+  font_atlas->AppendGlyph(
+      glyph_a,
+      FrameBounds{Rect::MakeLTRB(0, 0, 0, 0), Rect::MakeXYWH(0, 0, 10, 10),
+                  /*is_placeholder=*/true, /*page_index=*/1},
+      /*frame_number=*/4);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(1), 0u);
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      FontGlyphPair{scaled_font, glyph_a}, Rect::MakeXYWH(1, 1, 10, 10),
+      Rect::MakeXYWH(0, 0, 10, 10), /*page_index=*/1);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(1), 4u);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(0), 0u);
+
+  atlas.AddTypefaceGlyphPositionAndBounds(
+      FontGlyphPair{scaled_font, glyph_b}, Rect::MakeXYWH(13, 1, 10, 10),
+      Rect::MakeXYWH(0, 0, 10, 10), /*page_index=*/1);
+  font_atlas->FindGlyphBoundsAndMarkUsed(glyph_b, 9);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(1), 9u);
+
+  // The frame of a page is recomputed from the glyphs that eviction keeps.
+  EXPECT_EQ(atlas.EvictGlyphsUnusedSince(1, 5, nullptr), 1u);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(1), 9u);
+  EXPECT_EQ(atlas.EvictGlyphsUnusedSince(1, 10, nullptr), 1u);
+  EXPECT_EQ(atlas.GetPageLastUsedFrame(1), 0u);
 }
 
 TEST_P(TypographerTest, TextFrameInitialBoundsArePlaceholder) {
@@ -525,6 +809,144 @@ TEST_P(TypographerTest, TextFrameInitialBoundsArePlaceholder) {
   EXPECT_FALSE(frame->GetFrameBounds(0).is_placeholder);
 }
 
+TEST_P(TypographerTest, TextFrameUsesSdfAtlasWhileScaleAnimates) {
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  frame->SetPerFrameData(1.0f, {0, 0}, std::nullopt);
+  EXPECT_EQ(frame->GetAtlasType(), GlyphAtlas::Type::kAlphaBitmap);
+
+  // A change of scale switches to the distance field until the scale has
+  // settled.
+  frame->SetPerFrameData(1.5f, {0, 0}, std::nullopt);
+  EXPECT_EQ(frame->GetAtlasType(), GlyphAtlas::Type::kSignedDistanceField);
+  for (uint32_t i = 1; i < TextFrame::kScaleSettleFrameCount; i++) {
+    frame->SetPerFrameData(1.5f, {0, 0}, std::nullopt);
+    EXPECT_EQ(frame->GetAtlasType(), GlyphAtlas::Type::kSignedDistanceField);
+  }
+  frame->SetPerFrameData(1.5f, {0, 0}, std::nullopt);
+  EXPECT_EQ(frame->GetAtlasType(), GlyphAtlas::Type::kAlphaBitmap);
+
+  // Large text always uses the distance field, unless it is stroked.
+  Scalar large_scale = TextFrame::kSignedDistanceFieldMinFontSize / 12.0f;
+  for (uint32_t i = 0; i <= TextFrame::kScaleSettleFrameCount; i++) {
+    frame->SetPerFrameData(large_scale, {0, 0}, std::nullopt);
+  }
+  EXPECT_EQ(frame->GetAtlasType(), GlyphAtlas::Type::kSignedDistanceField);
+  GlyphProperties stroke;
+  stroke.stroke = true;
+  frame->SetPerFrameData(large_scale, {0, 0}, stroke);
+  EXPECT_EQ(frame->GetAtlasType(), GlyphAtlas::Type::kAlphaBitmap);
+}
+
+TEST_P(TypographerTest, SdfGlyphAtlasSharesGlyphsAcrossScales) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kSignedDistanceField);
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                       GlyphAtlas::Type::kSignedDistanceField, 1.0f,
+                       atlas_context, frame);
+  ASSERT_NE(atlas, nullptr);
+  EXPECT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  EXPECT_EQ(atlas->GetGlyphCount(), 4u);
+
+  for (Scalar scale : {1.5f, 2.25f, 4.0f}) {
+    auto next_atlas =
+        CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                         GlyphAtlas::Type::kSignedDistanceField, scale,
+                         atlas_context, frame);
+    EXPECT_EQ(next_atlas, atlas);
+    EXPECT_EQ(next_atlas->GetGlyphCount(), 4u);
+  }
+}
+
+TEST_P(TypographerTest, TextFrameInstanceDataSurvivesWholePixelTranslation) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context =
+      context->CreateGlyphAtlasContext(GlyphAtlas::Type::kAlphaBitmap);
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator(),
+                                        GetContext()->GetIdleWaiter());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto frame = MakeTextFrameFromTextBlobSkia(blob);
+
+  // The second atlas resolves the placeholder bounds of the first.
+  for (int i = 0; i < 2; i++) {
+    CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                     GlyphAtlas::Type::kAlphaBitmap, 1.0f, atlas_context,
+                     frame);
+  }
+  ASSERT_TRUE(frame->IsFrameComplete());
+  EXPECT_EQ(frame->GetInstanceData(GlyphAtlas::Type::kAlphaBitmap), nullptr);
+
+  TextFrame::InstanceData instance_data;
+  instance_data.type = GlyphAtlas::Type::kAlphaBitmap;
+  instance_data.scale = 1.0f;
+  for (size_t i = 0; i < 5u; i++) {
+    instance_data.frame_bounds.push_back(frame->GetFrameBounds(i));
+  }
+  frame->SetInstanceData(std::move(instance_data));
+  EXPECT_NE(frame->GetInstanceData(GlyphAtlas::Type::kAlphaBitmap), nullptr);
+  EXPECT_EQ(frame->GetInstanceData(GlyphAtlas::Type::kColorBitmap), nullptr);
+
+  frame->GetInstanceData(GlyphAtlas::Type::kAlphaBitmap)->stable_frame_count =
+      TextFrame::kInstanceDataStableFrameCount;
+
+  // Scrolling by whole pixels finds every glyph at the same place, and keeps
+  // counting towards promoting the data out of the transients buffer.
+  frame->SetPerFrameData(1.0f, {0, 100}, std::nullopt);
+  context->CreateGlyphAtlas(*GetContext(), GlyphAtlas::Type::kAlphaBitmap,
+                            *host_buffer, atlas_context, {frame});
+  const TextFrame::InstanceData* translated =
+      frame->GetInstanceData(GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_NE(translated, nullptr);
+  EXPECT_EQ(translated->stable_frame_count,
+            TextFrame::kInstanceDataStableFrameCount);
+
+  // A new scale places new glyphs in the atlas.
+  CreateGlyphAtlas(*GetContext(), context.get(), *host_buffer,
+                   GlyphAtlas::Type::kAlphaBitmap, 2.0f, atlas_context, frame);
+  EXPECT_EQ(frame->GetInstanceData(GlyphAtlas::Type::kAlphaBitmap), nullptr);
+}
+
+TEST(SignedDistanceFieldTest, ConvertsCoverageToDistance) {
+  constexpr size_t kWidth = 32u;
+  constexpr size_t kHeight = 24u;
+  constexpr Scalar kSpread = 4.0f;
+  // A square covering the pixels 8 to 23 horizontally and 4 to 19
+  // vertically.
+  std::vector<uint8_t> pixels(kWidth * kHeight, 0u);
+  for (size_t y = 4; y < 20; y++) {
+    for (size_t x = 8; x < 24; x++) {
+      pixels[y * kWidth + x] = 255u;
+    }
+  }
+
+  ComputeSignedDistanceField(pixels.data(), kWidth, kHeight, kWidth, kSpread);
+
+  auto value_at = [&](size_t x, size_t y) { return pixels[y * kWidth + x]; };
+  // Saturated far inside and far outside of the square.
+  EXPECT_EQ(value_at(16, 12), 255u);
+  EXPECT_EQ(value_at(0, 0), 0u);
+  // Half a pixel from the outline on either side.
+  EXPECT_NEAR(value_at(8, 12), 128 + 255 / 16, 1);
+  EXPECT_NEAR(value_at(7, 12), 128 - 255 / 16, 1);
+  // Distances grow with the distance to the outline.
+  EXPECT_GT(value_at(10, 12), value_at(9, 12));
+  EXPECT_LT(value_at(5, 12), value_at(6, 12));
+}
+
 }  // namespace testing
 }  // namespace impeller
 
@@ -92,6 +92,7 @@ typedef CanvasPath Path;
   V(IsolateNameServerNatives::RemovePortNameMapping)               \
   V(NativeStringAttribute::initLocaleStringAttribute)              \
   V(NativeStringAttribute::initSpellOutStringAttribute)            \
+  V(Paragraph::layoutAll)                                          \
   V(PlatformConfigurationNativeApi::DefaultRouteName)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame)                 \
   V(PlatformConfigurationNativeApi::EndWarmUpFrame)                \
@@ -4,10 +4,12 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/task_group.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
@@ -28,6 +30,7 @@
 #include "third_party/skia/include/core/SkPixelRef.h"
 #include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkPoint.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSize.h"
 
 namespace flutter {
@@ -47,6 +50,32 @@ void LoadGamut(SkPoint abc[3], const skcms_Matrix3x3& xyz) {
   }
 }
 
+/// The number of pixels converted by a single worker task.
+constexpr size_t kPixelsPerConversionTask = 256u * 1024u;
+
+/// Converts |src| into the format of |dst| like SkPixmap::readPixels, with
+/// bands of rows converted in parallel on the concurrent task runner.
+void ReadPixels(
+    const SkPixmap& src,
+    const SkPixmap& dst,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
+  TRACE_EVENT0("impeller", "ImageDecoderReadPixels");
+  const size_t width = std::max(dst.width(), 1);
+  const size_t rows_per_task =
+      std::max<size_t>(kPixelsPerConversionTask / width, 1u);
+  fml::ParallelFor(
+      concurrent_task_runner, dst.height(), rows_per_task,
+      [&](size_t begin, size_t end) {
+        SkPixmap dst_rows;
+        SkIRect rows = SkIRect::MakeLTRB(0, static_cast<int32_t>(begin),
+                                         dst.width(),
+                                         static_cast<int32_t>(end));
+        if (dst.extractSubset(&dst_rows, rows)) {
+          src.readPixels(dst_rows, 0, rows.top());
+        }
+      });
+}
+
 /**
  *  Calculates the area of the triangular gamut.
  */
@@ -115,7 +144,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
     const std::shared_ptr<const impeller::Capabilities>& capabilities,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     std::string decode_error("Invalid descriptor (should never happen)");
@@ -203,7 +233,7 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
     }
-    temp_bitmap->readPixels(bitmap->pixmap());
+    ReadPixels(temp_bitmap->pixmap(), bitmap->pixmap(), concurrent_task_runner);
     bitmap->setImmutable();
   }
 
@@ -220,7 +250,8 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       return DecompressResult{.decode_error = decode_error};
     }
     // readPixels() handles converting pixels to premultiplied form.
-    bitmap->readPixels(premul_bitmap->pixmap());
+    ReadPixels(bitmap->pixmap(), premul_bitmap->pixmap(),
+               concurrent_task_runner);
     premul_bitmap->setImmutable();
     bitmap_allocator = premul_allocator;
     bitmap = premul_bitmap;
@@ -527,7 +558,8 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        io_runner = runners_.GetIOTaskRunner(),                    //
        result,
        supports_wide_gamut = supports_wide_gamut_,  //
-       gpu_disabled_switch = gpu_disabled_switch_]() {
+       gpu_disabled_switch = gpu_disabled_switch_,  //
+       concurrent_task_runner = concurrent_task_runner_]() {
 #if FML_OS_IOS_SIMULATOR
         // No-op backend.
         if (!context) {
@@ -546,7 +578,8 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         auto bitmap_result = DecompressTexture(
             raw_descriptor, target_size, max_size_supported,
             /*supports_wide_gamut=*/supports_wide_gamut,
-            context->GetCapabilities(), context->GetResourceAllocator());
+            context->GetCapabilities(), context->GetResourceAllocator(),
+            concurrent_task_runner);
         if (!bitmap_result.device_buffer) {
           result(nullptr, bitmap_result.decode_error);
           return;
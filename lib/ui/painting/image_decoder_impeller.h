@@ -70,7 +70,9 @@ class ImageDecoderImpeller final : public ImageDecoder {
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
       const std::shared_ptr<const impeller::Capabilities>& capabilities,
-      const std::shared_ptr<impeller::Allocator>& allocator);
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner =
+          nullptr);
 
   /// @brief Create a device private texture from the provided host buffer.
   ///
@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/painting/image_decoder_no_gl_unittests.h"
 #include <memory>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/endianness.h"
 #include "impeller/renderer/capabilities.h"
 #include "include/core/SkColorType.h"
@@ -237,5 +238,58 @@ TEST(ImageDecoderNoGLTest, ImepllerUnmultipliedAlphaPng) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderNoGLTest, ImpellerPixelConversionInParallelMatchesSerial) {
+  // Large enough to be split into several bands of rows.
+  const int width = 512;
+  const int height = 1500;
+  auto info = SkImageInfo::Make(width, height, kRGBA_F32_SkColorType,
+                                kUnpremul_SkAlphaType);
+  SkBitmap bitmap;
+  bitmap.allocPixels(info);
+  for (int y = 0; y < height; ++y) {
+    float* row = static_cast<float*>(bitmap.pixmap().writable_addr(0, y));
+    for (int x = 0; x < width; ++x) {
+      row[x * 4 + 0] = static_cast<float>(x) / width;
+      row[x * 4 + 1] = static_cast<float>(y) / height;
+      row[x * 4 + 2] = 0.5f;
+      row[x * 4 + 3] = static_cast<float>((x + y) % 256) / 255.0f;
+    }
+  }
+  auto data =
+      SkData::MakeWithCopy(bitmap.getPixels(), bitmap.computeByteSize());
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      std::move(data), info, bitmap.rowBytes());
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Capabilities> capabilities =
+      impeller::CapabilitiesBuilder()
+          .SetSupportsTextureToTextureBlits(true)
+          .Build();
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+
+  DecompressResult serial = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(width, height), {width, height},
+      /*supports_wide_gamut=*/false, capabilities, allocator);
+  DecompressResult parallel = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), SkISize::Make(width, height), {width, height},
+      /*supports_wide_gamut=*/false, capabilities, allocator,
+      loop->GetTaskRunner());
+
+  ASSERT_TRUE(serial.sk_bitmap);
+  ASSERT_TRUE(parallel.sk_bitmap);
+  ASSERT_EQ(parallel.image_info, serial.image_info);
+  const SkPixmap& serial_pixmap = serial.sk_bitmap->pixmap();
+  const SkPixmap& parallel_pixmap = parallel.sk_bitmap->pixmap();
+  for (int y = 0; y < height; ++y) {
+    ASSERT_EQ(memcmp(serial_pixmap.addr(0, y), parallel_pixmap.addr(0, y),
+                     serial_pixmap.info().minRowBytes()),
+              0)
+        << "Row " << y;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 }  // namespace testing
 }  // namespace flutter
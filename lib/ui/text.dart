@@ -3009,6 +3009,31 @@ abstract class Paragraph {
   /// The [ParagraphConstraints] control how wide the text is allowed to be.
   void layout(ParagraphConstraints constraints);
 
+  /// Lays out each of the [paragraphs] with the [ParagraphConstraints] at the
+  /// same index of [constraints], as if [layout] had been called on each.
+  ///
+  /// The engine may lay out the paragraphs in parallel, which makes measuring
+  /// many paragraphs at once faster than laying them out one at a time.
+  ///
+  /// Returns the metrics of the paragraphs in order, eight values per
+  /// paragraph: [width], [height], [longestLine], [minIntrinsicWidth],
+  /// [maxIntrinsicWidth], [alphabeticBaseline], [ideographicBaseline], and
+  /// 1.0 if [didExceedMaxLines] is true or 0.0 otherwise.
+  static Float64List layoutAll(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    final Float64List widths = Float64List(paragraphs.length);
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      final _NativeParagraph paragraph = paragraphs[index] as _NativeParagraph;
+      assert(!paragraph.debugDisposed);
+      widths[index] = constraints[index].width;
+      assert(() {
+        paragraph._needsLayout = false;
+        return true;
+      }());
+    }
+    return _NativeParagraph._layoutAll(paragraphs, widths);
+  }
+
   /// Returns a list of text boxes that enclose the given text range.
   ///
   /// The [boxHeightStyle] and [boxWidthStyle] parameters allow customization
@@ -3181,6 +3206,9 @@ base class _NativeParagraph extends NativeFieldWrapperClass1 implements Paragrap
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Paragraph::layout', isLeaf: true)
   external void _layout(double width);
 
+  @Native<Handle Function(Handle, Handle)>(symbol: 'Paragraph::layoutAll')
+  external static Float64List _layoutAll(List<Paragraph> paragraphs, Float64List widths);
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -104,6 +104,7 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
     return nullptr;
   }
 
+  std::scoped_lock lock(typeface_mutex_);
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
     std::unique_ptr<fml::Mapping> asset_mapping =
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -58,6 +59,10 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
     sk_sp<SkTypeface> typeface;
   };
   std::vector<TypefaceAsset> assets_;
+  // Guards the lazy creation of the typefaces in |assets_|. Paragraphs may be
+  // laid out on several threads at once, each through its own font
+  // collection, but all of them share this style set.
+  std::mutex typeface_mutex_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
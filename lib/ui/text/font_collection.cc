@@ -31,12 +31,14 @@
 namespace flutter {
 
 FontCollection::FontCollection()
-    : collection_(std::make_shared<txt::FontCollection>()) {
+    : collection_(std::make_shared<txt::FontCollection>()),
+      paragraph_layout_cache_(std::make_shared<txt::ParagraphLayoutCache>()) {
   dynamic_font_manager_ = sk_make_sp<txt::DynamicFontManager>();
   collection_->SetDynamicFontManager(dynamic_font_manager_);
 }
 
 FontCollection::~FontCollection() {
+  paragraph_layout_cache_->Clear();
   collection_.reset();
   SkGraphics::PurgeFontCache();
 }
@@ -45,6 +47,11 @@ std::shared_ptr<txt::FontCollection> FontCollection::GetFontCollection() const {
   return collection_;
 }
 
+std::shared_ptr<txt::ParagraphLayoutCache>
+FontCollection::GetParagraphLayoutCache() const {
+  return paragraph_layout_cache_;
+}
+
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
   collection_->SetupDefaultFontManager(font_initialization_data);
@@ -11,6 +11,7 @@
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/third_party/txt/src/skia/paragraph_layout_cache.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 #include "txt/font_collection.h"
 
@@ -24,6 +25,10 @@ class FontCollection {
 
   std::shared_ptr<txt::FontCollection> GetFontCollection() const;
 
+  // The cache through which paragraphs built with this collection share
+  // their shaped and laid out text.
+  std::shared_ptr<txt::ParagraphLayoutCache> GetParagraphLayoutCache() const;
+
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
   // Virtual for testing.
@@ -39,6 +44,7 @@ class FontCollection {
  private:
   std::shared_ptr<txt::FontCollection> collection_;
   sk_sp<txt::DynamicFontManager> dynamic_font_manager_;
+  std::shared_ptr<txt::ParagraphLayoutCache> paragraph_layout_cache_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
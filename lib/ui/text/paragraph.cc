@@ -4,10 +4,19 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/text/font_collection.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 #include "third_party/skia/modules/skparagraph/include/DartTypes.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
@@ -19,6 +28,14 @@
 
 namespace flutter {
 
+namespace {
+
+// The most worker tasks that a batch of paragraphs is spread over, in
+// addition to the calling thread.
+constexpr size_t kMaxLayoutWorkerTasks = 4u;
+
+}  // namespace
+
 IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
 
 Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
@@ -62,6 +79,128 @@ void Paragraph::layout(double width) {
   m_paragraph_->Layout(width);
 }
 
+tonic::Float64List Paragraph::layoutAll(Dart_Handle paragraphs_handle,
+                                        const tonic::Float64List& widths) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  intptr_t count = 0;
+  Dart_Handle result = Dart_ListLength(paragraphs_handle, &count);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  count = std::min<intptr_t>(count, widths.num_elements());
+
+  std::vector<Paragraph*> wrappers;
+  std::vector<txt::Paragraph*> paragraphs;
+  std::vector<double> layout_widths;
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_Handle paragraph_handle = Dart_ListGetAt(paragraphs_handle, i);
+    if (Dart_IsError(paragraph_handle)) {
+      Dart_PropagateError(paragraph_handle);
+    }
+    Paragraph* paragraph =
+        tonic::DartConverter<Paragraph*>::FromDart(paragraph_handle);
+    wrappers.push_back(paragraph);
+    // Disposed paragraphs are skipped and report zero for every metric.
+    if (paragraph && paragraph->m_paragraph_) {
+      paragraphs.push_back(paragraph->m_paragraph_.get());
+      layout_widths.push_back(widths[i]);
+    }
+  }
+
+  UIDartState* dart_state = UIDartState::Current();
+  FontCollection& font_collection =
+      dart_state->platform_configuration()->client()->GetFontCollection();
+  LayoutAll(paragraphs, layout_widths, *font_collection.GetFontCollection(),
+            dart_state->GetConcurrentTaskRunner());
+
+  tonic::Float64List metrics(Dart_NewTypedData(
+      Dart_TypedData_kFloat64, count * kLayoutMetricsPerParagraph));
+  size_t position = 0;
+  for (Paragraph* wrapper : wrappers) {
+    if (!wrapper || !wrapper->m_paragraph_) {
+      for (size_t i = 0; i < kLayoutMetricsPerParagraph; i++) {
+        metrics[position++] = 0.0;
+      }
+      continue;
+    }
+    txt::Paragraph& paragraph = *wrapper->m_paragraph_;
+    metrics[position++] = paragraph.GetMaxWidth();
+    metrics[position++] = paragraph.GetHeight();
+    metrics[position++] = paragraph.GetLongestLine();
+    metrics[position++] = paragraph.GetMinIntrinsicWidth();
+    metrics[position++] = paragraph.GetMaxIntrinsicWidth();
+    metrics[position++] = paragraph.GetAlphabeticBaseline();
+    metrics[position++] = paragraph.GetIdeographicBaseline();
+    metrics[position++] = paragraph.DidExceedMaxLines() ? 1.0 : 0.0;
+  }
+  return metrics;
+}
+
+void Paragraph::LayoutAll(
+    const std::vector<txt::Paragraph*>& paragraphs,
+    const std::vector<double>& widths,
+    txt::FontCollection& font_collection,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
+  FML_DCHECK(paragraphs.size() == widths.size());
+  TRACE_EVENT0("flutter", "Paragraph::LayoutAll");
+  size_t count = paragraphs.size();
+  size_t worker_task_count =
+      concurrent_task_runner && count > 1
+          ? std::min(count - 1, kMaxLayoutWorkerTasks)
+          : 0u;
+  if (worker_task_count == 0u) {
+    for (size_t i = 0; i < count; i++) {
+      paragraphs[i]->Layout(widths[i]);
+    }
+    return;
+  }
+
+  // The calling thread lays out paragraphs with the font collection they were
+  // built with. Each worker task resolves fonts through a collection of its
+  // own, as Skia's collections cache fonts without any locking.
+  auto worker_font_collections =
+      font_collection.CreateSktFontCollectionsForThreads(worker_task_count);
+
+  struct State {
+    explicit State(size_t count) : latch(count) {}
+
+    std::atomic<size_t> next_paragraph = 0u;
+    fml::CountDownLatch latch;
+    std::mutex skipped_mutex;
+    std::vector<size_t> skipped;
+  };
+  auto state = std::make_shared<State>(count);
+  // Tasks that start after every paragraph was claimed return without
+  // touching |paragraphs| or |widths|, which only live until this returns.
+  auto make_task = [state, &paragraphs, &widths, count](
+                       sk_sp<skia::textlayout::FontCollection> collection) {
+    return [state, &paragraphs, &widths, count, collection]() {
+      for (size_t i = state->next_paragraph.fetch_add(1); i < count;
+           i = state->next_paragraph.fetch_add(1)) {
+        if (!collection) {
+          paragraphs[i]->Layout(widths[i]);
+        } else if (!paragraphs[i]->LayoutWithFontCollection(widths[i],
+                                                           collection)) {
+          // Only the calling thread may lay out this paragraph.
+          std::scoped_lock lock(state->skipped_mutex);
+          state->skipped.push_back(i);
+        }
+        state->latch.CountDown();
+      }
+    };
+  };
+
+  for (const auto& collection : worker_font_collections) {
+    concurrent_task_runner->PostTask(make_task(collection));
+  }
+  make_task(nullptr)();
+  state->latch.Wait();
+
+  for (size_t i : state->skipped) {
+    paragraphs[i]->Layout(widths[i]);
+  }
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   if (!m_paragraph_ || !canvas) {
     // disposed.
@@ -5,9 +5,14 @@
 #ifndef FLUTTER_LIB_UI_TEXT_PARAGRAPH_H_
 #define FLUTTER_LIB_UI_TEXT_PARAGRAPH_H_
 
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/canvas.h"
+#include "flutter/third_party/txt/src/txt/font_collection.h"
 #include "flutter/third_party/txt/src/txt/paragraph.h"
 
 namespace flutter {
@@ -25,6 +30,26 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
 
   ~Paragraph() override;
 
+  // The number of values per paragraph in the metrics returned by layoutAll.
+  static constexpr size_t kLayoutMetricsPerParagraph = 8u;
+
+  // Lays out each of the paragraphs to the width at the same index, and
+  // returns their metrics in order. See |LayoutAll|.
+  static tonic::Float64List layoutAll(Dart_Handle paragraphs,
+                                      const tonic::Float64List& widths);
+
+  // Lays out each of the paragraphs to the width at the same index, spreading
+  // them over the calling thread and tasks on |concurrent_task_runner|.
+  // Returns once all of the paragraphs have been laid out.
+  //
+  // The paragraphs must have been built with |font_collection|, and neither
+  // may be used elsewhere until this returns.
+  static void LayoutAll(
+      const std::vector<txt::Paragraph*>& paragraphs,
+      const std::vector<double>& widths,
+      txt::FontCollection& font_collection,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner);
+
   double width();
   double height();
   double longestLine();
@@ -301,7 +301,8 @@ ParagraphBuilder::ParagraphBuilder(
 
   auto impeller_enabled = UIDartState::Current()->IsImpellerEnabled();
   m_paragraph_builder_ = txt::ParagraphBuilder::CreateSkiaBuilder(
-      style, font_collection.GetFontCollection(), impeller_enabled);
+      style, font_collection.GetFontCollection(), impeller_enabled,
+      font_collection.GetParagraphLayoutCache());
 }
 
 ParagraphBuilder::~ParagraphBuilder() = default;
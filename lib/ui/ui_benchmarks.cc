@@ -4,11 +4,18 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/lib/ui/text/paragraph.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
+#include "flutter/runtime/test_font_data.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "flutter/third_party/txt/src/skia/paragraph_layout_cache.h"
+#include "flutter/third_party/txt/src/txt/asset_font_manager.h"
+#include "flutter/third_party/txt/src/txt/paragraph_builder.h"
+#include "flutter/third_party/txt/src/txt/typeface_font_asset_provider.h"
 
 #include <future>
 
@@ -69,4 +76,88 @@ static void BM_PlatformMessageResponseDartComplete(benchmark::State& state) {
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+static std::shared_ptr<txt::FontCollection> CreateTestFontCollection() {
+  auto font_collection = std::make_shared<txt::FontCollection>();
+  auto font_provider = std::make_unique<txt::TypefaceFontAssetProvider>();
+  for (auto& font : GetTestFontData()) {
+    font_provider->RegisterTypeface(font);
+  }
+  font_collection->SetAssetFontManager(
+      sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
+  return font_collection;
+}
+
+// Builds |count| paragraphs of distinct text, none of which have a layout in
+// |layout_cache| yet.
+static std::vector<std::unique_ptr<txt::Paragraph>> BuildParagraphs(
+    size_t count,
+    const std::shared_ptr<txt::FontCollection>& font_collection,
+    const std::shared_ptr<txt::ParagraphLayoutCache>& layout_cache) {
+  std::vector<std::unique_ptr<txt::Paragraph>> paragraphs;
+  for (size_t i = 0; i < count; i++) {
+    auto builder = txt::ParagraphBuilder::CreateSkiaBuilder(
+        txt::ParagraphStyle(), font_collection, false, layout_cache);
+    txt::TextStyle style;
+    style.font_families.push_back("Ahem");
+    builder->PushStyle(style);
+    std::string text = std::to_string(i) +
+                       " The quick brown fox jumps over the lazy dog, while "
+                       "the five boxing wizards jump quickly.";
+    builder->AddText(std::u16string(text.begin(), text.end()));
+    builder->Pop();
+    paragraphs.push_back(builder->Build());
+  }
+  return paragraphs;
+}
+
+// Lays out a batch of paragraphs, each with |Layout|, on the calling thread.
+static void BM_ParagraphLayoutSerial(benchmark::State& state) {
+  auto font_collection = CreateTestFontCollection();
+  size_t count = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto layout_cache = std::make_shared<txt::ParagraphLayoutCache>();
+    auto paragraphs = BuildParagraphs(count, font_collection, layout_cache);
+    state.ResumeTiming();
+
+    for (const auto& paragraph : paragraphs) {
+      paragraph->Layout(300);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Lays out the same batch of paragraphs with |Paragraph::LayoutAll|, which
+// spreads them over the calling thread and the concurrent worker pool.
+static void BM_ParagraphLayoutAll(benchmark::State& state) {
+  auto font_collection = CreateTestFontCollection();
+  auto concurrent_loop = fml::ConcurrentMessageLoop::Create();
+  auto concurrent_task_runner = concurrent_loop->GetTaskRunner();
+  size_t count = state.range(0);
+  std::vector<double> widths(count, 300);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto layout_cache = std::make_shared<txt::ParagraphLayoutCache>();
+    auto paragraphs = BuildParagraphs(count, font_collection, layout_cache);
+    std::vector<txt::Paragraph*> raw_paragraphs;
+    for (const auto& paragraph : paragraphs) {
+      raw_paragraphs.push_back(paragraph.get());
+    }
+    state.ResumeTiming();
+
+    Paragraph::LayoutAll(raw_paragraphs, widths, *font_collection,
+                         concurrent_task_runner);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_ParagraphLayoutSerial)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParagraphLayoutAll)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
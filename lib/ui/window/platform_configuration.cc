@@ -304,8 +304,15 @@ void PlatformConfiguration::DispatchPlatformMessage(
     return;
   }
   tonic::DartState::Scope scope(dart_state);
-  Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+  // Data owned by the message is handed to Dart as is. External data may be
+  // read-only and is only ever exposed as unmodifiable.
+  Dart_Handle data_handle = Dart_Null();
+  if (message->hasExternalData()) {
+    data_handle =
+        TransferToUnmodifiableByteData(message->releaseExternalData());
+  } else if (message->hasData()) {
+    data_handle = TransferToByteData(message->releaseData());
+  }
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
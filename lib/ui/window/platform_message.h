@@ -5,9 +5,11 @@
 #ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 #define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
@@ -21,21 +23,40 @@ class PlatformMessage {
                   fml::RefPtr<PlatformMessageResponse> response);
   PlatformMessage(std::string channel,
                   fml::RefPtr<PlatformMessageResponse> response);
+  /// Creates a message that holds |external_data| without copying it, e.g. a
+  /// buffer that an embedder frees once the message is done with it.
+  PlatformMessage(std::string channel,
+                  std::unique_ptr<fml::Mapping> external_data,
+                  fml::RefPtr<PlatformMessageResponse> response);
   ~PlatformMessage();
 
   const std::string& channel() const { return channel_; }
+  /// The data of the message. Empty if the message holds external data; use
+  /// |mapping| to read the data of either kind of message.
   const fml::MallocMapping& data() const { return data_; }
   bool hasData() { return has_data_; }
 
+  /// The data of the message, whether it is external or not.
+  const fml::Mapping& mapping() const;
+
   const fml::RefPtr<PlatformMessageResponse>& response() const {
     return response_;
   }
 
   fml::MallocMapping releaseData() { return std::move(data_); }
 
+  /// Whether the message holds external data, which may be read-only.
+  bool hasExternalData() const { return external_data_ != nullptr; }
+
+  /// Removes the external data of the message without copying it.
+  std::unique_ptr<fml::Mapping> releaseExternalData() {
+    return std::move(external_data_);
+  }
+
  private:
   std::string channel_;
   fml::MallocMapping data_;
+  std::unique_ptr<fml::Mapping> external_data_;
   bool has_data_;
   fml::RefPtr<PlatformMessageResponse> response_;
 };
@@ -5,12 +5,32 @@
 #ifndef FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RESPONSE_DART_H_
 #define FLUTTER_LIB_UI_WINDOW_PLATFORM_MESSAGE_RESPONSE_DART_H_
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/lib/ui/window/platform_message_response.h"
 #include "third_party/tonic/dart_persistent_value.h"
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Hands |data| to Dart as a modifiable `ByteData`.
+///
+///             Buffers above the external size threshold of
+///             |tonic::DartByteData| are not copied. They are freed once the
+///             `ByteData` is collected.
+///
+Dart_Handle TransferToByteData(fml::MallocMapping data);
+
+//------------------------------------------------------------------------------
+/// @brief      Hands |data| to Dart as an unmodifiable `ByteData`.
+///
+///             Buffers above the external size threshold of
+///             |tonic::DartByteData| are not copied. They are released once
+///             the `ByteData` is collected. Smaller buffers are copied and
+///             wrapped so that the result is unmodifiable whatever its size.
+///
+Dart_Handle TransferToUnmodifiableByteData(std::unique_ptr<fml::Mapping> data);
+
 class PlatformMessageResponseDart : public PlatformMessageResponse {
   FML_FRIEND_MAKE_REF_COUNTED(PlatformMessageResponseDart);
 
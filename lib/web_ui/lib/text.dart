@@ -717,6 +717,25 @@ abstract class Paragraph {
   double get ideographicBaseline;
   bool get didExceedMaxLines;
   void layout(ParagraphConstraints constraints);
+  static Float64List layoutAll(
+      List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    final Float64List metrics = Float64List(paragraphs.length * 8);
+    int position = 0;
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      final Paragraph paragraph = paragraphs[index];
+      paragraph.layout(constraints[index]);
+      metrics[position++] = paragraph.width;
+      metrics[position++] = paragraph.height;
+      metrics[position++] = paragraph.longestLine;
+      metrics[position++] = paragraph.minIntrinsicWidth;
+      metrics[position++] = paragraph.maxIntrinsicWidth;
+      metrics[position++] = paragraph.alphabeticBaseline;
+      metrics[position++] = paragraph.ideographicBaseline;
+      metrics[position++] = paragraph.didExceedMaxLines ? 1.0 : 0.0;
+    }
+    return metrics;
+  }
   List<TextBox> getBoxesForRange(int start, int end,
       {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight,
       BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight});
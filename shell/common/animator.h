@@ -45,9 +45,12 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  /// |pipeline_depth| is the number of frames that may be built ahead of
+  /// the rasterizer. See |Settings::frame_pipeline_depth|.
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           uint32_t pipeline_depth = 2);
 
   ~Animator();
 
@@ -5,6 +5,10 @@
 #include "flutter/shell/common/shell.h"
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/lib/ui/window/platform_configuration.h"
+#include "flutter/lib/ui/window/platform_message.h"
+#include "flutter/runtime/platform_isolate_manager.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_fixture.h"
 #include "flutter/testing/dart_isolate_runner.h"
@@ -25,10 +29,151 @@ class DartNativeBenchmarks : public DartFixture, public benchmark::Fixture {
 
   void TearDown(const ::benchmark::State& state) {}
 
+ protected:
+  void SendPlatformMessages(benchmark::State& st, bool copy);
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(DartNativeBenchmarks);
 };
 
+namespace {
+
+class BenchmarkPlatformConfigurationClient
+    : public PlatformConfigurationClient {
+ public:
+  std::shared_ptr<PlatformIsolateManager> mgr =
+      std::make_shared<PlatformIsolateManager>();
+  std::shared_ptr<PlatformIsolateManager> GetPlatformIsolateManager() override {
+    return mgr;
+  }
+
+  std::string DefaultRouteName() override { return ""; }
+  void ScheduleFrame() override {}
+  void EndWarmUpFrame() override {}
+  void Render(int64_t view_id,
+              Scene* scene,
+              double width,
+              double height) override {}
+  void UpdateSemantics(SemanticsUpdate* update) override {}
+  void HandlePlatformMessage(
+      std::unique_ptr<PlatformMessage> message) override {}
+  FontCollection& GetFontCollection() override {
+    FML_UNREACHABLE();
+    return *(FontCollection*)(this);
+  }
+  std::shared_ptr<AssetManager> GetAssetManager() override { return nullptr; }
+  void UpdateIsolateDescription(const std::string isolate_name,
+                                int64_t isolate_port) override {}
+  void SetNeedsReportTimings(bool value) override {}
+  std::shared_ptr<const fml::Mapping> GetPersistentIsolateData() override {
+    return nullptr;
+  }
+  std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
+      const std::vector<std::string>& supported_locale_data) override {
+    return nullptr;
+  }
+  void RequestDartDeferredLibrary(intptr_t loading_unit_id) override {}
+  void SendChannelUpdate(std::string name, bool listening) override {}
+  double GetScaledFontSize(double unscaled_font_size,
+                           int configuration_id) const override {
+    return 0;
+  }
+};
+
+}  // namespace
+
+// Sends platform messages of |st.range(0)| bytes from the platform thread to
+// a Dart handler, and waits for each one to be received. If |copy| is true,
+// the data is copied into the message like `FlutterEngineSendPlatformMessage`
+// does. Otherwise, the message wraps the data of the sender like
+// `FlutterEngineSendPlatformMessageNoCopy` does.
+void DartNativeBenchmarks::SendPlatformMessages(benchmark::State& st,
+                                                bool copy) {
+  const size_t message_size = st.range(0);
+  std::vector<uint8_t> message_data(message_size, 0xAB);
+
+  fml::AutoResetWaitableEvent ready_latch;
+  fml::AutoResetWaitableEvent message_latch;
+  AddNativeCallback("NotifyNative",
+                    CREATE_NATIVE_ENTRY(([&ready_latch](Dart_NativeArguments) {
+                      ready_latch.Signal();
+                    })));
+  AddNativeCallback(
+      "NotifyMessageReceived",
+      CREATE_NATIVE_ENTRY(([&message_latch](Dart_NativeArguments) {
+        message_latch.Signal();
+      })));
+
+  const auto settings = CreateSettingsForFixture();
+  DartVMRef vm_ref = DartVMRef::Create(settings);
+
+  ThreadHost thread_host("io.flutter.test.DartNativeBenchmarks.",
+                         ThreadHost::Type::kPlatform | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners(
+      "test",
+      thread_host.platform_thread->GetTaskRunner(),  // platform
+      thread_host.platform_thread->GetTaskRunner(),  // raster
+      thread_host.ui_thread->GetTaskRunner(),        // ui
+      thread_host.io_thread->GetTaskRunner()         // io
+  );
+
+  BenchmarkPlatformConfigurationClient client;
+  auto platform_configuration =
+      std::make_unique<PlatformConfiguration>(&client);
+  PlatformConfiguration* configuration = platform_configuration.get();
+  auto isolate = RunDartCodeInIsolate(
+      vm_ref, settings, task_runners, "receivePlatformMessages", {},
+      GetDefaultKernelFilePath(), {}, std::move(platform_configuration));
+  FML_CHECK(isolate);
+  ready_latch.Wait();
+
+  for (auto _ : st) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners.GetPlatformTaskRunner(), [&]() {
+          std::unique_ptr<PlatformMessage> message;
+          if (copy) {
+            message = std::make_unique<PlatformMessage>(
+                "benchmark",
+                fml::MallocMapping::Copy(message_data.data(), message_size),
+                nullptr);
+          } else {
+            message = std::make_unique<PlatformMessage>(
+                "benchmark",
+                std::make_unique<fml::NonOwnedMapping>(message_data.data(),
+                                                       message_size),
+                nullptr);
+          }
+          task_runners.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+              [configuration, message = std::move(message)]() mutable {
+                configuration->DispatchPlatformMessage(std::move(message));
+              }));
+        });
+    message_latch.Wait();
+  }
+  st.SetBytesProcessed(st.iterations() * message_size);
+}
+
+BENCHMARK_DEFINE_F(DartNativeBenchmarks, PlatformMessagesCopied)
+(benchmark::State& st) {
+  SendPlatformMessages(st, /*copy=*/true);
+}
+
+BENCHMARK_DEFINE_F(DartNativeBenchmarks, PlatformMessagesNotCopied)
+(benchmark::State& st) {
+  SendPlatformMessages(st, /*copy=*/false);
+}
+
+BENCHMARK_REGISTER_F(DartNativeBenchmarks, PlatformMessagesCopied)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(DartNativeBenchmarks, PlatformMessagesNotCopied)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 16 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_F(DartNativeBenchmarks, TimeToFirstNativeMessageFromIsolateInNewVM)
 (benchmark::State& st) {
   while (st.KeepRunning()) {
@@ -347,7 +347,7 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
 }
 
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
   std::string state(reinterpret_cast<const char*>(data.GetMapping()),
                     data.GetSize());
 
@@ -365,7 +365,7 @@ bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
 
 bool Engine::HandleNavigationPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
 
   rapidjson::Document document;
   document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
@@ -384,7 +384,7 @@ bool Engine::HandleNavigationPlatformMessage(
 }
 
 bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
 
   rapidjson::Document document;
   document.Parse(reinterpret_cast<const char*>(data.GetMapping()),
@@ -427,7 +427,7 @@ bool Engine::HandleLocalizationPlatformMessage(PlatformMessage* message) {
 }
 
 void Engine::HandleSettingsPlatformMessage(PlatformMessage* message) {
-  const auto& data = message->data();
+  const auto& data = message->mapping();
   std::string jsonData(reinterpret_cast<const char*>(data.GetMapping()),
                        data.GetSize());
   if (runtime_controller_->SetUserSettingsData(jsonData)) {
@@ -445,6 +445,10 @@ void Engine::DispatchPointerDataPacket(
   pointer_data_dispatcher_->DispatchPacket(std::move(packet), trace_flow_id);
 }
 
+std::vector<PointerData> Engine::GetRawPointerHistory(int64_t device) const {
+  return pointer_data_dispatcher_->GetRawHistory(device);
+}
+
 void Engine::DispatchSemanticsAction(int node_id,
                                      SemanticsAction action,
                                      fml::MallocMapping args) {
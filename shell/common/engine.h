@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
@@ -798,6 +799,19 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   void DispatchPointerDataPacket(std::unique_ptr<PointerDataPacket> packet,
                                  uint64_t trace_flow_id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The most recent raw pointer events of |device|, oldest first,
+  ///             before the pointer data dispatcher coalesced or resampled
+  ///             them. Clients that need every sample, e.g. for handwriting,
+  ///             read them here.
+  ///
+  /// @param[in]  device  The device of the pointer events.
+  ///
+  /// @return     The raw events, or an empty list if the dispatcher forwards
+  ///             every event unmodified.
+  ///
+  std::vector<PointerData> GetRawPointerHistory(int64_t device) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder encountered an
   ///             accessibility related action on the specified node. This call
@@ -153,6 +153,18 @@ void thousandCallsToNative() {
   }
 }
 
+@pragma('vm:external-name', 'NotifyMessageReceived')
+external void notifyMessageReceived(int lengthInBytes);
+
+@pragma('vm:entry-point')
+void receivePlatformMessages() {
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    notifyMessageReceived(data!.lengthInBytes);
+  };
+  notifyNative();
+}
+
 void secondaryIsolateMain(String message) {
   print('Secondary isolate got message: $message');
   notifyNative();
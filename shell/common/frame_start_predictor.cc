@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+FrameStartPredictor::FrameStartPredictor() = default;
+
+FrameStartPredictor::~FrameStartPredictor() = default;
+
+void FrameStartPredictor::AddFrame(const FrameTiming& timing) {
+  AddFrameDuration(timing.Get(FrameTiming::kRasterFinish) -
+                   timing.Get(FrameTiming::kBuildStart));
+}
+
+void FrameStartPredictor::AddFrameDuration(fml::TimeDelta duration) {
+  std::scoped_lock lock(mutex_);
+  durations_[next_duration_index_] = duration;
+  next_duration_index_ = (next_duration_index_ + 1) % kHistorySize;
+  duration_count_ = std::min(duration_count_ + 1, kHistorySize);
+}
+
+std::optional<fml::TimeDelta> FrameStartPredictor::PredictFrameDuration()
+    const {
+  std::array<fml::TimeDelta, kHistorySize> durations;
+  size_t count = 0;
+  {
+    std::scoped_lock lock(mutex_);
+    count = duration_count_;
+    std::copy_n(durations_.begin(), count, durations.begin());
+  }
+  if (count < kMinHistorySize) {
+    return std::nullopt;
+  }
+
+  size_t index = static_cast<size_t>(
+      std::ceil(kPercentile / 100.0 * static_cast<double>(count)) - 1);
+  auto nth = durations.begin() + index;
+  std::nth_element(durations.begin(), nth, durations.begin() + count);
+  return *nth;
+}
+
+fml::TimeDelta FrameStartPredictor::GetFrameStartOffset(
+    fml::TimeDelta frame_interval) const {
+  std::optional<fml::TimeDelta> frame_duration = PredictFrameDuration();
+  if (!frame_duration || frame_interval <= fml::TimeDelta::Zero()) {
+    return fml::TimeDelta::Zero();
+  }
+  const fml::TimeDelta max_offset = frame_interval / 2;
+  return std::clamp(frame_interval - *frame_duration - kMargin,
+                    fml::TimeDelta::Zero() - max_offset, max_offset);
+}
+
+}  // namespace flutter
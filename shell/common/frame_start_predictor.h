@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
+
+#include <array>
+#include <mutex>
+#include <optional>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Predicts how long the next frame will take from the start of
+///             its build to the end of its rasterization, and how far from
+///             the vsync to start it so that it is rasterized just before its
+///             target time.
+///
+///             Starting a frame after the vsync lets it sample more recent
+///             input, which shortens the input to photon latency when frames
+///             are cheap. Starting it before the vsync gives an expensive
+///             frame a chance to meet its target. Only vsync waiters that know
+///             the time of the vsync ahead of it can start frames early.
+///
+///             The prediction is a high percentile of the durations of recent
+///             frames, so occasional slow frames make it conservative for a
+///             while rather than being missed.
+///
+///             This class is thread safe.
+///
+class FrameStartPredictor {
+ public:
+  /// The number of recent frames that predictions are made from.
+  static constexpr size_t kHistorySize = 32u;
+
+  /// No offset is predicted until this many frames have been recorded.
+  static constexpr size_t kMinHistorySize = 8u;
+
+  /// The percentile of the recent frame durations that is predicted.
+  static constexpr double kPercentile = 90.0;
+
+  /// The time left between the end of the predicted rasterization and the
+  /// target time, to absorb the cost of posting tasks between threads.
+  static constexpr fml::TimeDelta kMargin =
+      fml::TimeDelta::FromMicroseconds(1500);
+
+  FrameStartPredictor();
+
+  ~FrameStartPredictor();
+
+  /// Records the duration from the build start to the raster finish of a
+  /// rasterized frame.
+  void AddFrame(const FrameTiming& timing);
+
+  void AddFrameDuration(fml::TimeDelta duration);
+
+  /// The predicted duration of the next frame, or nullopt if too few frames
+  /// have been recorded.
+  std::optional<fml::TimeDelta> PredictFrameDuration() const;
+
+  /// The offset from the vsync at which to start the next frame, so that it
+  /// finishes |kMargin| before the following vsync. It is negative when the
+  /// frame is predicted not to fit in |frame_interval|, and is clamped to half
+  /// of |frame_interval| either way.
+  fml::TimeDelta GetFrameStartOffset(fml::TimeDelta frame_interval) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::array<fml::TimeDelta, kHistorySize> durations_;
+  size_t duration_count_ = 0;
+  size_t next_duration_index_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameStartPredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_START_PREDICTOR_H_
@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include <algorithm>
+#include <random>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/common/vsync_waiter_fallback.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr size_t kFrameCount = 1200;
+
+fml::TimeDelta RandomCost(std::mt19937& random,
+                          double mean_millis,
+                          double stddev_millis) {
+  std::normal_distribution<double> distribution(mean_millis, stddev_millis);
+  return fml::TimeDelta::FromMillisecondsF(
+      std::max(distribution(random), 0.5));
+}
+
+}  // namespace
+
+// Simulates rendering frames on the vsync schedule of
+// |VsyncWaiterFallback|, in simulated time so that the results are
+// deterministic.
+//
+// Input is sampled when the build of a frame starts, and the frame is
+// presented at the first vsync after it is rasterized. A frame is missed if
+// that is after its target time. Half way through, the frames become
+// expensive enough that they only fit in the interval if started early.
+static void BM_FrameStartPrediction(benchmark::State& state) {
+  const bool predict = state.range(0) != 0;
+  const fml::TimeDelta interval = VsyncWaiterFallback::kSingleFrameInterval;
+  const fml::TimePoint phase = fml::TimePoint();
+
+  fml::TimeDelta total_latency;
+  size_t missed_frames = 0;
+  for (auto _ : state) {
+    std::mt19937 random(0);
+    FrameStartPredictor predictor;
+    fml::TimePoint ui_idle = phase;
+    fml::TimePoint raster_idle = phase;
+    fml::TimePoint previous_raster_start = phase;
+    total_latency = fml::TimeDelta::Zero();
+    missed_frames = 0;
+
+    for (size_t i = 0; i < kFrameCount; i++) {
+      const bool expensive = i >= kFrameCount / 2;
+      const fml::TimeDelta build_cost =
+          RandomCost(random, expensive ? 5.0 : 3.0, 1.0);
+      const fml::TimeDelta raster_cost =
+          RandomCost(random, expensive ? 9.0 : 4.0, 1.5);
+
+      // The animator requests the next frame once the previous one has been
+      // built and the pipeline has room for it.
+      const fml::TimePoint request_time =
+          std::max(ui_idle, previous_raster_start);
+      const fml::TimePoint vsync = VsyncWaiterFallback::SnapToNextTick(
+          request_time, phase, interval);
+      const fml::TimePoint target_time = vsync + interval;
+      fml::TimePoint build_start = vsync;
+      if (predict) {
+        const fml::TimeDelta offset = predictor.GetFrameStartOffset(interval);
+        build_start = std::max(vsync + offset, request_time);
+      }
+
+      const fml::TimePoint build_finish = build_start + build_cost;
+      const fml::TimePoint raster_start = std::max(build_finish, raster_idle);
+      const fml::TimePoint raster_finish = raster_start + raster_cost;
+      const fml::TimePoint present_time = VsyncWaiterFallback::SnapToNextTick(
+          raster_finish, phase, interval);
+
+      predictor.AddFrameDuration(raster_finish - build_start);
+      total_latency = total_latency + (present_time - build_start);
+      if (present_time > target_time) {
+        missed_frames++;
+      }
+
+      ui_idle = build_finish;
+      raster_idle = raster_finish;
+      previous_raster_start = raster_start;
+    }
+  }
+
+  state.counters["latency_ms"] =
+      total_latency.ToMillisecondsF() / static_cast<double>(kFrameCount);
+  state.counters["missed_rate"] =
+      static_cast<double>(missed_frames) / static_cast<double>(kFrameCount);
+}
+
+BENCHMARK(BM_FrameStartPrediction)
+    ->ArgName("predict")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
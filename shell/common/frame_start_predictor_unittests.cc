@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_start_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameInterval =
+    fml::TimeDelta::FromMicroseconds(16667);
+
+fml::TimeDelta Micros(int64_t micros) {
+  return fml::TimeDelta::FromMicroseconds(micros);
+}
+
+void AddFrames(FrameStartPredictor& predictor,
+               size_t count,
+               fml::TimeDelta duration) {
+  for (size_t i = 0; i < count; i++) {
+    predictor.AddFrameDuration(duration);
+  }
+}
+
+}  // namespace
+
+TEST(FrameStartPredictorTest, NoOffsetUntilEnoughFrames) {
+  FrameStartPredictor predictor;
+  AddFrames(predictor, FrameStartPredictor::kMinHistorySize - 1, Micros(2000));
+  EXPECT_FALSE(predictor.PredictFrameDuration().has_value());
+  EXPECT_EQ(predictor.GetFrameStartOffset(kFrameInterval),
+            fml::TimeDelta::Zero());
+
+  AddFrames(predictor, 1, Micros(2000));
+  EXPECT_EQ(predictor.PredictFrameDuration(), Micros(2000));
+  EXPECT_GT(predictor.GetFrameStartOffset(kFrameInterval),
+            fml::TimeDelta::Zero());
+}
+
+TEST(FrameStartPredictorTest, RecordsBuildStartToRasterFinish) {
+  FrameStartPredictor predictor;
+  fml::TimePoint vsync =
+      fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromSeconds(100));
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  timing.Set(FrameTiming::kBuildStart, vsync + Micros(1000));
+  timing.Set(FrameTiming::kBuildFinish, vsync + Micros(4000));
+  timing.Set(FrameTiming::kRasterStart, vsync + Micros(5000));
+  timing.Set(FrameTiming::kRasterFinish, vsync + Micros(9000));
+  for (size_t i = 0; i < FrameStartPredictor::kMinHistorySize; i++) {
+    predictor.AddFrame(timing);
+  }
+  EXPECT_EQ(predictor.PredictFrameDuration(), Micros(8000));
+}
+
+TEST(FrameStartPredictorTest, StartsCheapFramesLate) {
+  FrameStartPredictor predictor;
+  AddFrames(predictor, FrameStartPredictor::kHistorySize, Micros(10000));
+  EXPECT_EQ(predictor.GetFrameStartOffset(kFrameInterval),
+            kFrameInterval - Micros(10000) - FrameStartPredictor::kMargin);
+
+  // Frames never start more than half an interval late.
+  AddFrames(predictor, FrameStartPredictor::kHistorySize, Micros(1000));
+  EXPECT_EQ(predictor.GetFrameStartOffset(kFrameInterval), kFrameInterval / 2);
+}
+
+TEST(FrameStartPredictorTest, StartsExpensiveFramesEarly) {
+  FrameStartPredictor predictor;
+  AddFrames(predictor, FrameStartPredictor::kHistorySize, Micros(20000));
+  EXPECT_EQ(predictor.GetFrameStartOffset(kFrameInterval),
+            kFrameInterval - Micros(20000) - FrameStartPredictor::kMargin);
+
+  // Frames never start more than half an interval early.
+  AddFrames(predictor, FrameStartPredictor::kHistorySize, Micros(40000));
+  EXPECT_EQ(predictor.GetFrameStartOffset(kFrameInterval),
+            fml::TimeDelta::Zero() - kFrameInterval / 2);
+}
+
+TEST(FrameStartPredictorTest, PredictsHighPercentileOfRecentFrames) {
+  FrameStartPredictor predictor;
+  // A single slow frame in the history is ignored.
+  AddFrames(predictor, FrameStartPredictor::kHistorySize - 1, Micros(5000));
+  AddFrames(predictor, 1, Micros(30000));
+  EXPECT_EQ(predictor.PredictFrameDuration(), Micros(5000));
+
+  // More than a tenth of slow frames are not.
+  AddFrames(predictor, 3, Micros(12000));
+  EXPECT_EQ(predictor.PredictFrameDuration(), Micros(12000));
+
+  // The slow frames are forgotten once the history has been overwritten.
+  AddFrames(predictor, FrameStartPredictor::kHistorySize, Micros(5000));
+  EXPECT_EQ(predictor.PredictFrameDuration(), Micros(5000));
+}
+
+TEST(FrameStartPredictorTest, NoOffsetWithoutFrameInterval) {
+  FrameStartPredictor predictor;
+  AddFrames(predictor, FrameStartPredictor::kHistorySize, Micros(5000));
+  EXPECT_EQ(predictor.GetFrameStartOffset(fml::TimeDelta::Zero()),
+            fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
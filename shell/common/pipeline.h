@@ -8,6 +8,7 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
@@ -42,7 +43,9 @@ size_t GetNextPipelineTraceID();
 /// Pipelines support two key operations: produce and consume.
 ///
 /// The consumer calls |Consume| to wait for a resource to be produced and
-/// consume it when ready.
+/// consume it when ready. A consumer that only cares about the newest resource
+/// calls |ConsumeLatest| instead, which skips the stale resources queued
+/// before it.
 ///
 /// The producer calls |Produce| to generate a `ProducerContinuation` which
 /// provides a means to enqueue a resource in the pipeline, if the pipeline is
@@ -57,6 +60,8 @@ size_t GetNextPipelineTraceID();
 ///   calls |Produce| to the time they complete the `ProducerContinuation` with
 ///   a resource.
 /// * Pipeline Depth: counter of inflight resource producers.
+/// * PipelineItemSkipped: instant marking a resource skipped by
+///   |ConsumeLatest|.
 ///
 /// The primary use of this class is as the frame pipeline used in Flutter's
 /// animator/rasterizer.
@@ -179,8 +184,39 @@ class Pipeline {
 
   using Consumer = std::function<void(ResourcePtr)>;
 
+  /// Decides whether the |stale| resource may be skipped because the |newer|
+  /// resource queued after it supersedes it. It may move the parts of |stale|
+  /// that |newer| lacks into |newer| before allowing the skip.
+  using Superseder = std::function<bool(Resource& stale, Resource& newer)>;
+
   /// @note Procedure doesn't copy all closures.
   [[nodiscard]] PipelineConsumeResult Consume(const Consumer& consumer) {
+    return ConsumeAfterSkipping(consumer, nullptr);
+  }
+
+  /// Consumes the newest available resource, skipping the stale resources
+  /// queued before it for as long as |superseder| allows it.
+  ///
+  /// @note Procedure doesn't copy all closures.
+  [[nodiscard]] PipelineConsumeResult ConsumeLatest(
+      const Consumer& consumer,
+      const Superseder& superseder) {
+    return ConsumeAfterSkipping(consumer, superseder);
+  }
+
+  /// The number of resources skipped by |ConsumeLatest| so far.
+  size_t GetSkippedCount() const { return skipped_count_.load(); }
+
+ private:
+  fml::Semaphore empty_;
+  fml::Semaphore available_;
+  std::atomic<int> inflight_;
+  std::atomic<size_t> skipped_count_ = 0;
+  std::mutex queue_mutex_;
+  std::deque<std::pair<ResourcePtr, size_t>> queue_;
+
+  PipelineConsumeResult ConsumeAfterSkipping(const Consumer& consumer,
+                                             const Superseder& superseder) {
     if (consumer == nullptr) {
       return PipelineConsumeResult::NoneAvailable;
     }
@@ -192,14 +228,37 @@ class Pipeline {
     ResourcePtr resource;
     size_t trace_id = 0;
     size_t items_count = 0;
+    std::vector<std::pair<ResourcePtr, size_t>> skipped;
 
     {
       std::scoped_lock lock(queue_mutex_);
+      // A producer signals |available_| after queueing its resource, so a
+      // resource may only be skipped once its signal has been taken too.
+      while (superseder && queue_.size() > 1 && available_.TryWait()) {
+        ResourcePtr& stale = queue_[0].first;
+        ResourcePtr& newer = queue_[1].first;
+        if (!stale || !newer || !superseder(*stale, *newer)) {
+          available_.Signal();
+          break;
+        }
+        skipped.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
       std::tie(resource, trace_id) = std::move(queue_.front());
       queue_.pop_front();
       items_count = queue_.size();
     }
 
+    for (const auto& [skipped_resource, skipped_trace_id] : skipped) {
+      TRACE_EVENT_INSTANT0("flutter", "PipelineItemSkipped");
+      TRACE_FLOW_END("flutter", "PipelineItem", skipped_trace_id);
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", skipped_trace_id);
+      empty_.Signal();
+      --inflight_;
+    }
+    skipped_count_ += skipped.size();
+    skipped.clear();
+
     consumer(std::move(resource));
 
     empty_.Signal();
@@ -212,13 +271,6 @@ class Pipeline {
                            : PipelineConsumeResult::Done;
   }
 
- private:
-  fml::Semaphore empty_;
-  fml::Semaphore available_;
-  std::atomic<int> inflight_;
-  std::mutex queue_mutex_;
-  std::deque<std::pair<ResourcePtr, size_t>> queue_;
-
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
   PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
@@ -6,9 +6,13 @@
 
 #include "flutter/shell/common/pipeline.h"
 
+#include <algorithm>
 #include <functional>
 #include <future>
+#include <limits>
 #include <memory>
+#include <random>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -144,5 +148,194 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ConsumeLatestSkipsStaleItems) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  for (int i = 1; i <= depth; i++) {
+    Continuation continuation = pipeline->Produce();
+    ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)).success);
+  }
+  ASSERT_FALSE(pipeline->Produce());
+
+  std::vector<int> superseded;
+  PipelineConsumeResult consume_result = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 3); },
+      [&superseded](int& stale, int& newer) {
+        superseded.push_back(stale);
+        return true;
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  EXPECT_EQ(superseded, std::vector<int>({1, 2}));
+  EXPECT_EQ(pipeline->GetSkippedCount(), 2u);
+
+  // The slots of the skipped items are free again.
+  for (int i = 0; i < depth; i++) {
+    EXPECT_TRUE(pipeline->Produce());
+  }
+}
+
+TEST(PipelineTest, ConsumeLatestKeepsItemsTheSupersederRefuses) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  for (int i = 1; i <= depth; i++) {
+    Continuation continuation = pipeline->Produce();
+    ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)).success);
+  }
+
+  // Only the first item can be skipped.
+  auto superseder = [](int& stale, int& newer) { return stale == 1; };
+  PipelineConsumeResult consume_result = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 2); }, superseder);
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  consume_result = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 3); }, superseder);
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  EXPECT_EQ(pipeline->GetSkippedCount(), 1u);
+  ASSERT_EQ(pipeline->ConsumeLatest([](std::unique_ptr<int> v) { FAIL(); },
+                                    superseder),
+            PipelineConsumeResult::NoneAvailable);
+}
+
+TEST(PipelineTest, ConsumeLatestCanMergeIntoTheNewerItem) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
+
+  for (int i = 1; i <= 2; i++) {
+    Continuation continuation = pipeline->Produce();
+    ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i * 10)).success);
+  }
+
+  PipelineConsumeResult consume_result = pipeline->ConsumeLatest(
+      [](std::unique_ptr<int> v) { ASSERT_EQ(*v, 30); },
+      [](int& stale, int& newer) {
+        newer += stale;
+        return true;
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+}
+
+namespace {
+
+// The outcome of rendering frames at 120 Hz through a pipeline.
+struct PipelineSimulation {
+  int produced_count = 0;
+  int presented_count = 0;
+  int skipped_count = 0;
+  int pipeline_full_count = 0;
+  // From the end of the build of a frame to the start of its rasterization.
+  std::vector<int64_t> queue_latencies;
+  // From the vsync of a frame to the end of its rasterization.
+  std::vector<int64_t> present_latencies;
+
+  static int64_t Percentile(std::vector<int64_t> latencies, double percentile) {
+    if (latencies.empty()) {
+      return 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    size_t index = static_cast<size_t>(percentile / 100.0 *
+                                       (latencies.size() - 1));
+    return latencies[index];
+  }
+};
+
+// Simulates |frame_count| frames with a 120 Hz vsync, a constant build cost
+// and a raster cost that usually fits in a frame but sometimes takes several.
+//
+// Time is simulated, so the outcome is deterministic. The rasterizer takes a
+// frame out of the pipeline when it starts rasterizing it, so |depth| counts
+// the frames that are being built or are waiting for the rasterizer.
+PipelineSimulation SimulatePipeline(int depth,
+                                    bool consume_latest,
+                                    int frame_count) {
+  constexpr int64_t kVsyncMicros = 8333;
+  constexpr int64_t kBuildMicros = 3000;
+
+  std::mt19937 random(1234);
+  auto raster_micros = [&random]() -> int64_t {
+    // One frame in ten takes two to four vsync intervals to rasterize.
+    if (random() % 10 == 0) {
+      return 16000 + random() % 16000;
+    }
+    return 3000 + random() % 4000;
+  };
+
+  IntPipeline pipeline(depth);
+  PipelineSimulation simulation;
+  std::vector<int64_t> build_end_times(frame_count);
+  int64_t raster_free_time = 0;
+
+  // Rasterizes the queued frames that the rasterizer starts before |time|.
+  auto rasterize_until = [&](int64_t time) {
+    while (raster_free_time <= time) {
+      int64_t frame = -1;
+      auto consumer = [&frame](std::unique_ptr<int> v) { frame = *v; };
+      PipelineConsumeResult result =
+          consume_latest
+              ? pipeline.ConsumeLatest(
+                    consumer, [](int& stale, int& newer) { return true; })
+              : pipeline.Consume(consumer);
+      if (result == PipelineConsumeResult::NoneAvailable) {
+        return;
+      }
+      int64_t raster_start =
+          std::max(raster_free_time, build_end_times[frame]);
+      raster_free_time = raster_start + raster_micros();
+      simulation.queue_latencies.push_back(raster_start -
+                                           build_end_times[frame]);
+      simulation.present_latencies.push_back(raster_free_time -
+                                             frame * kVsyncMicros);
+      simulation.presented_count++;
+    }
+  };
+
+  for (int frame = 0; frame < frame_count; frame++) {
+    const int64_t vsync_time = frame * kVsyncMicros;
+    rasterize_until(vsync_time);
+    Continuation continuation = pipeline.Produce();
+    if (!continuation) {
+      simulation.pipeline_full_count++;
+      continue;
+    }
+    build_end_times[frame] = vsync_time + kBuildMicros;
+    rasterize_until(build_end_times[frame]);
+    EXPECT_TRUE(continuation.Complete(std::make_unique<int>(frame)).success);
+    simulation.produced_count++;
+  }
+  rasterize_until(std::numeric_limits<int64_t>::max());
+
+  simulation.skipped_count = pipeline.GetSkippedCount();
+  return simulation;
+}
+
+}  // namespace
+
+TEST(PipelineTest, SimulatedHighRefreshRateWithJitteryRaster) {
+  constexpr int kFrameCount = 1200;
+  PipelineSimulation fifo = SimulatePipeline(2, false, kFrameCount);
+  PipelineSimulation deep_fifo = SimulatePipeline(3, false, kFrameCount);
+  PipelineSimulation latest = SimulatePipeline(3, true, kFrameCount);
+
+  for (const PipelineSimulation* simulation : {&fifo, &deep_fifo, &latest}) {
+    EXPECT_EQ(simulation->presented_count + simulation->skipped_count,
+              simulation->produced_count);
+    EXPECT_EQ(simulation->pipeline_full_count + simulation->produced_count,
+              kFrameCount);
+  }
+  EXPECT_EQ(fifo.skipped_count, 0);
+  EXPECT_EQ(deep_fifo.skipped_count, 0);
+  EXPECT_GT(latest.skipped_count, 0);
+
+  // A deeper pipeline lets the UI thread keep building during raster spikes.
+  EXPECT_LT(deep_fifo.pipeline_full_count, fifo.pipeline_full_count);
+  // Skipping stale frames lets it do so without making every later frame
+  // wait behind the backlog.
+  EXPECT_LE(latest.pipeline_full_count, deep_fifo.pipeline_full_count);
+  EXPECT_LT(PipelineSimulation::Percentile(latest.queue_latencies, 99),
+            PipelineSimulation::Percentile(deep_fifo.queue_latencies, 99));
+  EXPECT_LT(PipelineSimulation::Percentile(latest.present_latencies, 99),
+            PipelineSimulation::Percentile(deep_fifo.present_latencies, 99));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,19 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate,
+    NowCallback now)
+    : DefaultPointerDataDispatcher(delegate),
+      now_(std::move(now)),
+      weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
+std::vector<PointerData> PointerDataDispatcher::GetRawHistory(
+    int64_t device) const {
+  return {};
+}
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +87,181 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "ResamplingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (packet->GetLength() == 0) {
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+    return;
+  }
+
+  const fml::TimePoint arrival_time = now_();
+  bool needs_flush = false;
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    PointerData data = packet->GetPointerData(i);
+    DeviceState& state = devices_[data.device];
+    state.history.push_back(data);
+    if (state.history.size() > kMaxRawHistorySize) {
+      state.history.pop_front();
+    }
+    state.last_arrival_time = arrival_time;
+    needs_flush |= !CanCoalesce(data);
+    pending_events_.push_back(data);
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+
+  if (needs_flush) {
+    FlushPendingEvents();
+  } else {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+std::vector<PointerData> ResamplingPointerDataDispatcher::GetRawHistory(
+    int64_t device) const {
+  auto found = devices_.find(device);
+  if (found == devices_.end()) {
+    return {};
+  }
+  return {found->second.history.begin(), found->second.history.end()};
+}
+
+bool ResamplingPointerDataDispatcher::CanCoalesce(const PointerData& data) {
+  return (data.change == PointerData::Change::kMove ||
+          data.change == PointerData::Change::kHover) &&
+         data.signal_kind == PointerData::SignalKind::kNone &&
+         data.synthesized == 0;
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  if (is_callback_scheduled_) {
+    return;
+  }
+  is_callback_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->is_callback_scheduled_ = false;
+          dispatcher->FlushPendingEvents();
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::FlushPendingEvents() {
+  if (pending_events_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::FlushPendingEvents");
+
+  std::vector<PointerData> events;
+  events.reserve(pending_events_.size());
+  // The index in |events| of the last move of each device, which later moves
+  // of the device may be merged into.
+  std::unordered_map<int64_t, size_t> open_moves;
+  for (const PointerData& data : pending_events_) {
+    DeviceState& state = devices_[data.device];
+    auto open_move = open_moves.find(data.device);
+    if (!CanCoalesce(data)) {
+      if (open_move != open_moves.end()) {
+        open_moves.erase(open_move);
+      }
+      state.predicted_offset_x = 0;
+      state.predicted_offset_y = 0;
+      events.push_back(data);
+      if (data.change == PointerData::Change::kRemove) {
+        devices_.erase(data.device);
+      }
+      continue;
+    }
+
+    if (open_move != open_moves.end()) {
+      PointerData& merged = events[open_move->second];
+      if (merged.change == data.change && merged.buttons == data.buttons &&
+          merged.pointer_identifier == data.pointer_identifier &&
+          merged.view_id == data.view_id) {
+        const double delta_x = merged.physical_delta_x + data.physical_delta_x;
+        const double delta_y = merged.physical_delta_y + data.physical_delta_y;
+        merged = data;
+        merged.physical_delta_x = delta_x;
+        merged.physical_delta_y = delta_y;
+        continue;
+      }
+    }
+
+    // The previous move was dispatched at its predicted position, so the
+    // delta from it is shorter by the predicted offset.
+    PointerData move = data;
+    move.physical_delta_x -= state.predicted_offset_x;
+    move.physical_delta_y -= state.predicted_offset_y;
+    state.predicted_offset_x = 0;
+    state.predicted_offset_y = 0;
+    open_moves[data.device] = events.size();
+    events.push_back(move);
+  }
+  pending_events_.clear();
+
+  for (const auto& [device, index] : open_moves) {
+    PredictPosition(devices_[device], events[index]);
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  // The coalesced packets end their flows here, and the flow of the last one
+  // continues with the dispatched packet.
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t coalesced_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", coalesced_trace_flow_id);
+  }
+  pending_trace_flow_ids_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::PredictPosition(DeviceState& state,
+                                                      PointerData& data) const {
+  const std::deque<PointerData>& history = state.history;
+  if (history.size() < 2) {
+    return;
+  }
+  const PointerData& last = history[history.size() - 1];
+  const PointerData& previous = history[history.size() - 2];
+  if (last.time_stamp != data.time_stamp || previous.change != last.change ||
+      previous.pointer_identifier != last.pointer_identifier ||
+      previous.buttons != last.buttons) {
+    return;
+  }
+  // Time stamps are in microseconds.
+  const int64_t sample_interval = last.time_stamp - previous.time_stamp;
+  if (sample_interval <= 0 ||
+      sample_interval > kMaxSampleInterval.ToMicroseconds()) {
+    return;
+  }
+
+  const fml::TimeDelta prediction =
+      std::clamp(now_() - state.last_arrival_time, fml::TimeDelta::Zero(),
+                 kMaxPrediction);
+  const double scale = static_cast<double>(prediction.ToMicroseconds()) /
+                       static_cast<double>(sample_interval);
+  const double offset_x = (last.physical_x - previous.physical_x) * scale;
+  const double offset_y = (last.physical_y - previous.physical_y) * scale;
+  data.physical_x += offset_x;
+  data.physical_y += offset_y;
+  data.physical_delta_x += offset_x;
+  data.physical_delta_y += offset_y;
+  data.time_stamp += prediction.ToMicroseconds();
+  state.predicted_offset_x = offset_x;
+  state.predicted_offset_y = offset_y;
+}
+
 }  // namespace flutter
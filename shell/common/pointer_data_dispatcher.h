@@ -5,6 +5,12 @@
 #ifndef FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 #define FLUTTER_SHELL_COMMON_POINTER_DATA_DISPATCHER_H_
 
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -74,6 +80,16 @@ class PointerDataDispatcher {
   virtual void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The most recent raw events of |device|, oldest first, as they
+  ///             were received before the dispatcher modified them.
+  ///
+  ///             Dispatchers that forward every event unmodified keep no
+  ///             history and return an empty list.
+  ///
+  /// @param[in]  device  The device of the `PointerData`.
+  virtual std::vector<PointerData> GetRawHistory(int64_t device) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Default destructor.
   virtual ~PointerDataDispatcher();
@@ -163,6 +179,87 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that coalesces move and hover events and resamples them to the
+/// time of the frame, so that the UI thread handles at most one move per
+/// pointer per frame regardless of the input rate.
+///
+/// It works as follows:
+///
+/// Packets that only contain moves and hovers are held until the next vsync,
+/// through `ScheduleSecondaryVsyncCallback`. Any other event (e.g. down, up,
+/// or a scroll signal) flushes the held events together with its packet right
+/// away, so that it isn't delayed and the order of the events of each pointer
+/// is preserved.
+///
+/// When the held events are flushed, consecutive moves of a pointer that have
+/// the same buttons are merged into the last one, and their deltas are summed.
+/// The position of the last move is then extrapolated from the velocity of
+/// the last two raw samples to the time of the flush, by at most
+/// |kMaxPrediction|. The next move of the pointer takes the predicted offset
+/// out of its delta again, so the sum of the deltas always matches the
+/// position.
+///
+/// The raw events of each device are kept, up to |kMaxRawHistorySize|, so
+/// that clients that need every sample (e.g. for handwriting) can ask for them
+/// with `GetRawHistory`, or through `Engine::GetRawPointerHistory`.
+///
+/// See also pointer_data_dispatcher_unittests.cc.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  /// The furthest ahead of the last raw sample that a position is predicted.
+  static constexpr fml::TimeDelta kMaxPrediction =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  /// Samples further apart than this aren't used to predict the velocity.
+  static constexpr fml::TimeDelta kMaxSampleInterval =
+      fml::TimeDelta::FromMilliseconds(20);
+
+  /// The number of raw events kept per device.
+  static constexpr size_t kMaxRawHistorySize = 64u;
+
+  using NowCallback = std::function<fml::TimePoint()>;
+
+  explicit ResamplingPointerDataDispatcher(
+      Delegate& delegate,
+      NowCallback now = [] { return fml::TimePoint::Now(); });
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+  // |PointerDataDispatcer|
+  std::vector<PointerData> GetRawHistory(int64_t device) const override;
+
+ private:
+  struct DeviceState {
+    // The most recent raw events of the device, oldest first.
+    std::deque<PointerData> history;
+    fml::TimePoint last_arrival_time;
+    // The offset by which the last dispatched move was predicted ahead of its
+    // raw position.
+    double predicted_offset_x = 0;
+    double predicted_offset_y = 0;
+  };
+
+  void FlushPendingEvents();
+  void ScheduleSecondaryVsyncCallback();
+  void PredictPosition(DeviceState& state, PointerData& data) const;
+  static bool CanCoalesce(const PointerData& data);
+
+  NowCallback now_;
+  std::vector<PointerData> pending_events_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  std::unordered_map<int64_t, DeviceState> devices_;
+  bool is_callback_scheduled_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include "flutter/benchmarking/benchmarking.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr int64_t kInputRate = 1000;
+constexpr int64_t kFrameRate = 60;
+
+// Stands in for the engine, and copies each dispatched packet the way
+// |PlatformConfiguration| does when it hands the packet to the isolate.
+class BenchmarkDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<uint8_t> data = packet->data();
+    benchmark::DoNotOptimize(data.data());
+    packet_count++;
+    event_count += packet->GetLength();
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  fml::closure vsync_callback;
+  size_t packet_count = 0;
+  size_t event_count = 0;
+};
+
+}  // namespace
+
+// Dispatches a second of 1000Hz touch moves with a vsync at 60Hz, and
+// measures the time it takes on the UI thread up to the isolate. The counters
+// are the number of packets and events that reach the isolate, each of which
+// costs a call into Dart and the framework's handling of the event.
+static void BM_DispatchPointerInput(benchmark::State& state) {
+  const bool resample = state.range(0) != 0;
+  BenchmarkDispatcherDelegate delegate;
+  std::unique_ptr<PointerDataDispatcher> dispatcher;
+  if (resample) {
+    dispatcher = std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+  } else {
+    dispatcher = std::make_unique<DefaultPointerDataDispatcher>(delegate);
+  }
+
+  PointerData data;
+  data.Clear();
+  data.change = PointerData::Change::kMove;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.buttons = kPointerButtonTouchContact;
+  data.physical_delta_x = 1;
+
+  int64_t time_stamp = 0;
+  for (auto _ : state) {
+    delegate.packet_count = 0;
+    delegate.event_count = 0;
+    for (int64_t i = 0; i < kInputRate; i++) {
+      time_stamp += 1000000 / kInputRate;
+      data.time_stamp = time_stamp;
+      data.physical_x = static_cast<double>(time_stamp) / 1000;
+      auto packet = std::make_unique<PointerDataPacket>(1);
+      packet->SetPointerData(0, data);
+      dispatcher->DispatchPacket(std::move(packet), 0);
+      if ((i + 1) * kFrameRate / kInputRate != i * kFrameRate / kInputRate) {
+        delegate.FireVsync();
+      }
+    }
+  }
+
+  state.counters["packets_per_second"] =
+      static_cast<double>(delegate.packet_count);
+  state.counters["events_per_second"] =
+      static_cast<double>(delegate.event_count);
+}
+
+BENCHMARK(BM_DispatchPointerInput)
+    ->ArgName("resample")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
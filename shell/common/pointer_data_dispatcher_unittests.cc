@@ -0,0 +1,200 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDispatcherDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    std::vector<PointerData> events;
+    for (size_t i = 0; i < packet->GetLength(); i++) {
+      events.push_back(packet->GetPointerData(i));
+    }
+    packets.push_back(std::move(events));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::vector<PointerData>> packets;
+  fml::closure vsync_callback;
+};
+
+class ResamplingPointerDataDispatcherTest : public ::testing::Test {
+ protected:
+  ResamplingPointerDataDispatcherTest()
+      : dispatcher_(delegate_, [this] { return now_; }) {}
+
+  void Dispatch(std::vector<PointerData> events) {
+    auto packet = std::make_unique<PointerDataPacket>(events.size());
+    for (size_t i = 0; i < events.size(); i++) {
+      packet->SetPointerData(i, events[i]);
+    }
+    dispatcher_.DispatchPacket(std::move(packet), 0);
+  }
+
+  void Advance(int64_t micros) {
+    now_ = now_ + fml::TimeDelta::FromMicroseconds(micros);
+  }
+
+  FakeDispatcherDelegate delegate_;
+  fml::TimePoint now_;
+  ResamplingPointerDataDispatcher dispatcher_;
+};
+
+PointerData CreateEvent(PointerData::Change change,
+                        int64_t time_stamp,
+                        double x,
+                        double delta_x = 0,
+                        int64_t device = 0,
+                        int64_t buttons = kPointerButtonTouchContact) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.time_stamp = time_stamp;
+  data.device = device;
+  data.physical_x = x;
+  data.physical_delta_x = delta_x;
+  data.buttons = buttons;
+  return data;
+}
+
+PointerData CreateMove(int64_t time_stamp,
+                       double x,
+                       double delta_x,
+                       int64_t device = 0,
+                       int64_t buttons = kPointerButtonTouchContact) {
+  return CreateEvent(PointerData::Change::kMove, time_stamp, x, delta_x,
+                     device, buttons);
+}
+
+}  // namespace
+
+TEST_F(ResamplingPointerDataDispatcherTest, CoalescesMovesUntilVsync) {
+  Dispatch({CreateEvent(PointerData::Change::kDown, 0, 0)});
+  ASSERT_EQ(delegate_.packets.size(), 1u);
+
+  for (int i = 1; i <= 4; i++) {
+    Dispatch({CreateMove(i * 30000, i * 10, 10)});
+  }
+  EXPECT_EQ(delegate_.packets.size(), 1u);
+
+  delegate_.FireVsync();
+  ASSERT_EQ(delegate_.packets.size(), 2u);
+  ASSERT_EQ(delegate_.packets[1].size(), 1u);
+  const PointerData& move = delegate_.packets[1][0];
+  EXPECT_EQ(move.change, PointerData::Change::kMove);
+  EXPECT_EQ(move.time_stamp, 120000);
+  EXPECT_EQ(move.physical_x, 40);
+  EXPECT_EQ(move.physical_delta_x, 40);
+
+  // Nothing is dispatched when there were no new events.
+  delegate_.FireVsync();
+  EXPECT_EQ(delegate_.packets.size(), 2u);
+}
+
+TEST_F(ResamplingPointerDataDispatcherTest, DispatchesOtherEventsRightAway) {
+  Dispatch({CreateMove(1000, 10, 10)});
+  Dispatch({CreateMove(2000, 20, 10)});
+  Dispatch({CreateEvent(PointerData::Change::kUp, 3000, 20)});
+
+  ASSERT_EQ(delegate_.packets.size(), 1u);
+  ASSERT_EQ(delegate_.packets[0].size(), 2u);
+  EXPECT_EQ(delegate_.packets[0][0].change, PointerData::Change::kMove);
+  EXPECT_EQ(delegate_.packets[0][0].physical_x, 20);
+  EXPECT_EQ(delegate_.packets[0][1].change, PointerData::Change::kUp);
+
+  delegate_.FireVsync();
+  EXPECT_EQ(delegate_.packets.size(), 1u);
+}
+
+TEST_F(ResamplingPointerDataDispatcherTest, KeepsDevicesAndButtonsApart) {
+  Dispatch({CreateMove(1000, 10, 10, /*device=*/0),
+            CreateMove(1000, 50, 10, /*device=*/1)});
+  Dispatch({CreateMove(2000, 20, 10, /*device=*/0),
+            CreateMove(2000, 60, 10, /*device=*/1)});
+  Dispatch({CreateMove(3000, 30, 10, /*device=*/0, /*buttons=*/0)});
+  delegate_.FireVsync();
+
+  ASSERT_EQ(delegate_.packets.size(), 1u);
+  const std::vector<PointerData>& events = delegate_.packets[0];
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].device, 0);
+  EXPECT_EQ(events[0].physical_x, 20);
+  EXPECT_EQ(events[1].device, 1);
+  EXPECT_EQ(events[1].physical_x, 60);
+  EXPECT_EQ(events[2].device, 0);
+  EXPECT_EQ(events[2].buttons, 0);
+}
+
+TEST_F(ResamplingPointerDataDispatcherTest, PredictsPositionToVsync) {
+  Dispatch({CreateMove(1000, 10, 10)});
+  Dispatch({CreateMove(2000, 20, 10)});
+  Advance(4000);
+  delegate_.FireVsync();
+
+  ASSERT_EQ(delegate_.packets.size(), 1u);
+  PointerData move = delegate_.packets[0][0];
+  EXPECT_EQ(move.time_stamp, 6000);
+  EXPECT_EQ(move.physical_x, 60);
+  EXPECT_EQ(move.physical_delta_x, 60);
+
+  // The next move is relative to the predicted position.
+  Dispatch({CreateMove(3000, 30, 10)});
+  delegate_.FireVsync();
+  ASSERT_EQ(delegate_.packets.size(), 2u);
+  move = delegate_.packets[1][0];
+  EXPECT_EQ(move.physical_x, 30);
+  EXPECT_EQ(move.physical_delta_x, -30);
+
+  // Predictions are capped at 8ms.
+  Dispatch({CreateMove(4000, 40, 10)});
+  Advance(100000);
+  delegate_.FireVsync();
+  ASSERT_EQ(delegate_.packets.size(), 3u);
+  move = delegate_.packets[2][0];
+  EXPECT_EQ(move.time_stamp, 12000);
+  EXPECT_EQ(move.physical_x, 120);
+}
+
+TEST_F(ResamplingPointerDataDispatcherTest, KeepsRawHistory) {
+  const size_t count = ResamplingPointerDataDispatcher::kMaxRawHistorySize + 4;
+  for (size_t i = 0; i < count; i++) {
+    Dispatch({CreateMove(i * 1000, i, 1)});
+  }
+  delegate_.FireVsync();
+
+  // The moves were coalesced into one, but the raw history has all of them.
+  ASSERT_EQ(delegate_.packets.size(), 1u);
+  std::vector<PointerData> history = dispatcher_.GetRawHistory(0);
+  ASSERT_EQ(history.size(),
+            ResamplingPointerDataDispatcher::kMaxRawHistorySize);
+  EXPECT_EQ(history.front().physical_x, 4);
+  EXPECT_EQ(history.back().physical_x, count - 1);
+  EXPECT_TRUE(dispatcher_.GetRawHistory(1).empty());
+
+  Dispatch({CreateEvent(PointerData::Change::kRemove, count * 1000, 0)});
+  EXPECT_TRUE(dispatcher_.GetRawHistory(0).empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -108,6 +108,18 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
       }
     });
   }
+
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    const Settings& settings = delegate_.GetSettings();
+    if (settings.impeller_enable_dual_kawase_blur) {
+      aiks_context->GetContentContext().SetBlurAlgorithm(
+          impeller::BlurAlgorithm::kDualKawase);
+    }
+    aiks_context->GetContentContext().SetComputeTessellationEnabled(
+        settings.impeller_enable_compute_tessellation);
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
 void Rasterizer::TeardownExternalViewEmbedder() {
@@ -242,6 +254,23 @@ void Rasterizer::DrawLastLayerTrees(
   }
 }
 
+// Allows a stale frame to be skipped in favor of a newer one. The newer frame
+// takes over the layer trees of the views that it does not render, so that
+// skipping the stale frame does not lose their content.
+static bool SupersedeFrameItem(FrameItem& stale, FrameItem& newer) {
+  for (std::unique_ptr<LayerTreeTask>& stale_task : stale.layer_tree_tasks) {
+    bool rendered_by_newer = std::any_of(
+        newer.layer_tree_tasks.begin(), newer.layer_tree_tasks.end(),
+        [&stale_task](const std::unique_ptr<LayerTreeTask>& task) {
+          return task->view_id == stale_task->view_id;
+        });
+    if (!rendered_by_newer) {
+      newer.layer_tree_tasks.push_back(std::move(stale_task));
+    }
+  }
+  return true;
+}
+
 DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
   TRACE_EVENT0("flutter", "GPURasterizer::Draw");
   if (raster_thread_merger_ &&
@@ -260,7 +289,10 @@ DrawStatus Rasterizer::Draw(const std::shared_ptr<FramePipeline>& pipeline) {
                          std::move(item->layer_tree_tasks));
   };
 
-  PipelineConsumeResult consume_result = pipeline->Consume(consumer);
+  PipelineConsumeResult consume_result =
+      delegate_.GetSettings().skip_stale_frames
+          ? pipeline->ConsumeLatest(consumer, SupersedeFrameItem)
+          : pipeline->Consume(consumer);
   if (consume_result == PipelineConsumeResult::NoneAvailable) {
     return DrawStatus::kPipelineEmpty;
   }
@@ -507,7 +539,9 @@ Rasterizer::DoDrawResult Rasterizer::DoDraw(
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
-  delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
+  const FrameTiming timing = frame_timings_recorder->GetRecordedTime();
+  compositor_context_->frame_timing_histograms()->RecordFrame(timing);
+  delegate_.OnFrameRasterized(timing);
 
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
@@ -785,6 +819,7 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
 
     frame->set_submit_info(submit_info);
 
+    const fml::TimePoint submit_start = fml::TimePoint::Now();
     if (external_view_embedder_ &&
         (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
       FML_DCHECK(!frame->IsSubmitted());
@@ -794,6 +829,9 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     } else {
       frame->Submit();
     }
+    compositor_context_->frame_timing_histograms()->Record(
+        FrameTimingHistograms::Phase::kGpuSubmit,
+        fml::TimePoint::Now() - submit_start);
 
 #if !SLIMPELLER
     // Do not update raster cache metrics for kResubmit because that status
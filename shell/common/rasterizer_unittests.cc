@@ -743,6 +743,93 @@ TEST(RasterizerTest, drawMultipleViewsWithExternalViewEmbedder) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, drawSkipsStaleFramesAndKeepsTheirViews) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.skip_stale_frames = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(1);
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  std::shared_ptr<NiceMock<MockExternalViewEmbedder>> external_view_embedder =
+      std::make_shared<NiceMock<MockExternalViewEmbedder>>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize())).Times(2);
+  ON_CALL(*surface, AcquireFrame).WillByDefault([](const SkISize& size) {
+    SurfaceFrame::FramebufferInfo framebuffer_info;
+    framebuffer_info.supports_readback = true;
+    return std::make_unique<SurfaceFrame>(
+        /*surface=*/
+        nullptr, framebuffer_info,
+        /*encode_callback=*/[](const SurfaceFrame&, DlCanvas*) { return true; },
+        /*submit_callback=*/[](const SurfaceFrame&) { return true; },
+        /*frame_size=*/SkISize::Make(800, 600));
+  });
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  // The stale frame renders views 0 and 1, the latest frame only view 0.
+  EXPECT_CALL(*external_view_embedder,
+              PrepareFlutterView(/*frame_size=*/SkISize(),
+                                 /*device_pixel_ratio=*/1.5))
+      .Times(0);
+  EXPECT_CALL(*external_view_embedder,
+              PrepareFlutterView(/*frame_size=*/SkISize(),
+                                 /*device_pixel_ratio=*/3.0))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              PrepareFlutterView(/*frame_size=*/SkISize(),
+                                 /*device_pixel_ratio=*/2.0))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              SubmitFlutterView(/*flutter_view_id=*/0, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              SubmitFlutterView(/*flutter_view_id=*/1, _, _, _))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<FramePipeline>(/*depth=*/10);
+    std::vector<std::unique_ptr<LayerTreeTask>> stale_tasks;
+    stale_tasks.push_back(std::make_unique<LayerTreeTask>(
+        0, std::make_unique<LayerTree>(nullptr, SkISize()), 1.5));
+    stale_tasks.push_back(std::make_unique<LayerTreeTask>(
+        1, std::make_unique<LayerTree>(nullptr, SkISize()), 2.0));
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::make_unique<FrameItem>(
+            std::move(stale_tasks), CreateFinishedBuildRecorder()));
+    EXPECT_TRUE(result.success);
+    std::vector<std::unique_ptr<LayerTreeTask>> latest_tasks;
+    latest_tasks.push_back(std::make_unique<LayerTreeTask>(
+        0, std::make_unique<LayerTree>(nullptr, SkISize()), 3.0));
+    result = pipeline->Produce().Complete(std::make_unique<FrameItem>(
+        std::move(latest_tasks), CreateFinishedBuildRecorder()));
+    EXPECT_TRUE(result.success);
+    ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+    rasterizer->Draw(pipeline);
+    EXPECT_EQ(pipeline->GetSkippedCount(), 1u);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(RasterizerTest,
      drawWithGpuEnabledAndSurfaceAllowsDrawingWhenGpuDisabledDoesAcquireFrame) {
   std::string test_name =
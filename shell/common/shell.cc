@@ -6,6 +6,7 @@
 #include "flutter/shell/common/shell.h"
 
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_recorder.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
@@ -95,6 +97,47 @@ void RegisterCodecsWithSkia() {
   SkCodecs::Register(SkIcoDecoder::Decoder());
 }
 
+// The engine trace requested with --trace-engine-to-file
+// (Settings::trace_engine_to_file) is recorded while any shell that requested
+// it exists. Stopping the recorder when the last of them is
+// destroyed writes the events of the last flush interval and finishes the
+// file, which JSON traces need to be readable.
+std::mutex gTraceRecorderMutex;
+size_t gTraceRecorderShellCount = 0;
+
+void AddTraceRecorderShell(const Settings& settings) {
+  const std::string& path = settings.trace_engine_to_file;
+  if (path.empty()) {
+    return;
+  }
+  std::scoped_lock lock(gTraceRecorderMutex);
+  if (gTraceRecorderShellCount++ > 0) {
+    return;
+  }
+  const std::string json_extension = ".json";
+  bool is_json = path.size() >= json_extension.size() &&
+                 path.compare(path.size() - json_extension.size(),
+                              json_extension.size(), json_extension) == 0;
+  if (!fml::tracing::TraceRecorderStart(
+          path, is_json ? fml::tracing::TraceRecorderFormat::kChromeJson
+                        : fml::tracing::TraceRecorderFormat::kPerfetto)) {
+    FML_LOG(ERROR) << "Could not record the engine trace to " << path << ".";
+  }
+}
+
+void RemoveTraceRecorderShell(const Settings& settings) {
+  if (settings.trace_engine_to_file.empty()) {
+    return;
+  }
+  std::scoped_lock lock(gTraceRecorderMutex);
+  FML_DCHECK(gTraceRecorderShellCount > 0);
+  if (--gTraceRecorderShellCount > 0) {
+    return;
+  }
+  fml::tracing::TraceRecorderFlush();
+  fml::tracing::TraceRecorderStop();
+}
+
 // Though there can be multiple shells, some settings apply to all components in
 // the process. These have to be set up before the shell or any of its
 // sub-components can be initialized. In a perfect world, this would be empty.
@@ -265,6 +308,10 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   if (!vsync_waiter) {
     return nullptr;
   }
+  if (settings.enable_predictive_frame_start) {
+    shell->frame_start_predictor_ = std::make_shared<FrameStartPredictor>();
+    vsync_waiter->SetFrameStartPredictor(shell->frame_start_predictor_);
+  }
 
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
@@ -334,8 +381,9 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->GetSettings().frame_pipeline_depth);
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -455,6 +503,8 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.IsValid());
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  AddTraceRecorderShell(settings_);
+
   display_manager_ = std::make_unique<DisplayManager>();
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
@@ -506,6 +556,11 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingHistogramsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingHistograms, this,
+                    std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kReloadAssetFonts] = {
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
@@ -574,6 +629,8 @@ Shell::~Shell() {
         platform_latch.Signal();
       }));
   platform_latch.Wait();
+
+  RemoveTraceRecorderShell(settings_);
 }
 
 std::unique_ptr<Shell> Shell::Spawn(
@@ -749,6 +806,8 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   engine_ = std::move(engine);
   rasterizer_ = std::move(rasterizer);
   io_manager_ = io_manager;
+  frame_timing_histograms_ =
+      rasterizer_->compositor_context()->frame_timing_histograms();
 
   // Set the external view embedder for the rasterizer.
   auto view_embedder = platform_view_->CreateExternalViewEmbedder();
@@ -1587,6 +1646,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (frame_start_predictor_) {
+    frame_start_predictor_->AddFrame(timing);
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1883,6 +1946,11 @@ double Shell::GetMainDisplayRefreshRate() {
   return display_manager_->GetMainDisplayRefreshRate();
 }
 
+const std::shared_ptr<FrameTimingHistograms>& Shell::GetFrameTimingHistograms()
+    const {
+  return frame_timing_histograms_;
+}
+
 void Shell::RegisterImageDecoder(ImageGeneratorFactory factory,
                                  int32_t priority) {
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
@@ -1954,6 +2022,53 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetFrameTimingHistograms(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+
+  fml::TimeDelta window = FrameTimingHistograms::kMaxWindow;
+  if (params.count("windowMillis") != 0) {
+    char* end = nullptr;
+    const std::string& window_millis = params.at("windowMillis");
+    int64_t millis = std::strtoll(window_millis.c_str(), &end, 10);
+    if (window_millis.empty() || *end != '\0' || millis <= 0) {
+      ServiceProtocolParameterError(
+          response, "'windowMillis' must be a positive integer.");
+      return false;
+    }
+    window = fml::TimeDelta::FromMilliseconds(millis);
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FrameTimingHistograms", allocator);
+  rapidjson::Value phases(rapidjson::kObjectType);
+  const fml::TimePoint now = fml::TimePoint::Now();
+  for (FrameTimingHistograms::Phase phase : FrameTimingHistograms::kPhases) {
+    const FrameTimingHistograms::Statistics statistics =
+        frame_timing_histograms_->GetStatistics(phase, window, now);
+    rapidjson::Value phase_json(rapidjson::kObjectType);
+    auto add_micros = [&](const char* name, fml::TimeDelta duration) {
+      phase_json.AddMember(rapidjson::StringRef(name),
+                           duration.ToMicroseconds(), allocator);
+    };
+    phase_json.AddMember<uint64_t>("count", statistics.count, allocator);
+    add_micros("minMicros", statistics.min);
+    add_micros("maxMicros", statistics.max);
+    add_micros("meanMicros", statistics.mean);
+    add_micros("p50Micros", statistics.p50);
+    add_micros("p90Micros", statistics.p90);
+    add_micros("p99Micros", statistics.p99);
+    add_micros("p999Micros", statistics.p999);
+    phases.AddMember(rapidjson::StringRef(
+                         FrameTimingHistograms::GetPhaseName(phase)),
+                     phase_json, allocator);
+  }
+  response->AddMember("phases", phases, allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
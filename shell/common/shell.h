@@ -35,6 +35,7 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_start_predictor.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
@@ -397,6 +398,15 @@ class Shell final : public PlatformView::Delegate,
   ///
   double GetMainDisplayRefreshRate();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The latency histograms of the phases of the frames rendered
+  ///             by this shell. They may be queried from any thread.
+  ///
+  /// @return     The histograms, or nullptr if the shell is not set up.
+  ///
+  const std::shared_ptr<FrameTimingHistograms>& GetFrameTimingHistograms()
+      const;
+
   //----------------------------------------------------------------------------
   /// @brief      Install a new factory that can match against and decode image
   ///             data.
@@ -461,6 +471,9 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
+  std::shared_ptr<FrameTimingHistograms> frame_timing_histograms_;
+  // Only set when predictive frame start is enabled.
+  std::shared_ptr<FrameStartPredictor> frame_start_predictor_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
@@ -762,6 +775,14 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Reports the latency percentiles of each frame phase over the last
+  // `windowMillis` milliseconds, or the longest window that is kept.
+  bool OnServiceProtocolGetFrameTimingHistograms(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Forces the FontCollection to reload the font manifest. Used to support
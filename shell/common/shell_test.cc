@@ -327,6 +327,9 @@ void ShellTest::OnServiceProtocol(
           case ServiceProtocolEnum::kRunInView:
             shell->OnServiceProtocolRunInView(params, response);
             break;
+          case ServiceProtocolEnum::kGetFrameTimingHistograms:
+            shell->OnServiceProtocolGetFrameTimingHistograms(params, response);
+            break;
         }
         finished.set_value(true);
       });
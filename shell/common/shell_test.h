@@ -140,6 +140,7 @@ class ShellTest : public FixtureTest {
     kEstimateRasterCacheMemory,
     kSetAssetBundlePath,
     kRunInView,
+    kGetFrameTimingHistograms,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
@@ -29,6 +29,7 @@
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/runtime/dart_vm.h"
@@ -466,6 +467,31 @@ TEST_F(ShellTest, InitializeWithSingleThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, EngineTraceIsFinishedWhenTheLastShellIsDestroyed) {
+  fml::ScopedTemporaryDirectory trace_dir;
+  const std::string path =
+      fml::paths::JoinPaths({trace_dir.path(), "trace.json"});
+  Settings settings = CreateSettingsForFixture();
+  settings.trace_engine_to_file = path;
+  ThreadHost thread_host("io.flutter.test." + GetCurrentTestName() + ".",
+                         ThreadHost::Type::kPlatform);
+  auto task_runner = thread_host.platform_thread->GetTaskRunner();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  auto shell = CreateShell(settings, task_runners);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  DestroyShell(std::move(shell), task_runners);
+
+  auto trace = fml::FileMapping::CreateReadOnly(path);
+  ASSERT_TRUE(trace);
+  std::string contents(reinterpret_cast<const char*>(trace->GetMapping()),
+                       trace->GetSize());
+  // The closing bracket of the JSON array is only written when recording
+  // stops.
+  EXPECT_EQ(contents.front(), '[');
+  EXPECT_EQ(contents.substr(contents.find_last_not_of('\n')), "]\n");
+}
+
 TEST_F(ShellTest, InitializeWithSingleThreadWhichIsTheCallingThread) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
   Settings settings = CreateSettingsForFixture();
@@ -2593,6 +2619,48 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetFrameTimingHistogramsWorks) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent rasterized;
+  settings.frame_rasterized_callback =
+      [&rasterized](const FrameTiming& timing) { rasterized.Signal(); };
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  rasterized.Wait();
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameTimingHistograms,
+                    shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                    &document);
+  ASSERT_STREQ(document["type"].GetString(), "FrameTimingHistograms");
+  const auto& phases = document["phases"];
+  EXPECT_EQ(phases["build"]["count"].GetUint64(), 1u);
+  EXPECT_EQ(phases["raster"]["count"].GetUint64(), 1u);
+  EXPECT_EQ(phases["presentLatency"]["count"].GetUint64(), 1u);
+  EXPECT_GE(phases["presentLatency"]["p99Micros"].GetInt64(),
+            phases["raster"]["p99Micros"].GetInt64());
+  EXPECT_EQ(
+      shell->GetFrameTimingHistograms()
+          ->GetStatistics(FrameTimingHistograms::Phase::kGpuSubmit)
+          .count,
+      1u);
+
+  params["windowMillis"] = "soon";
+  rapidjson::Document error;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetFrameTimingHistograms,
+                    shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                    &error);
+  EXPECT_EQ(error["code"].GetInt(), -32602);
+
+  DestroyShell(std::move(shell));
+}
+
 // TODO(https://github.com/flutter/flutter/issues/100273): Disabled due to
 // flakiness.
 // TODO(https://github.com/flutter/flutter/issues/100299): Fix it when
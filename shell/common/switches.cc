@@ -354,6 +354,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   command_line.GetOptionValue(FlagForSwitch(Switch::TraceToFile),
                               &settings.trace_to_file);
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::TraceEngineToFile),
+                              &settings.trace_engine_to_file);
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -473,6 +476,10 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
       command_line.HasOption(FlagForSwitch(Switch::EnableOpenGLGPUTracing));
   settings.enable_vulkan_gpu_tracing =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanGPUTracing));
+  settings.impeller_enable_dual_kawase_blur =
+      command_line.HasOption(FlagForSwitch(Switch::ImpellerDualKawaseBlur));
+  settings.impeller_enable_compute_tessellation = command_line.HasOption(
+      FlagForSwitch(Switch::ImpellerComputeTessellation));
 
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
@@ -523,6 +530,23 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string frame_pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &frame_pipeline_depth);
+    settings.frame_pipeline_depth =
+        std::max(std::stoi(frame_pipeline_depth), 1);
+  }
+
+  settings.skip_stale_frames =
+      command_line.HasOption(FlagForSwitch(Switch::SkipStaleFrames));
+
+  settings.enable_predictive_frame_start = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameStart));
+
+  settings.enable_pointer_resampling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePointerResampling));
+
   settings.enable_platform_isolates =
       command_line.HasOption(FlagForSwitch(Switch::EnablePlatformIsolates));
 
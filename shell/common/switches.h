@@ -202,6 +202,15 @@ DEF_SWITCH(TraceToFile,
            "Write the timeline trace to a file at the specified path. The file "
            "will be in Perfetto's proto format; it will be possible to load "
            "the file into Perfetto's trace viewer.")
+DEF_SWITCH(TraceEngineToFile,
+           "trace-engine-to-file",
+           "Record the engine's trace events into per-thread buffers, which "
+           "are written to a file at the specified path in the background. "
+           "Unlike --trace-to-file, this does not go through the Dart "
+           "timeline, and is available in release builds compiled with "
+           "flutter_trace_recorder_in_release. The file is in the JSON format "
+           "of chrome://tracing if the path ends in .json, and in Perfetto's "
+           "proto format otherwise.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -262,6 +271,23 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The number of frames that the UI thread may build ahead of the "
+           "raster thread. Defaults to 2.")
+DEF_SWITCH(SkipStaleFrames,
+           "skip-stale-frames",
+           "When the raster thread falls behind, skip the frames waiting in "
+           "the pipeline and rasterize the latest one.")
+DEF_SWITCH(EnablePredictiveFrameStart,
+           "enable-predictive-frame-start",
+           "Start each frame at an offset from the vsync that is predicted "
+           "from the durations of recent frames, so that it finishes just "
+           "before its target time.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Coalesce pointer move events to one per pointer per frame, and "
+           "resample their positions to the frame time.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -283,6 +309,16 @@ DEF_SWITCH(EnableVulkanGPUTracing,
            "enable-vulkan-gpu-tracing",
            "Enable tracing of GPU execution time when using the Impeller "
            "Vulkan backend.")
+DEF_SWITCH(ImpellerDualKawaseBlur,
+           "impeller-dual-kawase-blur",
+           "Render Gaussian blurs with large sigmas using a dual Kawase "
+           "filter chain, which is cheaper than separable Gaussian passes at "
+           "a small cost in accuracy. Only applies to Impeller.")
+DEF_SWITCH(ImpellerComputeTessellation,
+           "impeller-compute-tessellation",
+           "Tessellate complex paths with compute shaders on devices that "
+           "support them. Every such path is submitted to the GPU separately, "
+           "so this is experimental. Only applies to Impeller.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
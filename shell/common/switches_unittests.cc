@@ -105,6 +105,62 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, FramePipeline) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_EQ(settings.frame_pipeline_depth, 2u);
+  EXPECT_FALSE(settings.skip_stale_frames);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--frame-pipeline-depth=3", "--skip-stale-frames"}));
+  EXPECT_EQ(settings.frame_pipeline_depth, 3u);
+  EXPECT_TRUE(settings.skip_stale_frames);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--frame-pipeline-depth=0"}));
+  EXPECT_EQ(settings.frame_pipeline_depth, 1u);
+}
+
+TEST(SwitchesTest, EnablePredictiveFrameStart) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.enable_predictive_frame_start);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--enable-predictive-frame-start"}));
+  EXPECT_TRUE(settings.enable_predictive_frame_start);
+}
+
+TEST(SwitchesTest, EnablePointerResampling) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.enable_pointer_resampling);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--enable-pointer-resampling"}));
+  EXPECT_TRUE(settings.enable_pointer_resampling);
+}
+
+TEST(SwitchesTest, ImpellerDualKawaseBlur) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.impeller_enable_dual_kawase_blur);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--impeller-dual-kawase-blur"}));
+  EXPECT_TRUE(settings.impeller_enable_dual_kawase_blur);
+}
+
+TEST(SwitchesTest, ImpellerComputeTessellation) {
+  Settings settings = SettingsFromCommandLine(
+      fml::CommandLineFromInitializerList({"command"}));
+  EXPECT_FALSE(settings.impeller_enable_compute_tessellation);
+
+  settings = SettingsFromCommandLine(fml::CommandLineFromInitializerList(
+      {"command", "--impeller-compute-tessellation"}));
+  EXPECT_TRUE(settings.impeller_enable_compute_tessellation);
+}
+
 #if !FLUTTER_RELEASE
 TEST(SwitchesTest, EnableAsserts) {
   fml::CommandLine command_line = fml::CommandLineFromInitializerList(
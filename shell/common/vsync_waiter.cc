@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/vsync_waiter.h"
 
+#include <algorithm>
+
 #include "flow/frame_timings.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
@@ -84,6 +86,21 @@ void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
   AwaitVSyncForSecondaryCallback();
 }
 
+void VsyncWaiter::SetFrameStartPredictor(
+    std::shared_ptr<FrameStartPredictor> predictor) {
+  frame_start_predictor_ = std::move(predictor);
+}
+
+fml::TimeDelta VsyncWaiter::GetFrameStartOffset(
+    fml::TimePoint frame_start_time,
+    fml::TimePoint frame_target_time) const {
+  if (!frame_start_predictor_) {
+    return fml::TimeDelta::Zero();
+  }
+  return frame_start_predictor_->GetFrameStartOffset(frame_target_time -
+                                                     frame_start_time);
+}
+
 void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
                                fml::TimePoint frame_target_time,
                                bool pause_secondary_tasks) {
@@ -111,9 +128,6 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
   if (callback) {
     const uint64_t flow_identifier = fml::tracing::TraceNonce();
-    if (pause_secondary_tasks) {
-      PauseDartEventLoopTasks();
-    }
 
     // The base trace ensures that flows have a root to begin from if one does
     // not exist. The trace viewer will ignore traces that have no base event
@@ -125,26 +139,47 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
 
     TRACE_FLOW_BEGIN("flutter", kVsyncFlowName, flow_identifier);
 
-    fml::TaskQueueId ui_task_queue_id =
-        task_runners_.GetUITaskRunner()->GetTaskQueueId();
-
-    task_runners_.GetUITaskRunner()->PostTask(
-        [ui_task_queue_id, callback, flow_identifier, frame_start_time,
-         frame_target_time, pause_secondary_tasks]() {
-          FML_TRACE_EVENT_WITH_FLOW_IDS(
-              "flutter", kVsyncTraceName, /*flow_id_count=*/1,
-              /*flow_ids=*/&flow_identifier, "StartTime", frame_start_time,
-              "TargetTime", frame_target_time);
-          std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
-              std::make_unique<FrameTimingsRecorder>();
-          frame_timings_recorder->RecordVsync(frame_start_time,
-                                              frame_target_time);
-          callback(std::move(frame_timings_recorder));
-          TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
-          if (pause_secondary_tasks) {
-            ResumeDartEventLoopTasks(ui_task_queue_id);
-          }
-        });
+    fml::RefPtr<fml::TaskRunner> ui_task_runner =
+        task_runners_.GetUITaskRunner();
+    fml::TaskQueueId ui_task_queue_id = ui_task_runner->GetTaskQueueId();
+
+    auto start_frame = [ui_task_runner, ui_task_queue_id, callback,
+                        flow_identifier, frame_start_time, frame_target_time,
+                        pause_secondary_tasks]() {
+      if (pause_secondary_tasks) {
+        PauseDartEventLoopTasks(ui_task_queue_id);
+      }
+      ui_task_runner->PostTask([ui_task_queue_id, callback, flow_identifier,
+                                frame_start_time, frame_target_time,
+                                pause_secondary_tasks]() {
+        FML_TRACE_EVENT_WITH_FLOW_IDS(
+            "flutter", kVsyncTraceName, /*flow_id_count=*/1,
+            /*flow_ids=*/&flow_identifier, "StartTime", frame_start_time,
+            "TargetTime", frame_target_time);
+        std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
+            std::make_unique<FrameTimingsRecorder>();
+        frame_timings_recorder->RecordVsync(frame_start_time,
+                                            frame_target_time);
+        callback(std::move(frame_timings_recorder));
+        TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
+        if (pause_secondary_tasks) {
+          ResumeDartEventLoopTasks(ui_task_queue_id);
+        }
+      });
+    };
+
+    // Delaying the start of a frame that is predicted to finish well before
+    // its target time lets it sample more recent input.
+    const fml::TimeDelta delay = std::max(
+        GetFrameStartOffset(frame_start_time, frame_target_time),
+        fml::TimeDelta::Zero());
+    if (delay > fml::TimeDelta::Zero()) {
+      TRACE_EVENT_INSTANT1("flutter", "VsyncDelayFrameStart", "delay_micros",
+                           std::to_string(delay.ToMicroseconds()).c_str());
+      ui_task_runner->PostTaskForTime(start_frame, frame_start_time + delay);
+    } else {
+      start_frame();
+    }
   }
 
   for (auto& secondary_callback : secondary_callbacks) {
@@ -152,8 +187,7 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
   }
 }
 
-void VsyncWaiter::PauseDartEventLoopTasks() {
-  auto ui_task_queue_id = task_runners_.GetUITaskRunner()->GetTaskQueueId();
+void VsyncWaiter::PauseDartEventLoopTasks(fml::TaskQueueId ui_task_queue_id) {
   auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
   task_queues->PauseSecondarySource(ui_task_queue_id);
 }
@@ -13,6 +13,7 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_start_predictor.h"
 
 namespace flutter {
 
@@ -35,6 +36,11 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// Starts frames at the offset from the vsync that |predictor| predicts,
+  /// rather than at the vsync. Must be called before the first call to
+  /// |AsyncWaitForVsync|.
+  void SetFrameStartPredictor(std::shared_ptr<FrameStartPredictor> predictor);
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -69,17 +75,25 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   virtual void AwaitVSyncForSecondaryCallback() { AwaitVSync(); }
 
   // Schedules the callback on the UI task runner. Needs to be invoked as close
-  // to the `frame_start_time` as possible.
+  // to the `frame_start_time` as possible. The callback is delayed if the frame
+  // start predictor predicts a positive offset.
   void FireCallback(fml::TimePoint frame_start_time,
                     fml::TimePoint frame_target_time,
                     bool pause_secondary_tasks = true);
 
+  // The offset from |frame_start_time| at which to start the frame, or zero if
+  // there is no frame start predictor. Implementations that know the time of
+  // the vsync ahead of it may call |FireCallback| early by a negative offset.
+  fml::TimeDelta GetFrameStartOffset(fml::TimePoint frame_start_time,
+                                     fml::TimePoint frame_target_time) const;
+
  private:
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  std::shared_ptr<FrameStartPredictor> frame_start_predictor_;
 
-  void PauseDartEventLoopTasks();
+  static void PauseDartEventLoopTasks(fml::TaskQueueId ui_task_queue_id);
   static void ResumeDartEventLoopTasks(fml::TaskQueueId ui_task_queue_id);
 
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiter);
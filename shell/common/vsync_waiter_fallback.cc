@@ -4,6 +4,7 @@
 
 #include "flutter/shell/common/vsync_waiter_fallback.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "flutter/fml/logging.h"
@@ -11,19 +12,6 @@
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
-namespace {
-
-static fml::TimePoint SnapToNextTick(fml::TimePoint value,
-                                     fml::TimePoint tick_phase,
-                                     fml::TimeDelta tick_interval) {
-  fml::TimeDelta offset = (tick_phase - value) % tick_interval;
-  if (offset != fml::TimeDelta::Zero()) {
-    offset = offset + tick_interval;
-  }
-  return value + offset;
-}
-
-}  // namespace
 
 VsyncWaiterFallback::VsyncWaiterFallback(const TaskRunners& task_runners,
                                          bool for_testing)
@@ -33,14 +21,31 @@ VsyncWaiterFallback::VsyncWaiterFallback(const TaskRunners& task_runners,
 
 VsyncWaiterFallback::~VsyncWaiterFallback() = default;
 
+fml::TimePoint VsyncWaiterFallback::SnapToNextTick(
+    fml::TimePoint value,
+    fml::TimePoint tick_phase,
+    fml::TimeDelta tick_interval) {
+  fml::TimeDelta offset = (tick_phase - value) % tick_interval;
+  if (offset != fml::TimeDelta::Zero()) {
+    offset = offset + tick_interval;
+  }
+  return value + offset;
+}
+
 // |VsyncWaiter|
 void VsyncWaiterFallback::AwaitVSync() {
-  constexpr fml::TimeDelta kSingleFrameInterval =
-      fml::TimeDelta::FromSecondsF(1.0 / 60.0);
-  auto frame_start_time =
-      SnapToNextTick(fml::TimePoint::Now(), phase_, kSingleFrameInterval);
+  const fml::TimePoint now = fml::TimePoint::Now();
+  auto frame_start_time = SnapToNextTick(now, phase_, kSingleFrameInterval);
   auto frame_target_time = frame_start_time + kSingleFrameInterval;
 
+  // The vsync is known ahead of time, so a frame that is predicted not to fit
+  // in the interval can be started before it.
+  const fml::TimeDelta offset =
+      GetFrameStartOffset(frame_start_time, frame_target_time);
+  if (offset < fml::TimeDelta::Zero()) {
+    frame_start_time = std::max(frame_start_time + offset, now);
+  }
+
   TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
                    frame_start_time.ToEpochDelta().ToMicroseconds(),
                    "frame_target_time",
@@ -20,6 +20,15 @@ class VsyncWaiterFallback final : public VsyncWaiter {
 
   ~VsyncWaiterFallback() override;
 
+  static constexpr fml::TimeDelta kSingleFrameInterval =
+      fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+
+  /// The first tick at or after |value| of a clock that ticks every
+  /// |tick_interval| from |tick_phase|.
+  static fml::TimePoint SnapToNextTick(fml::TimePoint value,
+                                       fml::TimePoint tick_phase,
+                                       fml::TimeDelta tick_interval);
+
  private:
   fml::TimePoint phase_;
   const bool for_testing_;
@@ -4,7 +4,11 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/shell/common/frame_start_predictor.h"
 #include "flutter/shell/common/switches.h"
+#include "flutter/shell/common/vsync_waiter_fallback.h"
 
 #include "gtest/gtest.h"
 #include "thread_host.h"
@@ -20,10 +24,33 @@ class TestVsyncWaiter : public VsyncWaiter {
 
   int await_vsync_call_count_ = 0;
 
+  void FireCallbackForTest(fml::TimePoint frame_start_time,
+                           fml::TimePoint frame_target_time,
+                           bool pause_secondary_tasks) {
+    FireCallback(frame_start_time, frame_target_time, pause_secondary_tasks);
+  }
+
  protected:
   void AwaitVSync() override { await_vsync_call_count_++; }
 };
 
+namespace {
+
+constexpr fml::TimeDelta kFrameInterval =
+    VsyncWaiterFallback::kSingleFrameInterval;
+
+// A predictor that predicts every frame to take |frame_duration|.
+std::shared_ptr<FrameStartPredictor> MakePredictor(
+    fml::TimeDelta frame_duration) {
+  auto predictor = std::make_shared<FrameStartPredictor>();
+  for (size_t i = 0; i < FrameStartPredictor::kHistorySize; i++) {
+    predictor->AddFrameDuration(frame_duration);
+  }
+  return predictor;
+}
+
+}  // namespace
+
 TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   using flutter::ThreadHost;
   std::string prefix = "vsync_waiter_test";
@@ -43,5 +70,112 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+TEST(VsyncWaiterTest, DelaysCheapFramesByThePredictedOffset) {
+  ThreadHost thread_host("io.flutter.test.vsync_waiter.",
+                         ThreadHost::Type::kUi);
+  auto task_runner = thread_host.ui_thread->GetTaskRunner();
+  const TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                                 task_runner);
+  auto vsync_waiter = std::make_shared<TestVsyncWaiter>(task_runners);
+  auto predictor = MakePredictor(fml::TimeDelta::FromMilliseconds(2));
+  vsync_waiter->SetFrameStartPredictor(predictor);
+
+  const fml::TimeDelta delay = predictor->GetFrameStartOffset(kFrameInterval);
+  ASSERT_GT(delay, fml::TimeDelta::Zero());
+
+  fml::AutoResetWaitableEvent latch;
+  fml::TimePoint callback_time;
+  std::unique_ptr<FrameTimingsRecorder> recorder;
+  vsync_waiter->AsyncWaitForVsync(
+      [&](std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+        callback_time = fml::TimePoint::Now();
+        recorder = std::move(frame_timings_recorder);
+        latch.Signal();
+      });
+  const fml::TimePoint frame_start_time = fml::TimePoint::Now();
+  const fml::TimePoint frame_target_time = frame_start_time + kFrameInterval;
+  vsync_waiter->FireCallbackForTest(frame_start_time, frame_target_time,
+                                    /*pause_secondary_tasks=*/false);
+  latch.Wait();
+
+  // The frame starts late but keeps the timings of the vsync it belongs to.
+  EXPECT_GE(callback_time, frame_start_time + delay);
+  ASSERT_TRUE(recorder);
+  EXPECT_EQ(recorder->GetVsyncStartTime(), frame_start_time);
+  EXPECT_EQ(recorder->GetVsyncTargetTime(), frame_target_time);
+}
+
+TEST(VsyncWaiterTest, DelayedFramesPauseSecondaryTasks) {
+  ThreadHost thread_host("io.flutter.test.vsync_waiter.",
+                         ThreadHost::Type::kUi);
+  auto task_runner = thread_host.ui_thread->GetTaskRunner();
+  const TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                                 task_runner);
+  auto vsync_waiter = std::make_shared<TestVsyncWaiter>(task_runners);
+  vsync_waiter->SetFrameStartPredictor(
+      MakePredictor(fml::TimeDelta::FromMilliseconds(2)));
+
+  // A Dart event loop task that is not due before the test ends. It is only
+  // counted as pending while secondary tasks are not paused.
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const fml::TaskQueueId queue_id = task_runner->GetTaskQueueId();
+  task_queues->RegisterTask(
+      queue_id, [] {}, fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(60),
+      fml::TaskSourceGrade::kDartEventLoop);
+
+  fml::AutoResetWaitableEvent latch;
+  size_t pending_tasks_during_frame = 0;
+  size_t pending_tasks_after_frame = 0;
+  vsync_waiter->AsyncWaitForVsync(
+      [&](std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+        pending_tasks_during_frame = task_queues->GetNumPendingTasks(queue_id);
+        task_runner->PostTask([&] {
+          pending_tasks_after_frame =
+              task_queues->GetNumPendingTasks(queue_id);
+          latch.Signal();
+        });
+      });
+  const fml::TimePoint frame_start_time = fml::TimePoint::Now();
+  vsync_waiter->FireCallbackForTest(frame_start_time,
+                                    frame_start_time + kFrameInterval,
+                                    /*pause_secondary_tasks=*/true);
+  latch.Wait();
+
+  EXPECT_EQ(pending_tasks_during_frame, 0u);
+  EXPECT_EQ(pending_tasks_after_frame, 1u);
+}
+
+TEST(VsyncWaiterTest, FallbackWaiterStartsExpensiveFramesEarly) {
+  ThreadHost thread_host("io.flutter.test.vsync_waiter.",
+                         ThreadHost::Type::kUi);
+  auto task_runner = thread_host.ui_thread->GetTaskRunner();
+  const TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                                 task_runner);
+  auto vsync_waiter =
+      std::make_shared<VsyncWaiterFallback>(task_runners, /*for_testing=*/true);
+  auto predictor = MakePredictor(fml::TimeDelta::FromMilliseconds(30));
+  vsync_waiter->SetFrameStartPredictor(predictor);
+
+  const fml::TimeDelta offset = predictor->GetFrameStartOffset(kFrameInterval);
+  ASSERT_LT(offset, fml::TimeDelta::Zero());
+
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<FrameTimingsRecorder> recorder;
+  vsync_waiter->AsyncWaitForVsync(
+      [&](std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+        recorder = std::move(frame_timings_recorder);
+        latch.Signal();
+      });
+  latch.Wait();
+
+  // The frame starts before the tick preceding its target time, but never
+  // earlier than the predicted offset.
+  ASSERT_TRUE(recorder);
+  const fml::TimeDelta lead =
+      recorder->GetVsyncTargetTime() - recorder->GetVsyncStartTime();
+  EXPECT_GT(lead, kFrameInterval);
+  EXPECT_LE(lead, kFrameInterval - offset);
+}
+
 }  // namespace testing
 }  // namespace flutter
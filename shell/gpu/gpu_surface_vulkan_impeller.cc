@@ -54,8 +54,14 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
+  // Without a delegate, the surface renders to the swapchain of a surface
+  // context wrapping the context that owns the worker task runner.
+  const impeller::ContextVK& context_vk =
+      delegate_ ? impeller::ContextVK::Cast(*context)
+                : *impeller::SurfaceContextVK::Cast(*context).GetParent();
   auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+      context, impeller::TypographerContextSkia::Make(
+                   context_vk.GetConcurrentWorkerTaskRunner()));
   if (!aiks_context->IsValid()) {
     return;
   }
@@ -4,8 +4,6 @@
 
 #include "flutter/shell/platform/common/client_wrapper/testing/stub_flutter_api.h"
 
-#include <cassert>
-
 static flutter::testing::StubFlutterApi* s_stub_implementation;
 
 namespace flutter {
@@ -95,30 +93,39 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
   }
 }
 
+void FlutterDesktopMessengerSetTaskRunner(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageTaskRunner task_runner,
+    void* user_data,
+    size_t capacity) {
+  if (s_stub_implementation) {
+    s_stub_implementation->MessengerSetTaskRunner(channel, task_runner,
+                                                  user_data, capacity);
+  }
+}
+
 FlutterDesktopMessengerRef FlutterDesktopMessengerAddRef(
     FlutterDesktopMessengerRef messenger) {
-  assert(false);  // not implemented
-  return nullptr;
+  return messenger;
 }
 
-void FlutterDesktopMessengerRelease(FlutterDesktopMessengerRef messenger) {
-  assert(false);  // not implemented
-}
+void FlutterDesktopMessengerRelease(FlutterDesktopMessengerRef messenger) {}
 
 bool FlutterDesktopMessengerIsAvailable(FlutterDesktopMessengerRef messenger) {
-  assert(false);  // not implemented
-  return false;
+  bool result = false;
+  if (s_stub_implementation) {
+    result = s_stub_implementation->MessengerIsAvailable();
+  }
+  return result;
 }
 
 FlutterDesktopMessengerRef FlutterDesktopMessengerLock(
     FlutterDesktopMessengerRef messenger) {
-  assert(false);  // not implemented
-  return nullptr;
+  return messenger;
 }
 
-void FlutterDesktopMessengerUnlock(FlutterDesktopMessengerRef messenger) {
-  assert(false);  // not implemented
-}
+void FlutterDesktopMessengerUnlock(FlutterDesktopMessengerRef messenger) {}
 
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
@@ -65,6 +65,16 @@ class StubFlutterApi {
                                     FlutterDesktopMessageCallback callback,
                                     void* user_data) {}
 
+  // Called for FlutterDesktopMessengerSetTaskRunner.
+  virtual void MessengerSetTaskRunner(
+      const char* channel,
+      FlutterDesktopMessageTaskRunner task_runner,
+      void* user_data,
+      size_t capacity) {}
+
+  // Called for FlutterDesktopMessengerIsAvailable.
+  virtual bool MessengerIsAvailable() { return true; }
+
   // Called for FlutterDesktopTextureRegistrarRegisterExternalTexture.
   virtual int64_t TextureRegistrarRegisterExternalTexture(
       const FlutterDesktopTextureInfo* info) {
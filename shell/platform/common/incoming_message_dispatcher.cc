@@ -4,11 +4,149 @@
 
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 namespace flutter {
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::chrono::microseconds ToMicroseconds(Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+}
+
+// A reference to a messenger that keeps it alive, though not necessarily the
+// engine it refers to.
+using MessengerReference = std::shared_ptr<FlutterDesktopMessenger>;
+
+MessengerReference AddMessengerReference(FlutterDesktopMessengerRef messenger) {
+  return MessengerReference(FlutterDesktopMessengerAddRef(messenger),
+                            &FlutterDesktopMessengerRelease);
+}
+
+// Sends an empty response to a message that will not be handled, from any
+// thread. The response is skipped if the engine is already gone.
+void SendEmptyResponse(const MessengerReference& messenger,
+                       const FlutterDesktopMessageResponseHandle* handle) {
+  FlutterDesktopMessengerLock(messenger.get());
+  if (FlutterDesktopMessengerIsAvailable(messenger.get())) {
+    FlutterDesktopMessengerSendResponse(messenger.get(), handle, nullptr, 0);
+  }
+  FlutterDesktopMessengerUnlock(messenger.get());
+}
+
+}  // namespace
+
+// A copy of a message that waits in a task queue.
+struct IncomingMessageDispatcher::QueuedMessage {
+  std::vector<uint8_t> data;
+  const FlutterDesktopMessageResponseHandle* response_handle = nullptr;
+  Clock::time_point arrival_time;
+};
+
+// The messages of a channel that wait to be handled on |task_runner|.
+struct IncomingMessageDispatcher::TaskQueue {
+  TaskQueue(std::string channel,
+            TaskRunner task_runner,
+            size_t capacity,
+            FlutterDesktopMessengerRef messenger)
+      : channel(std::move(channel)),
+        task_runner(std::move(task_runner)),
+        capacity(capacity),
+        messenger(AddMessengerReference(messenger)) {}
+
+  const std::string channel;
+  const TaskRunner task_runner;
+  const size_t capacity;
+  // Used to respond to the messages that are dropped after the dispatcher is
+  // destroyed.
+  const MessengerReference messenger;
+
+  std::mutex mutex;
+  std::deque<QueuedMessage> messages;
+  // Whether a task that handles the messages has been posted and not finished.
+  bool is_draining = false;
+};
+
+struct IncomingMessageDispatcher::SharedState {
+  explicit SharedState(FlutterDesktopMessengerRef messenger)
+      : messenger(messenger) {}
+
+  std::optional<std::pair<FlutterDesktopMessageCallback, void*>> GetCallback(
+      const std::string& channel) const {
+    std::scoped_lock lock(mutex);
+    auto callback_iterator = callbacks.find(channel);
+    if (callback_iterator == callbacks.end()) {
+      return std::nullopt;
+    }
+    return callback_iterator->second;
+  }
+
+  void RecordHandledMessage(const std::string& channel_name,
+                            Clock::time_point arrival_time,
+                            Clock::time_point start_time,
+                            Clock::time_point end_time) {
+    const std::chrono::microseconds latency =
+        ToMicroseconds(end_time - arrival_time);
+    const std::chrono::microseconds queue_time =
+        ToMicroseconds(start_time - arrival_time);
+    std::scoped_lock lock(mutex);
+    ChannelMetrics& channel = metrics[channel_name];
+    channel.handled_count++;
+    channel.total_latency += latency;
+    channel.max_latency = std::max(channel.max_latency, latency);
+    channel.total_queue_time += queue_time;
+  }
+
+  void RecordDroppedMessage(const std::string& channel) {
+    std::scoped_lock lock(mutex);
+    metrics[channel].dropped_count++;
+  }
+
+  // Calls the handler of |queue|'s channel with |queued_message|.
+  void HandleQueuedMessage(const TaskQueue& queue,
+                           const QueuedMessage& queued_message) {
+    const Clock::time_point start_time = Clock::now();
+    auto callback = GetCallback(queue.channel);
+    if (!callback) {
+      // The handler was unregistered after the message was taken from the
+      // queue.
+      SendEmptyResponse(queue.messenger, queued_message.response_handle);
+      RecordDroppedMessage(queue.channel);
+      return;
+    }
+    FlutterDesktopMessage message = {
+        .struct_size = sizeof(FlutterDesktopMessage),
+        .channel = queue.channel.c_str(),
+        .message = queued_message.data.data(),
+        .message_size = queued_message.data.size(),
+        .response_handle = queued_message.response_handle,
+    };
+    callback->first(messenger, &message, callback->second);
+    RecordHandledMessage(queue.channel, queued_message.arrival_time,
+                         start_time, Clock::now());
+  }
+
+  const FlutterDesktopMessengerRef messenger;
+
+  mutable std::mutex mutex;
+
+  // A map from channel names to the FlutterDesktopMessageCallback that should
+  // be called for incoming messages on that channel, along with the void* user
+  // data to pass to it.
+  std::map<std::string, std::pair<FlutterDesktopMessageCallback, void*>>
+      callbacks;
+
+  std::map<std::string, ChannelMetrics> metrics;
+};
+
 IncomingMessageDispatcher::IncomingMessageDispatcher(
     FlutterDesktopMessengerRef messenger)
-    : messenger_(messenger) {}
+    : messenger_(messenger), state_(std::make_shared<SharedState>(messenger)) {}
 
 IncomingMessageDispatcher::~IncomingMessageDispatcher() = default;
 
@@ -17,27 +155,59 @@ void IncomingMessageDispatcher::HandleMessage(
     const FlutterDesktopMessage& message,
     const std::function<void(void)>& input_block_cb,
     const std::function<void(void)>& input_unblock_cb) {
+  const Clock::time_point arrival_time = Clock::now();
   std::string channel(message.channel);
 
-  auto callback_iterator = callbacks_.find(channel);
+  auto callback = state_->GetCallback(channel);
   // Find the handler for the channel; if there isn't one, report the failure.
-  if (callback_iterator == callbacks_.end()) {
+  if (!callback) {
     FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
                                         nullptr, 0);
     return;
   }
-  auto& callback_info = callback_iterator->second;
-  const FlutterDesktopMessageCallback& message_callback = callback_info.first;
+
+  auto queue_iterator = task_queues_.find(channel);
+  if (queue_iterator != task_queues_.end()) {
+    std::shared_ptr<TaskQueue> queue = queue_iterator->second;
+    std::optional<QueuedMessage> dropped_message;
+    bool start_draining = false;
+    {
+      std::scoped_lock lock(queue->mutex);
+      if (queue->messages.size() >= queue->capacity) {
+        dropped_message = std::move(queue->messages.front());
+        queue->messages.pop_front();
+      }
+      queue->messages.push_back({
+          .data = std::vector<uint8_t>(message.message,
+                                       message.message + message.message_size),
+          .response_handle = message.response_handle,
+          .arrival_time = arrival_time,
+      });
+      start_draining = !queue->is_draining;
+      queue->is_draining = true;
+    }
+    if (dropped_message) {
+      FlutterDesktopMessengerSendResponse(
+          messenger_, dropped_message->response_handle, nullptr, 0);
+      state_->RecordDroppedMessage(channel);
+    }
+    if (start_draining) {
+      PostDrainTask(state_, std::move(queue));
+    }
+    return;
+  }
 
   // Process the call, handling input blocking if requested.
   bool block_input = input_blocking_channels_.count(channel) > 0;
   if (block_input) {
     input_block_cb();
   }
-  message_callback(messenger_, &message, callback_info.second);
+  callback->first(messenger_, &message, callback->second);
   if (block_input) {
     input_unblock_cb();
   }
+  state_->RecordHandledMessage(channel, arrival_time, arrival_time,
+                               Clock::now());
 }
 
 void IncomingMessageDispatcher::SetMessageCallback(
@@ -45,10 +215,28 @@ void IncomingMessageDispatcher::SetMessageCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data) {
   if (!callback) {
-    callbacks_.erase(channel);
+    {
+      std::scoped_lock lock(state_->mutex);
+      state_->callbacks.erase(channel);
+    }
+    // Respond to the messages that will no longer be handled while the
+    // messenger is known to be valid.
+    auto queue_iterator = task_queues_.find(channel);
+    if (queue_iterator != task_queues_.end()) {
+      std::deque<QueuedMessage> messages;
+      {
+        std::scoped_lock lock(queue_iterator->second->mutex);
+        messages.swap(queue_iterator->second->messages);
+      }
+      for (const QueuedMessage& message : messages) {
+        FlutterDesktopMessengerSendResponse(messenger_, message.response_handle,
+                                            nullptr, 0);
+      }
+    }
     return;
   }
-  callbacks_[channel] = std::make_pair(callback, user_data);
+  std::scoped_lock lock(state_->mutex);
+  state_->callbacks[channel] = std::make_pair(callback, user_data);
 }
 
 void IncomingMessageDispatcher::EnableInputBlockingForChannel(
@@ -56,4 +244,91 @@ void IncomingMessageDispatcher::EnableInputBlockingForChannel(
   input_blocking_channels_.insert(channel);
 }
 
+void IncomingMessageDispatcher::SetMessageTaskQueue(const std::string& channel,
+                                                    TaskRunner task_runner,
+                                                    size_t capacity) {
+  if (!task_runner) {
+    task_queues_.erase(channel);
+    return;
+  }
+  task_queues_[channel] = std::make_shared<TaskQueue>(
+      channel, std::move(task_runner), std::max<size_t>(capacity, 1),
+      messenger_);
+}
+
+IncomingMessageDispatcher::TaskRunner IncomingMessageDispatcher::WrapTaskRunner(
+    FlutterDesktopMessageTaskRunner task_runner,
+    void* user_data) {
+  if (!task_runner) {
+    return nullptr;
+  }
+  return [task_runner, user_data](std::function<void()> task) {
+    task_runner(
+        [](void* task_data) {
+          std::unique_ptr<std::function<void()>> task(
+              static_cast<std::function<void()>*>(task_data));
+          (*task)();
+        },
+        new std::function<void()>(std::move(task)), user_data);
+  };
+}
+
+std::optional<IncomingMessageDispatcher::ChannelMetrics>
+IncomingMessageDispatcher::GetChannelMetrics(const std::string& channel) const {
+  std::scoped_lock lock(state_->mutex);
+  auto metrics_iterator = state_->metrics.find(channel);
+  if (metrics_iterator == state_->metrics.end()) {
+    return std::nullopt;
+  }
+  return metrics_iterator->second;
+}
+
+void IncomingMessageDispatcher::PostDrainTask(
+    std::weak_ptr<SharedState> weak_state,
+    std::shared_ptr<TaskQueue> queue) {
+  TaskQueue* task_queue = queue.get();
+  task_queue->task_runner([weak_state, queue = std::move(queue)]() mutable {
+    std::optional<QueuedMessage> queued_message;
+    {
+      std::scoped_lock lock(queue->mutex);
+      if (!queue->messages.empty()) {
+        queued_message = std::move(queue->messages.front());
+        queue->messages.pop_front();
+      }
+    }
+    std::shared_ptr<SharedState> state = weak_state.lock();
+    if (state) {
+      if (queued_message) {
+        state->HandleQueuedMessage(*queue, *queued_message);
+      }
+    } else {
+      // The dispatcher is gone, and with it the handlers. Every message that
+      // is still waiting is answered so that its sender isn't left waiting.
+      std::deque<QueuedMessage> dropped_messages;
+      {
+        std::scoped_lock lock(queue->mutex);
+        dropped_messages.swap(queue->messages);
+      }
+      if (queued_message) {
+        dropped_messages.push_front(std::move(*queued_message));
+      }
+      for (const QueuedMessage& message : dropped_messages) {
+        SendEmptyResponse(queue->messenger, message.response_handle);
+      }
+    }
+    {
+      std::scoped_lock lock(queue->mutex);
+      if (!state) {
+        // Messages can no longer be added to the queue.
+        queue->messages.clear();
+      }
+      if (queue->messages.empty()) {
+        queue->is_draining = false;
+        return;
+      }
+    }
+    PostDrainTask(std::move(weak_state), std::move(queue));
+  });
+}
+
 }  // namespace flutter
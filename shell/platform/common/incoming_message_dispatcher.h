@@ -5,8 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_COMMON_INCOMING_MESSAGE_DISPATCHER_H_
 #define FLUTTER_SHELL_PLATFORM_COMMON_INCOMING_MESSAGE_DISPATCHER_H_
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -17,8 +21,40 @@ namespace flutter {
 
 // Manages per-channel registration of callbacks for handling messages from the
 // Flutter engine, and dispatching incoming messages to those handlers.
+//
+// Messages are handled on the platform thread unless a task queue has been set
+// for their channel, in which case they are handled, in order, by tasks posted
+// to that queue.
 class IncomingMessageDispatcher {
  public:
+  // Runs |task| on a thread other than the platform thread. The tasks of a
+  // channel are posted one at a time, so a task runner that runs tasks
+  // concurrently still handles the messages of each channel in order.
+  using TaskRunner = std::function<void(std::function<void()> task)>;
+
+  // The number of messages that may wait in a channel's task queue by default
+  // before the oldest of them are dropped.
+  static constexpr size_t kDefaultTaskQueueCapacity = 64;
+
+  // Statistics about the messages received on a channel.
+  struct ChannelMetrics {
+    // The number of messages that were passed to the channel's handler.
+    uint64_t handled_count = 0;
+
+    // The number of messages that were dropped because the channel's task
+    // queue was full.
+    uint64_t dropped_count = 0;
+
+    // The sum and the maximum of the time from the arrival of a message to the
+    // return of its handler.
+    std::chrono::microseconds total_latency{0};
+    std::chrono::microseconds max_latency{0};
+
+    // The sum of the time messages waited in the channel's task queue before
+    // their handler was called.
+    std::chrono::microseconds total_queue_time{0};
+  };
+
   // Creates a new IncomingMessageDispatcher. |messenger| must remain valid as
   // long as this object exists.
   explicit IncomingMessageDispatcher(FlutterDesktopMessengerRef messenger);
@@ -37,6 +73,12 @@ class IncomingMessageDispatcher {
   //
   // If no handler is registered for the message's channel, sends a
   // NotImplemented response to the engine.
+  //
+  // If a task queue has been set for the message's channel, the message is
+  // copied and handled later on that queue, without input blocking. If the
+  // queue is full, the oldest message in it is dropped and sent an empty
+  // response, so that the queue cannot grow without bound when the handler
+  // falls behind.
   void HandleMessage(
       const FlutterDesktopMessage& message,
       const std::function<void(void)>& input_block_cb = [] {},
@@ -58,15 +100,49 @@ class IncomingMessageDispatcher {
   // while waiting for the handler for messages on that channel to run.
   void EnableInputBlockingForChannel(const std::string& channel);
 
+  // Handles the messages that arrive on |channel| from now on by posting tasks
+  // to |task_runner|, keeping at most |capacity| of them waiting. Pass a null
+  // task runner to handle them on the platform thread again. Messages that are
+  // already queued are still handled on the previous task runner.
+  //
+  // The channel's handler is then called on the threads of |task_runner|, and
+  // must follow the rules for using the messenger from those threads. It may
+  // still be running when it is unregistered. Messages that are dropped
+  // because the handler was unregistered or this object was destroyed are
+  // sent an empty response.
+  void SetMessageTaskQueue(const std::string& channel,
+                           TaskRunner task_runner,
+                           size_t capacity = kDefaultTaskQueueCapacity);
+
+  // Adapts a task runner of the C API to a |TaskRunner|. Returns a null task
+  // runner if |task_runner| is null.
+  static TaskRunner WrapTaskRunner(FlutterDesktopMessageTaskRunner task_runner,
+                                   void* user_data);
+
+  // Returns the statistics of the messages received on |channel|, or nullopt
+  // if none have been received. May be called from any thread.
+  std::optional<ChannelMetrics> GetChannelMetrics(
+      const std::string& channel) const;
+
  private:
+  struct QueuedMessage;
+  struct TaskQueue;
+  struct SharedState;
+
+  // Posts a task to |queue| that handles its oldest message, and then posts
+  // the next task if more messages are waiting.
+  static void PostDrainTask(std::weak_ptr<SharedState> weak_state,
+                            std::shared_ptr<TaskQueue> queue);
+
   // Handle for interacting with the C messaging API.
   FlutterDesktopMessengerRef messenger_;
 
-  // A map from channel names to the FlutterDesktopMessageCallback that should
-  // be called for incoming messages on that channel, along with the void* user
-  // data to pass to it.
-  std::map<std::string, std::pair<FlutterDesktopMessageCallback, void*>>
-      callbacks_;
+  // The state that is also used by the tasks of the task queues, which may
+  // outlive this object.
+  std::shared_ptr<SharedState> state_;
+
+  // A map from channel names to the task queues their messages are posted to.
+  std::map<std::string, std::shared_ptr<TaskQueue>> task_queues_;
 
   // Channel names for which input blocking should be enabled during the call to
   // that channel's handler.
@@ -4,9 +4,73 @@
 
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/testing/stub_flutter_api.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
+
+namespace {
+
+// Records the responses sent to the engine.
+class TestApi : public testing::StubFlutterApi {
+ public:
+  void MessengerSendResponse(const FlutterDesktopMessageResponseHandle* handle,
+                             const uint8_t* data,
+                             size_t data_length) override {
+    responses.push_back(handle);
+  }
+
+  std::vector<const FlutterDesktopMessageResponseHandle*> responses;
+};
+
+// A task runner that runs its tasks when asked to.
+class TestTaskRunner {
+ public:
+  IncomingMessageDispatcher::TaskRunner GetTaskRunner() {
+    return [this](std::function<void()> task) {
+      tasks_.push_back(std::move(task));
+    };
+  }
+
+  size_t GetPendingTaskCount() const { return tasks_.size(); }
+
+  void RunTasks() {
+    while (!tasks_.empty()) {
+      std::function<void()> task = std::move(tasks_.front());
+      tasks_.erase(tasks_.begin());
+      task();
+    }
+  }
+
+ private:
+  std::vector<std::function<void()>> tasks_;
+};
+
+void RecordMessage(FlutterDesktopMessengerRef messenger,
+                   const FlutterDesktopMessage* message,
+                   void* user_data) {
+  reinterpret_cast<std::vector<std::string>*>(user_data)->emplace_back(
+      reinterpret_cast<const char*>(message->message), message->message_size);
+}
+
+FlutterDesktopMessage CreateMessage(const std::string& data,
+                                    uintptr_t response_handle = 0) {
+  return {
+      .struct_size = sizeof(FlutterDesktopMessage),
+      .channel = "hello",
+      .message = reinterpret_cast<const uint8_t*>(data.data()),
+      .message_size = data.size(),
+      .response_handle =
+          reinterpret_cast<const FlutterDesktopMessageResponseHandle*>(
+              response_handle),
+  };
+}
+
+}  // namespace
+
 TEST(IncomingMessageDispatcher, SetHandle) {
   FlutterDesktopMessengerRef messenger =
       reinterpret_cast<FlutterDesktopMessengerRef>(0xfeedface);
@@ -88,4 +152,140 @@ TEST(IncomingMessageDispatcher, BlockInputTrue) {
   EXPECT_EQ(did_call[2], 2);
 }
 
+TEST(IncomingMessageDispatcher, TaskQueueHandlesMessagesInOrder) {
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(nullptr);
+  TestTaskRunner task_runner;
+  std::vector<std::string> received;
+  dispatcher->SetMessageCallback("hello", RecordMessage, &received);
+  dispatcher->SetMessageTaskQueue("hello", task_runner.GetTaskRunner());
+
+  for (std::string data : {"a", "b", "c"}) {
+    // The message is copied, so its data may be gone before it is handled.
+    dispatcher->HandleMessage(CreateMessage(data));
+  }
+  EXPECT_TRUE(received.empty());
+  // Messages of a channel are handled by one task at a time.
+  EXPECT_EQ(task_runner.GetPendingTaskCount(), 1u);
+
+  task_runner.RunTasks();
+  EXPECT_EQ(received, std::vector<std::string>({"a", "b", "c"}));
+
+  auto metrics = dispatcher->GetChannelMetrics("hello");
+  ASSERT_TRUE(metrics.has_value());
+  EXPECT_EQ(metrics->handled_count, 3u);
+  EXPECT_EQ(metrics->dropped_count, 0u);
+  EXPECT_GE(metrics->total_latency, metrics->total_queue_time);
+  EXPECT_GE(metrics->total_latency, metrics->max_latency);
+}
+
+TEST(IncomingMessageDispatcher, TaskQueueDropsOldestMessagesWhenFull) {
+  testing::ScopedStubFlutterApi scoped_api_stub(std::make_unique<TestApi>());
+  auto test_api = static_cast<TestApi*>(scoped_api_stub.stub());
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(nullptr);
+  TestTaskRunner task_runner;
+  std::vector<std::string> received;
+  dispatcher->SetMessageCallback("hello", RecordMessage, &received);
+  dispatcher->SetMessageTaskQueue("hello", task_runner.GetTaskRunner(),
+                                  /*capacity=*/2);
+
+  dispatcher->HandleMessage(CreateMessage("a", 1));
+  dispatcher->HandleMessage(CreateMessage("b", 2));
+  EXPECT_TRUE(test_api->responses.empty());
+  dispatcher->HandleMessage(CreateMessage("c", 3));
+  // The oldest message is answered with an empty response.
+  ASSERT_EQ(test_api->responses.size(), 1u);
+  EXPECT_EQ(test_api->responses[0],
+            reinterpret_cast<const FlutterDesktopMessageResponseHandle*>(1));
+
+  task_runner.RunTasks();
+  EXPECT_EQ(received, std::vector<std::string>({"b", "c"}));
+
+  auto metrics = dispatcher->GetChannelMetrics("hello");
+  ASSERT_TRUE(metrics.has_value());
+  EXPECT_EQ(metrics->handled_count, 2u);
+  EXPECT_EQ(metrics->dropped_count, 1u);
+}
+
+TEST(IncomingMessageDispatcher, UnregisteringRespondsToQueuedMessages) {
+  testing::ScopedStubFlutterApi scoped_api_stub(std::make_unique<TestApi>());
+  auto test_api = static_cast<TestApi*>(scoped_api_stub.stub());
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(nullptr);
+  TestTaskRunner task_runner;
+  std::vector<std::string> received;
+  dispatcher->SetMessageCallback("hello", RecordMessage, &received);
+  dispatcher->SetMessageTaskQueue("hello", task_runner.GetTaskRunner());
+
+  dispatcher->HandleMessage(CreateMessage("a", 1));
+  dispatcher->HandleMessage(CreateMessage("b", 2));
+  dispatcher->SetMessageCallback("hello", nullptr, nullptr);
+  EXPECT_EQ(test_api->responses.size(), 2u);
+
+  task_runner.RunTasks();
+  EXPECT_TRUE(received.empty());
+}
+
+TEST(IncomingMessageDispatcher, QueuedMessagesAreNotHandledAfterDestruction) {
+  testing::ScopedStubFlutterApi scoped_api_stub(std::make_unique<TestApi>());
+  auto test_api = static_cast<TestApi*>(scoped_api_stub.stub());
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(nullptr);
+  TestTaskRunner task_runner;
+  std::vector<std::string> received;
+  dispatcher->SetMessageCallback("hello", RecordMessage, &received);
+  dispatcher->SetMessageTaskQueue("hello", task_runner.GetTaskRunner());
+
+  dispatcher->HandleMessage(CreateMessage("a", 1));
+  dispatcher->HandleMessage(CreateMessage("b", 2));
+  dispatcher.reset();
+  EXPECT_TRUE(test_api->responses.empty());
+
+  task_runner.RunTasks();
+  EXPECT_TRUE(received.empty());
+  EXPECT_EQ(task_runner.GetPendingTaskCount(), 0u);
+  // Every dropped message is still answered.
+  EXPECT_EQ(
+      test_api->responses,
+      std::vector<const FlutterDesktopMessageResponseHandle*>(
+          {reinterpret_cast<const FlutterDesktopMessageResponseHandle*>(1),
+           reinterpret_cast<const FlutterDesktopMessageResponseHandle*>(2)}));
+}
+
+TEST(IncomingMessageDispatcher, WrapsTaskRunnersOfTheCApi) {
+  EXPECT_EQ(IncomingMessageDispatcher::WrapTaskRunner(nullptr, nullptr),
+            nullptr);
+
+  // Runs every task immediately.
+  FlutterDesktopMessageTaskRunner run_task =
+      [](FlutterDesktopMessageTask task, void* task_data, void* user_data) {
+        (*static_cast<int*>(user_data))++;
+        task(task_data);
+      };
+  int posted_count = 0;
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(nullptr);
+  std::vector<std::string> received;
+  dispatcher->SetMessageCallback("hello", RecordMessage, &received);
+  dispatcher->SetMessageTaskQueue(
+      "hello",
+      IncomingMessageDispatcher::WrapTaskRunner(run_task, &posted_count));
+
+  dispatcher->HandleMessage(CreateMessage("a"));
+  dispatcher->HandleMessage(CreateMessage("b"));
+  EXPECT_EQ(received, std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(posted_count, 2);
+}
+
+TEST(IncomingMessageDispatcher, MetricsAreRecordedForPlatformThreadChannels) {
+  auto dispatcher = std::make_unique<IncomingMessageDispatcher>(nullptr);
+  std::vector<std::string> received;
+  EXPECT_FALSE(dispatcher->GetChannelMetrics("hello").has_value());
+  dispatcher->SetMessageCallback("hello", RecordMessage, &received);
+
+  dispatcher->HandleMessage(CreateMessage("a"));
+  EXPECT_EQ(received, std::vector<std::string>({"a"}));
+
+  auto metrics = dispatcher->GetChannelMetrics("hello");
+  ASSERT_TRUE(metrics.has_value());
+  EXPECT_EQ(metrics->handled_count, 1u);
+  EXPECT_EQ(metrics->total_queue_time.count(), 0);
+}
+
 }  // namespace flutter
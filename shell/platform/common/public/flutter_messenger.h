@@ -51,6 +51,21 @@ typedef void (*FlutterDesktopMessageCallback)(
     const FlutterDesktopMessage* /* message*/,
     void* /* user data */);
 
+// Function pointer type for a task posted by the messenger, which must be
+// called exactly once with the |task_data| it was posted with.
+typedef void (*FlutterDesktopMessageTask)(void* /* task_data */);
+
+// Function pointer type for a task runner that handles the messages of a
+// channel away from the platform thread. It must arrange for |task| to be
+// called with |task_data|, e.g. by posting it to a thread pool.
+//
+// The user data will be whatever was passed to
+// FlutterDesktopMessengerSetTaskRunner for the channel.
+typedef void (*FlutterDesktopMessageTaskRunner)(
+    FlutterDesktopMessageTask /* task */,
+    void* /* task_data */,
+    void* /* user data */);
+
 // Sends a binary message to the Flutter side on the specified channel.
 FLUTTER_EXPORT bool FlutterDesktopMessengerSend(
     FlutterDesktopMessengerRef messenger,
@@ -90,6 +105,24 @@ FLUTTER_EXPORT void FlutterDesktopMessengerSetCallback(
     FlutterDesktopMessageCallback callback,
     void* user_data);
 
+// Handles the messages that arrive on the specified channel from now on on the
+// threads of |task_runner| rather than the platform thread. At most |capacity|
+// messages wait to be handled; when more arrive, the oldest are dropped and
+// sent an empty response. A capacity of 0 selects a default.
+//
+// The callback registered for the channel is then called on the threads of
+// |task_runner|, and must lock the messenger as described in
+// |FlutterDesktopMessengerLock| before using it. Provide a null task runner to
+// handle the channel's messages on the platform thread again.
+//
+// If |user_data| is provided, it will be passed in |task_runner| calls.
+FLUTTER_EXPORT void FlutterDesktopMessengerSetTaskRunner(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageTaskRunner task_runner,
+    void* user_data,
+    size_t capacity);
+
 // Increments the reference count for the |messenger|.
 //
 // Operation is thread-safe.
@@ -127,6 +127,11 @@ void PlatformViewIOS::attachView() {
 }
 
 PointerDataDispatcherMaker PlatformViewIOS::GetDispatcherMaker() {
+  if (GetSettings().enable_pointer_resampling) {
+    return [](DefaultPointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+    };
+  }
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<SmoothPointerDataDispatcher>(delegate);
   };
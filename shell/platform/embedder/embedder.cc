@@ -2884,9 +2884,12 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
       message_data);
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
+// Sends |flutter_message| to the engine. If |external_data| is set, it holds
+// the data of the message, which is then sent without being copied.
+static FlutterEngineResult SendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+    const FlutterPlatformMessage* flutter_message,
+    std::unique_ptr<fml::Mapping> external_data) {
   if (engine == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
   }
@@ -2921,6 +2924,9 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   if (message_size == 0) {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel, response);
+  } else if (external_data) {
+    message = std::make_unique<flutter::PlatformMessage>(
+        flutter_message->channel, std::move(external_data), response);
   } else {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
@@ -2935,6 +2941,43 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return SendPlatformMessage(engine, flutter_message, nullptr);
+}
+
+// Wraps a buffer owned by the embedder, which is released through
+// |release_callback| when the mapping is destroyed.
+static std::unique_ptr<fml::Mapping> CreateReleasableMapping(
+    const uint8_t* data,
+    size_t size,
+    VoidCallback release_callback,
+    void* user_data) {
+  return std::make_unique<fml::NonOwnedMapping>(
+      data, size, [release_callback, user_data](const uint8_t*, size_t) {
+        release_callback(user_data);
+      });
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message,
+    VoidCallback release_callback,
+    void* user_data) {
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid release callback.");
+  }
+
+  // The buffer is released on every path that doesn't hand it to the engine.
+  std::unique_ptr<fml::Mapping> data = CreateReleasableMapping(
+      flutter_message ? SAFE_ACCESS(flutter_message, message, nullptr)
+                      : nullptr,
+      flutter_message ? SAFE_ACCESS(flutter_message, message_size, 0) : 0,
+      release_callback, user_data);
+  return SendPlatformMessage(engine, flutter_message, std::move(data));
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -3012,6 +3055,42 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
   return kSuccess;
 }
 
+// Note: This can execute on any thread.
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* user_data) {
+  if (release_callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid release callback.");
+  }
+
+  // The buffer is released on every path that doesn't hand it to the engine.
+  std::unique_ptr<fml::Mapping> mapping =
+      CreateReleasableMapping(data, data_length, release_callback, user_data);
+  if (data_length != 0 && data == nullptr) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "Data size was non zero but the pointer to the data was null.");
+  }
+
+  auto response = handle->message->response();
+
+  if (response) {
+    if (data_length == 0) {
+      response->CompleteEmpty();
+    } else {
+      response->Complete(std::move(mapping));
+    }
+  }
+
+  delete handle;
+
+  return kSuccess;
+}
+
 FlutterEngineResult __FlutterEngineFlushPendingTasksNow() {
   fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
   return kSuccess;
@@ -3583,6 +3662,54 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineGetFramePhaseStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFramePhase phase,
+    uint64_t window_millis,
+    FlutterFramePhaseStatistics* statistics) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  static_assert(kFlutterFramePhaseCount ==
+                flutter::FrameTimingHistograms::kPhaseCount);
+  if (static_cast<size_t>(phase) >= kFlutterFramePhaseCount) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid frame phase.");
+  }
+
+  if (statistics == nullptr || !STRUCT_HAS_MEMBER(statistics, p999_micros)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame phase statistics.");
+  }
+
+  const std::shared_ptr<flutter::FrameTimingHistograms>& histograms =
+      reinterpret_cast<flutter::EmbedderEngine*>(engine)
+          ->GetShell()
+          .GetFrameTimingHistograms();
+  if (!histograms) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Frame timing histograms unavailable.");
+  }
+
+  const fml::TimeDelta max_window = flutter::FrameTimingHistograms::kMaxWindow;
+  const fml::TimeDelta window =
+      window_millis == 0 ? max_window
+                         : fml::TimeDelta::FromMilliseconds(std::min<uint64_t>(
+                               window_millis, max_window.ToMilliseconds()));
+  const flutter::FrameTimingHistograms::Statistics result =
+      histograms->GetStatistics(
+          static_cast<flutter::FrameTimingHistograms::Phase>(phase), window);
+  statistics->count = result.count;
+  statistics->min_micros = result.min.ToMicroseconds();
+  statistics->max_micros = result.max.ToMicroseconds();
+  statistics->mean_micros = result.mean.ToMicroseconds();
+  statistics->p50_micros = result.p50.ToMicroseconds();
+  statistics->p90_micros = result.p90.ToMicroseconds();
+  statistics->p99_micros = result.p99.ToMicroseconds();
+  statistics->p999_micros = result.p999.ToMicroseconds();
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3637,6 +3764,10 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
   SET_PROC(AddView, FlutterEngineAddView);
   SET_PROC(RemoveView, FlutterEngineRemoveView);
+  SET_PROC(GetFramePhaseStatistics, FlutterEngineGetFramePhaseStatistics);
+  SET_PROC(SendPlatformMessageNoCopy, FlutterEngineSendPlatformMessageNoCopy);
+  SET_PROC(SendPlatformMessageResponseNoCopy,
+           FlutterEngineSendPlatformMessageResponseNoCopy);
 #undef SET_PROC
 
   return kSuccess;
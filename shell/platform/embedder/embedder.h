@@ -2084,6 +2084,44 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// The phases of rendering a frame whose latencies are reported by
+/// `FlutterEngineGetFramePhaseStatistics`.
+typedef enum {
+  /// From the vsync signal to the start of the build.
+  kFlutterFramePhaseVsyncToBuildStart,
+  /// Building the layer tree on the UI thread.
+  kFlutterFramePhaseBuild,
+  /// Rasterizing the layer tree on the raster thread.
+  kFlutterFramePhaseRaster,
+  /// Submitting a rasterized frame to the render surface, per view.
+  kFlutterFramePhaseGpuSubmit,
+  /// From the vsync signal to the end of the rasterization of the frame.
+  kFlutterFramePhasePresentLatency,
+  /// Populating the raster cache during a frame.
+  kFlutterFramePhaseRasterCache,
+  /// From the end of the build to the start of the rasterization, while the
+  /// frame waits in the pipeline.
+  kFlutterFramePhasePipelineQueue,
+  kFlutterFramePhaseCount,
+} FlutterFramePhase;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFramePhaseStatistics).
+  size_t struct_size;
+  /// The number of durations recorded in the window.
+  uint64_t count;
+  /// The durations are in microseconds. Percentiles are rounded up to the
+  /// precision of the histogram, so they may overstate the duration by up to
+  /// 6.25%.
+  int64_t min_micros;
+  int64_t max_micros;
+  int64_t mean_micros;
+  int64_t p50_micros;
+  int64_t p90_micros;
+  int64_t p99_micros;
+  int64_t p999_micros;
+} FlutterFramePhaseStatistics;
+
 typedef int64_t FlutterEngineDartPort;
 
 typedef enum {
@@ -2757,6 +2795,35 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the Flutter application without
+///             copying its data, unlike `FlutterEngineSendPlatformMessage`.
+///             Messages larger than a kilobyte are handed to Dart as external
+///             typed data that points at the buffer of the embedder, so large
+///             binary payloads (e.g. camera frames or file chunks) are never
+///             copied.
+///
+///             The engine takes ownership of `message->message`, which must
+///             stay valid and unmodified until `release_callback` is called.
+///             The release callback is called exactly once with `user_data`,
+///             on an arbitrary thread, including when this call fails. It may
+///             be called before this call returns.
+///
+/// @param[in]  engine            A running engine instance.
+/// @param[in]  message           The message to send.
+/// @param[in]  release_callback  Called when the engine no longer needs the
+///                               data of the message.
+/// @param[in]  user_data         The user data passed to the release callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -2830,6 +2897,38 @@ FlutterEngineResult FlutterEngineSendPlatformMessageResponse(
     const uint8_t* data,
     size_t data_length);
 
+//------------------------------------------------------------------------------
+/// @brief      Send a response from the native side to a platform message from
+///             the Dart Flutter application without copying its data, unlike
+///             `FlutterEngineSendPlatformMessageResponse`.
+///
+///             The engine takes ownership of `data`, which must stay valid and
+///             unmodified until `release_callback` is called. The release
+///             callback is called exactly once with `user_data`, on an
+///             arbitrary thread, including when this call fails. It may be
+///             called before this call returns.
+///
+/// @param[in]  engine            The running engine instance.
+/// @param[in]  handle            The platform message response handle.
+/// @param[in]  data              The data to associate with the platform
+///                               message response.
+/// @param[in]  data_length       The length of the platform message response
+///                               data.
+/// @param[in]  release_callback  Called when the engine no longer needs
+///                               `data`.
+/// @param[in]  user_data         The user data passed to the release callback.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageResponseNoCopy(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief      This API is only meant to be used by platforms that need to
 ///             flush tasks on a message loop not controlled by the Flutter
@@ -3263,6 +3362,30 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the latency statistics of a phase of the frames rendered
+///             by the engine recently. The engine keeps these histograms
+///             whether or not tracing is enabled. This may be called from any
+///             thread.
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  phase          The phase of the frames.
+/// @param[in]  window_millis  The duration of the window of recent frames, in
+///                            milliseconds. It is rounded up to 10 seconds and
+///                            clamped to the last minute. Pass 0 for the
+///                            longest window.
+/// @param[out] statistics     The statistics of the phase. Its `struct_size`
+///                            must be set by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFramePhaseStatistics(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFramePhase phase,
+    uint64_t window_millis,
+    FlutterFramePhaseStatistics* statistics);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -3304,6 +3427,11 @@ typedef FlutterEngineResult (*FlutterEngineSendKeyEventFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
+typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message,
+    VoidCallback release_callback,
+    void* user_data);
 typedef FlutterEngineResult (
     *FlutterEnginePlatformMessageCreateResponseHandleFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -3319,6 +3447,14 @@ typedef FlutterEngineResult (*FlutterEngineSendPlatformMessageResponseFnPtr)(
     const FlutterPlatformMessageResponseHandle* handle,
     const uint8_t* data,
     size_t data_length);
+typedef FlutterEngineResult (
+    *FlutterEngineSendPlatformMessageResponseNoCopyFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessageResponseHandle* handle,
+    const uint8_t* data,
+    size_t data_length,
+    VoidCallback release_callback,
+    void* user_data);
 typedef FlutterEngineResult (*FlutterEngineRegisterExternalTextureFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     int64_t texture_identifier);
@@ -3391,6 +3527,11 @@ typedef FlutterEngineResult (*FlutterEngineAddViewFnPtr)(
 typedef FlutterEngineResult (*FlutterEngineRemoveViewFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterRemoveViewInfo* info);
+typedef FlutterEngineResult (*FlutterEngineGetFramePhaseStatisticsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFramePhase phase,
+    uint64_t window_millis,
+    FlutterFramePhaseStatistics* statistics);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -3439,6 +3580,10 @@ typedef struct {
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
   FlutterEngineAddViewFnPtr AddView;
   FlutterEngineRemoveViewFnPtr RemoveView;
+  FlutterEngineGetFramePhaseStatisticsFnPtr GetFramePhaseStatistics;
+  FlutterEngineSendPlatformMessageNoCopyFnPtr SendPlatformMessageNoCopy;
+  FlutterEngineSendPlatformMessageResponseNoCopyFnPtr
+      SendPlatformMessageResponseNoCopy;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
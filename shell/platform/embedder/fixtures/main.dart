@@ -400,6 +400,22 @@ void platform_messages_response() {
   signalNativeTest();
 }
 
+@pragma('vm:entry-point')
+// ignore: non_constant_identifier_names
+void platform_message_response_echo() {
+  PlatformDispatcher.instance.sendPlatformMessage('test_channel', null,
+      (ByteData? data) {
+    bool isUnmodifiable = false;
+    try {
+      data!.setUint8(0, data.getUint8(0));
+    } on UnsupportedError {
+      isUnmodifiable = true;
+    }
+    notifyBoolValue(isUnmodifiable);
+    PlatformDispatcher.instance.sendPlatformMessage('echo_channel', data, null);
+  });
+}
+
 @pragma('vm:entry-point')
 // ignore: non_constant_identifier_names
 void platform_messages_no_response() {
@@ -423,6 +423,181 @@ TEST_F(EmbedderTest, PlatformMessagesCanReceiveResponse) {
   captures.latch.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Sends a large platform message without copying it to Dart code that echoes
+/// the contents back, and checks that the buffer of the embedder is released
+/// once the engine is done with it.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutCopies) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(SkISize::Make(1, 1));
+  builder.SetDartEntrypoint("platform_messages_response");
+
+  fml::AutoResetWaitableEvent ready;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  struct Captures {
+    std::vector<uint8_t> message_data;
+    std::vector<uint8_t> response_data;
+    fml::AutoResetWaitableEvent response_latch;
+    fml::AutoResetWaitableEvent release_latch;
+  };
+  Captures captures;
+  for (size_t i = 0; i < 64 * 1024; i++) {
+    captures.message_data.push_back(i % 251);
+  }
+
+  FlutterPlatformMessageResponseHandle* response_handle = nullptr;
+  auto callback = [](const uint8_t* data, size_t size,
+                     void* user_data) -> void {
+    auto captures = reinterpret_cast<Captures*>(user_data);
+    captures->response_data.assign(data, data + size);
+    captures->response_latch.Signal();
+  };
+  auto result = FlutterPlatformMessageCreateResponseHandle(
+      engine.get(), callback, &captures, &response_handle);
+  ASSERT_EQ(result, kSuccess);
+
+  FlutterPlatformMessage message = {};
+  message.struct_size = sizeof(FlutterPlatformMessage);
+  message.channel = "test_channel";
+  message.message = captures.message_data.data();
+  message.message_size = captures.message_data.size();
+  message.response_handle = response_handle;
+
+  ready.Wait();
+  result = FlutterEngineSendPlatformMessageNoCopy(
+      engine.get(), &message,
+      [](void* user_data) {
+        reinterpret_cast<Captures*>(user_data)->release_latch.Signal();
+      },
+      &captures);
+  ASSERT_EQ(result, kSuccess);
+
+  result = FlutterPlatformMessageReleaseResponseHandle(engine.get(),
+                                                       response_handle);
+  ASSERT_EQ(result, kSuccess);
+
+  captures.response_latch.Wait();
+  EXPECT_EQ(captures.response_data, captures.message_data);
+
+  // Dart holds on to the buffer until it is collected, or the engine shuts
+  // down at the latest.
+  engine.reset();
+  captures.release_latch.Wait();
+}
+
+//------------------------------------------------------------------------------
+/// Responds to a platform message from Dart without copying the response, and
+/// checks that Dart receives it as unmodifiable data, whatever its size, and
+/// that the buffer of the embedder is released.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeRespondedToWithoutCopies) {
+  for (size_t size : {16u, 64u * 1024u}) {
+    auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+
+    struct Captures {
+      std::vector<uint8_t> response_data;
+      std::vector<uint8_t> echoed_data;
+      bool is_unmodifiable = false;
+      fml::AutoResetWaitableEvent unmodifiable_latch;
+      fml::AutoResetWaitableEvent echo_latch;
+      fml::AutoResetWaitableEvent release_latch;
+    };
+    Captures captures;
+    for (size_t i = 0; i < size; i++) {
+      captures.response_data.push_back(i % 251);
+    }
+
+    context.AddNativeCallback(
+        "NotifyBoolValue", CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+          captures.is_unmodifiable = tonic::DartConverter<bool>::FromDart(
+              Dart_GetNativeArgument(args, 0));
+          captures.unmodifiable_latch.Signal();
+        }));
+
+    // Platform messages are delivered on the platform thread, which must not
+    // be blocked by the test.
+    auto platform_task_runner = CreateNewThread("platform_thread");
+    UniqueEngine engine;
+    fml::AutoResetWaitableEvent launched;
+    platform_task_runner->PostTask([&]() {
+      EmbedderConfigBuilder builder(context);
+      builder.SetSurface(SkISize::Make(1, 1));
+      builder.SetDartEntrypoint("platform_message_response_echo");
+      builder.SetPlatformMessageCallback(
+          [&](const FlutterPlatformMessage* message) {
+            if (strcmp(message->channel, "echo_channel") == 0) {
+              captures.echoed_data.assign(
+                  message->message, message->message + message->message_size);
+              captures.echo_latch.Signal();
+              return;
+            }
+            ASSERT_STREQ(message->channel, "test_channel");
+            auto result = FlutterEngineSendPlatformMessageResponseNoCopy(
+                engine.get(), message->response_handle,
+                captures.response_data.data(), captures.response_data.size(),
+                [](void* user_data) {
+                  reinterpret_cast<Captures*>(user_data)
+                      ->release_latch.Signal();
+                },
+                &captures);
+            ASSERT_EQ(result, kSuccess);
+          });
+      engine = builder.LaunchEngine();
+      ASSERT_TRUE(engine.is_valid());
+      launched.Signal();
+    });
+    launched.Wait();
+
+    captures.unmodifiable_latch.Wait();
+    EXPECT_TRUE(captures.is_unmodifiable);
+    captures.echo_latch.Wait();
+    EXPECT_EQ(captures.echoed_data, captures.response_data);
+
+    // Small responses are copied right away. Large ones are held until the
+    // data is collected, or the engine shuts down at the latest.
+    fml::AutoResetWaitableEvent shutdown;
+    platform_task_runner->PostTask([&]() {
+      engine.reset();
+      shutdown.Signal();
+    });
+    shutdown.Wait();
+    captures.release_latch.Wait();
+  }
+}
+
+TEST_F(EmbedderTest, PlatformMessageBuffersAreReleasedWhenSendingFails) {
+  const uint8_t data[] = {1, 2, 3};
+  FlutterPlatformMessage message = {};
+  message.struct_size = sizeof(FlutterPlatformMessage);
+  message.channel = "test_channel";
+  message.message = data;
+  message.message_size = sizeof(data);
+
+  bool released = false;
+  auto release_callback = [](void* user_data) {
+    *reinterpret_cast<bool*>(user_data) = true;
+  };
+  EXPECT_EQ(FlutterEngineSendPlatformMessageNoCopy(nullptr, &message,
+                                                   release_callback, &released),
+            kInvalidArguments);
+  EXPECT_TRUE(released);
+
+  released = false;
+  EXPECT_EQ(FlutterEngineSendPlatformMessageNoCopy(nullptr, nullptr,
+                                                   release_callback, &released),
+            kInvalidArguments);
+  EXPECT_TRUE(released);
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a platform message can be sent with no response handle. Instead
 /// of the platform message integrity checked via a response handle, a native
@@ -3423,6 +3598,52 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetFramePhaseStatistics) {
+  auto& context = GetEmbedderContext<EmbedderTestContextSoftware>();
+  EmbedderConfigBuilder builder(context);
+  builder.SetSurface(SkISize::Make(1, 1));
+  builder.SetDartEntrypoint("draw_solid_red");
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  fml::AutoResetWaitableEvent callback_latch;
+  VoidCallback callback = [](void* user_data) {
+    static_cast<fml::AutoResetWaitableEvent*>(user_data)->Signal();
+  };
+  ASSERT_EQ(FlutterEngineSetNextFrameCallback(engine.get(), callback,
+                                              &callback_latch),
+            kSuccess);
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  callback_latch.Wait();
+
+  // The submission of the frame is recorded before the callback is called.
+  FlutterFramePhaseStatistics statistics = {};
+  statistics.struct_size = sizeof(statistics);
+  ASSERT_EQ(FlutterEngineGetFramePhaseStatistics(
+                engine.get(), kFlutterFramePhaseGpuSubmit, 0, &statistics),
+            kSuccess);
+  EXPECT_GE(statistics.count, 1u);
+  EXPECT_LE(statistics.min_micros, statistics.p50_micros);
+  EXPECT_LE(statistics.p50_micros, statistics.p999_micros);
+  EXPECT_LE(statistics.p999_micros, statistics.max_micros);
+
+  EXPECT_EQ(FlutterEngineGetFramePhaseStatistics(
+                engine.get(), kFlutterFramePhaseCount, 0, &statistics),
+            kInvalidArguments);
+  statistics.struct_size = 0;
+  EXPECT_EQ(FlutterEngineGetFramePhaseStatistics(
+                engine.get(), kFlutterFramePhaseRaster, 0, &statistics),
+            kInvalidArguments);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
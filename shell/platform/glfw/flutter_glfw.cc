@@ -1182,6 +1182,21 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
       channel, callback, user_data);
 }
 
+void FlutterDesktopMessengerSetTaskRunner(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageTaskRunner task_runner,
+    void* user_data,
+    size_t capacity) {
+  messenger->GetEngine()->message_dispatcher->SetMessageTaskQueue(
+      channel,
+      flutter::IncomingMessageDispatcher::WrapTaskRunner(task_runner,
+                                                         user_data),
+      capacity > 0
+          ? capacity
+          : flutter::IncomingMessageDispatcher::kDefaultTaskQueueCapacity);
+}
+
 FlutterDesktopTextureRegistrarRef FlutterDesktopRegistrarGetTextureRegistrar(
     FlutterDesktopPluginRegistrarRef registrar) {
   std::cerr << "GLFW Texture support is not implemented yet." << std::endl;
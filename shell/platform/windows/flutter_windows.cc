@@ -393,6 +393,27 @@ void FlutterDesktopMessengerSetCallback(FlutterDesktopMessengerRef messenger,
       ->SetMessageCallback(channel, callback, user_data);
 }
 
+void FlutterDesktopMessengerSetTaskRunner(
+    FlutterDesktopMessengerRef messenger,
+    const char* channel,
+    FlutterDesktopMessageTaskRunner task_runner,
+    void* user_data,
+    size_t capacity) {
+  FML_DCHECK(FlutterDesktopMessengerIsAvailable(messenger))
+      << "Messenger must reference a running engine to set a task runner";
+
+  flutter::FlutterDesktopMessenger::FromRef(messenger)
+      ->GetEngine()
+      ->message_dispatcher()
+      ->SetMessageTaskQueue(
+          channel,
+          flutter::IncomingMessageDispatcher::WrapTaskRunner(task_runner,
+                                                             user_data),
+          capacity > 0
+              ? capacity
+              : flutter::IncomingMessageDispatcher::kDefaultTaskQueueCapacity);
+}
+
 FlutterDesktopMessengerRef FlutterDesktopMessengerAddRef(
     FlutterDesktopMessengerRef messenger) {
   return flutter::FlutterDesktopMessenger::FromRef(messenger)
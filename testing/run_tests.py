@@ -592,6 +592,8 @@ def run_engine_benchmarks(build_dir, executable_filter):
 
   run_engine_executable(build_dir, 'geometry_benchmarks', executable_filter, icu_flags)
 
+  run_engine_executable(build_dir, 'typographer_benchmarks', executable_filter, icu_flags)
+
   if is_linux():
     run_engine_executable(build_dir, 'txt_benchmarks', executable_filter, icu_flags)
 
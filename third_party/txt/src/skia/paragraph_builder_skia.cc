@@ -17,6 +17,9 @@
 #include "paragraph_builder_skia.h"
 #include "paragraph_skia.h"
 
+#include <cstring>
+#include <type_traits>
+
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "third_party/skia/modules/skunicode/include/SkUnicode_icu.h"
@@ -43,28 +46,160 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
                                            : SkFontStyle::Slant::kItalic_Slant);
 }
 
+// The kinds of builder calls that are encoded in a layout cache key.
+enum class LayoutKeyTag : uint8_t {
+  kPushStyle,
+  kPop,
+  kText,
+  kUTF8Text,
+  kPlaceholder,
+};
+
+template <typename T>
+void AppendToLayoutKey(std::string& key, const T& value) {  // NOLINT
+  static_assert(std::is_trivially_copyable_v<T>);
+  key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void AppendToLayoutKey(std::string& key,  // NOLINT
+                       const char* data,
+                       size_t size) {
+  AppendToLayoutKey(key, size);
+  key.append(data, size);
+}
+
+void AppendToLayoutKey(std::string& key,  // NOLINT
+                       const std::string& value) {
+  AppendToLayoutKey(key, value.data(), value.size());
+}
+
+void AppendToLayoutKey(std::string& key,  // NOLINT
+                       const std::u16string& value) {
+  AppendToLayoutKey(key, reinterpret_cast<const char*>(value.data()),
+                    value.size() * sizeof(char16_t));
+}
+
+void AppendToLayoutKey(std::string& key,  // NOLINT
+                       const std::vector<std::string>& values) {
+  AppendToLayoutKey(key, values.size());
+  for (const std::string& value : values) {
+    AppendToLayoutKey(key, value);
+  }
+}
+
+void AppendToLayoutKey(std::string& key,  // NOLINT
+                       const ParagraphStyle& style) {
+  AppendToLayoutKey(key, style.font_weight);
+  AppendToLayoutKey(key, style.font_style);
+  AppendToLayoutKey(key, style.font_family);
+  AppendToLayoutKey(key, style.font_size);
+  AppendToLayoutKey(key, style.height);
+  AppendToLayoutKey(key, style.has_height_override);
+  AppendToLayoutKey(key, style.text_height_behavior);
+  AppendToLayoutKey(key, style.strut_enabled);
+  AppendToLayoutKey(key, style.strut_font_weight);
+  AppendToLayoutKey(key, style.strut_font_style);
+  AppendToLayoutKey(key, style.strut_font_families);
+  AppendToLayoutKey(key, style.strut_font_size);
+  AppendToLayoutKey(key, style.strut_height);
+  AppendToLayoutKey(key, style.strut_has_height_override);
+  AppendToLayoutKey(key, style.strut_half_leading);
+  AppendToLayoutKey(key, style.strut_leading);
+  AppendToLayoutKey(key, style.force_strut_height);
+  AppendToLayoutKey(key, style.text_align);
+  AppendToLayoutKey(key, style.text_direction);
+  AppendToLayoutKey(key, style.max_lines);
+  AppendToLayoutKey(key, style.ellipsis);
+  AppendToLayoutKey(key, style.locale);
+}
+
+void AppendToLayoutKey(std::string& key,  // NOLINT
+                       const TextStyle& style) {
+  AppendToLayoutKey(key, style.color);
+  AppendToLayoutKey(key, style.decoration);
+  AppendToLayoutKey(key, style.decoration_color);
+  AppendToLayoutKey(key, style.decoration_style);
+  AppendToLayoutKey(key, style.decoration_thickness_multiplier);
+  AppendToLayoutKey(key, style.font_weight);
+  AppendToLayoutKey(key, style.font_style);
+  AppendToLayoutKey(key, style.text_baseline);
+  AppendToLayoutKey(key, style.half_leading);
+  AppendToLayoutKey(key, style.font_families);
+  AppendToLayoutKey(key, style.font_size);
+  AppendToLayoutKey(key, style.letter_spacing);
+  AppendToLayoutKey(key, style.word_spacing);
+  AppendToLayoutKey(key, style.height);
+  AppendToLayoutKey(key, style.has_height_override);
+  AppendToLayoutKey(key, style.locale);
+  // The paints themselves are never shared, as each paragraph paints with its
+  // own. Only the paint IDs that the styles refer to are, and those depend on
+  // which paints are present.
+  AppendToLayoutKey(key, style.background.has_value());
+  AppendToLayoutKey(key, style.foreground.has_value());
+  AppendToLayoutKey(key, style.text_shadows.size());
+  for (const TextShadow& shadow : style.text_shadows) {
+    AppendToLayoutKey(key, shadow.color);
+    AppendToLayoutKey(key, shadow.offset);
+    AppendToLayoutKey(key, shadow.blur_sigma);
+  }
+  AppendToLayoutKey(key, style.font_features.GetFontFeatures().size());
+  for (const auto& [tag, value] : style.font_features.GetFontFeatures()) {
+    AppendToLayoutKey(key, tag);
+    AppendToLayoutKey(key, value);
+  }
+  AppendToLayoutKey(key, style.font_variations.GetAxisValues().size());
+  for (const auto& [axis, value] : style.font_variations.GetAxisValues()) {
+    AppendToLayoutKey(key, axis);
+    AppendToLayoutKey(key, value);
+  }
+}
+
 }  // anonymous namespace
 
 ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
-    const bool impeller_enabled)
-    : base_style_(style.GetTextStyle()), impeller_enabled_(impeller_enabled) {
+    const bool impeller_enabled,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache)
+    : base_style_(style.GetTextStyle()),
+      impeller_enabled_(impeller_enabled),
+      layout_cache_(std::move(layout_cache)) {
+  skia_paragraph_style_ = TxtToSkia(style);
+  skia_font_collection_ = font_collection->CreateSktFontCollection();
   builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection(),
-      SkUnicodes::ICU::Make());
+      skia_paragraph_style_, skia_font_collection_, SkUnicodes::ICU::Make());
+  if (layout_cache_) {
+    font_collection_ = std::move(font_collection);
+    AppendToLayoutKey(layout_key_, style);
+  }
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  skt::TextStyle skia_style = TxtToSkia(style);
+  builder_->pushStyle(skia_style);
   txt_style_stack_.push(style);
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyTag::kPushStyle);
+    AppendToLayoutKey(layout_key_, style);
+    recorded_calls_.push_back(
+        [skia_style](skt::ParagraphBuilder& builder, const std::string&) {
+          builder.pushStyle(skia_style);
+        });
+  }
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
   txt_style_stack_.pop();
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyTag::kPop);
+    recorded_calls_.push_back(
+        [](skt::ParagraphBuilder& builder, const std::string&) {
+          builder.pop();
+        });
+  }
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -73,11 +208,35 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyTag::kText);
+    AppendToLayoutKey(layout_key_, text);
+    // The text is read back from the layout key rather than copied.
+    size_t size = text.size();
+    size_t offset = layout_key_.size() - size * sizeof(char16_t);
+    recorded_calls_.push_back([offset, size](skt::ParagraphBuilder& builder,
+                                             const std::string& layout_key) {
+      std::u16string text(size, u'\0');
+      memcpy(text.data(), layout_key.data() + offset, size * sizeof(char16_t));
+      builder.addText(text);
+    });
+  }
 }
 
 void ParagraphBuilderSkia::AddText(const uint8_t* utf8_data,
                                    size_t byte_length) {
   builder_->addText(reinterpret_cast<const char*>(utf8_data), byte_length);
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyTag::kUTF8Text);
+    AppendToLayoutKey(layout_key_, reinterpret_cast<const char*>(utf8_data),
+                      byte_length);
+    size_t offset = layout_key_.size() - byte_length;
+    recorded_calls_.push_back(
+        [offset, byte_length](skt::ParagraphBuilder& builder,
+                              const std::string& layout_key) {
+          builder.addText(layout_key.data() + offset, byte_length);
+        });
+  }
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -90,11 +249,48 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+  if (layout_cache_) {
+    AppendToLayoutKey(layout_key_, LayoutKeyTag::kPlaceholder);
+    AppendToLayoutKey(layout_key_, span.width);
+    AppendToLayoutKey(layout_key_, span.height);
+    AppendToLayoutKey(layout_key_, span.alignment);
+    AppendToLayoutKey(layout_key_, span.baseline);
+    AppendToLayoutKey(layout_key_, span.baseline_offset);
+    recorded_calls_.push_back(
+        [placeholder_style](skt::ParagraphBuilder& builder,
+                            const std::string&) {
+          builder.addPlaceholder(placeholder_style);
+        });
+  }
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
+  if (!layout_cache_) {
+    return std::make_unique<ParagraphSkia>(
+        builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+  }
+  // The paragraph, its factory and the keys of its cached layouts all share
+  // one copy of the layout key.
+  auto layout_key =
+      std::make_shared<const std::string>(std::move(layout_key_));
+  auto paragraph_factory =
+      [paragraph_style = skia_paragraph_style_,
+       default_font_collection = skia_font_collection_,
+       calls = std::move(recorded_calls_),
+       layout_key](sk_sp<skt::FontCollection> font_collection) {
+        auto builder = skt::ParagraphBuilder::make(
+            paragraph_style,
+            font_collection ? font_collection : default_font_collection,
+            SkUnicodes::ICU::Make());
+        for (const auto& call : calls) {
+          call(*builder, *layout_key);
+        }
+        return builder->Build();
+      };
   return std::make_unique<ParagraphSkia>(
-      builder_->Build(), std::move(dl_paints_), impeller_enabled_);
+      builder_->Build(), std::move(dl_paints_), impeller_enabled_,
+      std::move(layout_cache_), std::move(layout_key),
+      std::move(font_collection_), std::move(paragraph_factory));
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
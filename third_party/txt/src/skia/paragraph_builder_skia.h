@@ -19,7 +19,10 @@
 
 #include "txt/paragraph_builder.h"
 
+#include <functional>
+
 #include "flutter/display_list/dl_paint.h"
+#include "paragraph_layout_cache.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
@@ -31,9 +34,11 @@ namespace txt {
 ///             and is also used with the Impeller backend.
 class ParagraphBuilderSkia : public ParagraphBuilder {
  public:
-  ParagraphBuilderSkia(const ParagraphStyle& style,
-                       std::shared_ptr<FontCollection> font_collection,
-                       const bool impeller_enabled);
+  ParagraphBuilderSkia(
+      const ParagraphStyle& style,
+      std::shared_ptr<FontCollection> font_collection,
+      const bool impeller_enabled,
+      std::shared_ptr<ParagraphLayoutCache> layout_cache = nullptr);
 
   virtual ~ParagraphBuilderSkia();
 
@@ -65,6 +70,20 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   const bool impeller_enabled_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+
+  // When a layout cache is given, the builder encodes everything that affects
+  // the layout of the paragraph into |layout_key_|, and records the calls made
+  // to |builder_| so that the paragraph can be built again if it has to be
+  // laid out after its layout was shared. The recorded calls read their text
+  // back from the layout key instead of keeping copies of their own.
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  std::shared_ptr<FontCollection> font_collection_;
+  skia::textlayout::ParagraphStyle skia_paragraph_style_;
+  sk_sp<skia::textlayout::FontCollection> skia_font_collection_;
+  std::string layout_key_;
+  std::vector<std::function<void(skia::textlayout::ParagraphBuilder&,
+                                 const std::string& layout_key)>>
+      recorded_calls_;
 };
 
 }  // namespace txt
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_layout_cache.h"
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+bool ParagraphLayoutCache::Key::operator==(const Key& other) const {
+  if (width != other.width || font_generation != other.font_generation ||
+      content_hash != other.content_hash) {
+    return false;
+  }
+  // Layouts of the same paragraph share its content.
+  return content == other.content ||
+         (content && other.content && *content == *other.content);
+}
+
+size_t ParagraphLayoutCache::KeyHash::operator()(const Key* key) const {
+  return fml::HashCombine(key->content_hash, key->width, key->font_generation);
+}
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {
+  FML_DCHECK(max_bytes_ > 0u);
+}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+std::shared_ptr<skia::textlayout::Paragraph> ParagraphLayoutCache::Find(
+    const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(&key);
+  if (found == index_.end()) {
+    miss_count_++;
+    TraceCounters();
+    return nullptr;
+  }
+  hit_count_++;
+  TraceCounters();
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->paragraph;
+}
+
+void ParagraphLayoutCache::Insert(
+    Key key,
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(&key);
+  if (found != index_.end()) {
+    // Another paragraph with the same content was laid out at the same time.
+    // Both layouts are equivalent, so keep the one that is already shared.
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return;
+  }
+  size_t byte_size = EstimateByteSize(key);
+  if (byte_size > max_bytes_) {
+    return;
+  }
+  while (byte_count_ + byte_size > max_bytes_) {
+    EvictLeastRecentlyUsed();
+  }
+  entries_.push_front(Entry{std::move(key), std::move(paragraph), byte_size});
+  index_.emplace(&entries_.front().key, entries_.begin());
+  byte_count_ += byte_size;
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  byte_count_ = 0u;
+}
+
+size_t ParagraphLayoutCache::EstimateByteSize(const Key& key) {
+  size_t content_size = key.content ? key.content->size() : 0u;
+  return kParagraphOverheadBytes + content_size * kBytesPerContentByte;
+}
+
+size_t ParagraphLayoutCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t ParagraphLayoutCache::GetByteCount() const {
+  std::scoped_lock lock(mutex_);
+  return byte_count_;
+}
+
+size_t ParagraphLayoutCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t ParagraphLayoutCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+void ParagraphLayoutCache::EvictLeastRecentlyUsed() {
+  FML_DCHECK(!entries_.empty());
+  byte_count_ -= entries_.back().byte_size;
+  index_.erase(&entries_.back().key);
+  entries_.pop_back();
+}
+
+void ParagraphLayoutCache::TraceCounters() const {
+  size_t lookup_count = hit_count_ + miss_count_;
+  FML_TRACE_COUNTER("flutter", "ParagraphLayoutCache",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Hits", hit_count_,               //
+                    "Misses", miss_count_,            //
+                    "HitRatePercent", hit_count_ * 100u / lookup_count,
+                    "Bytes", byte_count_);
+}
+
+}  // namespace txt
@@ -0,0 +1,127 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+
+namespace txt {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of shaped and laid out paragraphs,
+///             shared by all of the paragraphs built with it.
+///
+///             Lists of labels and buttons lay out the same text with the same
+///             styles over and over. A paragraph whose content, width and
+///             fonts match a cached layout adopts it instead of shaping and
+///             breaking its text again.
+///
+///             Paragraphs in the cache must not be laid out again, as other
+///             paragraphs may be sharing them.
+///
+///             The cache is bounded by an estimate of the memory used by its
+///             layouts rather than by their number, so that a few long
+///             paragraphs can't hold on to as much memory as a list of
+///             labels.
+///
+///             The cache may be used from any thread.
+///
+class ParagraphLayoutCache {
+ public:
+  struct Key {
+    /// The paragraph style, text, text styles and placeholders of the
+    /// paragraph, as encoded by the paragraph builder. The content is shared
+    /// by the paragraph and the keys of its layouts rather than copied.
+    std::shared_ptr<const std::string> content;
+    /// The hash of |content|, computed once when the paragraph is built.
+    size_t content_hash = 0u;
+    /// The width the paragraph was laid out to.
+    SkScalar width = 0;
+    /// The generation of the font collection the paragraph was laid out with.
+    uint64_t font_generation = 0u;
+
+    bool operator==(const Key& other) const;
+  };
+
+  /// The estimated size of a laid out paragraph, not counting its text.
+  static constexpr size_t kParagraphOverheadBytes = 2048u;
+
+  /// The estimated size of the runs, glyphs, clusters and lines of a laid
+  /// out paragraph for each byte of its content.
+  static constexpr size_t kBytesPerContentByte = 16u;
+
+  static constexpr size_t kDefaultMaxBytes = 4u * 1024u * 1024u;
+
+  explicit ParagraphLayoutCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~ParagraphLayoutCache();
+
+  /// Return the paragraph laid out for the key and mark it as the most
+  /// recently used, or nullptr if there is none.
+  std::shared_ptr<skia::textlayout::Paragraph> Find(const Key& key);
+
+  /// Add a paragraph that has been laid out for the key, evicting the least
+  /// recently used paragraphs until its estimated size fits. Paragraphs that
+  /// are estimated to be larger than the whole cache are not added.
+  void Insert(Key key, std::shared_ptr<skia::textlayout::Paragraph> paragraph);
+
+  void Clear();
+
+  /// The estimated size of the layout cached for the key.
+  static size_t EstimateByteSize(const Key& key);
+
+  size_t GetEntryCount() const;
+
+  /// The sum of the estimated sizes of the cached layouts.
+  size_t GetByteCount() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+ private:
+  struct Entry {
+    Key key;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+    size_t byte_size = 0u;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key* key) const;
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key* a, const Key* b) const { return *a == *b; }
+  };
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // The most recently used entries are at the front. The index refers to the
+  // keys of the entries, which don't move as the list is reordered.
+  std::list<Entry> entries_;
+  std::unordered_map<const Key*, std::list<Entry>::iterator, KeyHash, KeyEqual>
+      index_;
+  size_t byte_count_ = 0u;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+
+  void EvictLeastRecentlyUsed();
+
+  void TraceCounters() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
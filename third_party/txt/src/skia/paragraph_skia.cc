@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <string>
 #include "display_list/dl_paint.h"
 #include "fml/logging.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
@@ -220,6 +221,26 @@ ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
       dl_paints_(dl_paints),
       impeller_enabled_(impeller_enabled) {}
 
+ParagraphSkia::ParagraphSkia(
+    std::unique_ptr<skt::Paragraph> paragraph,
+    std::vector<flutter::DlPaint>&& dl_paints,
+    bool impeller_enabled,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache,
+    std::shared_ptr<const std::string> layout_key,
+    std::shared_ptr<FontCollection> font_collection,
+    ParagraphFactory paragraph_factory)
+    : paragraph_(std::move(paragraph)),
+      dl_paints_(std::move(dl_paints)),
+      impeller_enabled_(impeller_enabled),
+      layout_cache_(std::move(layout_cache)),
+      layout_key_(std::move(layout_key)),
+      font_collection_(std::move(font_collection)),
+      paragraph_factory_(std::move(paragraph_factory)) {
+  FML_DCHECK(layout_cache_ && layout_key_ && font_collection_ &&
+             paragraph_factory_);
+  layout_key_hash_ = std::hash<std::string>{}(*layout_key_);
+}
+
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
 }
@@ -299,7 +320,65 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
-  paragraph_->layout(width);
+  if (!layout_cache_) {
+    paragraph_->layout(width);
+    return;
+  }
+
+  ParagraphLayoutCache::Key key = MakeLayoutKey(width);
+  if (AdoptCachedLayout(key)) {
+    return;
+  }
+  LayoutAndCache(std::move(key), nullptr);
+}
+
+bool ParagraphSkia::LayoutWithFontCollection(
+    double width,
+    sk_sp<skt::FontCollection> font_collection) {
+  if (!layout_cache_) {
+    return false;
+  }
+  line_metrics_.reset();
+  line_metrics_styles_.clear();
+
+  ParagraphLayoutCache::Key key = MakeLayoutKey(width);
+  if (AdoptCachedLayout(key)) {
+    return true;
+  }
+  // The paragraph was built with its own font collection, so it is always
+  // built again with the given one.
+  paragraph_is_shared_ = true;
+  LayoutAndCache(std::move(key), std::move(font_collection));
+  return true;
+}
+
+ParagraphLayoutCache::Key ParagraphSkia::MakeLayoutKey(double width) const {
+  return ParagraphLayoutCache::Key{
+      .content = layout_key_,
+      .content_hash = layout_key_hash_,
+      .width = SkDoubleToScalar(width),
+      .font_generation = font_collection_->GetGeneration(),
+  };
+}
+
+bool ParagraphSkia::AdoptCachedLayout(const ParagraphLayoutCache::Key& key) {
+  auto cached = layout_cache_->Find(key);
+  if (!cached) {
+    return false;
+  }
+  paragraph_ = std::move(cached);
+  paragraph_is_shared_ = true;
+  return true;
+}
+
+void ParagraphSkia::LayoutAndCache(ParagraphLayoutCache::Key key,
+                                   sk_sp<skt::FontCollection> font_collection) {
+  if (paragraph_is_shared_) {
+    paragraph_ = paragraph_factory_(std::move(font_collection));
+  }
+  paragraph_->layout(key.width);
+  layout_cache_->Insert(std::move(key), paragraph_);
+  paragraph_is_shared_ = true;
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
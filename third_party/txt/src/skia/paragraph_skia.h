@@ -17,10 +17,13 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <functional>
 #include <optional>
 
+#include "txt/font_collection.h"
 #include "txt/paragraph.h"
 
+#include "paragraph_layout_cache.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
 namespace txt {
@@ -28,10 +31,27 @@ namespace txt {
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // Builds another copy of the paragraph, to lay out again once the paragraph
+  // has been shared through the layout cache, or to lay out with another font
+  // collection. A null font collection builds the copy with the collection
+  // the paragraph was originally built with.
+  using ParagraphFactory = std::function<std::unique_ptr<
+      skia::textlayout::Paragraph>(sk_sp<skia::textlayout::FontCollection>)>;
+
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
                 std::vector<flutter::DlPaint>&& dl_paints,
                 bool impeller_enabled);
 
+  // Creates a paragraph that looks up its layouts in the given cache by its
+  // |layout_key| and the generation of |font_collection|.
+  ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
+                std::vector<flutter::DlPaint>&& dl_paints,
+                bool impeller_enabled,
+                std::shared_ptr<ParagraphLayoutCache> layout_cache,
+                std::shared_ptr<const std::string> layout_key,
+                std::shared_ptr<FontCollection> font_collection,
+                ParagraphFactory paragraph_factory);
+
   virtual ~ParagraphSkia() = default;
 
   double GetMaxWidth() override;
@@ -62,6 +82,10 @@ class ParagraphSkia : public Paragraph {
 
   void Layout(double width) override;
 
+  bool LayoutWithFontCollection(
+      double width,
+      sk_sp<skia::textlayout::FontCollection> font_collection) override;
+
   bool Paint(flutter::DisplayListBuilder* builder, double x, double y) override;
 
   std::vector<TextBox> GetRectsForRange(
@@ -89,11 +113,31 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  ParagraphLayoutCache::Key MakeLayoutKey(double width) const;
+
+  // Adopts the cached layout of the paragraph at the width of the key, if
+  // there is one.
+  bool AdoptCachedLayout(const ParagraphLayoutCache::Key& key);
+
+  // Lays out |paragraph_|, replacing it with a new copy built with the given
+  // font collection first if it is shared, and adds it to the layout cache.
+  void LayoutAndCache(ParagraphLayoutCache::Key key,
+                      sk_sp<skia::textlayout::FontCollection> font_collection);
+
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
   const bool impeller_enabled_;
+
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+  std::shared_ptr<const std::string> layout_key_;
+  size_t layout_key_hash_ = 0u;
+  std::shared_ptr<FontCollection> font_collection_;
+  ParagraphFactory paragraph_factory_;
+  // Whether |paragraph_| is in the layout cache, in which case it must not be
+  // laid out again.
+  bool paragraph_is_shared_ = false;
 };
 
 }  // namespace txt
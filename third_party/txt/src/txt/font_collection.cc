@@ -31,12 +31,25 @@
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+namespace {
+
+uint64_t NextGeneration() {
+  static std::atomic<uint64_t> next_generation = 1u;
+  return next_generation.fetch_add(1u, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+FontCollection::FontCollection()
+    : enable_font_fallback_(true), generation_(NextGeneration()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  for (const auto& collection : skt_thread_collections_) {
+    collection->clearCaches();
+  }
 }
 
 size_t FontCollection::GetFontManagersCount() const {
@@ -46,27 +59,27 @@ size_t FontCollection::GetFontManagersCount() const {
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
   default_font_manager_ = GetDefaultFontManager(font_initialization_data);
-  skt_collection_.reset();
+  ResetSktFontCollections();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollections();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollections();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollections();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollections();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -88,34 +101,71 @@ void FontCollection::DisableFontFallback() {
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  for (const auto& collection : skt_thread_collections_) {
+    collection->disableFontFallback();
+  }
+  UpdateGeneration();
 }
 
 void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  for (const auto& collection : skt_thread_collections_) {
+    collection->clearCaches();
+  }
+  UpdateGeneration();
+}
+
+uint64_t FontCollection::GetGeneration() const {
+  return generation_.load(std::memory_order_relaxed);
+}
+
+void FontCollection::UpdateGeneration() {
+  generation_.store(NextGeneration(), std::memory_order_relaxed);
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
   if (!skt_collection_) {
-    skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
-
-    std::vector<SkString> default_font_families;
-    for (const std::string& family : GetDefaultFontFamilies()) {
-      default_font_families.emplace_back(family);
-    }
-    skt_collection_->setDefaultFontManager(default_font_manager_,
-                                           default_font_families);
-    skt_collection_->setAssetFontManager(asset_font_manager_);
-    skt_collection_->setDynamicFontManager(dynamic_font_manager_);
-    skt_collection_->setTestFontManager(test_font_manager_);
-    if (!enable_font_fallback_) {
-      skt_collection_->disableFontFallback();
-    }
+    skt_collection_ = MakeSktFontCollection();
   }
 
   return skt_collection_;
 }
 
+std::vector<sk_sp<skia::textlayout::FontCollection>>
+FontCollection::CreateSktFontCollectionsForThreads(size_t count) {
+  while (skt_thread_collections_.size() < count) {
+    skt_thread_collections_.push_back(MakeSktFontCollection());
+  }
+  return {skt_thread_collections_.begin(),
+          skt_thread_collections_.begin() + count};
+}
+
+sk_sp<skia::textlayout::FontCollection>
+FontCollection::MakeSktFontCollection() const {
+  auto collection = sk_make_sp<skia::textlayout::FontCollection>();
+
+  std::vector<SkString> default_font_families;
+  for (const std::string& family : GetDefaultFontFamilies()) {
+    default_font_families.emplace_back(family);
+  }
+  collection->setDefaultFontManager(default_font_manager_,
+                                    default_font_families);
+  collection->setAssetFontManager(asset_font_manager_);
+  collection->setDynamicFontManager(dynamic_font_manager_);
+  collection->setTestFontManager(test_font_manager_);
+  if (!enable_font_fallback_) {
+    collection->disableFontFallback();
+  }
+  return collection;
+}
+
+void FontCollection::ResetSktFontCollections() {
+  skt_collection_.reset();
+  skt_thread_collections_.clear();
+  UpdateGeneration();
+}
+
 }  // namespace txt
@@ -17,10 +17,13 @@
 #ifndef LIB_TXT_SRC_FONT_COLLECTION_H_
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
@@ -56,18 +59,41 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // Construct |count| Skia text layout FontCollections equivalent to the one
+  // returned by CreateSktFontCollection. Skia's collections cache the fonts
+  // they resolve without any locking, so these share no state with it or with
+  // each other, and each may be used on a different thread at the same time.
+  // The collections are reused by later calls until the fonts change.
+  std::vector<sk_sp<skia::textlayout::FontCollection>>
+  CreateSktFontCollectionsForThreads(size_t count);
+
+  // An identifier of the fonts currently available in this collection. It
+  // changes whenever fonts are added or removed, or the font family cache is
+  // cleared, and is never shared by two collections, so that text laid out
+  // with one set of fonts is never mistaken for text laid out with another.
+  uint64_t GetGeneration() const;
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
   bool enable_font_fallback_;
+  std::atomic<uint64_t> generation_;
 
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
+  // Further equivalent collections, for use on other threads.
+  std::vector<sk_sp<skia::textlayout::FontCollection>> skt_thread_collections_;
 
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
+  sk_sp<skia::textlayout::FontCollection> MakeSktFontCollection() const;
+
+  void ResetSktFontCollections();
+
+  void UpdateGeneration();
+
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
 
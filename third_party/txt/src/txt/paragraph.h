@@ -23,6 +23,7 @@
 #include "paragraph_style.h"
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
 #include "third_party/skia/modules/skparagraph/include/Metrics.h"
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
 
@@ -146,6 +147,19 @@ class Paragraph {
   // before Painting and getting any statistics from this class.
   virtual void Layout(double width) = 0;
 
+  // Lays out the paragraph like Layout, but resolves fonts through the given
+  // Skia font collection rather than the paragraph's own. A Skia font
+  // collection must not be used on several threads at once, so paragraphs
+  // are laid out in parallel by giving each thread a collection of its own.
+  //
+  // Returns false, without laying out the paragraph, if the paragraph can't be
+  // laid out with another font collection.
+  virtual bool LayoutWithFontCollection(
+      double width,
+      sk_sp<skia::textlayout::FontCollection> font_collection) {
+    return false;
+  }
+
   // Paints the laid out text onto the supplied DisplayListBuilder at
   // (x, y) offset from the origin. Only valid after Layout() is called.
   virtual bool Paint(flutter::DisplayListBuilder* builder,
@@ -28,12 +28,16 @@ namespace txt {
 /// @param[in]  style             The style to use for the paragraph.
 /// @param[in]  font_collection   The font collection to use for the paragraph.
 /// @param[in]  impeller_enabled  Whether Impeller is enabled in the runtime.
+/// @param[in]  layout_cache      The cache of laid out paragraphs to share
+///                               layouts through, or nullptr to lay out the
+///                               paragraph on its own.
 std::unique_ptr<ParagraphBuilder> ParagraphBuilder::CreateSkiaBuilder(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection,
-    const bool impeller_enabled) {
-  return std::make_unique<ParagraphBuilderSkia>(style, font_collection,
-                                                impeller_enabled);
+    const bool impeller_enabled,
+    std::shared_ptr<ParagraphLayoutCache> layout_cache) {
+  return std::make_unique<ParagraphBuilderSkia>(
+      style, font_collection, impeller_enabled, std::move(layout_cache));
 }
 
 }  // namespace txt
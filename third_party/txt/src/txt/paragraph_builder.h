@@ -29,12 +29,15 @@
 
 namespace txt {
 
+class ParagraphLayoutCache;
+
 class ParagraphBuilder {
  public:
   static std::unique_ptr<ParagraphBuilder> CreateSkiaBuilder(
       const ParagraphStyle& style,
       std::shared_ptr<FontCollection> font_collection,
-      const bool impeller_enabled);
+      const bool impeller_enabled,
+      std::shared_ptr<ParagraphLayoutCache> layout_cache = nullptr);
 
   virtual ~ParagraphBuilder() = default;
 
@@ -39,5 +39,22 @@ TEST_F(FontCollectionTests, SettingUpDefaultFontManagerClearsCache) {
   sk_font_collection = font_collection.CreateSktFontCollection();
   ASSERT_NE(sk_font_collection->getFallbackManager().get(), nullptr);
 }
+
+TEST_F(FontCollectionTests, GenerationChangesWithFonts) {
+  FontCollection font_collection;
+  FontCollection other_font_collection;
+  uint64_t generation = font_collection.GetGeneration();
+  ASSERT_NE(generation, other_font_collection.GetGeneration());
+
+  font_collection.CreateSktFontCollection();
+  ASSERT_EQ(font_collection.GetGeneration(), generation);
+
+  font_collection.SetupDefaultFontManager(0);
+  ASSERT_NE(font_collection.GetGeneration(), generation);
+
+  generation = font_collection.GetGeneration();
+  font_collection.ClearFontFamilyCache();
+  ASSERT_NE(font_collection.GetGeneration(), generation);
+}
 }  // namespace testing
 }  // namespace txt
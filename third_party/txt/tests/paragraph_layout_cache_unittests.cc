@@ -0,0 +1,160 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "runtime/test_font_data.h"
+#include "skia/paragraph_builder_skia.h"
+#include "skia/paragraph_layout_cache.h"
+#include "txt/asset_font_manager.h"
+#include "txt/typeface_font_asset_provider.h"
+
+namespace txt {
+namespace testing {
+
+class ParagraphLayoutCacheTest : public ::testing::Test {
+ public:
+  ParagraphLayoutCacheTest() {}
+
+  void SetUp() override {
+    font_collection_ = std::make_shared<FontCollection>();
+    auto font_provider = std::make_unique<TypefaceFontAssetProvider>();
+    for (auto& font : flutter::GetTestFontData()) {
+      font_provider->RegisterTypeface(font);
+    }
+    font_collection_->SetAssetFontManager(
+        sk_make_sp<AssetFontManager>(std::move(font_provider)));
+    layout_cache_ = std::make_shared<ParagraphLayoutCache>();
+  }
+
+ protected:
+  std::unique_ptr<Paragraph> BuildParagraph(const std::u16string& text,
+                                            double font_size = 14) {
+    ParagraphBuilderSkia builder(ParagraphStyle(), font_collection_, false,
+                                 layout_cache_);
+    TextStyle style;
+    style.font_families.push_back("ahem");
+    style.font_size = font_size;
+    builder.PushStyle(style);
+    builder.AddText(text);
+    builder.Pop();
+    return builder.Build();
+  }
+
+  std::shared_ptr<FontCollection> font_collection_;
+  std::shared_ptr<ParagraphLayoutCache> layout_cache_;
+};
+
+TEST_F(ParagraphLayoutCacheTest, IdenticalParagraphsShareLayouts) {
+  auto first = BuildParagraph(u"Hello World");
+  first->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetMissCount(), 1u);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 0u);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 1u);
+
+  auto second = BuildParagraph(u"Hello World");
+  second->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetMissCount(), 1u);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 1u);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 1u);
+
+  EXPECT_EQ(second->GetHeight(), first->GetHeight());
+  EXPECT_EQ(second->GetLongestLine(), first->GetLongestLine());
+  EXPECT_EQ(second->GetLineMetrics().size(), 1u);
+}
+
+TEST_F(ParagraphLayoutCacheTest, DifferentContentDoesNotShareLayouts) {
+  BuildParagraph(u"Hello World")->Layout(1000);
+  BuildParagraph(u"Hello There")->Layout(1000);
+  BuildParagraph(u"Hello World", 20)->Layout(1000);
+  BuildParagraph(u"Hello World")->Layout(500);
+
+  EXPECT_EQ(layout_cache_->GetMissCount(), 4u);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 0u);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 4u);
+}
+
+TEST_F(ParagraphLayoutCacheTest, RelayoutDoesNotChangeSharedLayouts) {
+  auto first = BuildParagraph(u"Hello World");
+  first->Layout(1000);
+  double single_line_height = first->GetHeight();
+
+  auto second = BuildParagraph(u"Hello World");
+  second->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 1u);
+
+  // The ahem font is 14 pixels wide per character, so neither word fits on
+  // the same line as the other.
+  second->Layout(100);
+  EXPECT_EQ(layout_cache_->GetMissCount(), 2u);
+  EXPECT_GT(second->GetHeight(), single_line_height);
+  EXPECT_EQ(second->GetLineMetrics().size(), 2u);
+
+  EXPECT_EQ(first->GetHeight(), single_line_height);
+  EXPECT_EQ(first->GetLineMetrics().size(), 1u);
+
+  second->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 2u);
+  EXPECT_EQ(second->GetHeight(), single_line_height);
+}
+
+TEST_F(ParagraphLayoutCacheTest, FontChangesInvalidateLayouts) {
+  BuildParagraph(u"Hello World")->Layout(1000);
+  font_collection_->ClearFontFamilyCache();
+  BuildParagraph(u"Hello World")->Layout(1000);
+
+  EXPECT_EQ(layout_cache_->GetMissCount(), 2u);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 0u);
+}
+
+TEST_F(ParagraphLayoutCacheTest, EvictsLeastRecentlyUsedLayouts) {
+  // Paragraphs with one letter of text are all estimated to be the same size.
+  BuildParagraph(u"A")->Layout(1000);
+  size_t paragraph_bytes = layout_cache_->GetByteCount();
+  EXPECT_GT(paragraph_bytes, ParagraphLayoutCache::kParagraphOverheadBytes);
+
+  layout_cache_ = std::make_shared<ParagraphLayoutCache>(2u * paragraph_bytes);
+  BuildParagraph(u"A")->Layout(1000);
+  BuildParagraph(u"B")->Layout(1000);
+  // Use A again so that B is the least recently used layout.
+  BuildParagraph(u"A")->Layout(1000);
+  BuildParagraph(u"C")->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 2u);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 1u);
+  EXPECT_EQ(layout_cache_->GetMissCount(), 3u);
+
+  BuildParagraph(u"A")->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetHitCount(), 2u);
+  BuildParagraph(u"B")->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetMissCount(), 4u);
+  EXPECT_EQ(layout_cache_->GetByteCount(), 2u * paragraph_bytes);
+}
+
+TEST_F(ParagraphLayoutCacheTest, LongParagraphsTakeTheRoomOfShortOnes) {
+  BuildParagraph(u"A")->Layout(1000);
+  size_t short_bytes = layout_cache_->GetByteCount();
+
+  layout_cache_ = std::make_shared<ParagraphLayoutCache>(4u * short_bytes);
+  BuildParagraph(u"A")->Layout(1000);
+  BuildParagraph(u"B")->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 2u);
+
+  // A paragraph that is larger than the whole cache is not cached.
+  std::u16string long_text(4u * short_bytes, u'x');
+  BuildParagraph(long_text)->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 2u);
+
+  // A paragraph that fits evicts as many short ones as it needs to.
+  std::u16string medium_text(
+      (3u * short_bytes - ParagraphLayoutCache::kParagraphOverheadBytes) /
+          (ParagraphLayoutCache::kBytesPerContentByte * sizeof(char16_t)),
+      u'x');
+  BuildParagraph(medium_text)->Layout(1000);
+  EXPECT_EQ(layout_cache_->GetEntryCount(), 1u);
+  EXPECT_LE(layout_cache_->GetByteCount(), 4u * short_bytes);
+}
+
+}  // namespace testing
+}  // namespace txt